@@ -20,6 +20,7 @@
 #include <vector>
 #include <string>
 #include <math.h>
+#include <string.h>
 
 // --- RESERVED PARAMETER ID VALUES
 const unsigned int PLUGIN_SIDE_BYPASS = 131072; ///<RESERVED PARAMETER ID VALUE
@@ -254,6 +255,100 @@ Use this strongly typed enum to easily set the control taper
 */
 enum class taper { kLinearTaper, kLogTaper, kAntiLogTaper, kVoltOctaveTaper };
 
+const uint32_t TAPER_TABLE_BITS = 11;							///< log2 of the fast taper math table size
+const uint32_t TAPER_TABLE_SIZE = 1 << TAPER_TABLE_BITS;		///< intervals in the fast taper math tables
+const double kLog10Of2 = 0.30102999566398119521;				///< log10(2)
+const double kLog2Of10 = 3.32192809488736234787;				///< log2(10)
+
+/**
+\class FastTaperMath
+\ingroup ASPiK-Core
+\brief
+Table based log2( ) and exp2( ) for the log, anti-log and volt/octave control tapers, so that normalized-to-actual
+conversions during automation do not call log10( ), pow( ) and log2( ).
+
+- log2: the exponent comes from the double's bits, the mantissa indexes a table of log2(1 + i/N) with linear interpolation
+- exp2: the integer part goes straight into the double's exponent, the fraction indexes a table of 2^(i/N) with linear interpolation
+- with N = TAPER_TABLE_SIZE the error is below float precision, which is how the control values are stored
+- zero, negative, denormal, infinite and out-of-range arguments fall back to the math library, so the results match it there
+
+The tables are shared by all parameters and are built once, when the first PluginParameter is constructed.
+
+\version Revision : 1.0
+*/
+class FastTaperMath
+{
+public:
+	/** the shared tables */
+	static const FastTaperMath& getInstance()
+	{
+		static FastTaperMath instance;
+		return instance;
+	}
+
+	/** log2(x) */
+	inline double fastLog2(double x) const
+	{
+		uint64_t bits = 0;
+		memcpy(&bits, &x, sizeof(double));
+
+		// --- zero, negative, denormal, inf, NaN
+		uint32_t exponent = (uint32_t)(bits >> 52);
+		if (exponent == 0 || exponent >= 0x7FF)
+			return log2(x);
+
+		// --- top mantissa bits index the table, the rest interpolate
+		const uint32_t shift = 52 - TAPER_TABLE_BITS;
+		uint64_t mantissa = bits & 0xFFFFFFFFFFFFFull;
+		uint32_t index = (uint32_t)(mantissa >> shift);
+		double frac = (double)(mantissa & (((uint64_t)1 << shift) - 1)) * (1.0 / (double)((uint64_t)1 << shift));
+
+		return (double)((int32_t)exponent - 1023) + log2Table[index] + frac*(log2Table[index + 1] - log2Table[index]);
+	}
+
+	/** 2^x */
+	inline double fastExp2(double x) const
+	{
+		// --- out of range or NaN
+		if (!(x > -1022.0 && x < 1023.0))
+			return pow(2.0, x);
+
+		int32_t integer = (int32_t)x;
+		if ((double)integer > x)
+			integer--;
+
+		double position = (x - (double)integer) * TAPER_TABLE_SIZE;
+		uint32_t index = (uint32_t)position;
+		double mantissa = exp2Table[index] + (position - (double)index)*(exp2Table[index + 1] - exp2Table[index]);
+
+		// --- 2^integer
+		uint64_t bits = (uint64_t)(integer + 1023) << 52;
+		double scale = 0.0;
+		memcpy(&scale, &bits, sizeof(double));
+
+		return mantissa * scale;
+	}
+
+	/** log10(x) */
+	inline double fastLog10(double x) const { return kLog10Of2 * fastLog2(x); }
+
+	/** 10^x */
+	inline double fastPow10(double x) const { return fastExp2(kLog2Of10 * x); }
+
+private:
+	FastTaperMath()
+	{
+		for (uint32_t i = 0; i <= TAPER_TABLE_SIZE; i++)
+		{
+			log2Table[i] = log2(1.0 + (double)i / TAPER_TABLE_SIZE);
+			exp2Table[i] = pow(2.0, (double)i / TAPER_TABLE_SIZE);
+		}
+	}
+
+	double log2Table[TAPER_TABLE_SIZE + 1];	///< log2(1 + i/N)
+	double exp2Table[TAPER_TABLE_SIZE + 1];	///< 2^(i/N)
+};
+
 /**
 \enum meterCal
 \ingroup Constants-Enums
@@ -303,6 +398,8 @@ Use this strongly typed enum to easily set the control's linked variable datatyp
 */
 enum class boundVariableType { kFloat, kDouble, kInt, kUInt };
 
+const double SMOOTHING_SETTLE_THRESHOLD = 1.0e-6; ///< LPF smoothing snaps to the target within this fraction of the control range
+
 /**
 \class ParamSmoother
 \ingroup ASPiK-GUI
@@ -334,6 +431,9 @@ public:
 
 		// --- for linear smoother
 		linInc = (maxVal - minVal) / (smoothingTimeInMSec * 0.001 * sampleRate);
+
+		// --- LPF is done when this close to the target
+		settleThreshold = (maxVal - minVal) * SMOOTHING_SETTLE_THRESHOLD;
 	}
 
 	/** initialize the smoother; this recalculates internal coefficients
@@ -355,6 +455,7 @@ public:
 		maxVal = maxControlValue;
 		sampleRate = samplingRate;
 		smoothingTimeInMSec = smoothingTimeInMs;
+		smootherType = smoother;
 
 		setSampleRate(samplingRate);
 
@@ -372,12 +473,16 @@ public:
 	{
 		if (smootherType == smoothingMethod::kLPFSmoother)
 		{
-			z = (in * b) + (z * a);
-			if (z == z2)
+			if (z == in)
 			{
 				out = in;
 				return false;
 			}
+			z = (in * b) + (z * a);
+
+			// --- a one-pole only approaches the target; snap when close enough
+			if (fabs(z - in) <= settleThreshold)
+				z = in;
 			z2 = z;
 			out = z2;
 			return true;
@@ -411,6 +516,7 @@ private:
 	T z2 = 0.0;		///< storage register
 
 	T linInc = 0.0;	///< linear stepping value
+	T settleThreshold = 0.0;	///< LPF snaps to the target within this distance
 
 	T minVal = 0.0;	///< min extrema
 	T maxVal = 1.0;	///< max exrema
@@ -422,4 +528,304 @@ private:
 };
 
 
+const uint32_t SMOOTHING_BLOCK_SIZE = 64; ///< samples per smoother bank block
+
+/**
+\class ParamSmootherBank
+\ingroup ASPiK-Core
+\brief
+The ParamSmootherBank object smooths all of the plugin's smoothable parameters in one place. Targets, states and
+coefficients are kept in contiguous arrays (structure-of-arrays) and the smoothers run once per block of up to
+SMOOTHING_BLOCK_SIZE samples, publishing a ramp of per-sample values for each moving parameter. Parameters that are
+not moving are skipped: the bank keeps a list of the active smoothers, a smoother joins it when it gets a new target
+and leaves it the block after it settles, so an idle bank does no work.
+
+The LPF smoother uses the closed form of the one-pole recursion, y(k) = target + (y(0) - target)*a^(k+1), with the
+powers of a precomputed per parameter, so each ramp is a single loop with no recursion that the compiler can vectorize.
+The linear smoother steps by a fixed increment and clamps at the target. The LPF snaps to the target once it is within
+SMOOTHING_SETTLE_THRESHOLD of the control range.
+
+\version Revision : 1.0
+*/
+class ParamSmootherBank
+{
+public:
+	ParamSmootherBank() {}
+	~ParamSmootherBank() { destroy(); }
+
+	/** allocate the arrays; NOT thread safe, call during initialization only */
+	void create(uint32_t _numSmoothers)
+	{
+		destroy();
+		numSmoothers = _numSmoothers;
+		if (numSmoothers == 0)
+			return;
+
+		targets = new double[numSmoothers];
+		states = new double[numSmoothers];
+		linearIncs = new double[numSmoothers];
+		settleThresholds = new double[numSmoothers];
+		activeList = new uint32_t[numSmoothers];
+		isLinear = new bool[numSmoothers];
+		isEnabled = new bool[numSmoothers];
+		isActive = new bool[numSmoothers];
+		lpfPowers = new double[numSmoothers*SMOOTHING_BLOCK_SIZE];
+		ramps = new double[numSmoothers*SMOOTHING_BLOCK_SIZE];
+
+		for (uint32_t i = 0; i < numSmoothers; i++)
+		{
+			targets[i] = 0.0;
+			states[i] = 0.0;
+			linearIncs[i] = 0.0;
+			settleThresholds[i] = 0.0;
+			activeList[i] = 0;
+			isLinear[i] = false;
+			isEnabled[i] = false;
+			isActive[i] = false;
+		}
+		memset(lpfPowers, 0, sizeof(double)*numSmoothers*SMOOTHING_BLOCK_SIZE);
+		memset(ramps, 0, sizeof(double)*numSmoothers*SMOOTHING_BLOCK_SIZE);
+
+		numActive = 0;
+		rampLength = 0;
+		rampPosition = 0;
+	}
+
+	/** initialize one smoother; same arguments as ParamSmoother::initParamSmoother( ) plus the enable flag
+	\param index smoother index
+	\param smoothingTimeInMs the smoothing time in mSec to move from the two control extrema (min and max values)
+	\param samplingRate the sampling rate
+	\param initValue initial (pre-smoothed) value
+	\param minControlValue minimum numerical value control takes
+	\param maxControlValue maximum numerical value control takes
+	\param smoother type of smoothing
+	\param enable false for parameters that do not use smoothing
+	*/
+	void initSmoother(uint32_t index, double smoothingTimeInMs, double samplingRate, double initValue,
+					  double minControlValue, double maxControlValue, smoothingMethod smoother, bool enable)
+	{
+		if (index >= numSmoothers)
+			return;
+
+		double samples = smoothingTimeInMs * 0.001 * samplingRate;
+		double a = samples > 0.0 ? exp(-kTwoPi / samples) : 0.0;
+
+		// --- powers a^1 ... a^N for the closed form LPF
+		double power = 1.0;
+		for (uint32_t k = 0; k < SMOOTHING_BLOCK_SIZE; k++)
+		{
+			power *= a;
+			lpfPowers[index*SMOOTHING_BLOCK_SIZE + k] = power;
+		}
+
+		linearIncs[index] = samples > 0.0 ? (maxControlValue - minControlValue) / samples : (maxControlValue - minControlValue);
+		settleThresholds[index] = (maxControlValue - minControlValue) * SMOOTHING_SETTLE_THRESHOLD;
+		isLinear[index] = smoother == smoothingMethod::kLinearSmoother;
+		isEnabled[index] = enable;
+		targets[index] = initValue;
+		states[index] = initValue;
+	}
+
+	/** empty the active list and the ramps; call before re-initializing the smoothers */
+	void reset()
+	{
+		for (uint32_t j = 0; j < numActive; j++)
+			isActive[activeList[j]] = false;
+		numActive = 0;
+		rampLength = 0;
+		rampPosition = 0;
+	}
+
+	/** set a new target; the ramp toward it starts with the next block; an idle bank starts that block right away */
+	inline void setTarget(uint32_t index, double target)
+	{
+		targets[index] = target;
+		if (!isActive[index] && isEnabled[index] && target != states[index])
+		{
+			if (numActive == 0)
+				rampPosition = rampLength;
+			else
+			{
+				// --- joining in the middle of a block: hold the current value until the block ends so the ramp is valid
+				double* ramp = &ramps[index*SMOOTHING_BLOCK_SIZE];
+				for (uint32_t k = rampPosition; k < rampLength; k++)
+					ramp[k] = states[index];
+			}
+
+			isActive[index] = true;
+			activeList[numActive++] = index;
+		}
+	}
+
+	/** snap a smoother to a value (e.g. after a sample accurate automation write); a moving smoother holds the
+	    value for the rest of the current block and then settles */
+	inline void setValue(uint32_t index, double value)
+	{
+		targets[index] = value;
+		states[index] = value;
+
+		if (isActive[index])
+		{
+			double* ramp = &ramps[index*SMOOTHING_BLOCK_SIZE];
+			for (uint32_t k = rampPosition; k < rampLength; k++)
+				ramp[k] = value;
+		}
+	}
+
+	/** run all moving smoothers for one block
+	\param blockSize number of samples, up to SMOOTHING_BLOCK_SIZE
+	*/
+	void processBlock(uint32_t blockSize)
+	{
+		if (blockSize > SMOOTHING_BLOCK_SIZE)
+			blockSize = SMOOTHING_BLOCK_SIZE;
+
+		// --- drop the smoothers that settled during the last block
+		uint32_t count = 0;
+		for (uint32_t j = 0; j < numActive; j++)
+		{
+			uint32_t i = activeList[j];
+			if (states[i] == targets[i])
+				isActive[i] = false;
+			else
+				activeList[count++] = i;
+		}
+		numActive = count;
+
+		for (uint32_t j = 0; j < numActive; j++)
+		{
+			uint32_t i = activeList[j];
+			double* ramp = &ramps[i*SMOOTHING_BLOCK_SIZE];
+			double start = states[i];
+			double target = targets[i];
+
+			if (isLinear[i])
+			{
+				// --- fixed step, clamped at the target
+				if (target > start)
+				{
+					double inc = linearIncs[i];
+					for (uint32_t k = 0; k < blockSize; k++)
+					{
+						double value = start + inc*(k + 1);
+						ramp[k] = value < target ? value : target;
+					}
+				}
+				else
+				{
+					double inc = -linearIncs[i];
+					for (uint32_t k = 0; k < blockSize; k++)
+					{
+						double value = start + inc*(k + 1);
+						ramp[k] = value > target ? value : target;
+					}
+				}
+			}
+			else
+			{
+				// --- closed form one-pole
+				const double* powers = &lpfPowers[i*SMOOTHING_BLOCK_SIZE];
+				double distance = start - target;
+				for (uint32_t k = 0; k < blockSize; k++)
+					ramp[k] = target + distance*powers[k];
+
+				// --- snap when close enough; we leave the active list next block
+				if (fabs(ramp[blockSize - 1] - target) <= settleThresholds[i])
+					ramp[blockSize - 1] = target;
+			}
+
+			states[i] = ramp[blockSize - 1];
+		}
+
+		rampLength = blockSize;
+		rampPosition = 0;
+	}
+
+	/** true if nothing is moving, no smoother has a new target and the last ramps have been consumed */
+	bool isIdle()
+	{
+		if (numActive == 0)
+			return true;
+
+		for (uint32_t j = 0; j < numActive; j++)
+		{
+			if (states[activeList[j]] != targets[activeList[j]])
+				return false;
+		}
+		return rampPosition >= rampLength;
+	}
+
+	/** number of smoothers */
+	uint32_t getNumSmoothers() { return numSmoothers; }
+
+	/** number of smoothers in the active list */
+	uint32_t getNumActive() { return numActive; }
+
+	/** the active list: indexes of the smoothers whose ramps are valid for the last block */
+	inline const uint32_t* getActiveList() { return activeList; }
+
+	/** smoother is enabled */
+	inline bool getEnabled(uint32_t index) { return isEnabled[index]; }
+
+	/** smoother is in the active list; its ramp is valid for the last block */
+	inline bool getActive(uint32_t index) { return isActive[index]; }
+
+	/** the ramp of per-sample values for the last block (valid if getActive( ) is true) */
+	inline const double* getRamp(uint32_t index) { return &ramps[index*SMOOTHING_BLOCK_SIZE]; }
+
+	/** value at the end of the last block */
+	inline double getValue(uint32_t index) { return states[index]; }
+
+	/** length of the last block */
+	uint32_t getRampLength() { return rampLength; }
+
+	/** per-frame consumers: position within the last block */
+	uint32_t getRampPosition() { return rampPosition; }
+
+	/** move to the next sample of the block, or past a span of samples */
+	inline void advanceRampPosition(uint32_t numSamples = 1) { rampPosition += numSamples; }
+
+protected:
+	uint32_t numSmoothers = 0;		///< number of smoothers
+	double* targets = nullptr;		///< target values
+	double* states = nullptr;		///< current values (end of last block)
+	double* linearIncs = nullptr;	///< linear smoother step per sample
+	double* settleThresholds = nullptr;	///< LPF snaps to the target within this distance
+	double* lpfPowers = nullptr;	///< a^1 ... a^N per smoother, for the closed form LPF
+	double* ramps = nullptr;		///< SMOOTHING_BLOCK_SIZE values per smoother
+	bool* isLinear = nullptr;		///< linear or LPF
+	bool* isEnabled = nullptr;		///< smoothing enabled
+	bool* isActive = nullptr;		///< in the active list
+
+	uint32_t* activeList = nullptr;	///< indexes of the moving smoothers
+	uint32_t numActive = 0;			///< length of the active list
+	uint32_t rampLength = 0;		///< samples in the last block
+	uint32_t rampPosition = 0;		///< per-frame read position
+
+	/** free the arrays */
+	void destroy()
+	{
+		delete[] targets;
+		delete[] states;
+		delete[] linearIncs;
+		delete[] settleThresholds;
+		delete[] activeList;
+		delete[] lpfPowers;
+		delete[] ramps;
+		delete[] isLinear;
+		delete[] isEnabled;
+		delete[] isActive;
+		targets = states = linearIncs = settleThresholds = lpfPowers = ramps = nullptr;
+		activeList = nullptr;
+		isLinear = isEnabled = isActive = nullptr;
+		numSmoothers = 0;
+		numActive = 0;
+	}
+
+private:
+	ParamSmootherBank(const ParamSmootherBank&);				///< not copyable
+	ParamSmootherBank& operator=(const ParamSmootherBank&);	///< not copyable
+};
+
+
 #endif
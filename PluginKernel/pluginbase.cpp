@@ -18,6 +18,7 @@
 Operation:
 - flush frame buffers
 - pluginHostConnector reset
+- connect the kernel MIDI event ring to processMIDIEvent( )
 - NOTE: most initializations done in .h file
 */
 PluginBase::PluginBase()
@@ -28,6 +29,7 @@ PluginBase::PluginBase()
     memset(&auxOutputFrame, 0, sizeof(float)*MAX_CHANNEL_COUNT);
 
     pluginHostConnector = nullptr;
+    midiEventRing.setMidiEventProcessor(this);
 }
 
 /**
@@ -58,6 +60,8 @@ PluginBase::~PluginBase()
 	delete [] pluginParameterArray;
 	delete [] smoothablePluginParameters;
 	delete [] outboundPluginParameters;
+	delete [] changedParameterIndexes;
+	clearControlIDLookup();
 }
 
 /**
@@ -66,9 +70,16 @@ PluginBase::~PluginBase()
 Operation:
 - update sample-rate dependent objects
 - PluginParameter will update its smoother (its only sample rate dependent member)
+- discard any MIDI events left in the kernel ring
 */
 bool PluginBase::reset(ResetInfo& resetInfo)
 {
+	// --- stale MIDI from the last run
+	midiEventRing.flush();
+
+	// --- smoother bank coefficients
+	initSmootherBank(resetInfo.sampleRate);
+
 	// --- update param smoothers
 	for (std::vector<PluginParameter*>::iterator it = pluginParameters.begin(); it != pluginParameters.end(); ++it)
 	{
@@ -98,22 +109,41 @@ bool PluginBase::initialize(PluginInfo& _pluginInfo)
 \brief initialize object for a new run of audio; called just before audio streams
 
 Operation:
-- iterate through parameters and copy their values into the bound variables you set up
+- iterate through the parameters whose values changed since the last sync (see ParameterChangeFlags) and copy their values into the bound variables you set up
+- the values come from the parameter snapshot (see ParameterSnapshot), at full double precision; they are read after the flags
+  are collected, and a value is always published before its flag is set, so every flagged value is in the snapshot
 - then, call the postUpdatePluginParameter method to do any post-update cooking required to use the variable for processing
+- unchanged parameters are not visited, so they are not re-cooked
+- a preset loaded with applyPreset( ) is picked up with one atomic exchange; its flags are all set before they are
+  collected, so the whole preset lands in the same buffer
 */
 void PluginBase::syncInBoundVariables()
 {
+	PresetImage* presetImage = pendingPresetImage.exchange(nullptr, std::memory_order_acquire);
+	if (presetImage)
+		presetImage->setFlags(parameterChangeFlags, smoothingTargetFlags);
+
+	CollectParameterIndex changed = { changedParameterIndexes, 0 };
+	parameterChangeFlags.collectFlags(changed);
+	if (changed.count == 0)
+		return;
+
 	ParameterUpdateInfo info;
 	info.bufferProcUpdate = true;
 	info.boundVariableUpdate = true;
 
-	// --- rip through and synch em
-	for (unsigned int i = 0; i < numPluginParameters; i++)
+	for (uint32_t i = 0; i < changed.count; i++)
 	{
-		if (pluginParameterArray[i] && pluginParameterArray[i]->updateInBoundVariable())
-		{
-			postUpdatePluginParameter(pluginParameterArray[i]->getControlID(), pluginParameterArray[i]->getControlValue(), info);
-		}
+		uint32_t index = changedParameterIndexes[i];
+		PluginParameter* piParam = pluginParameterArray[index];
+
+		// --- meters are written by the audio thread and are not in the snapshot
+		if (!piParam || piParam->getControlVariableType() == controlVariableType::kMeter)
+			continue;
+
+		double value = parameterSnapshot.getValue(index);
+		if (piParam->updateInBoundVariable(value))
+			postUpdatePluginParameter(piParam->getControlID(), value, info);
 	}
 }
 
@@ -140,6 +170,13 @@ bool PluginBase::processAudioBuffers(ProcessBufferInfo& processBufferInfo)
 
 	double sampleInterval = 1.0 / audioProcDescriptor.sampleRate;
 
+	// --- wrappers that fill the kernel MIDI event ring do not need to supply a queue
+	if (!processBufferInfo.midiEventQueue)
+		processBufferInfo.midiEventQueue = &midiEventRing;
+
+	// --- events pushed from here on belong to the next buffer
+	midiEventRing.beginBuffer();
+
 	if (pluginDescriptor.processFrames)
 	{
 		ProcessFrameInfo info;
@@ -163,38 +200,64 @@ bool PluginBase::processAudioBuffers(ProcessBufferInfo& processBufferInfo)
 		// --- sync internal bound variables
 		preProcessAudioBuffers(processBufferInfo);
 
-		// --- build frames, one sample from each channel
-		for (uint32_t frame = 0; frame<processBufferInfo.numFramesToProcess; frame++)
+		// --- VST3 sample accurate automation: read the queues once for the whole buffer
+		automationTimelineValid = buildAutomationTimeline(processBufferInfo.numFramesToProcess);
+
+		if (scheduleBufferEvents(processBufferInfo))
 		{
-			for (uint32_t i = 0; i<processBufferInfo.numAudioInChannels; i++)
-			{
-				inputFrame[i] = processBufferInfo.inputs[i][frame];
-			}
+			// --- kernel event scheduler: fire MIDI and automation at their timestamps and render the
+			//     spans in between; an idle buffer is one span
+			info.eventsScheduled = true;
+
+			// --- block ramp smoothing: spans are also cut at the smoothing block boundaries
+			bool rampSmoothing = !smootherBank.isIdle();
 
-			for (uint32_t i = 0; i<processBufferInfo.numAuxAudioInChannels; i++)
+			uint32_t startFrame = 0;
+			uint32_t nextEvent = 0;
+			while (startFrame < processBufferInfo.numFramesToProcess)
 			{
-				auxInputFrame[i] = processBufferInfo.auxInputs[i][frame];
-			}
+				if (nextEvent < scheduledEventOffsets.getCount() && scheduledEventOffsets.getOffset(nextEvent) == startFrame)
+				{
+					if (info.midiEventQueue)
+						info.midiEventQueue->fireMidiEvents(startFrame);
 
-			info.currentFrame = frame;
+					doScheduledParameterUpdates(startFrame);
+					nextEvent++;
+				}
 
-			// -- process the frame of data
-			processAudioFrame(info);
+				if (rampSmoothing && smootherBank.getRampPosition() >= smootherBank.getRampLength())
+					startParameterRampBlock();
 
-			for (uint32_t i = 0; i<processBufferInfo.numAudioOutChannels; i++)
-			{
-				processBufferInfo.outputs[i][frame] = outputFrame[i];
-			}
-			for (uint32_t i = 0; i<processBufferInfo.numAuxAudioOutChannels; i++)
-			{
-				processBufferInfo.auxOutputs[i][frame] = auxOutputFrame[i];
-			}
+				uint32_t endFrame = nextEvent < scheduledEventOffsets.getCount() ? scheduledEventOffsets.getOffset(nextEvent) : processBufferInfo.numFramesToProcess;
+				if (rampSmoothing)
+					endFrame = std::min(endFrame, startFrame + smootherBank.getRampLength() - smootherBank.getRampPosition());
 
-			// --- update per-frame
-			info.hostInfo->uAbsoluteFrameBufferIndex += 1;
-			info.hostInfo->dAbsoluteFrameBufferTime += sampleInterval;
+				// --- derived class may render the whole span; else break it into frames
+				if (processAudioSubBlock(processBufferInfo, startFrame, endFrame - startFrame))
+				{
+					info.hostInfo->uAbsoluteFrameBufferIndex += endFrame - startFrame;
+					info.hostInfo->dAbsoluteFrameBufferTime += (endFrame - startFrame)*sampleInterval;
+				}
+				else
+					processFrameSpan(processBufferInfo, info, startFrame, endFrame - startFrame);
+
+				if (rampSmoothing)
+					smootherBank.advanceRampPosition(endFrame - startFrame);
+
+				startFrame = endFrame;
+			}
+		}
+		else
+		{
+			// --- timestamps unknown or parameters are smoothing: processAudioFrame( ) polls per-frame
+			info.eventsScheduled = false;
+			processFrameSpan(processBufferInfo, info, 0, processBufferInfo.numFramesToProcess);
 		}
 
+		// --- fire any late events of this buffer (timestamps past its end) so they can not block the ring
+		if (info.midiEventQueue == &midiEventRing)
+			midiEventRing.fireMidiEvents(0xFFFFFFFF);
+
 		// --- generally not used
 		postProcessAudioBuffers(processBufferInfo);
 
@@ -204,6 +267,209 @@ bool PluginBase::processAudioBuffers(ProcessBufferInfo& processBufferInfo)
 	return false; /// processed
 }
 
+/**
+\brief break a span of the buffer into frames and call processAudioFrame( ) on each
+
+\param processBufferInfo - the buffer being processed
+\param info - frame information, already set up for this buffer
+\param startFrame - first frame of the span
+\param numFrames - length of the span
+*/
+void PluginBase::processFrameSpan(ProcessBufferInfo& processBufferInfo, ProcessFrameInfo& info, uint32_t startFrame, uint32_t numFrames)
+{
+	double sampleInterval = 1.0 / audioProcDescriptor.sampleRate;
+
+	// --- build frames, one sample from each channel
+	for (uint32_t frame = startFrame; frame < startFrame + numFrames; frame++)
+	{
+		for (uint32_t i = 0; i<processBufferInfo.numAudioInChannels; i++)
+		{
+			inputFrame[i] = processBufferInfo.inputs[i][frame];
+		}
+
+		for (uint32_t i = 0; i<processBufferInfo.numAuxAudioInChannels; i++)
+		{
+			auxInputFrame[i] = processBufferInfo.auxInputs[i][frame];
+		}
+
+		info.currentFrame = frame;
+
+		// -- process the frame of data
+		processAudioFrame(info);
+
+		for (uint32_t i = 0; i<processBufferInfo.numAudioOutChannels; i++)
+		{
+			processBufferInfo.outputs[i][frame] = outputFrame[i];
+		}
+		for (uint32_t i = 0; i<processBufferInfo.numAuxAudioOutChannels; i++)
+		{
+			processBufferInfo.auxOutputs[i][frame] = auxOutputFrame[i];
+		}
+
+		// --- update per-frame
+		info.hostInfo->uAbsoluteFrameBufferIndex += 1;
+		info.hostInfo->dAbsoluteFrameBufferTime += sampleInterval;
+	}
+}
+
+/**
+\brief kernel event scheduler: collect and sort the MIDI and VST3 automation timestamps for this buffer
+
+Operation:
+- if any parameter is still smoothing, the buffer must be updated per-frame, so return false; parameters with block ramp
+  smoothing are the exception: their smoothing blocks become span boundaries (see startParameterRampBlock( ))
+- ask the MIDI queue for its sample offsets and add the offsets of the automation timeline (see buildAutomationTimeline( ));
+  a queue that can not report them forces per-frame polling
+- sort and remove duplicates; the buffer is then rendered in the spans between the offsets
+
+\param processBufferInfo - the buffer about to be processed
+
+\return true if scheduledEventOffsets holds every event timestamp, false to poll per-frame
+*/
+bool PluginBase::scheduleBufferEvents(ProcessBufferInfo& processBufferInfo)
+{
+	uint32_t bufferSize = processBufferInfo.numFramesToProcess;
+	scheduledEventOffsets.clear();
+
+	// --- smoothing needs per-frame updates unless the moving parameters use block ramps
+	updateSmootherTargets();
+	if (!smootherBank.isIdle() && !smoothingIsBlockRamped())
+		return false;
+
+	// --- MIDI
+	if (processBufferInfo.midiEventQueue && processBufferInfo.midiEventQueue->getEventCount() > 0)
+	{
+		uint32_t count = 0;
+		if (!processBufferInfo.midiEventQueue->getEventSampleOffsets(scheduledEventOffsets.getFreeSpace(), scheduledEventOffsets.getFreeSpaceCount(), count))
+			return false;
+		scheduledEventOffsets.commitFreeSpace(count, bufferSize);
+	}
+
+	// --- VST3 sample accurate automation: the timeline was built at the top of the buffer
+	if (wantsVST3SampleAccurateAutomation())
+	{
+		if (!automationTimelineValid)
+			return false;
+
+		for (uint32_t i = 0; i < automationTimeline.getCount(); i++)
+			scheduledEventOffsets.addOffset(automationTimeline.getOffset(i), bufferSize);
+	}
+
+	if (scheduledEventOffsets.didOverflow())
+		return false;
+
+	scheduledEventOffsets.sortOffsets();
+	return true;
+}
+
+/**
+\brief collect the VST3 sample accurate automation of this buffer into a sorted timeline
+
+Operation:
+- each automated parameter queue reports its point offsets once per buffer
+- the value ramps from the top of the buffer up to the last point; the ramp is sampled every
+  apiSpecificInfo.vst3SampleAccurateGranularity frames, so the granularity is the automation sub-block size
+- events are sorted by offset; the buffer is then split at them (see scheduleBufferEvents( )) or, when polled per-frame,
+  only the frames with events touch a queue (see doSampleAccurateParameterUpdates( ))
+
+\param bufferSize - number of frames in the buffer
+
+\return true if the timeline holds every automation event, false if a queue can not report its points and must be polled
+*/
+bool PluginBase::buildAutomationTimeline(uint32_t bufferSize)
+{
+	automationTimeline.clear();
+	sampleAccurateFrame = 0;
+
+	if (!wantsVST3SampleAccurateAutomation())
+		return true;
+
+	uint32_t granularity = getVST3SampleAccuracyGranularity() > 0 ? getVST3SampleAccuracyGranularity() : 1;
+
+	for (uint32_t i = 0; i < numSmoothablePluginParameters; i++)
+	{
+		PluginParameter* piParam = smoothablePluginParameters[i];
+		if (!piParam || !piParam->getParameterUpdateQueue() || !piParam->getEnableVSTSampleAccurateAutomation())
+			continue;
+
+		uint32_t* points = automationTimeline.getPointSpace();
+		uint32_t count = 0;
+		if (!piParam->getParameterUpdateQueue()->getPointSampleOffsets(points, automationTimeline.getPointSpaceCount(), count))
+			return false;
+
+		count = std::min(count, automationTimeline.getPointSpaceCount());
+		uint32_t lastPoint = 0;
+		for (uint32_t p = 0; p < count; p++)
+		{
+			automationTimeline.addEvent(points[p], i, bufferSize);
+			lastPoint = points[p] > lastPoint ? points[p] : lastPoint;
+		}
+
+		// --- the value ramps from the top of the buffer up to the last point
+		for (uint32_t offset = 0; offset < lastPoint && offset < bufferSize; offset += granularity)
+			automationTimeline.addEvent(offset, i, bufferSize);
+
+		if (automationTimeline.didOverflow())
+			return false;
+	}
+
+	automationTimeline.sortEvents();
+	return true;
+}
+
+/**
+\brief kernel event scheduler: apply VST3 sample accurate automation at one timestamp
+
+Operation:
+- only the parameters with an event in the automation timeline at this offset are visited; the value is fetched by offset
+- no parameter is smoothing when this is called (see scheduleBufferEvents( ))
+
+\param sampleOffset - the timestamp, in samples from the top of the buffer
+*/
+void PluginBase::doScheduledParameterUpdates(uint32_t sampleOffset)
+{
+	if (numSmoothablePluginParameters == 0 || !wantsVST3SampleAccurateAutomation())
+		return;
+
+	ParameterUpdateInfo vst3Update(false, true); /// false = this is NOT called from smoothing operation, true: this is a VST sample accurate update
+	vst3Update.isVSTSampleAccurateUpdate = true;
+
+	uint32_t firstEvent = 0;
+	uint32_t count = automationTimeline.getEventsAtOffset(sampleOffset, firstEvent);
+	for (uint32_t i = firstEvent; i < firstEvent + count; i++)
+		applyAutomationEvent(automationTimeline.getEvent(i), vst3Update);
+}
+
+/**
+\brief apply one VST3 sample accurate automation event: fetch the value at its offset and update the parameter
+
+\param event - the timeline event
+\param vst3Update - update info for postUpdatePluginParameter( )
+*/
+void PluginBase::applyAutomationEvent(const AutomationEvent& event, ParameterUpdateInfo& vst3Update)
+{
+	PluginParameter* piParam = smoothablePluginParameters[event.parameterIndex];
+
+	double value = 0;
+	double previousValue = piParam->getNormalizedControlValueWithActualValue(piParam->getControlValue());
+	if (piParam->getParameterUpdateQueue()->getValueAtOffset(event.sampleOffset, previousValue, value))
+	{
+		// --- use the double it returns; the stored control value is only a float
+		double actualValue = piParam->setSampleAccurateControlValueNormalized(value); // no taper, no smoothing, not published to the snapshot
+
+		// --- a smoothed parameter must not ramp back to the old smoother state afterwards
+		if (smootherBank.getEnabled(event.parameterIndex))
+			smootherBank.setValue(event.parameterIndex, actualValue);
+
+		// --- now update the bound variable
+		if (piParam->updateInBoundVariable(actualValue))
+		{
+			vst3Update.boundVariableUpdate = true;
+		}
+		postUpdatePluginParameter(piParam->getControlID(), actualValue, vst3Update);
+	}
+}
+
 /**
 \brief copy newly updated metering variables into GUI parameters for display
 
@@ -236,10 +502,13 @@ bool PluginBase::updateOutBoundVariables()
 
 NOTE:
 - beware: this function can eat a lot of CPU if the sample accurate updates trigger complex cooking functions
-- to combat CPU usage, you can set the VST3 sample granularity in initPluginDescriptors() apiSpecificInfo.vst3SampleAccurateGranularity
+- to combat CPU usage, you can set the VST3 sample granularity in initPluginDescriptors() apiSpecificInfo.vst3SampleAccurateGranularity;
+  automation ramps are then updated once per granularity sub-block
 - you can also change the parameter smoothing granularity
-- but in either case, the list MUST be iterated; this function is the reason for the old-fashioned C-array of pointers\n
-  as it was found to be faster than any other list method for entire-list iteration (if you have a faster way, let me knmow!)
+- VST3 sample accurate automation comes from the automation timeline (see buildAutomationTimeline( )); only the frames with
+  events touch a queue; if a queue can not report its points, the whole list is iterated and every queue is polled per-frame
+- smoothing is done by the ParamSmootherBank once every SMOOTHING_BLOCK_SIZE calls; each call then reads one sample of the ramps
+- without VST3 sample accurate automation only the bank's active list is visited, so an idle plugin does no smoothing work
 - the parameter is updated with the smoothed value
 - the post-parameter update function is then called (complex cooking functions here will eat the CPU as well)
 */
@@ -248,21 +517,73 @@ void PluginBase::doSampleAccurateParameterUpdates()
 	if (numSmoothablePluginParameters == 0)
 		return;
 
-	// --- do updates
-	double value = 0;
-	bool vstSAAutomated = false;
-	ParameterUpdateInfo vst3Update(false, true); /// false = this is NOT called from smoothing operation, true: this is a VST sample accurate update
-	vst3Update.isVSTSampleAccurateUpdate = true;
+	// --- next block of smoothing ramps when the last one is used up; when nothing is moving,
+	//     a new target starts a block right away
+	bool newBlock = smootherBank.getRampPosition() >= smootherBank.getRampLength();
+	if (newBlock || smootherBank.getNumActive() == 0)
+	{
+		if (updateSmootherTargets() > 0)
+			newBlock = true;
+	}
+	if (newBlock)
+		smootherBank.processBlock(SMOOTHING_BLOCK_SIZE);
+
+	uint32_t rampPosition = smootherBank.getRampPosition();
+	smootherBank.advanceRampPosition();
+	uint32_t frame = sampleAccurateFrame++;
 
 	ParameterUpdateInfo paramSmoothUpdate(true, false); /// true = this is called from smoothing operation, false = NOT VST sample accurate update
 	paramSmoothUpdate.isSmoothing = true;
 
+	// --- smoothing, and the automation events at this frame from the timeline: visit the active list
+	if (!wantsVST3SampleAccurateAutomation() || automationTimelineValid)
+	{
+		uint32_t firstEvent = 0;
+		uint32_t numEvents = wantsVST3SampleAccurateAutomation() ? automationTimeline.getEventsAtOffset(frame, firstEvent) : 0;
+
+		ParameterUpdateInfo vst3Update(false, true); /// false = this is NOT called from smoothing operation, true: this is a VST sample accurate update
+		vst3Update.isVSTSampleAccurateUpdate = true;
+		for (uint32_t e = firstEvent; e < firstEvent + numEvents; e++)
+			applyAutomationEvent(automationTimeline.getEvent(e), vst3Update);
+
+		uint32_t numActive = smootherBank.getNumActive();
+		const uint32_t* activeList = smootherBank.getActiveList();
+		for (uint32_t j = 0; j < numActive; j++)
+		{
+			// --- do smoothing, but not if we did a sample accurate automation update!
+			bool vstSAAutomated = false;
+			for (uint32_t e = firstEvent; e < firstEvent + numEvents && !vstSAAutomated; e++)
+				vstSAAutomated = automationTimeline.getEvent(e).parameterIndex == activeList[j];
+			if (vstSAAutomated)
+				continue;
+
+			PluginParameter* piParam = smoothablePluginParameters[activeList[j]];
+			double smoothedValue = smootherBank.getRamp(activeList[j])[rampPosition];
+			piParam->setSmoothedControlValue(smoothedValue);
+
+			// --- update bound variable, if there is one
+			if (piParam->updateInBoundVariable(smoothedValue))
+			{
+				paramSmoothUpdate.boundVariableUpdate = true;
+			}
+			postUpdatePluginParameter(piParam->getControlID(), smoothedValue, paramSmoothUpdate);
+		}
+		return;
+	}
+
+	// --- the queues can not report their points: poll every queue
+	double value = 0;
+	ParameterUpdateInfo vst3Update(false, true); /// false = this is NOT called from smoothing operation, true: this is a VST sample accurate update
+	vst3Update.isVSTSampleAccurateUpdate = true;
+
 	// --- rip through the array
 	for (unsigned int i = 0; i < numSmoothablePluginParameters; i++)
 	{
 		PluginParameter* piParam = smoothablePluginParameters[i];
 		if (piParam)
 		{
+			bool vstSAAutomated = false;
+
 			// --- VST sample accurate stuff
 			if (wantsVST3SampleAccurateAutomation())
 			{
@@ -272,33 +593,228 @@ void PluginBase::doSampleAccurateParameterUpdates()
 				{
 					if (piParam->getParameterUpdateQueue()->getNextValue(value))
 					{
-						piParam->setControlValueNormalized(value, false, true); // false = do not apply taper, true = ignore smoothing (not needed here)
+						// --- use the double it returns; the stored control value is only a float
+						double actualValue = piParam->setSampleAccurateControlValueNormalized(value); // no taper, no smoothing, not published to the snapshot
 						vstSAAutomated = true;
 
+						// --- a smoothed parameter must not ramp back to the old smoother state afterwards
+						if (smootherBank.getEnabled(i))
+							smootherBank.setValue(i, actualValue);
+
 						// --- now update the bound variable
-						if (piParam->updateInBoundVariable())
+						if (piParam->updateInBoundVariable(actualValue))
 						{
 							vst3Update.boundVariableUpdate = true;
 						}
-						postUpdatePluginParameter(piParam->getControlID(), piParam->getControlValue(), vst3Update);
+						postUpdatePluginParameter(piParam->getControlID(), actualValue, vst3Update);
 					}
 				}
 			}
 
 			// --- do smoothing, but not if we did a sample accurate automation update!
-			if (!vstSAAutomated && piParam->smoothParameterValue())
+			if (!vstSAAutomated && smootherBank.getActive(i))
 			{
+				double smoothedValue = smootherBank.getRamp(i)[rampPosition];
+				piParam->setSmoothedControlValue(smoothedValue);
+
 				// --- update bound variable, if there is one
-				if (piParam->updateInBoundVariable())
+				if (piParam->updateInBoundVariable(smoothedValue))
 				{
 					paramSmoothUpdate.boundVariableUpdate = true;
 				}
-				postUpdatePluginParameter(piParam->getControlID(), piParam->getControlValue(), paramSmoothUpdate);
+				postUpdatePluginParameter(piParam->getControlID(), smoothedValue, paramSmoothUpdate);
 			}
 		}
 	}
 }
 
+/**
+\brief copy the new smoothing targets (written by the GUI/host thread) into the ParamSmootherBank; only parameters
+whose target flag is set are visited, and the targets come from the parameter snapshot at full precision
+
+NOTE:
+- the preset morph runs first, so a knob that moved since then wins over the morph
+
+\return the number of new targets
+*/
+uint32_t PluginBase::updateSmootherTargets()
+{
+	uint32_t morphCount = updatePresetMorph();
+
+	CollectParameterIndex changed = { changedParameterIndexes, 0 };
+	smoothingTargetFlags.collectFlags(changed);
+	if (changed.count == 0)
+		return morphCount;
+
+	for (uint32_t i = 0; i < changed.count; i++)
+	{
+		uint32_t index = changedParameterIndexes[i];
+		smootherBank.setTarget(index, parameterSnapshot.getValue(smoothablePluginParameters[index]->getSnapshotIndex()));
+	}
+	return changed.count + morphCount;
+}
+
+/**
+\brief run the preset morph and feed the morphed values to the smoother bank
+
+Operation:
+- called at control rate from updateSmootherTargets( ): at the top of each buffer and each smoothing block
+- the morph only runs when its mix changed (see PresetMorph)
+- parameters that smooth get a new smoother target; the others are written and cooked directly
+
+\return the number of new targets
+*/
+uint32_t PluginBase::updatePresetMorph()
+{
+	if (!presetMorph.morph())
+		return 0;
+
+	const double* values = presetMorph.getValues();
+	const uint32_t* indexes = presetMorph.getIndexes();
+	uint32_t count = presetMorph.getNumIndexes();
+
+	ParameterUpdateInfo info;
+	info.bufferProcUpdate = true;
+	info.boundVariableUpdate = true;
+
+	for (uint32_t j = 0; j < count; j++)
+	{
+		uint32_t i = indexes[j];
+		if (smootherBank.getEnabled(i))
+		{
+			smootherBank.setTarget(i, values[i]);
+			continue;
+		}
+
+		PluginParameter* piParam = smoothablePluginParameters[i];
+		piParam->setSmoothedControlValue(values[i]);
+		if (piParam->updateInBoundVariable(values[i]))
+			postUpdatePluginParameter(piParam->getControlID(), values[i], info);
+	}
+	return count;
+}
+
+/**
+\brief block ramp smoothing: check the smoothers in the active list
+
+\return true if every one belongs to a parameter with block ramp smoothing enabled
+*/
+bool PluginBase::smoothingIsBlockRamped()
+{
+	uint32_t numActive = smootherBank.getNumActive();
+	const uint32_t* activeList = smootherBank.getActiveList();
+	for (uint32_t j = 0; j < numActive; j++)
+	{
+		if (!smoothablePluginParameters[activeList[j]]->getBlockRampSmoothing())
+			return false;
+	}
+	return true;
+}
+
+/**
+\brief block ramp smoothing: run the next block of smoothing ramps for the kernel event scheduler
+
+NOTE:
+- the targets are the ones read at the start of the buffer
+- each moving parameter is set to its value at the end of the block, and its bound variable and
+  postUpdatePluginParameter( ) are updated once for the block; processAudioSubBlock( ) reads the
+  per-sample values with getParameterRamp( ) or getParameterRampLine( )
+*/
+void PluginBase::startParameterRampBlock()
+{
+	smootherBank.processBlock(SMOOTHING_BLOCK_SIZE);
+
+	ParameterUpdateInfo paramSmoothUpdate(true, false); /// true = this is called from smoothing operation, false = NOT VST sample accurate update
+	paramSmoothUpdate.isSmoothing = true;
+
+	uint32_t numActive = smootherBank.getNumActive();
+	const uint32_t* activeList = smootherBank.getActiveList();
+	for (uint32_t j = 0; j < numActive; j++)
+	{
+		PluginParameter* piParam = smoothablePluginParameters[activeList[j]];
+		double smoothedValue = smootherBank.getValue(activeList[j]);
+		piParam->setSmoothedControlValue(smoothedValue);
+
+		// --- update bound variable, if there is one
+		if (piParam->updateInBoundVariable(smoothedValue))
+		{
+			paramSmoothUpdate.boundVariableUpdate = true;
+		}
+		postUpdatePluginParameter(piParam->getControlID(), smoothedValue, paramSmoothUpdate);
+	}
+}
+
+/**
+\brief block ramp smoothing: get the smoothed values of a parameter for the current processAudioSubBlock( ) span
+
+NOTE:
+- only valid inside processAudioSubBlock( ); the span never crosses a smoothing block, so the ramp covers all of its frames
+- the parameter should have block ramp smoothing enabled (PluginParameter::setBlockRampSmoothing( )), otherwise
+  any move puts the buffer on the per-frame path and processAudioSubBlock( ) is not called
+
+\param controlID the parameter's control ID
+
+\return pointer to one value per frame of the span, or NULL if the parameter is not moving (use its bound variable)
+*/
+const double* PluginBase::getParameterRamp(int32_t controlID)
+{
+	PluginParameter* piParam = getPluginParameterByControlID(controlID);
+	if (!piParam || !piParam->getParameterSmoothing())
+		return nullptr;
+
+	if (piParam->getControlVariableType() != controlVariableType::kDouble &&
+		piParam->getControlVariableType() != controlVariableType::kFloat)
+		return nullptr;
+
+	uint32_t index = piParam->getSmootherIndex();
+	if (index >= smootherBank.getNumSmoothers() || !smootherBank.getActive(index) ||
+		smootherBank.getRampPosition() >= smootherBank.getRampLength())
+		return nullptr;
+
+	return smootherBank.getRamp(index) + smootherBank.getRampPosition();
+}
+
+/**
+\brief block ramp smoothing: get the current processAudioSubBlock( ) span of a parameter as a line from its first to its last value
+
+\param controlID the parameter's control ID
+\param numFrames the length of the span
+\param start returns the value at the first frame
+\param increment returns the per-frame increment; 0.0 if the parameter is not moving
+*/
+void PluginBase::getParameterRampLine(int32_t controlID, uint32_t numFrames, double& start, double& increment)
+{
+	const double* ramp = getParameterRamp(controlID);
+	if (!ramp)
+	{
+		start = getPIParamValueDouble(controlID);
+		increment = 0.0;
+		return;
+	}
+
+	start = ramp[0];
+	increment = numFrames > 1 ? (ramp[numFrames - 1] - ramp[0]) / (numFrames - 1) : 0.0;
+}
+
+/**
+\brief initialize the ParamSmootherBank from the smoothable parameters' settings and current values
+
+\param sampleRate the sample rate
+*/
+void PluginBase::initSmootherBank(double sampleRate)
+{
+	smootherBank.reset();
+	for (uint32_t i = 0; i < numSmoothablePluginParameters; i++)
+	{
+		PluginParameter* piParam = smoothablePluginParameters[i];
+		smootherBank.initSmoother(i, piParam->getSmoothingTimeMsec(), sampleRate, piParam->getControlValue(),
+								  piParam->getMinValue(), piParam->getMaxValue(), piParam->getSmoothingMethod(), piParam->getParameterSmoothing());
+
+		// --- pick up a target that is already pending
+		smootherBank.setTarget(i, parameterSnapshot.getValue(piParam->getSnapshotIndex()));
+	}
+}
+
 /**
 \brief adds a new plugin parameter to the parameter map
 
@@ -745,12 +1261,17 @@ const char* PluginBase::getPresetName(uint32_t index)
 size_t PluginBase::addPreset(PresetInfo* preset)
 {
 	presets.push_back(preset);
+	presetImages.push_back(nullptr);
+	compilePresetImage((uint32_t)presets.size() - 1);
 	return presets.size();
 }
 
 /**
 \brief remove a  preset - NOTE: does not delete object
 
+NOTE:
+- its compiled PresetImage is deleted; call with audio stopped (see releasePresetImage( ))
+
 \param index index of preset to remove
 */
 void PluginBase::removePreset(uint32_t index)
@@ -764,11 +1285,18 @@ void PluginBase::removePreset(uint32_t index)
 
 		delete preset;
 		presets.erase(presets.begin() + index);
+
+		releasePresetImage(presetImages[index]);
+		delete presetImages[index];
+		presetImages.erase(presetImages.begin() + index);
 	}
 }
 
 /**
 \brief remove all presets - NOTE: does not delete objects
+
+NOTE:
+- the compiled PresetImages are deleted; call with audio stopped (see releasePresetImage( ))
 */
 void PluginBase::removeAllPresets()
 {
@@ -781,6 +1309,13 @@ void PluginBase::removeAllPresets()
 		delete *it;
 	}
 	presets.clear();
+
+	for (std::vector<PresetImage*>::iterator it = presetImages.begin(); it != presetImages.end(); ++it)
+	{
+		releasePresetImage(*it);
+		delete *it;
+	}
+	presetImages.clear();
 }
 
 /**
@@ -796,6 +1331,192 @@ PresetInfo* PluginBase::getPreset(uint32_t index)
 	return nullptr;
 }
 
+/**
+\brief compile a preset into a dense PresetImage indexed like pluginParameterArray; called from addPreset( ) and
+initPluginParameterArray( ); call it again if you edit the preset or change a parameter's smoothing setting
+
+NOTE:
+- NOT on the audio thread, and call with audio stopped: the image is rebuilt in place (see releasePresetImage( ))
+- presets added before initPluginParameterArray( ) are compiled there
+
+\param index index of preset
+
+\return true if the image was compiled
+*/
+bool PluginBase::compilePresetImage(uint32_t index)
+{
+	if (index >= presets.size() || !pluginParameterArray)
+		return false;
+
+	if (!presetImages[index])
+		presetImages[index] = new PresetImage;
+	else
+		releasePresetImage(presetImages[index]);
+
+	PresetImage* image = presetImages[index];
+	image->create(numPluginParameters, numSmoothablePluginParameters);
+
+	std::vector<PresetParameter>& presetParameters = presets[index]->presetParameters;
+	for (std::vector<PresetParameter>::iterator it = presetParameters.begin(); it != presetParameters.end(); ++it)
+	{
+		PluginParameter* piParam = getPluginParameterByControlID((*it).controlID);
+		if (!piParam || piParam->getControlVariableType() == controlVariableType::kMeter)
+			continue;
+
+		// --- same choice as PluginParameter::setControlValue( )
+		bool smoothed = piParam->getParameterSmoothing() &&
+						(piParam->getControlVariableType() == controlVariableType::kDouble ||
+						 piParam->getControlVariableType() == controlVariableType::kFloat);
+		if (smoothed)
+			image->setSmoothedValue(piParam->getSnapshotIndex(), (*it).actualValue, piParam->getSmootherIndex());
+		else
+			image->setValue(piParam->getSnapshotIndex(), (*it).actualValue);
+	}
+
+	return true;
+}
+
+/**
+\brief set up a morph between two or four compiled presets; the smoothable (kDouble, kFloat) parameters that are in
+every one of them are morphed, the others are left alone
+
+NOTE:
+- NOT on the audio thread; the source values are gathered into dense arrays here, so the morph itself has no lookups
+- the current mix is kept; set it with setPresetMorphWeights( ), setPresetMorphPosition( ) or the vector joystick
+
+\param presetA index of preset A
+\param presetB index of preset B
+\param presetC index of preset C, or -1 for a two-way morph
+\param presetD index of preset D, or -1 for a two-way morph
+
+\return true if the morph was set up
+*/
+bool PluginBase::setPresetMorph(int32_t presetA, int32_t presetB, int32_t presetC, int32_t presetD)
+{
+	uint32_t numSources = presetC >= 0 && presetD >= 0 ? MAX_MORPH_PRESETS : 2;
+	int32_t presetIndexes[MAX_MORPH_PRESETS] = { presetA, presetB, presetC, presetD };
+	PresetImage* images[MAX_MORPH_PRESETS] = { nullptr, nullptr, nullptr, nullptr };
+
+	for (uint32_t k = 0; k < numSources; k++)
+	{
+		images[k] = presetIndexes[k] >= 0 ? getPresetImage((uint32_t)presetIndexes[k]) : nullptr;
+		if (!images[k])
+			return false;
+	}
+
+	presetMorph.lockSetup();
+	presetMorph.beginSetup(numSources);
+
+	for (uint32_t i = 0; i < numSmoothablePluginParameters; i++)
+	{
+		uint32_t index = smoothablePluginParameters[i]->getSnapshotIndex();
+		bool inEveryPreset = true;
+
+		for (uint32_t k = 0; k < numSources; k++)
+		{
+			bool hasValue = images[k]->hasValue(index);
+			presetMorph.getSource(k)[i] = hasValue ? images[k]->getValues()[index] : 0.0;
+			inEveryPreset = inEveryPreset && hasValue;
+		}
+
+		if (inEveryPreset)
+			presetMorph.addIndex(i);
+	}
+
+	presetMorph.unlockSetup();
+	return true;
+}
+
+/**
+\brief turn the preset morph off; the parameters keep their current values
+*/
+void PluginBase::clearPresetMorph()
+{
+	presetMorph.lockSetup();
+	presetMorph.beginSetup(0);
+	presetMorph.unlockSetup();
+}
+
+/**
+\brief set the preset morph mix as an X/Y position with bilinear weights; a two-way morph only follows X
+
+\param x 0.0 = A (and C), 1.0 = B (and D)
+\param y 0.0 = A and B, 1.0 = C and D
+*/
+void PluginBase::setPresetMorphPosition(double x, double y)
+{
+	x = x < 0.0 ? 0.0 : (x > 1.0 ? 1.0 : x);
+	y = y < 0.0 ? 0.0 : (y > 1.0 ? 1.0 : y);
+	presetMorph.setWeights((1.0 - x)*(1.0 - y), x*(1.0 - y), (1.0 - x)*y, x*y);
+}
+
+/**
+\brief take a PresetImage back from the audio thread before it is deleted or rebuilt; if it is still pending,
+its flags are set here so the values that applyPreset( ) already published are not lost
+
+NOTE:
+- this closes the window between applyPreset( ) and the next buffer; it can not stop an audio thread that has
+  already taken the image in syncInBoundVariables( ), so images must only be deleted or rebuilt with audio stopped
+
+\param image the image (may be NULL)
+*/
+void PluginBase::releasePresetImage(PresetImage* image)
+{
+	PresetImage* expected = image;
+	if (image && pendingPresetImage.compare_exchange_strong(expected, nullptr, std::memory_order_acq_rel))
+		image->setFlags(parameterChangeFlags, smoothingTargetFlags);
+}
+
+/**
+\brief get a compiled preset
+
+\return a naked pointer to the image, or nullptr if the preset does not exist or is not compiled
+*/
+PresetImage* PluginBase::getPresetImage(uint32_t index)
+{
+	if (index < presetImages.size())
+		return presetImages[index];
+
+	return nullptr;
+}
+
+/**
+\brief load a compiled preset from the GUI/host thread
+
+Operation:
+- store the values in the parameters (smoothed ones get a new target) without publishing them one at a time
+- publish the whole image to the parameter snapshot in one go
+- hand the image to the audio thread with one atomic exchange; syncInBoundVariables( ) then sets all of its flags
+  at once, so the preset never lands across two buffers and there are no per-parameter lookups
+- if the previous preset has not been picked up yet, its flags are set here so none of its values are lost
+
+\param index index of preset
+
+\return true if the preset was loaded
+*/
+bool PluginBase::applyPreset(uint32_t index)
+{
+	PresetImage* image = getPresetImage(index);
+	if (!image)
+		return false;
+
+	const double* values = image->getValues();
+	const uint32_t* indexes = image->getIndexes();
+	uint32_t count = image->getNumIndexes();
+
+	for (uint32_t i = 0; i < count; i++)
+		pluginParameterArray[indexes[i]]->setPresetControlValue(values[indexes[i]]);
+
+	// --- publish before handing over, so the audio thread always finds the values in the snapshot
+	parameterSnapshot.setValues(values, indexes, count);
+
+	PresetImage* previous = pendingPresetImage.exchange(image, std::memory_order_acq_rel);
+	if (previous && previous != image)
+		previous->setFlags(parameterChangeFlags, smoothingTargetFlags);
+
+	return true;
+}
+
 /**
 \brief called at the end of the initialization phase, this function creates the various non map-versions of the parameter lists\n
        and initializes the parameters; this is the final step of construction
@@ -810,9 +1531,29 @@ void PluginBase::initPluginParameterArray()
 	numOutboundPluginParameters = 0;
 
 	pluginParameterArray = new PluginParameter*[numPluginParameters];
+
+	// --- one change flag per parameter, all set so the first sync visits everything
+	parameterChangeFlags.create(numPluginParameters);
+
+	// --- the snapshot starts with the current values; meters are written by the audio thread so they do not publish
+	parameterSnapshot.create(numPluginParameters);
+	if (changedParameterIndexes)
+		delete[] changedParameterIndexes;
+	changedParameterIndexes = new uint32_t[numPluginParameters > 0 ? numPluginParameters : 1];
+
 	for (unsigned int i = 0; i < numPluginParameters; i++)
 	{
 		pluginParameterArray[i] = pluginParameters[i];
+		pluginParameterArray[i]->setParameterChangeFlags(&parameterChangeFlags, i);
+
+		if (pluginParameters[i]->getControlVariableType() != controlVariableType::kMeter)
+		{
+			bool smoothed = pluginParameters[i]->getParameterSmoothing() &&
+							(pluginParameters[i]->getControlVariableType() == controlVariableType::kDouble ||
+							 pluginParameters[i]->getControlVariableType() == controlVariableType::kFloat);
+			parameterSnapshot.initValue(i, smoothed ? pluginParameters[i]->getSmoothingTarget() : pluginParameters[i]->getControlValue());
+			pluginParameters[i]->setParameterSnapshot(&parameterSnapshot);
+		}
 
 		// --- how many are potentially smoothable?
 		if (pluginParameters[i]->getControlVariableType() == controlVariableType::kDouble ||
@@ -840,6 +1581,18 @@ void PluginBase::initPluginParameterArray()
 		}
 	}
 
+	// --- smoother bank for the smoothable parameters
+	smootherBank.create(numSmoothablePluginParameters);
+	initSmootherBank(audioProcDescriptor.sampleRate);
+
+	// --- preset morph output, one value per smoother
+	presetMorph.create(numSmoothablePluginParameters);
+
+	// --- new smoothing targets are flagged so the audio thread only reads those
+	smoothingTargetFlags.create(numSmoothablePluginParameters);
+	for (uint32_t i = 0; i < numSmoothablePluginParameters; i++)
+		smoothablePluginParameters[i]->setSmoothingTargetFlags(&smoothingTargetFlags, i);
+
 	if (outboundPluginParameters)
 		delete[] outboundPluginParameters;
 
@@ -854,6 +1607,91 @@ void PluginBase::initPluginParameterArray()
 		}
 	}
 
+	// --- flat controlID lookup for getPluginParameterByControlID( )
+	initControlIDLookup();
+
+	// --- presets added earlier are compiled against the new array
+	for (uint32_t i = 0; i < presets.size(); i++)
+		compilePresetImage(i);
+}
+
+/**
+\brief builds the flat controlID -> PluginParameter lookup used by getPluginParameterByControlID( )
+
+Operation:
+- if the control IDs are non-negative and not too sparse, build a dense table indexed directly by control ID (one load per lookup)
+- otherwise build an open-addressed hash table (linear probing, at most half full)
+- either way, lookups never allocate; the map is left as-is for non-realtime code
+*/
+void PluginBase::initControlIDLookup()
+{
+	clearControlIDLookup();
+	if (numPluginParameters == 0)
+		return;
+
+	// --- range of IDs
+	int32_t minID = pluginParameterArray[0]->getControlID();
+	int32_t maxID = minID;
+	for (uint32_t i = 1; i < numPluginParameters; i++)
+	{
+		int32_t id = pluginParameterArray[i]->getControlID();
+		minID = id < minID ? id : minID;
+		maxID = id > maxID ? id : maxID;
+	}
+
+	if (minID >= 0 && ((uint32_t)maxID < MAX_DENSE_CONTROL_ID || (uint32_t)maxID < 4 * numPluginParameters))
+	{
+		// --- dense
+		denseControlIDTableSize = (uint32_t)maxID + 1;
+		denseControlIDTable = new PluginParameter*[denseControlIDTableSize];
+		memset(denseControlIDTable, 0, sizeof(PluginParameter*)*denseControlIDTableSize);
+
+		for (uint32_t i = 0; i < numPluginParameters; i++)
+			denseControlIDTable[pluginParameterArray[i]->getControlID()] = pluginParameterArray[i];
+	}
+	else
+	{
+		// --- sparse: open-addressed hash, at most half full
+		hashControlIDTableSize = 2;
+		hashControlIDShift = 31;
+		while (hashControlIDTableSize < 2 * numPluginParameters)
+		{
+			hashControlIDTableSize <<= 1;
+			hashControlIDShift--;
+		}
+
+		hashControlIDs = new int32_t[hashControlIDTableSize];
+		hashControlIDParameters = new PluginParameter*[hashControlIDTableSize];
+		memset(hashControlIDs, 0, sizeof(int32_t)*hashControlIDTableSize);
+		memset(hashControlIDParameters, 0, sizeof(PluginParameter*)*hashControlIDTableSize);
+
+		for (uint32_t i = 0; i < numPluginParameters; i++)
+		{
+			int32_t id = pluginParameterArray[i]->getControlID();
+			uint32_t slot = hashControlID(id);
+			while (hashControlIDParameters[slot] && hashControlIDs[slot] != id)
+				slot = (slot + 1) & (hashControlIDTableSize - 1);
+
+			hashControlIDs[slot] = id;
+			hashControlIDParameters[slot] = pluginParameterArray[i];
+		}
+	}
+}
+
+/**
+\brief destroys the flat controlID lookup tables
+*/
+void PluginBase::clearControlIDLookup()
+{
+	delete[] denseControlIDTable;
+	denseControlIDTable = nullptr;
+	denseControlIDTableSize = 0;
+
+	delete[] hashControlIDs;
+	delete[] hashControlIDParameters;
+	hashControlIDs = nullptr;
+	hashControlIDParameters = nullptr;
+	hashControlIDTableSize = 0;
 }
 
 /**
@@ -218,7 +218,7 @@ PluginBase Operations:
 \version Revision : 1.0
 \date Date : 2018 / 09 / 7
 */
-class PluginBase
+class PluginBase : public IMidiEventProcessor
 {
 public:
     PluginBase();
@@ -256,6 +256,10 @@ public:
 	/** Buffer Proc Cycle: II PluginCore overrides this method to process frames */
 	virtual bool processAudioBuffers(ProcessBufferInfo& processInfo);
 
+	/** optional override: render a span of frames that has no MIDI or automation events inside it (called by the
+	    kernel event scheduler); return false to have the span broken into frames for processAudioFrame( ) */
+	virtual bool processAudioSubBlock(ProcessBufferInfo& processInfo, uint32_t startFrame, uint32_t numFrames) { return false; }
+
 	/** Buffer Proc Cycle: III connects meter variables to outbound GUI control changes (part of ASPiK output variable binding option) */
 	bool updateOutBoundVariables();
 
@@ -268,11 +272,55 @@ public:
 	/** ASPiK midi event system: base class implementation is empty */
 	virtual bool processMIDIEvent(midiEvent& event) { return true; }
 
+	/** kernel owned MIDI event ring; wrappers may push their events here instead of supplying an IMidiEventQueue;
+	    processAudioBuffers( ) calls its beginBuffer( ), so an override that drains it must do the same */
+	MidiEventRing* getMidiEventRing() { return &midiEventRing; }
+
 	/** perform parameter smoothing or VST3 sample accurate upates */
 	void doSampleAccurateParameterUpdates();
 
-	/** only for a vector joystick control from DAW that implements it (reserved for future use): base class implementation is empty */
-	virtual bool setVectorJoystickParameters(const VectorJoystickData& vectorJoysickData) { return true; }
+	/** copy new smoothing targets into the smoother bank; returns the number of new targets */
+	uint32_t updateSmootherTargets();
+
+	/** initialize the smoother bank from the smoothable parameters */
+	void initSmootherBank(double sampleRate);
+
+	/** the smoother bank, for DSP that wants the ramps of the smoothable parameters directly */
+	ParamSmootherBank* getSmootherBank() { return &smootherBank; }
+
+	/** block ramp smoothing: the smoothed values of a parameter for the frames of the current processAudioSubBlock( ) span; NULL if it is not moving */
+	const double* getParameterRamp(int32_t controlID);
+
+	/** block ramp smoothing: the current processAudioSubBlock( ) span of a parameter as a line, value(n) = start + n*increment */
+	void getParameterRampLine(int32_t controlID, uint32_t numFrames, double& start, double& increment);
+
+	/** block ramp smoothing: true if every moving smoother belongs to a parameter with block ramp smoothing enabled */
+	bool smoothingIsBlockRamped();
+
+	/** block ramp smoothing: run the next block of smoothing ramps and update the moving parameters once for the block */
+	void startParameterRampBlock();
+
+	/** kernel event scheduler: collect this buffer's MIDI and automation timestamps; false if they must be polled per-frame */
+	bool scheduleBufferEvents(ProcessBufferInfo& processInfo);
+
+	/** kernel event scheduler: collect the VST3 sample accurate automation of this buffer into the sorted timeline; false if it must be polled */
+	bool buildAutomationTimeline(uint32_t bufferSize);
+
+	/** kernel event scheduler: apply VST3 sample accurate updates at a scheduled timestamp */
+	void doScheduledParameterUpdates(uint32_t sampleOffset);
+
+	/** kernel event scheduler: apply one VST3 sample accurate update at its timestamp */
+	void applyAutomationEvent(const AutomationEvent& event, ParameterUpdateInfo& vst3Update);
+
+	/** Buffer Proc Cycle: helper to break a span of the buffer into frames for processAudioFrame( ) */
+	void processFrameSpan(ProcessBufferInfo& processBufferInfo, ProcessFrameInfo& info, uint32_t startFrame, uint32_t numFrames);
+
+	/** vector joystick control from a DAW that implements it: base class implementation drives the preset morph with the A, B, C, D mix */
+	virtual bool setVectorJoystickParameters(const VectorJoystickData& vectorJoysickData)
+	{
+		setPresetMorphWeights(vectorJoysickData.vectorA, vectorJoysickData.vectorB, vectorJoysickData.vectorC, vectorJoysickData.vectorD);
+		return true;
+	}
 
 	/** helper function to add a new plugin parameter to the variety of lists */
 	int32_t addPluginParameter(PluginParameter* piParam, double sampleRate = 44100);
@@ -293,13 +341,43 @@ public:
 	PluginParameter* getPluginParameterByIndex(int32_t index) { return pluginParameters[index]; }
 
 	/**
-	\brief get a parameter by control ID - uses map (slowest)
+	\brief get a parameter by control ID - uses the flat lookup built in initPluginParameterArray( ): a direct index for dense IDs,
+	       a hash table for sparse ones; before that it uses the map; never allocates (safe on the audio thread)
 
 	\param controlID the control ID of the parameter
 
-	\return a naked pointer to the PluginParameter object
+	\return a naked pointer to the PluginParameter object, or nullptr if there is none
 	*/
-	PluginParameter* getPluginParameterByControlID(int32_t controlID) { return pluginParameterMap[controlID]; }
+	inline PluginParameter* getPluginParameterByControlID(int32_t controlID)
+	{
+		if (denseControlIDTable)
+			return (uint32_t)controlID < denseControlIDTableSize ? denseControlIDTable[controlID] : nullptr;
+
+		if (hashControlIDParameters)
+		{
+			uint32_t slot = hashControlID(controlID);
+			while (hashControlIDParameters[slot])
+			{
+				if (hashControlIDs[slot] == controlID)
+					return hashControlIDParameters[slot];
+				slot = (slot + 1) & (hashControlIDTableSize - 1);
+			}
+			return nullptr;
+		}
+
+		// --- not initialized yet; find( ) does not insert
+		pluginParameterControlIDMap::iterator it = pluginParameterMap.find(controlID);
+		return it != pluginParameterMap.end() ? it->second : nullptr;
+	}
+
+	/** build the flat controlID lookup (called from initPluginParameterArray) */
+	void initControlIDLookup();
+
+	/** destroy the flat controlID lookup */
+	void clearControlIDLookup();
+
+	/** hash table slot for a control ID (Fibonacci hashing: top bits of the product) */
+	inline uint32_t hashControlID(int32_t controlID) { return ((uint32_t)controlID * 2654435769u) >> hashControlIDShift; }
 
 	/** get a parameter by type - used to find all meter variables for writing to GUI */
 	PluginParameter* getNextParameterOfType(int32_t& startIndex, controlVariableType controlType);
@@ -417,6 +495,33 @@ public:
 	/** get a preset pointner	*/
 	PresetInfo* getPreset(uint32_t index);
 
+	/** compile a preset into its dense PresetImage (with audio stopped) */
+	bool compilePresetImage(uint32_t index);
+
+	/** take a PresetImage back from the audio thread before it is deleted or rebuilt */
+	void releasePresetImage(PresetImage* image);
+
+	/** get a compiled preset; nullptr if there is none */
+	PresetImage* getPresetImage(uint32_t index);
+
+	/** load a compiled preset (GUI/host thread); the audio thread picks it up in one piece at the next syncInBoundVariables( ) */
+	bool applyPreset(uint32_t index);
+
+	/** morph between two (C, D < 0) or four compiled presets (not on the audio thread) */
+	bool setPresetMorph(int32_t presetA, int32_t presetB, int32_t presetC = -1, int32_t presetD = -1);
+
+	/** turn the preset morph off (not on the audio thread) */
+	void clearPresetMorph();
+
+	/** set the preset morph mix (any thread); the weights are normalized */
+	void setPresetMorphWeights(double weightA, double weightB, double weightC, double weightD) { presetMorph.setWeights(weightA, weightB, weightC, weightD); }
+
+	/** set the preset morph mix as an X/Y position, 0.0 to 1.0 (any thread): A = (0,0), B = (1,0), C = (0,1), D = (1,1) */
+	void setPresetMorphPosition(double x, double y);
+
+	/** run the preset morph at control rate if its mix changed and feed the results to the smoother bank (audio thread); returns the number of new targets */
+	uint32_t updatePresetMorph();
+
 	/** prepare all parameter lists	*/
 	void initPluginParameterArray();
 
@@ -451,6 +556,14 @@ public:
 	*/
 	double getLatencyInSamples() { return pluginDescriptor.latencyInSamples; }
 
+	/**
+	\brief Description mutator: latency; for objects with lookahead, set this in the constructor or reset( )
+	before the wrapper queries the plugin description
+
+	\param latencyInSamples latency in samples
+	*/
+	void setLatencyInSamples(uint32_t latencyInSamples) { pluginDescriptor.latencyInSamples = latencyInSamples; }
+
 	/**
 	\brief Description query: tail time
 
@@ -596,6 +709,33 @@ protected:
     float auxInputFrame[MAX_CHANNEL_COUNT];		///< aux input array for frame processing
     float auxOutputFrame[MAX_CHANNEL_COUNT];	///< aux output array for frame processing
 
+	// --- kernel event scheduler
+	EventOffsetList scheduledEventOffsets;		///< sorted MIDI and automation timestamps for the current buffer
+	MidiEventRing midiEventRing;				///< lock-free SPSC ring of compact MIDI events filled by the wrapper
+	AutomationTimeline automationTimeline;		///< sorted VST3 sample accurate automation events for the current buffer
+	bool automationTimelineValid = false;		///< false if the queues could not report their points; poll getNextValue( ) instead
+	uint32_t sampleAccurateFrame = 0;			///< frame counter for doSampleAccurateParameterUpdates( ), reset every buffer
+
+	// --- parameter smoothing, in smoothablePluginParameters order
+	ParamSmootherBank smootherBank;				///< SoA smoothers for all smoothable parameters
+	ParameterChangeFlags smoothingTargetFlags;	///< one flag per smoothable parameter, set when its smoothing target is written
+
+	// --- dirty tracking for syncInBoundVariables( )
+	ParameterChangeFlags parameterChangeFlags;	///< one flag per parameter in pluginParameterArray, set when its value is written
+
+	// --- GUI/host -> audio thread parameter values at full precision, in pluginParameterArray order
+	ParameterSnapshot parameterSnapshot;		///< lock-free double-precision inbound parameter values
+	uint32_t* changedParameterIndexes = nullptr;	///< flags collected for one sync, filled by ParameterChangeFlags::collectFlags( ) through CollectParameterIndex
+
+	/** collectFlags( ) helper: gather the flagged indexes so the snapshot values are read after the flags are cleared */
+	struct CollectParameterIndex
+	{
+		uint32_t* indexes;
+		uint32_t count;
+
+		inline void operator()(uint32_t index) { indexes[count++] = index; }
+	};
+
 	// --- ultra-fast access for real-time audio processing
 	PluginParameter** pluginParameterArray = nullptr;			///< old-fashioned C-arrays of pointers for ultra-fast access for real-time audio processing
 	uint32_t numPluginParameters = 0;							///< total number of parameters
@@ -611,11 +751,22 @@ protected:
     typedef std::map<uint32_t, PluginParameter*> pluginParameterControlIDMap;	///< map version of parameter list
     pluginParameterControlIDMap pluginParameterMap;								///< member map of parameter list
 
+	// --- flat controlID lookup, built in initPluginParameterArray( )
+	PluginParameter** denseControlIDTable = nullptr;		///< indexed by control ID when IDs are dense
+	uint32_t denseControlIDTableSize = 0;					///< max control ID + 1
+	int32_t* hashControlIDs = nullptr;						///< hash table keys when IDs are sparse
+	PluginParameter** hashControlIDParameters = nullptr;	///< hash table values; nullptr = empty slot
+	uint32_t hashControlIDTableSize = 0;					///< hash table size (power of 2)
+	uint32_t hashControlIDShift = 31;						///< 32 - log2(hash table size)
+
     // --- plugin core -> host (wrap) connector
     IPluginHostConnector* pluginHostConnector = nullptr;						///< created and destroyed on host
 
     // --- PRESETS
     std::vector<PresetInfo*> presets;	///< preset list
+	std::vector<PresetImage*> presetImages;	///< compiled presets, same order as presets
+	std::atomic<PresetImage*> pendingPresetImage = { nullptr };	///< preset loaded since the last syncInBoundVariables( )
+	PresetMorph presetMorph;	///< interpolated presets, smoothablePluginParameters order
 };
 
 #endif /* defined(__PluginBase__) */
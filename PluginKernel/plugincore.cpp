@@ -80,6 +80,7 @@ bool PluginCore::initPluginParameters()
 	piParam = new PluginParameter(controlID::volume_gui, "Volume", "", controlVariableType::kDouble, 0.000000, 1.000000, 0.707000, taper::kAntiLogTaper);
 	piParam->setParameterSmoothing(true);
 	piParam->setSmoothingTimeMsec(20.00);
+	piParam->setBlockRampSmoothing(true);
 	piParam->setBoundVariable(&volume_gui, boundVariableType::kDouble);
 	addPluginParameter(piParam);
 
@@ -265,6 +266,7 @@ Operation:
 - decode the plugin type - for synth plugins, fill in the rendering code; for FX plugins, delete the if(synth) portion and add your processing code
 - note that MIDI events are fired for each sample interval so that MIDI is tightly sunk with audio
 - doSampleAccurateParameterUpdates will perform per-sample interval smoothing
+- when processFrameInfo.eventsScheduled is set, the kernel event scheduler has already done both for this frame
 
 \param processFrameInfo structure of information about *frame* processing
 
@@ -272,32 +274,18 @@ Operation:
 */
 bool PluginCore::processAudioFrame(ProcessFrameInfo& processFrameInfo)
 {
-    // --- fire any MIDI events for this sample interval
-    processFrameInfo.midiEventQueue->fireMidiEvents(processFrameInfo.currentFrame);
+	// --- the kernel event scheduler fires MIDI and automation at their timestamps; otherwise poll every frame
+	if (!processFrameInfo.eventsScheduled)
+	{
+		// --- fire any MIDI events for this sample interval
+		processFrameInfo.midiEventQueue->fireMidiEvents(processFrameInfo.currentFrame);
 
-	// --- do per-frame updates; VST automation and parameter smoothing
-	doSampleAccurateParameterUpdates();
+		// --- do per-frame updates; VST automation and parameter smoothing
+		doSampleAccurateParameterUpdates();
+	}
 
 	//variables can go here.
 
-	//Feed-Forward Filter 
-	double xn_left_ff_filter;
-	double xn_1_left_ff_filter;
-	double yn_left_ff_filter;
-
-	double xn_right_ff_filter;
-	double xn_1_right_ff_filter;
-	double yn_right_ff_filter;
-
-	//Feed-Back Filter 
-	double xn_left_fb_filter;
-	double yn_left_fb_filter;
-	double yn_1_left_fb_filter;
-
-	double xn_right_fb_filter;
-	double yn_right_fb_filter;
-	double yn_1_right_fb_filter;
-
 	//Volume
 	double master_volume_left = volume_gui;
 	double master_volume_right = volume_gui;
@@ -321,47 +309,11 @@ bool PluginCore::processAudioFrame(ProcessFrameInfo& processFrameInfo)
     if(processFrameInfo.channelIOConfig.inputChannelFormat == kCFMono &&
        processFrameInfo.channelIOConfig.outputChannelFormat == kCFMono)
     {
-		// --- pass through code: change this with your signal processing
-
-		//Feed-Forward Filter 
-
-		if (compareEnumToInt(filter_selection_guiEnum::FF_Filter, filter_selection_gui)) 
-		{
-			// Input sample is x(n)
-			xn_left_ff_filter = processFrameInfo.audioInputFrame[0];
-
-			//Delay sample is x(n - 1)
-			xn_1_left_ff_filter = z1_left_ff_filter;
-
-			//Difference Equation
-			yn_left_ff_filter = a0_left_ff_filter * xn_left_ff_filter + a1_left_ff_filter * xn_1_left_ff_filter;
-
-			//Delay with current x(n)
-			z1_left_ff_filter = xn_left_ff_filter;
-
-			//Output sample is y(n)
-			processFrameInfo.audioOutputFrame[0] = yn_left_ff_filter * master_volume_left;
-		}
-
-		//Feed-back Filter 
-
-		if (compareEnumToInt(filter_selection_guiEnum::FB_Filter, filter_selection_gui))
-		{
-			// Input sample is x(n)
-			xn_left_fb_filter = processFrameInfo.audioInputFrame[0];
-
-			//Delay sample is y(n - 1)
-			yn_1_left_fb_filter = z1_left_fb_filter;
-
-			//Difference Equation
-			yn_left_fb_filter = a0_left_fb_filter * xn_left_fb_filter - b1_left_fb_filter * yn_1_left_fb_filter;
-
-			//Delay with current y(n)
-			z1_left_fb_filter = yn_left_fb_filter;
+		// --- FF or FB filter, see processFilterSample( )
+		double yn = processFilterSample(0, processFrameInfo.audioInputFrame[0]);
 
-			//Output sample is y(n)
-			processFrameInfo.audioOutputFrame[0] = yn_left_fb_filter * master_volume_left;
-		}
+		//Output sample is y(n)
+		processFrameInfo.audioOutputFrame[0] = yn * master_volume_left;
 
         return true; /// processed
     }
@@ -370,51 +322,12 @@ bool PluginCore::processAudioFrame(ProcessFrameInfo& processFrameInfo)
     else if(processFrameInfo.channelIOConfig.inputChannelFormat == kCFMono &&
        processFrameInfo.channelIOConfig.outputChannelFormat == kCFStereo)
     {
-		// --- pass through code: change this with your signal processing
-
-		//Feed-Forward Filter 
-
-		if (compareEnumToInt(filter_selection_guiEnum::FF_Filter, filter_selection_gui))
-		{
-			// Input sample is x(n)
-			xn_left_ff_filter = processFrameInfo.audioInputFrame[0];
-
-			//Delay sample is x(n - 1)
-			xn_1_left_ff_filter = z1_left_ff_filter;
-
-			//Difference Equation
-			yn_left_ff_filter = a0_left_ff_filter * xn_left_ff_filter + a1_left_ff_filter * xn_1_left_ff_filter;
-
-			//Delay with current x(n)
-			z1_left_ff_filter = xn_left_ff_filter;
-
-			//Output sample is y(n)
-			yn_right_ff_filter = yn_left_ff_filter;
-			processFrameInfo.audioOutputFrame[0] = yn_left_ff_filter * master_volume_left;
-			processFrameInfo.audioOutputFrame[1] = yn_right_ff_filter * master_volume_right;
-		}
-
-		//Feed-back Filter 
-
-		if (compareEnumToInt(filter_selection_guiEnum::FB_Filter, filter_selection_gui))
-		{
-			// Input sample is x(n)
-			xn_left_fb_filter = processFrameInfo.audioInputFrame[0];
+		// --- FF or FB filter, see processFilterSample( )
+		double yn = processFilterSample(0, processFrameInfo.audioInputFrame[0]);
 
-			//Delay sample is y(n - 1)
-			yn_1_left_fb_filter = z1_left_fb_filter;
-
-			//Difference Equation
-			yn_left_fb_filter = a0_left_fb_filter * xn_left_fb_filter - b1_left_fb_filter * yn_1_left_fb_filter;
-
-			//Delay with current y(n)
-			z1_left_fb_filter = yn_left_fb_filter;
-
-			//Output sample is y(n)
-			yn_right_fb_filter = yn_left_fb_filter;
-			processFrameInfo.audioOutputFrame[0] = yn_left_fb_filter * master_volume_left;
-			processFrameInfo.audioOutputFrame[1] = yn_right_fb_filter * master_volume_right;
-		}
+		//Output sample is y(n)
+		processFrameInfo.audioOutputFrame[0] = yn * master_volume_left;
+		processFrameInfo.audioOutputFrame[1] = yn * master_volume_right;
 
 		return true; /// processed
     }
@@ -423,60 +336,92 @@ bool PluginCore::processAudioFrame(ProcessFrameInfo& processFrameInfo)
     else if(processFrameInfo.channelIOConfig.inputChannelFormat == kCFStereo &&
        processFrameInfo.channelIOConfig.outputChannelFormat == kCFStereo)
     {
-		// --- pass through code: change this with your signal processing
+		// --- FF or FB filter, see processFilterSample( )
+		double yn_left = processFilterSample(0, processFrameInfo.audioInputFrame[0]);
+		double yn_right = processFilterSample(1, processFrameInfo.audioInputFrame[1]);
 
-		//Feed-Forward Filter 
+		//Output sample is y(n)
+		processFrameInfo.audioOutputFrame[0] = yn_left * master_volume_left;
+		processFrameInfo.audioOutputFrame[1] = yn_right * master_volume_right;
 
-		if (compareEnumToInt(filter_selection_guiEnum::FF_Filter, filter_selection_gui))
-		{
-			// Input sample is x(n)
-			xn_left_ff_filter = processFrameInfo.audioInputFrame[0];
-			xn_right_ff_filter = processFrameInfo.audioInputFrame[1];
-
-			//Delay sample is x(n - 1)
-			xn_1_left_ff_filter = z1_left_ff_filter;
-			xn_1_right_ff_filter = z1_right_ff_filter;
+        return true; /// processed
+    }
 
-			//Difference Equation
-			yn_left_ff_filter = a0_left_ff_filter * xn_left_ff_filter + a1_left_ff_filter * xn_1_left_ff_filter;
-			yn_right_ff_filter = a0_right_ff_filter * xn_right_ff_filter + a1_right_ff_filter * xn_1_right_ff_filter;
+    return false; /// NOT processed
+}
 
-			//Delay with current x(n)
-			z1_left_ff_filter = xn_left_ff_filter;
-			z1_right_ff_filter = xn_right_ff_filter;
+/**
+\brief span-processing method
 
-			//Output sample is y(n)
-			processFrameInfo.audioOutputFrame[0] = yn_left_ff_filter * master_volume_left;
-			processFrameInfo.audioOutputFrame[1] = yn_right_ff_filter * master_volume_right;
-		}
+Operation:
+- the kernel event scheduler calls this for each span of the buffer that has no MIDI or automation events inside it
+- the filters run per-sample through processFilterSample( ), the same code processAudioFrame( ) uses; the
+  master volume is applied afterwards in its own loop, reading the volume smoothing ramp (block ramp
+  smoothing) so the multiply can be vectorized
+- the filter output is rounded to float before the volume multiply, so samples can differ from the
+  per-frame path in the last float bit
+- return false to have the span broken into frames for processAudioFrame( )
 
-		if (compareEnumToInt(filter_selection_guiEnum::FB_Filter, filter_selection_gui))
-		{
-			// Input sample is x(n)
-			xn_left_fb_filter = processFrameInfo.audioInputFrame[0];
-			xn_right_fb_filter = processFrameInfo.audioInputFrame[1];
+\param processInfo structure of information about *buffer* processing
+\param startFrame first frame of the span
+\param numFrames length of the span
 
-			//Delay sample is y(n - 1)
-			yn_1_left_fb_filter = z1_left_fb_filter;
-			yn_1_right_fb_filter = z1_right_fb_filter;
+\return true if operation succeeds, false otherwise
+*/
+bool PluginCore::processAudioSubBlock(ProcessBufferInfo& processInfo, uint32_t startFrame, uint32_t numFrames)
+{
+	bool monoIn = processInfo.channelIOConfig.inputChannelFormat == kCFMono;
+	bool stereoIn = processInfo.channelIOConfig.inputChannelFormat == kCFStereo;
+	bool monoOut = processInfo.channelIOConfig.outputChannelFormat == kCFMono;
+	bool stereoOut = processInfo.channelIOConfig.outputChannelFormat == kCFStereo;
+
+	// --- same channel configurations as processAudioFrame( )
+	if (!(monoIn && monoOut) && !(monoIn && stereoOut) && !(stereoIn && stereoOut))
+		return false; /// NOT processed
+
+	float* inLeft = &processInfo.inputs[0][startFrame];
+	float* outLeft = &processInfo.outputs[0][startFrame];
+	float* inRight = stereoIn ? &processInfo.inputs[1][startFrame] : nullptr;
+	float* outRight = stereoOut ? &processInfo.outputs[1][startFrame] : nullptr;
+
+	// --- filters: the same per-sample code as processAudioFrame( )
+	for (uint32_t n = 0; n < numFrames; n++)
+	{
+		outLeft[n] = (float)processFilterSample(0, inLeft[n]);
 
-			//Difference Equation
-			yn_left_fb_filter = a0_left_fb_filter * xn_left_fb_filter - b1_left_fb_filter * yn_1_left_fb_filter;
-			yn_right_fb_filter = a0_right_fb_filter * xn_right_fb_filter - b1_right_fb_filter * yn_1_right_fb_filter;
+		if (stereoIn)
+			outRight[n] = (float)processFilterSample(1, inRight[n]);
 
-			//Delay with current y(n)
-			z1_left_fb_filter = yn_left_fb_filter;
-			z1_right_fb_filter = yn_right_fb_filter;
+		// --- Mono-In/Stereo-Out
+		else if (stereoOut)
+			outRight[n] = outLeft[n];
+	}
 
-			//Output sample is y(n)
-			processFrameInfo.audioOutputFrame[0] = yn_left_fb_filter * master_volume_left;
-			processFrameInfo.audioOutputFrame[1] = yn_right_fb_filter * master_volume_right;
+	// --- master volume: the smoothing ramp while it moves, else the bound variable
+	const double* volumeRamp = getParameterRamp(controlID::volume_gui);
+	if (volumeRamp)
+	{
+		for (uint32_t n = 0; n < numFrames; n++)
+			outLeft[n] *= (float)volumeRamp[n];
+		if (stereoOut)
+		{
+			for (uint32_t n = 0; n < numFrames; n++)
+				outRight[n] *= (float)volumeRamp[n];
 		}
+	}
+	else
+	{
+		float master_volume = (float)volume_gui;
+		for (uint32_t n = 0; n < numFrames; n++)
+			outLeft[n] *= master_volume;
+		if (stereoOut)
+		{
+			for (uint32_t n = 0; n < numFrames; n++)
+				outRight[n] *= master_volume;
+		}
+	}
 
-        return true; /// processed
-    }
-
-    return false; /// NOT processed
+	return true; /// processed
 }
 
 
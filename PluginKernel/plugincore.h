@@ -77,6 +77,9 @@ public:
 	/** process frames of data */
 	virtual bool processAudioFrame(ProcessFrameInfo& processFrameInfo);
 
+	/** process a span of frames with no events inside it (kernel event scheduler) */
+	virtual bool processAudioSubBlock(ProcessBufferInfo& processInfo, uint32_t startFrame, uint32_t numFrames);
+
 	// --- uncomment and override this for buffer processing; see base class implementation for
 	//     help on breaking up buffers and getting info from processBufferInfo
 	//virtual bool processAudioBuffers(ProcessBufferInfo& processBufferInfo);
@@ -131,6 +134,36 @@ public:
 	double z1_left_fb_filter;
 	double z1_right_fb_filter;
 
+	/** run the selected filter on one sample of one channel (0 = left, 1 = right); shared by
+	    processAudioFrame( ) and processAudioSubBlock( ) so both paths always sound the same */
+	inline double processFilterSample(uint32_t channel, double xn)
+	{
+		//Feed-Forward Filter 
+		if (compareEnumToInt(filter_selection_guiEnum::FF_Filter, filter_selection_gui))
+		{
+			double& z1 = channel == 0 ? z1_left_ff_filter : z1_right_ff_filter;
+
+			//Difference Equation: x(n - 1) is in the delay
+			double yn = (channel == 0 ? a0_left_ff_filter : a0_right_ff_filter) * xn
+				+ (channel == 0 ? a1_left_ff_filter : a1_right_ff_filter) * z1;
+
+			//Delay with current x(n)
+			z1 = xn;
+			return yn;
+		}
+
+		//Feed-back Filter: y(n - 1) is in the delay
+		double& z1 = channel == 0 ? z1_left_fb_filter : z1_right_fb_filter;
+
+		//Difference Equation
+		double yn = (channel == 0 ? a0_left_fb_filter : a0_right_fb_filter) * xn
+			- (channel == 0 ? b1_left_fb_filter : b1_right_fb_filter) * z1;
+
+		//Delay with current y(n)
+		z1 = yn;
+		return yn;
+	}
+
 	// --- END USER VARIABLES AND FUNCTIONS -------------------------------------- //
 
 private:
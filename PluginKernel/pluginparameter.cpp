@@ -38,6 +38,9 @@ PluginParameter::PluginParameter(int _controlID, const char* _controlName, const
 , controlTaper(_controlTaper)
 , displayPrecision(_displayPrecision)
 {
+    // --- build the shared taper tables now, not during automation
+    FastTaperMath::getInstance();
+
     setControlValue(_defaultValue);
     setSmoothedTargetValue(_defaultValue);
     useParameterSmoothing = false;
@@ -194,6 +197,7 @@ PluginParameter::PluginParameter(const PluginParameter& initGuiControl)
     displayPrecision = initGuiControl.displayPrecision;
     stringList = initGuiControl.stringList;
     useParameterSmoothing = initGuiControl.useParameterSmoothing;
+    useBlockRampSmoothing = initGuiControl.useBlockRampSmoothing;
     smoothingType = initGuiControl.smoothingType;
     smoothingTimeMsec = initGuiControl.smoothingTimeMsec;
     meterAttack_ms = initGuiControl.meterAttack_ms;
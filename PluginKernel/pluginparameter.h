@@ -146,8 +146,12 @@ public:
     double getSmoothingTimeMsec() { return smoothingTimeMsec;}					///< query smoothing time
     void setSmoothingTimeMsec(double value) { smoothingTimeMsec = value; }		///< set inverted meter flag
 
+    bool getBlockRampSmoothing() { return useBlockRampSmoothing; }				///< query block ramp smoothing flag
+    void setBlockRampSmoothing(bool value) { useBlockRampSmoothing = value; }	///< set block ramp smoothing flag: DSP reads the smoothing ramps with PluginBase::getParameterRamp( )
+
     smoothingMethod getSmoothingMethod() { return smoothingType; }									///< query smoothing method
     void setSmoothingMethod(smoothingMethod smoothingMethod) { smoothingType = smoothingMethod; }	///< set smoothing method
+    double getSmoothingTarget() const { return getSmoothedTargetValue(); }							///< query smoothing target (audio thread)
 
     bool getIsWritable() { return isWritable; }				///< query writable control (meter)
     void setIsWritable(bool value) { isWritable = value; }	///< set writable control (meter)
@@ -377,13 +381,13 @@ public:
     /** normalized to Log-normalized version (convex transform) */
     inline double normToLogNorm(double normalizedValue)
     {
-        return 1.0 + kCTCoefficient*log10(normalizedValue);
+        return 1.0 + kCTCoefficient*FastTaperMath::getInstance().fastLog10(normalizedValue);
     }
 
 	/** Log-normalized to normalized version (reverse-convex transform) */
     inline double logNormToNorm(double logNormalizedValue)
     {
-        return pow(10.0, (logNormalizedValue - 1.0) / kCTCoefficient);
+        return FastTaperMath::getInstance().fastPow10((logNormalizedValue - 1.0) / kCTCoefficient);
     }
 
      /** normalized to AntiLog-normalized version */
@@ -392,7 +396,7 @@ public:
 		if (normalizedValue == 1.0)
 			return 1.0;
 
-		double aln = -kCTCoefficient*log10(1.0 - normalizedValue);
+		double aln = -kCTCoefficient*FastTaperMath::getInstance().fastLog10(1.0 - normalizedValue);
 		aln = fmin(1.0, aln);
 		return aln;
 	}
@@ -400,7 +404,7 @@ public:
      /** AntiLog-normalized to normalized version */
     inline double antiLogNormToNorm(double aLogNormalizedValue)
     {
-        return -pow(10.0, (-aLogNormalizedValue / kCTCoefficient)) + 1.0;
+        return -FastTaperMath::getInstance().fastPow10(-aLogNormalizedValue / kCTCoefficient) + 1.0;
     }
 
 	/**
@@ -439,10 +443,17 @@ public:
         double smoothedValue = 0.0;
         bool smoothed = paramSmoother.smoothParameter(getSmoothedTargetValue(), smoothedValue);
         if(smoothed)
-			setAtomicControlValueDouble(smoothedValue);
+			setSmoothedControlValue(smoothedValue);
         return smoothed;
     }
 
+	/**
+	\brief write a smoothed value from the audio thread; the caller updates the bound variable, so the change flag is not set
+
+	\param smoothedValue the new value
+	*/
+	inline void setSmoothedControlValue(double smoothedValue) { controlValueAtomic.store((float)smoothedValue, std::memory_order_relaxed); }
+
 	/**
 	\brief save the variable for binding operation
 
@@ -478,26 +489,34 @@ public:
 
 	\return boundVariableType
 	*/
-	bool updateInBoundVariable()
+	bool updateInBoundVariable() { return updateInBoundVariable(getControlValue()); }
+
+	/**
+	\brief perform the variable binding update with a value at full double precision (e.g. from the parameter snapshot or a smoothing ramp)
+
+	\param value the new value
+	\return true if variable was udpated, false otherwise
+	*/
+	bool updateInBoundVariable(double value)
 	{
 		if (boundVariableUInt)
 		{
-			*boundVariableUInt = (uint32_t)getControlValue();
+			*boundVariableUInt = (uint32_t)value;
 			return true;
 		}
 		else if (boundVariableInt)
 		{
-			*boundVariableInt = (int)getControlValue();
+			*boundVariableInt = (int)value;
 			return true;
 		}
 		else if (boundVariableFloat)
 		{
-			*boundVariableFloat = (float)getControlValue();
+			*boundVariableFloat = (float)value;
 			return true;
 		}
 		else if (boundVariableDouble)
 		{
-			*boundVariableDouble = getControlValue();
+			*boundVariableDouble = value;
 			return true;
 		}
 		return false;
@@ -547,6 +566,64 @@ public:
 	*/
 	IParameterUpdateQueue* getParameterUpdateQueue() { return parameterUpdateQueue; } // may be NULL - that is OK
 
+	/**
+	\brief connect the owner's change flags; every value write then sets our flag so the owner only syncs changed parameters
+
+	\param _changeFlags the flag set (may be NULL)
+	\param _changeFlagIndex our flag in the set
+	*/
+	void setParameterChangeFlags(ParameterChangeFlags* _changeFlags, uint32_t _changeFlagIndex) { changeFlags = _changeFlags; changeFlagIndex = _changeFlagIndex; }
+
+	/**
+	\brief connect the owner's smoothing target flags; every new smoothing target then sets our flag so the owner only reads new targets
+
+	\param _targetFlags the flag set (may be NULL)
+	\param _targetFlagIndex our flag in the set
+	*/
+	void setSmoothingTargetFlags(ParameterChangeFlags* _targetFlags, uint32_t _targetFlagIndex) { targetFlags = _targetFlags; targetFlagIndex = _targetFlagIndex; }
+
+	/**
+	\brief connect the owner's parameter snapshot; every value or smoothing target write from the GUI/host side is then
+	published at full precision, in the slot of our change flag
+
+	\param _snapshot the snapshot (may be NULL)
+	*/
+	void setParameterSnapshot(ParameterSnapshot* _snapshot) { snapshot = _snapshot; }
+
+	/**
+	\brief set the control value from the audio thread (VST3 sample accurate automation); it is not published to the
+	snapshot and does not set the change flag, the caller updates the bound variable
+
+	\param normalizedValue the normalized value, no taper is applied
+	\return the actual value
+	*/
+	inline double setSampleAccurateControlValueNormalized(double normalizedValue)
+	{
+		double actualParamValue = getControlValueFromNormalizedValue(normalizedValue);
+		controlValueAtomic.store((float)actualParamValue, std::memory_order_relaxed);
+		return actualParamValue;
+	}
+
+	/**
+	\brief set the control value, or the smoothing target when smoothing, for a preset load; it is not published to the
+	snapshot and does not set a flag, the owner publishes the whole PresetImage at once
+
+	\param actualParamValue the preset value
+	*/
+	inline void setPresetControlValue(double actualParamValue)
+	{
+		if ((controlType == controlVariableType::kDouble || controlType == controlVariableType::kFloat) && useParameterSmoothing)
+			smoothedTargetValueAtomic.store((float)actualParamValue);
+		else
+			controlValueAtomic.store((float)actualParamValue, std::memory_order_relaxed);
+	}
+
+	/** our slot in the owner's parameter snapshot (the same as our change flag) */
+	uint32_t getSnapshotIndex() { return changeFlagIndex; }
+
+	/** our index in the owner's smoother bank (the same as our smoothing target flag); only valid for smoothable (kDouble, kFloat) parameters */
+	uint32_t getSmootherIndex() { return targetFlagIndex; }
+
 	/** overloaded = operator (standard C++ fare) */
 	PluginParameter& operator=(const PluginParameter& aPluginParameter)	// need this override for collections to work
 	{
@@ -566,6 +643,7 @@ public:
 		displayPrecision = aPluginParameter.displayPrecision;
 		stringList = aPluginParameter.stringList;
 		useParameterSmoothing = aPluginParameter.useParameterSmoothing;
+		useBlockRampSmoothing = aPluginParameter.useBlockRampSmoothing;
 		smoothingType = aPluginParameter.smoothingType;
 		smoothingTimeMsec = aPluginParameter.smoothingTimeMsec;
 		meterAttack_ms = aPluginParameter.meterAttack_ms;
@@ -596,13 +674,22 @@ protected:
     std::atomic<float> controlValueAtomic;		///< the underlying atomic variable
 
     float getAtomicControlValueFloat() const { return controlValueAtomic.load(std::memory_order_relaxed); }			///< set atomic variable with float
-	void setAtomicControlValueFloat(float value) { controlValueAtomic.store(value, std::memory_order_relaxed); }	///< get atomic variable as float
+	void setAtomicControlValueFloat(float value) { controlValueAtomic.store(value, std::memory_order_relaxed); publishValue(value); markChanged(); }	///< get atomic variable as float
 
     double getAtomicControlValueDouble() const { return (double)controlValueAtomic.load(std::memory_order_relaxed); }		///< set atomic variable with double
-	void setAtomicControlValueDouble(double value) { controlValueAtomic.store((float)value, std::memory_order_relaxed); }	///< get atomic variable as double
+	void setAtomicControlValueDouble(double value) { controlValueAtomic.store((float)value, std::memory_order_relaxed); publishValue(value); markChanged(); }	///< get atomic variable as double
+
+	// --- dirty tracking for syncInBoundVariables( )
+	ParameterChangeFlags* changeFlags = nullptr;	///< owner's change flags (may be NULL)
+	uint32_t changeFlagIndex = 0;					///< our flag
+	inline void markChanged() { if (changeFlags) changeFlags->setFlag(changeFlagIndex); }	///< flag the owner that our value changed
+	ParameterSnapshot* snapshot = nullptr;			///< owner's parameter snapshot (may be NULL)
+	inline void publishValue(double value) { if (snapshot) snapshot->setValue(changeFlagIndex, value); }	///< publish before flagging, so a flagged value is always in the snapshot
+	ParameterChangeFlags* targetFlags = nullptr;	///< owner's smoothing target flags (may be NULL)
+	uint32_t targetFlagIndex = 0;					///< our flag
 
     std::atomic<float> smoothedTargetValueAtomic;	///< the underlying atomic variable TARGET for smoothing
-    void setSmoothedTargetValue(double value){ smoothedTargetValueAtomic.store((float)value); }	///< set atomic TARGET smoothing variable with double
+    void setSmoothedTargetValue(double value){ smoothedTargetValueAtomic.store((float)value); publishValue(value); if (targetFlags) targetFlags->setFlag(targetFlagIndex); }	///< set atomic TARGET smoothing variable with double
     double getSmoothedTargetValue() const { return (double)smoothedTargetValueAtomic.load(); }	///< set atomic TARGET smoothing variable with double
 
     // --- control tweakers
@@ -628,6 +715,7 @@ protected:
 
     // --- parameter smoothing
     bool useParameterSmoothing = false;			///< enable param smoothing
+    bool useBlockRampSmoothing = false;			///< bound variable is updated once per smoothing block; DSP reads the ramps
     smoothingMethod smoothingType = smoothingMethod::kLPFSmoother;	///< param smoothing type
     double smoothingTimeMsec = 100.0;			///< param smoothing time
     ParamSmoother<double> paramSmoother;		///< param smoothing object
@@ -649,11 +737,12 @@ protected:
 	*/
     inline double getVoltOctaveControlValueFromNormValue(double normalizedValue)
     {
-        double octaves = log2(maxValue / minValue);
+        const FastTaperMath& taperMath = FastTaperMath::getInstance();
+        double octaves = taperMath.fastLog2(maxValue / minValue);
         if (normalizedValue == 0)
             return minValue;
 
-        return minValue*pow(2.0, normalizedValue*octaves);
+        return minValue*taperMath.fastExp2(normalizedValue*octaves);
     }
 
 	/**
@@ -683,7 +772,8 @@ protected:
         if (minValue == 0)
             return getAtomicControlValueDouble();
 
-        return log2(getAtomicControlValueDouble() / minValue) / (log2(maxValue / minValue));
+        const FastTaperMath& taperMath = FastTaperMath::getInstance();
+        return taperMath.fastLog2(getAtomicControlValueDouble() / minValue) / (taperMath.fastLog2(maxValue / minValue));
     }
 
 	/**
@@ -764,7 +854,8 @@ protected:
         if (minValue == 0)
             return defaultValue;
 
-        return log2(defaultValue / minValue) / (log2(maxValue / minValue));
+        const FastTaperMath& taperMath = FastTaperMath::getInstance();
+        return taperMath.fastLog2(defaultValue / minValue) / (taperMath.fastLog2(maxValue / minValue));
     }
 
 private:
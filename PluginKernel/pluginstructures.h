@@ -16,10 +16,28 @@
 // --- support multichannel operation up to 128 channels
 #define MAX_CHANNEL_COUNT 128
 
+// --- maximum number of MIDI and automation timestamps the kernel event scheduler will split a buffer on
+#define MAX_SCHEDULED_EVENT_OFFSETS 2048
+
+// --- maximum number of VST3 sample accurate automation events (points and ramp steps) in one buffer
+#define MAX_AUTOMATION_TIMELINE_EVENTS 4096
+
+// --- maximum number of presets in a preset morph (vector joystick A, B, C, D)
+#define MAX_MORPH_PRESETS 4
+
+// --- capacity of the kernel MIDI event ring; MUST be a power of 2
+#define MIDI_EVENT_RING_SIZE 1024
+
+// --- control IDs below this always get a dense (direct index) lookup table
+#define MAX_DENSE_CONTROL_ID 4096
+
 #include <string>
 #include <sstream>
 #include <vector>
+#include <algorithm>
+#include <atomic>
 #include <stdint.h>
+#include <string.h>
 
 #include "readerwriterqueue.h"
 #include "atomicops.h"
@@ -655,6 +673,32 @@ struct midiEvent
 	double		audioTimeStamp = 0.0;		///< time stamp (not all APIs)
 };
 
+/**
+\struct CompactMidiEvent
+\ingroup Structures
+\brief
+Compact (8 byte) MIDI event for the kernel MidiEventRing; the message is the status byte with the channel
+nibble removed, as in midiEvent.
+
+\version Revision : 1.0
+*/
+struct CompactMidiEvent
+{
+	CompactMidiEvent() {}
+	CompactMidiEvent(uint32_t _sampleOffset, uint8_t _message, uint8_t _channel, uint8_t _data1, uint8_t _data2)
+		: sampleOffset(_sampleOffset)
+		, message(_message)
+		, channel(_channel)
+		, data1(_data1)
+		, data2(_data2) {}
+
+	uint32_t	sampleOffset = 0;	///< sample offset of midi event within audio buffer
+	uint8_t		message = 0;		///< BYTE message (status without channel)
+	uint8_t		channel = 0;		///< BYTE channel
+	uint8_t		data1 = 0;			///< BYTE data 1
+	uint8_t		data2 = 0;			///< BYTE data 2
+};
+
 
 /**
 \enum messageType
@@ -1124,6 +1168,7 @@ struct ProcessFrameInfo
     ChannelIOConfig channelIOConfig;	///< input/output channel I/O configuration pair
     ChannelIOConfig auxChannelIOConfig;	///< aux input/output channel I/O configuration pair
 	uint32_t currentFrame = 0;			///< index of this frame
+	bool eventsScheduled = false;		///< true when the kernel event scheduler has already fired MIDI and automation for this frame
 
 	// --- for future use, VCVRack
 	float* controlSignalInputs = nullptr;	///< control signals in (reserved for future use)
@@ -1566,6 +1611,161 @@ public:
 
 	/** Fire off the next <IDI event */
 	virtual bool fireMidiEvents(uint32_t uSampleOffset) = 0;
+
+	/** Get the sample offsets of the events in this buffer (any order, duplicates OK) for the kernel event scheduler;
+	//  return false if the queue can not report them and the kernel will fire events on every frame instead */
+	virtual bool getEventSampleOffsets(uint32_t* sampleOffsets, uint32_t maxOffsets, uint32_t& numOffsets) { return false; }
+};
+
+/**
+\class IMidiEventProcessor
+\ingroup Interfaces
+\brief
+Interface for the object that receives MIDI events fired from the kernel MidiEventRing (the PluginBase).
+
+\version Revision : 1.0
+*/
+class IMidiEventProcessor
+{
+public:
+	/** process one MIDI event */
+	virtual bool processMIDIEvent(midiEvent& event) = 0;
+};
+
+/**
+\class MidiEventRing
+\ingroup ASPiK-Core
+\brief
+Kernel owned, fixed capacity, lock-free single-producer/single-consumer ring of CompactMidiEvents.
+
+The wrapper (producer) pushes events in time order with pushEvent( ); the audio thread (consumer) drains
+them by timestamp, either with drainEvents( ) for a voice engine that wants the compact events directly, or
+through the IMidiEventQueue interface, which converts each one to a midiEvent for processMIDIEvent( ).
+Draining costs O(events) per buffer and nothing is allocated after construction.
+
+Timestamps are buffer relative, so the consumer calls beginBuffer( ) at the top of each buffer to mark the
+events pushed so far as this buffer's; only those are drained or reported. Events the producer pushes while
+the buffer is being processed wait for the next buffer's beginBuffer( ) instead of firing early.
+
+\version Revision : 1.0
+*/
+class MidiEventRing : public IMidiEventQueue
+{
+public:
+	MidiEventRing() {}
+	virtual ~MidiEventRing() {}
+
+	/** set the receiver for fireMidiEvents( ) */
+	void setMidiEventProcessor(IMidiEventProcessor* _midiEventProcessor) { midiEventProcessor = _midiEventProcessor; }
+
+	// --- PRODUCER ------------------------------------------------------------------------------ //
+	/** push one event; returns false (and drops the event) if the ring is full */
+	inline bool pushEvent(const CompactMidiEvent& event)
+	{
+		uint32_t write = writeIndex.load(std::memory_order_relaxed);
+		if (write - readIndex.load(std::memory_order_acquire) >= MIDI_EVENT_RING_SIZE)
+			return false;
+
+		events[write & (MIDI_EVENT_RING_SIZE - 1)] = event;
+		writeIndex.store(write + 1, std::memory_order_release);
+		return true;
+	}
+
+	/** push one event from the wrapper's midiEvent */
+	inline bool pushEvent(const midiEvent& event)
+	{
+		return pushEvent(CompactMidiEvent(event.midiSampleOffset, (uint8_t)event.midiMessage, (uint8_t)event.midiChannel,
+										  (uint8_t)event.midiData1, (uint8_t)event.midiData2));
+	}
+
+	// --- CONSUMER ------------------------------------------------------------------------------ //
+	/** start a new buffer: the events pushed so far belong to it; must be called before draining each buffer */
+	inline void beginBuffer() { bufferEndIndex = writeIndex.load(std::memory_order_acquire); }
+
+	/** number of events waiting in the current buffer */
+	virtual uint32_t getEventCount()
+	{
+		return bufferEndIndex - readIndex.load(std::memory_order_relaxed);
+	}
+
+	/** drain the events with timestamps up to and including sampleOffset, in order; handler(const CompactMidiEvent&) is called for each
+	\return the number of events drained
+	*/
+	template <class Handler>
+	inline uint32_t drainEvents(uint32_t sampleOffset, Handler& handler)
+	{
+		uint32_t read = readIndex.load(std::memory_order_relaxed);
+		uint32_t count = 0;
+
+		while (read != bufferEndIndex)
+		{
+			const CompactMidiEvent& event = events[read & (MIDI_EVENT_RING_SIZE - 1)];
+			if (event.sampleOffset > sampleOffset)
+				break;
+
+			handler(event);
+			read++;
+			count++;
+		}
+
+		readIndex.store(read, std::memory_order_release);
+		return count;
+	}
+
+	/** IMidiEventQueue: fire the events up to and including this offset into the IMidiEventProcessor */
+	virtual bool fireMidiEvents(uint32_t uSampleOffset)
+	{
+		FireToProcessor fire = { midiEventProcessor };
+		return drainEvents(uSampleOffset, fire) > 0;
+	}
+
+	/** IMidiEventQueue: report the waiting timestamps to the kernel event scheduler */
+	virtual bool getEventSampleOffsets(uint32_t* sampleOffsets, uint32_t maxOffsets, uint32_t& numOffsets)
+	{
+		uint32_t read = readIndex.load(std::memory_order_relaxed);
+
+		numOffsets = 0;
+		for (; read != bufferEndIndex && numOffsets < maxOffsets; read++)
+			sampleOffsets[numOffsets++] = events[read & (MIDI_EVENT_RING_SIZE - 1)].sampleOffset;
+
+		// --- could not report them all
+		return read == bufferEndIndex;
+	}
+
+	/** discard everything waiting (consumer side) */
+	void flush()
+	{
+		bufferEndIndex = writeIndex.load(std::memory_order_acquire);
+		readIndex.store(bufferEndIndex, std::memory_order_release);
+	}
+
+protected:
+	/** converts compact events to midiEvent for the IMidiEventQueue path */
+	struct FireToProcessor
+	{
+		IMidiEventProcessor* processor;
+
+		inline void operator()(const CompactMidiEvent& compactEvent)
+		{
+			if (!processor) return;
+
+			midiEvent event(compactEvent.message, compactEvent.channel, compactEvent.data1, compactEvent.data2, compactEvent.sampleOffset);
+
+			// --- pitch bend: 14-bit value, centered
+			if (compactEvent.message == 0xE0)
+			{
+				event.midiPitchBendValue = (int)(((uint32_t)compactEvent.data2 << 7) | compactEvent.data1) - 8192;
+				event.midiNormalizedPitchBendValue = (float)event.midiPitchBendValue / 8192.f;
+			}
+			processor->processMIDIEvent(event);
+		}
+	};
+
+	CompactMidiEvent events[MIDI_EVENT_RING_SIZE];	///< the ring
+	alignas(64) std::atomic<uint32_t> writeIndex{ 0 };	///< producer index (free running)
+	alignas(64) std::atomic<uint32_t> readIndex{ 0 };		///< consumer index (free running)
+	uint32_t bufferEndIndex = 0;						///< consumer only: writeIndex at beginBuffer( )
+	IMidiEventProcessor* midiEventProcessor = nullptr;	///< receiver for fireMidiEvents( )
 };
 
 
@@ -1593,6 +1793,721 @@ public:
 	/**    Get the sample-accurate value of the parameter at the next sample offset, determined by an internal counter
 	//     Returns true if dNextValue is different than the previous value */
 	virtual bool getNextValue(double& _nextValue) = 0;
+
+	/**    Get the sample offsets of the points in this buffer (any order) for the kernel event scheduler;
+	//     return false if the queue can not report them and the kernel will poll getNextValue( ) on every frame instead */
+	virtual bool getPointSampleOffsets(uint32_t* sampleOffsets, uint32_t maxOffsets, uint32_t& numOffsets) { return false; }
+};
+
+/**
+\class EventOffsetList
+\ingroup ASPiK-Core
+\brief
+Fixed size list of sample offsets within one buffer; the kernel event scheduler collects the MIDI and
+automation timestamps here, then sorts them so the buffer can be rendered in the spans between them.
+No memory is allocated on the audio thread.
+
+\version Revision : 1.0
+*/
+class EventOffsetList
+{
+public:
+	EventOffsetList() {}
+
+	/** empty the list at the top of the buffer */
+	void clear()
+	{
+		numOffsets = 0;
+		overflow = false;
+	}
+
+	/** add one offset; offsets outside the buffer are ignored */
+	inline void addOffset(uint32_t offset, uint32_t bufferSize)
+	{
+		if (offset >= bufferSize)
+			return;
+
+		if (numOffsets < MAX_SCHEDULED_EVENT_OFFSETS)
+			offsets[numOffsets++] = offset;
+		else
+			overflow = true;
+	}
+
+	/** pointer to the free space at the end of the list, for the queue interfaces to write into */
+	uint32_t* getFreeSpace() { return &offsets[numOffsets]; }
+
+	/** size of the free space */
+	uint32_t getFreeSpaceCount() { return MAX_SCHEDULED_EVENT_OFFSETS - numOffsets; }
+
+	/** append offsets written directly into getFreeSpace( ), dropping those outside the buffer */
+	void commitFreeSpace(uint32_t count, uint32_t bufferSize)
+	{
+		if (count > getFreeSpaceCount())
+		{
+			overflow = true;
+			count = getFreeSpaceCount();
+		}
+
+		uint32_t* freeSpace = getFreeSpace();
+		for (uint32_t i = 0; i < count; i++)
+		{
+			if (freeSpace[i] < bufferSize)
+				offsets[numOffsets++] = freeSpace[i];
+		}
+	}
+
+	/** sort ascending and remove duplicates */
+	void sortOffsets()
+	{
+		std::sort(offsets, offsets + numOffsets);
+		numOffsets = (uint32_t)(std::unique(offsets, offsets + numOffsets) - offsets);
+	}
+
+	/** true if more offsets were added than the list can hold */
+	bool didOverflow() { return overflow; }
+
+	/** number of offsets */
+	uint32_t getCount() { return numOffsets; }
+
+	/** get an offset */
+	uint32_t getOffset(uint32_t index) { return offsets[index]; }
+
+protected:
+	uint32_t offsets[MAX_SCHEDULED_EVENT_OFFSETS] = { 0 };	///< the offsets
+	uint32_t numOffsets = 0;	///< count
+	bool overflow = false;		///< overflow flag
+};
+
+/**
+\struct AutomationEvent
+\ingroup ASPiK-Core
+\brief
+One entry of the AutomationTimeline: a smoothable parameter that changes at a sample offset.
+
+\version Revision : 1.0
+*/
+struct AutomationEvent
+{
+	uint32_t sampleOffset;		///< timestamp, in samples from the top of the buffer
+	uint32_t parameterIndex;	///< index in PluginBase::smoothablePluginParameters
+
+	/** timeline order: by offset, then by parameter */
+	inline bool operator<(const AutomationEvent& other) const
+	{
+		return sampleOffset < other.sampleOffset || (sampleOffset == other.sampleOffset && parameterIndex < other.parameterIndex);
+	}
+
+	/** duplicate test */
+	inline bool operator==(const AutomationEvent& other) const
+	{
+		return sampleOffset == other.sampleOffset && parameterIndex == other.parameterIndex;
+	}
+};
+
+/**
+\class AutomationTimeline
+\ingroup ASPiK-Core
+\brief
+Sorted list of the VST3 sample accurate automation events in one buffer. The kernel collects every automated
+parameter's points (and its ramp, sampled at the VST3 sample accurate granularity) once per buffer; the events are
+then applied at their offsets, in order, with a cursor, so no queue is polled on frames without events.
+No memory is allocated on the audio thread.
+
+\version Revision : 1.0
+*/
+class AutomationTimeline
+{
+public:
+	AutomationTimeline() {}
+
+	/** empty the timeline at the top of the buffer */
+	void clear()
+	{
+		numEvents = 0;
+		nextEvent = 0;
+		overflow = false;
+	}
+
+	/** add one event; offsets outside the buffer are ignored */
+	inline void addEvent(uint32_t sampleOffset, uint32_t parameterIndex, uint32_t bufferSize)
+	{
+		if (sampleOffset >= bufferSize)
+			return;
+
+		if (numEvents < MAX_AUTOMATION_TIMELINE_EVENTS)
+		{
+			events[numEvents].sampleOffset = sampleOffset;
+			events[numEvents].parameterIndex = parameterIndex;
+			numEvents++;
+		}
+		else
+			overflow = true;
+	}
+
+	/** scratch space for IParameterUpdateQueue::getPointSampleOffsets( ) */
+	uint32_t* getPointSpace() { return points; }
+
+	/** size of the scratch space */
+	uint32_t getPointSpaceCount() { return MAX_AUTOMATION_TIMELINE_EVENTS; }
+
+	/** sort by offset, then parameter, and remove duplicates */
+	void sortEvents()
+	{
+		std::sort(events, events + numEvents);
+		numEvents = (uint32_t)(std::unique(events, events + numEvents) - events);
+		nextEvent = 0;
+	}
+
+	/** true if more events were added than the timeline can hold */
+	bool didOverflow() { return overflow; }
+
+	/** number of events */
+	uint32_t getCount() { return numEvents; }
+
+	/** get an event */
+	const AutomationEvent& getEvent(uint32_t index) { return events[index]; }
+
+	/** sample offset of an event */
+	uint32_t getOffset(uint32_t index) { return events[index].sampleOffset; }
+
+	/** move the cursor to the events at a sample offset; offsets must be visited in ascending order
+	\param sampleOffset the offset
+	\param firstEvent returns the index of the first event at the offset
+	\return the number of events at the offset
+	*/
+	inline uint32_t getEventsAtOffset(uint32_t sampleOffset, uint32_t& firstEvent)
+	{
+		while (nextEvent < numEvents && events[nextEvent].sampleOffset < sampleOffset)
+			nextEvent++;
+
+		firstEvent = nextEvent;
+		while (nextEvent < numEvents && events[nextEvent].sampleOffset == sampleOffset)
+			nextEvent++;
+
+		return nextEvent - firstEvent;
+	}
+
+protected:
+	AutomationEvent events[MAX_AUTOMATION_TIMELINE_EVENTS];	///< the events
+	uint32_t points[MAX_AUTOMATION_TIMELINE_EVENTS] = { 0 };	///< scratch for the queues
+	uint32_t numEvents = 0;		///< count
+	uint32_t nextEvent = 0;		///< cursor
+	bool overflow = false;		///< overflow flag
+};
+
+/**
+\class ParameterChangeFlags
+\ingroup ASPiK-Core
+\brief
+Atomic dirty-bit set with one bit per plugin parameter. The GUI/host thread sets a parameter's bit when it
+writes a new value; the audio thread collects and clears the bits once per buffer so the bound variable
+sync only visits parameters that actually changed.
+
+\version Revision : 1.0
+*/
+class ParameterChangeFlags
+{
+public:
+	ParameterChangeFlags() {}
+	~ParameterChangeFlags() { delete[] words; }
+
+	/** size the set; NOT thread safe, call during initialization only; all flags start set */
+	void create(uint32_t _numFlags)
+	{
+		delete[] words;
+		numFlags = _numFlags;
+		numWords = (numFlags + 63) / 64;
+		words = numWords > 0 ? new std::atomic<uint64_t>[numWords] : nullptr;
+		for (uint32_t i = 0; i < numWords; i++)
+			words[i].store(0, std::memory_order_relaxed);
+		for (uint32_t i = 0; i < numFlags; i++)
+			setFlag(i);
+	}
+
+	/** mark one parameter as changed (any thread) */
+	inline void setFlag(uint32_t index)
+	{
+		if (index < numFlags)
+			words[index >> 6].fetch_or((uint64_t)1 << (index & 63), std::memory_order_release);
+	}
+
+	/** mark a set of parameters as changed, 64 per word (any thread) */
+	inline void setFlags(const uint64_t* mask, uint32_t maskWords)
+	{
+		for (uint32_t w = 0; w < maskWords && w < numWords; w++)
+		{
+			if (mask[w])
+				words[w].fetch_or(mask[w], std::memory_order_release);
+		}
+	}
+
+	/** collect and clear the changed flags (audio thread); function(index) is called for each one in index order
+	\return the number of changed parameters
+	*/
+	template <class Function>
+	inline uint32_t collectFlags(Function& function)
+	{
+		uint32_t count = 0;
+		for (uint32_t w = 0; w < numWords; w++)
+		{
+			// --- cheap test first, so an idle word costs one load
+			if (words[w].load(std::memory_order_relaxed) == 0)
+				continue;
+
+			uint64_t bits = words[w].exchange(0, std::memory_order_acquire);
+			while (bits)
+			{
+				function(w * 64 + countTrailingZeros(bits));
+				bits &= bits - 1;
+				count++;
+			}
+		}
+		return count;
+	}
+
+	/** number of flags */
+	uint32_t getNumFlags() { return numFlags; }
+
+protected:
+	std::atomic<uint64_t>* words = nullptr;	///< 64 flags per word
+	uint32_t numWords = 0;					///< word count
+	uint32_t numFlags = 0;					///< flag count
+
+	/** index of lowest set bit; bits must be non-zero */
+	static inline uint32_t countTrailingZeros(uint64_t bits)
+	{
+#if defined _MSC_VER && defined _WIN64
+		unsigned long index = 0;
+		_BitScanForward64(&index, bits);
+		return (uint32_t)index;
+#elif defined __GNUC__
+		return (uint32_t)__builtin_ctzll(bits);
+#else
+		uint32_t index = 0;
+		while ((bits & 1) == 0)
+		{
+			bits >>= 1;
+			index++;
+		}
+		return index;
+#endif
+	}
+
+private:
+	ParameterChangeFlags(const ParameterChangeFlags&);				///< not copyable
+	ParameterChangeFlags& operator=(const ParameterChangeFlags&);	///< not copyable
+};
+
+/**
+\class ParameterSnapshot
+\ingroup ASPiK-Core
+\brief
+Lock-free double-precision parameter values, one 64 bit atomic slot per parameter. Any thread (GUI, host or the
+audio thread inside the wrapper's process call) publishes a value with a single atomic store; the audio thread
+reads the values it was flagged for with single atomic loads.
+
+- a write is O(1) and never waits, so it is safe from the audio thread
+- a value is stored with release before its change flag is set and read with acquire after the flags are
+  collected, so every flagged value is visible; a group of values published before one release operation (see
+  PresetImage) is seen together
+- values are doubles, so frequencies and other wide-range parameters are not truncated to float
+
+\version Revision : 1.0
+*/
+class ParameterSnapshot
+{
+public:
+	ParameterSnapshot() {}
+	~ParameterSnapshot() { destroy(); }
+
+	/** size the slots; NOT thread safe, call during initialization only */
+	void create(uint32_t _numValues)
+	{
+		destroy();
+		numValues = _numValues;
+		if (numValues == 0)
+			return;
+
+		values = new std::atomic<uint64_t>[numValues];
+		for (uint32_t i = 0; i < numValues; i++)
+			initValue(i, 0.0);
+	}
+
+	/** set a value; NOT thread safe, call during initialization only */
+	void initValue(uint32_t index, double value)
+	{
+		if (index < numValues)
+			values[index].store(doubleToBits(value), std::memory_order_relaxed);
+	}
+
+	/** publish one value (any thread); lock-free */
+	inline void setValue(uint32_t index, double value)
+	{
+		if (index < numValues)
+			values[index].store(doubleToBits(value), std::memory_order_release);
+	}
+
+	/** publish a set of values (any thread); the values are dense, indexed like the snapshot
+	\param _values the dense values
+	\param indexes the indexes to publish
+	\param count number of indexes
+	*/
+	void setValues(const double* _values, const uint32_t* indexes, uint32_t count)
+	{
+		for (uint32_t i = 0; i < count; i++)
+			setValue(indexes[i], _values[indexes[i]]);
+	}
+
+	/** read one value (audio thread); lock-free */
+	inline double getValue(uint32_t index)
+	{
+		return index < numValues ? bitsToDouble(values[index].load(std::memory_order_acquire)) : 0.0;
+	}
+
+	/** number of values */
+	uint32_t getNumValues() { return numValues; }
+
+protected:
+	std::atomic<uint64_t>* values = nullptr;	///< double bits, one slot per parameter
+	uint32_t numValues = 0;						///< value count
+
+	/** double to bits, no aliasing */
+	static inline uint64_t doubleToBits(double value)
+	{
+		uint64_t bits = 0;
+		memcpy(&bits, &value, sizeof(double));
+		return bits;
+	}
+
+	/** bits to double, no aliasing */
+	static inline double bitsToDouble(uint64_t bits)
+	{
+		double value = 0.0;
+		memcpy(&value, &bits, sizeof(double));
+		return value;
+	}
+
+	/** free the slots */
+	void destroy()
+	{
+		delete[] values;
+		values = nullptr;
+		numValues = 0;
+	}
+
+private:
+	ParameterSnapshot(const ParameterSnapshot&);				///< not copyable
+	ParameterSnapshot& operator=(const ParameterSnapshot&);	///< not copyable
+};
+
+/**
+\class PresetImage
+\ingroup ASPiK-Core
+\brief
+A preset compiled into a dense array of values indexed like PluginBase::pluginParameterArray, with the change and
+smoothing target flag masks it sets. The kernel publishes the whole image to the parameter snapshot at once and hands
+it to the audio thread with a single atomic exchange, so loading a preset needs no per-parameter lookups and the
+audio thread sees all of its values in the same buffer.
+
+- the masks follow the parameters' smoothing settings when the image is compiled; smoothed parameters get a new
+  smoothing target, the others a new value
+- meters are never part of an image
+
+\version Revision : 1.0
+*/
+class PresetImage
+{
+public:
+	PresetImage() {}
+	~PresetImage() { destroy(); }
+
+	/** size the image for the parameter and smoother counts; NOT thread safe; the image starts empty */
+	void create(uint32_t _numValues, uint32_t _numTargets)
+	{
+		destroy();
+		numValues = _numValues;
+		numChangeWords = (numValues + 63) / 64;
+		numTargetWords = (_numTargets + 63) / 64;
+
+		values = new double[numValues > 0 ? numValues : 1];
+		indexes = new uint32_t[numValues > 0 ? numValues : 1];
+		changeMask = new uint64_t[numChangeWords > 0 ? numChangeWords : 1];
+		presentMask = new uint64_t[numChangeWords > 0 ? numChangeWords : 1];
+		targetMask = new uint64_t[numTargetWords > 0 ? numTargetWords : 1];
+
+		memset(values, 0, sizeof(double)*numValues);
+		memset(changeMask, 0, sizeof(uint64_t)*numChangeWords);
+		memset(presentMask, 0, sizeof(uint64_t)*numChangeWords);
+		memset(targetMask, 0, sizeof(uint64_t)*numTargetWords);
+		numIndexes = 0;
+	}
+
+	/** add a value that is written directly (change flag) */
+	inline void setValue(uint32_t index, double value)
+	{
+		if (!addIndex(index, value))
+			return;
+		changeMask[index >> 6] |= (uint64_t)1 << (index & 63);
+	}
+
+	/** add a value that is smoothed (smoothing target flag) */
+	inline void setSmoothedValue(uint32_t index, double value, uint32_t smootherIndex)
+	{
+		if (!addIndex(index, value) || (smootherIndex >> 6) >= numTargetWords)
+			return;
+		targetMask[smootherIndex >> 6] |= (uint64_t)1 << (smootherIndex & 63);
+	}
+
+	/** the dense values */
+	const double* getValues() { return values; }
+
+	/** the indexes of the values in the image, in the order they were added */
+	const uint32_t* getIndexes() { return indexes; }
+
+	/** number of values in the image */
+	uint32_t getNumIndexes() { return numIndexes; }
+
+	/** true if the preset has a value for this index */
+	inline bool hasValue(uint32_t index)
+	{
+		return index < numValues && (presentMask[index >> 6] & ((uint64_t)1 << (index & 63))) != 0;
+	}
+
+	/** set the flags of every value in the image (any thread) */
+	inline void setFlags(ParameterChangeFlags& changeFlags, ParameterChangeFlags& targetFlags)
+	{
+		changeFlags.setFlags(changeMask, numChangeWords);
+		targetFlags.setFlags(targetMask, numTargetWords);
+	}
+
+protected:
+	double* values = nullptr;			///< dense values, pluginParameterArray order
+	uint32_t numValues = 0;				///< value count
+	uint32_t* indexes = nullptr;		///< indexes that are in the image
+	uint32_t numIndexes = 0;			///< index count
+	uint64_t* changeMask = nullptr;		///< change flags to set, pluginParameterArray order
+	uint64_t* presentMask = nullptr;	///< values that are in the image, pluginParameterArray order
+	uint32_t numChangeWords = 0;		///< mask words
+	uint64_t* targetMask = nullptr;		///< smoothing target flags to set, smoothablePluginParameters order
+	uint32_t numTargetWords = 0;		///< mask words
+
+	/** store a value; false if it is out of range or already in the image */
+	inline bool addIndex(uint32_t index, double value)
+	{
+		if (index >= numValues)
+			return false;
+
+		values[index] = value;
+		if (presentMask[index >> 6] & ((uint64_t)1 << (index & 63)))
+			return false;
+
+		presentMask[index >> 6] |= (uint64_t)1 << (index & 63);
+		indexes[numIndexes++] = index;
+		return true;
+	}
+
+	/** free the arrays */
+	void destroy()
+	{
+		delete[] values;
+		delete[] indexes;
+		delete[] changeMask;
+		delete[] presentMask;
+		delete[] targetMask;
+		values = nullptr;
+		indexes = nullptr;
+		changeMask = nullptr;
+		presentMask = nullptr;
+		targetMask = nullptr;
+		numValues = 0;
+		numIndexes = 0;
+		numChangeWords = 0;
+		numTargetWords = 0;
+	}
+
+private:
+	PresetImage(const PresetImage&);				///< not copyable
+	PresetImage& operator=(const PresetImage&);	///< not copyable
+};
+
+/**
+\class PresetMorph
+\ingroup ASPiK-Core
+\brief
+Morph between two or four compiled presets (see PresetImage). The source values are gathered once, in smoother bank
+order, into one contiguous array per preset; a morph is then a weighted sum of the dense arrays in a single loop with
+no lookups that the compiler can vectorize. The audio thread runs it at control rate, only when the weights changed,
+and feeds the results to the ParamSmootherBank as new targets.
+
+- the weights are packed as 21 bit fractions into one atomic word (D is what is left of the whole), so they can be
+  written from any thread (GUI, vector joystick, MIDI CC) and are never torn
+- the kernel sets the morph up under a spin flag; the audio thread only tries the flag and skips the morph for one
+  block if it is busy, so it never waits
+- only parameters that are in every source preset are morphed; values are interpolated in the actual (not
+  normalized) domain
+
+\version Revision : 1.0
+*/
+class PresetMorph
+{
+public:
+	PresetMorph() {}
+	~PresetMorph() { destroy(); }
+
+	/** size the arrays; NOT thread safe, call during initialization only */
+	void create(uint32_t _numValues)
+	{
+		destroy();
+		numValues = _numValues;
+		sources = new double[MAX_MORPH_PRESETS*(numValues > 0 ? numValues : 1)];
+		values = new double[numValues > 0 ? numValues : 1];
+		indexes = new uint32_t[numValues > 0 ? numValues : 1];
+		memset(sources, 0, sizeof(double)*MAX_MORPH_PRESETS*numValues);
+		memset(values, 0, sizeof(double)*numValues);
+		numIndexes = 0;
+		numSources = 0;
+	}
+
+	/** take the setup flag (not the audio thread); spins while the audio thread is morphing */
+	inline void lockSetup() { while (setupLock.test_and_set(std::memory_order_acquire)) {} }
+
+	/** release the setup flag */
+	inline void unlockSetup() { setupLock.clear(std::memory_order_release); }
+
+	/** start a new setup under the setup flag: 2 or 4 sources, 0 turns the morph off */
+	void beginSetup(uint32_t _numSources)
+	{
+		numSources = _numSources == 2 || _numSources == MAX_MORPH_PRESETS ? _numSources : 0;
+		numIndexes = 0;
+		lastWeights = MORPH_WEIGHTS_NONE;
+	}
+
+	/** dense source array of one preset, smoother bank order */
+	double* getSource(uint32_t source) { return &sources[source*numValues]; }
+
+	/** morph a value that is in every source */
+	inline void addIndex(uint32_t index)
+	{
+		if (index < numValues && numIndexes < numValues)
+			indexes[numIndexes++] = index;
+	}
+
+	/** number of sources; 0 = off */
+	uint32_t getNumSources() { return numSources; }
+
+	/** set the weights (any thread); they are normalized so they sum to 1; a 2-way morph uses A+C and B+D */
+	inline void setWeights(double a, double b, double c, double d)
+	{
+		a = a > 0.0 ? a : 0.0;
+		b = b > 0.0 ? b : 0.0;
+		c = c > 0.0 ? c : 0.0;
+		d = d > 0.0 ? d : 0.0;
+
+		double sum = a + b + c + d;
+		if (sum <= 0.0)
+			return;
+
+		double scale = (double)MORPH_WEIGHT_ONE / sum;
+		uint64_t wa = (uint64_t)(a*scale + 0.5);
+		wa = wa < MORPH_WEIGHT_ONE ? wa : MORPH_WEIGHT_ONE;
+		uint64_t wb = (uint64_t)(b*scale + 0.5);
+		wb = wb < MORPH_WEIGHT_ONE - wa ? wb : MORPH_WEIGHT_ONE - wa;
+		uint64_t wc = (uint64_t)(c*scale + 0.5);
+		wc = wc < MORPH_WEIGHT_ONE - wa - wb ? wc : MORPH_WEIGHT_ONE - wa - wb;
+		weights.store(wa | (wb << 21) | (wc << 42), std::memory_order_relaxed);
+	}
+
+	/** run the morph if the weights changed since the last one (audio thread); never waits
+	\return true if getValues( ) holds new values
+	*/
+	bool morph()
+	{
+		if (setupLock.test_and_set(std::memory_order_acquire))
+			return false;
+
+		uint64_t packed = weights.load(std::memory_order_relaxed);
+		bool morphed = packed != lastWeights && numSources > 0 && numIndexes > 0;
+		if (morphed)
+		{
+			double w[MAX_MORPH_PRESETS];
+			uint64_t left = MORPH_WEIGHT_ONE;
+			for (uint32_t k = 0; k < MAX_MORPH_PRESETS - 1; k++)
+			{
+				uint64_t weight = (packed >> (21 * k)) & MORPH_WEIGHT_ONE;
+				w[k] = (double)weight;
+				left -= weight;
+			}
+			w[MAX_MORPH_PRESETS - 1] = (double)left;
+			double sum = (double)MORPH_WEIGHT_ONE;
+
+			const double* a = getSource(0);
+			const double* b = getSource(1);
+			if (numSources == 2)
+			{
+				// --- A+C is the first preset, B+D the second, so an X/Y position works for both morph sizes
+				double x = (w[1] + w[3]) / sum;
+				for (uint32_t i = 0; i < numValues; i++)
+					values[i] = a[i] + x*(b[i] - a[i]);
+			}
+			else
+			{
+				const double* c = getSource(2);
+				const double* d = getSource(3);
+				double wa = w[0] / sum;
+				double wb = w[1] / sum;
+				double wc = w[2] / sum;
+				double wd = w[3] / sum;
+				for (uint32_t i = 0; i < numValues; i++)
+					values[i] = wa*a[i] + wb*b[i] + wc*c[i] + wd*d[i];
+			}
+			lastWeights = packed;
+		}
+
+		setupLock.clear(std::memory_order_release);
+		return morphed;
+	}
+
+	/** the morphed values, smoother bank order; valid for the indexes only */
+	const double* getValues() { return values; }
+
+	/** the morphed indexes */
+	const uint32_t* getIndexes() { return indexes; }
+
+	/** number of morphed indexes */
+	uint32_t getNumIndexes() { return numIndexes; }
+
+protected:
+	static const uint64_t MORPH_WEIGHT_ONE = 0x1FFFFF;					///< a weight of 1.0 (21 bits)
+	static const uint64_t MORPH_WEIGHTS_NONE = 0xFFFFFFFFFFFFFFFFull;	///< no morph has run yet (never a packed value, those use 63 bits)
+
+	double* sources = nullptr;		///< MAX_MORPH_PRESETS dense arrays, one after the other
+	double* values = nullptr;		///< morph output
+	uint32_t* indexes = nullptr;	///< indexes that are in every source
+	uint32_t numValues = 0;			///< values per array
+	uint32_t numIndexes = 0;		///< index count
+	uint32_t numSources = 0;		///< 2 or 4; 0 = off
+
+	alignas(64) std::atomic<uint64_t> weights = { MORPH_WEIGHT_ONE };	///< packed weights A, B, C; A = 1
+	uint64_t lastWeights = MORPH_WEIGHTS_NONE;					///< weights of the last morph (audio thread)
+	std::atomic_flag setupLock = ATOMIC_FLAG_INIT;				///< held during setup and during a morph
+
+	/** free the arrays */
+	void destroy()
+	{
+		delete[] sources;
+		delete[] values;
+		delete[] indexes;
+		sources = nullptr;
+		values = nullptr;
+		indexes = nullptr;
+		numValues = 0;
+		numIndexes = 0;
+		numSources = 0;
+	}
+
+private:
+	PresetMorph(const PresetMorph&);				///< not copyable
+	PresetMorph& operator=(const PresetMorph&);	///< not copyable
 };
 
 // --------------------------------------------------------------------------------------------------------------------------- //
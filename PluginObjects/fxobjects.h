@@ -18,7 +18,10 @@
 #pragma once
 
 #include <memory>
+#include <atomic>
 #include <math.h>
+#include <stdint.h>
+#include <string.h>
 #include "guiconstants.h"
 #include "filters.h"
 #include <time.h>       /* time */
@@ -148,6 +151,62 @@ inline double doLagrangeInterpolation(double* x, double* y, int n, double xbar)
 	return (fx);
 }
 
+/**
+@doHermiteInterpolation
+\ingroup FX-Functions
+
+@brief performs 4-point, 3rd order Hermite (Catmull-Rom) interpolation of fractional x distance
+between the two inner points y0 and y1 of four equally spaced points; returns interpolated value
+
+\param ym1 - the y coordinate of the point before y0
+\param y0 - the y coordinate of the first inner point
+\param y1 - the y coordinate of the second inner point
+\param y2 - the y coordinate of the point after y1
+\param fractional_X - the interpolation location as a fractional distance between y0 and y1
+\return the interpolated value
+*/
+inline double doHermiteInterpolation(double ym1, double y0, double y1, double y2, double fractional_X)
+{
+	// --- polynomial coefficients
+	double c0 = y0;
+	double c1 = 0.5*(y1 - ym1);
+	double c2 = ym1 - 2.5*y0 + 2.0*y1 - 0.5*y2;
+	double c3 = 0.5*(y2 - ym1) + 1.5*(y0 - y1);
+
+	// --- Horner's method
+	return ((c3*fractional_X + c2)*fractional_X + c1)*fractional_X + c0;
+}
+
+/**
+@doLagrange4Interpolation
+\ingroup FX-Functions
+
+@brief performs 4-point, 3rd order Lagrange interpolation of fractional x distance between
+the two inner points y0 and y1 of four equally spaced points; this is the fixed-order
+equivalent of doLagrangeInterpolation( ) with no divisions
+
+\param ym1 - the y coordinate of the point before y0
+\param y0 - the y coordinate of the first inner point
+\param y1 - the y coordinate of the second inner point
+\param y2 - the y coordinate of the point after y1
+\param fractional_X - the interpolation location as a fractional distance between y0 and y1
+\return the interpolated value
+*/
+inline double doLagrange4Interpolation(double ym1, double y0, double y1, double y2, double fractional_X)
+{
+	// --- Lagrange basis polynomials for points at x = -1, 0, 1, 2
+	double xp1 = fractional_X + 1.0;
+	double xm1 = fractional_X - 1.0;
+	double xm2 = fractional_X - 2.0;
+
+	double hm1 = -fractional_X*xm1*xm2 / 6.0;
+	double h0 = xp1*xm1*xm2 / 2.0;
+	double h1 = -xp1*fractional_X*xm2 / 2.0;
+	double h2 = xp1*fractional_X*xm1 / 6.0;
+
+	return hm1*ym1 + h0*y0 + h1*y1 + h2*y2;
+}
+
 
 /**
 @boundValue
@@ -284,6 +343,89 @@ inline double dB2Raw(double dB)
 	return pow(10.0, (dB / 20.0));
 }
 
+/**
+@fastLog2
+\ingroup FX-Functions
+
+@brief fast log2( ) approximation: the exponent is read from the IEEE-754 bits and log2 of the
+mantissa in [1, 2) is found with a 5th order polynomial; max absolute error is 1.5e-5 (0.0001 dB)
+
+\param x - value to convert, must be a positive normal number
+\return the approximate log2(x)
+*/
+inline double fastLog2(double x)
+{
+	uint64_t bits = 0;
+	memcpy(&bits, &x, sizeof(double));
+
+	// --- unbiased exponent
+	double exponent = (double)((int)((bits >> 52) & 0x7FF) - 1023);
+
+	// --- replace exponent with 0 (biased 1023) to get mantissa in [1, 2)
+	bits = (bits & 0x000FFFFFFFFFFFFFULL) | 0x3FF0000000000000ULL;
+	double mantissa = 0.0;
+	memcpy(&mantissa, &bits, sizeof(double));
+
+	double t = mantissa - 1.0;
+	return exponent + 1.439092999e-05 + t*(1.441592077 + t*(-0.7072534336 + t*(0.4115614823 + t*(-0.1898324465 + t*0.04392862785))));
+}
+
+/**
+@fastPow2
+\ingroup FX-Functions
+
+@brief fast 2^x approximation: 2^fraction is found with a 4th order polynomial and the integer part
+is added to the IEEE-754 exponent bits; max relative error is 2.7e-6 (0.00003 dB)
+
+\param x - exponent, clamped to [-1022, 1023]
+\return the approximate 2^x
+*/
+inline double fastPow2(double x)
+{
+	x = fmin(fmax(x, -1022.0), 1023.0);
+
+	double integer = floor(x);
+	double t = x - integer;
+	double y = 1.000002518 + t*(0.6930066207 + t*(0.2414274933 + t*(0.05203742877 + t*0.0135206032)));
+
+	// --- scale by 2^integer in the exponent field
+	uint64_t bits = 0;
+	memcpy(&bits, &y, sizeof(double));
+	bits += (uint64_t)((int64_t)integer) << 52;
+	memcpy(&y, &bits, sizeof(double));
+	return y;
+}
+
+/**
+@fastRaw2dB
+\ingroup FX-Functions
+
+@brief calculates dB for given input with fastLog2( ); max error is 0.0001 dB
+
+\param raw - value to convert to dB, must be > 0
+\return the dB value
+*/
+inline double fastRaw2dB(double raw)
+{
+	// --- 20*log10(2)
+	return 6.0205999132796239*fastLog2(raw);
+}
+
+/**
+@fastDB2Raw
+\ingroup FX-Functions
+
+@brief converts dB to raw value with fastPow2( ); max relative error is 2.7e-6
+
+\param dB - value to convert to raw
+\return the raw value
+*/
+inline double fastDB2Raw(double dB)
+{
+	// --- log2(10)/20
+	return fastPow2(0.16609640474436813*dB);
+}
+
 /**
 @peakGainFor_Q
 \ingroup FX-Functions
@@ -315,33 +457,57 @@ inline double dBPeakGainFor_Q(double Q)
 }
 
 /**
-@doWhiteNoise
-\ingroup FX-Functions
+\struct FastRandom
+\ingroup FX-Objects
+\brief
+The FastRandom object is a per-instance xorshift32 random number generator; unlike rand( ) it has no
+shared state or lock, and it is deterministic for a given seed.
 
-@brief calculates a random value between -1.0 and +1.0
-\return the random value on the range [-1.0, +1.0]
+\version Revision : 1.0
 */
-inline double doWhiteNoise()
+struct FastRandom
 {
-	float noise = 0.0;
+	FastRandom(uint32_t _seed = 22222) { setSeed(_seed); }
+
+	/** set the seed; 0 is not a valid xorshift state and is replaced */
+	void setSeed(uint32_t _seed) { state = _seed != 0 ? _seed : 0x9E3779B9; }
 
-#if defined _WINDOWS || defined _WINDLL
-	// fNoise is 0 -> 32767.0
-	noise = (float)rand();
+	/** next 32-bit value */
+	inline uint32_t nextUInt()
+	{
+		state ^= state << 13;
+		state ^= state >> 17;
+		state ^= state << 5;
+		return state;
+	}
 
-	// normalize and make bipolar
-	noise = 2.0*(noise / 32767.0) - 1.0;
-#else
-	// fNoise is 0 -> ARC4RANDOMMAX
-	noise = (float)arc4random();
+	/** next value on the range [-1.0, +1.0) */
+	inline double nextBipolar() { return (double)(int32_t)nextUInt() * (1.0 / 2147483648.0); }
 
-	// normalize and make bipolar
-	noise = 2.0*(noise / ARC4RANDOMMAX) - 1.0;
-#endif
+	/** next value on the range [0.0, +1.0) */
+	inline double nextUnipolar() { return (double)nextUInt() * (1.0 / 4294967296.0); }
+
+	uint32_t state = 22222; ///< generator state
+};
+
+/**
+@doWhiteNoise
+\ingroup FX-Functions
 
-	return noise;
+@brief calculates a random value between -1.0 and +1.0; uses a per-thread FastRandom generator
+so there is no shared state or library lock (see NoiseGenerator for per-instance, seeded noise);
+each thread's generator gets a distinct seed so voices on different threads are uncorrelated
+\return the random value on the range [-1.0, +1.0)
+*/
+inline double doWhiteNoise()
+{
+	// --- one seed step per thread, taken once on that thread's first call
+	static std::atomic<uint32_t> threadSeedCounter(0);
+	static thread_local FastRandom noiseGenerator(22222 + 0x9E3779B9 * threadSeedCounter.fetch_add(1, std::memory_order_relaxed));
+	return noiseGenerator.nextBipolar();
 }
 
+
 /**
 @sgn
 \ingroup FX-Functions
@@ -1765,6 +1931,275 @@ protected:
 	LRFilterBankParameters parameters; ///< parameters for the object
 };
 
+const unsigned int MAX_CROSSOVER_BANDS = 8;		///< most bands for the LRCrossoverBank
+const unsigned int MAX_CROSSOVER_CHANNELS = 2;	///< most channels (lanes) for the LRCrossoverBank
+
+/**
+\struct LRCrossoverBankParameters
+\ingroup FX-Objects
+\brief
+Custom parameter structure for the LRCrossoverBank object. The split frequencies must be
+ascending; only the first (numBands - 1) are used.
+
+\version Revision : 1.0
+*/
+struct LRCrossoverBankParameters
+{
+	LRCrossoverBankParameters() {}
+	/** all FXObjects parameter objects require overloaded= operator so remember to add new entries if you add new variables. */
+	LRCrossoverBankParameters& operator=(const LRCrossoverBankParameters& params)	// need this override for collections to work
+	{
+		if (this == &params)
+			return *this;
+		numBands = params.numBands;
+		for (unsigned int i = 0; i < MAX_CROSSOVER_BANDS - 1; i++)
+			splitFrequency[i] = params.splitFrequency[i];
+		return *this;
+	}
+
+	// --- individual parameters
+	unsigned int numBands = 3; ///< number of bands, 2 to MAX_CROSSOVER_BANDS
+	double splitFrequency[MAX_CROSSOVER_BANDS - 1] = { 200.0, 2000.0, 4000.0, 6000.0, 8000.0, 10000.0, 12000.0 }; ///< ascending split frequencies
+};
+
+/**
+\class LRCrossoverBank
+\ingroup FX-Objects
+\brief
+The LRCrossoverBank object splits the input into 2 to 8 bands with a tree of 4th order Linkwitz-Riley
+crossovers: each split divides the remaining upper band into a low band and a new upper band. Each low
+band is then passed through the 2nd order allpass of every higher split (LP4 + HP4 = AP2 at the same fc),
+so all bands have the same phase and the band sum is an allpass with a flat magnitude response.
+
+The filters are transposed direct form II biquads stored in structure-of-arrays form so that the channels
+(and, for the phase compensation, all bands that share an allpass) run as parallel lanes in simple loops
+that the compiler can vectorize.
+
+Audio I/O:
+- Processes one or two channels into band outputs with processCrossoverFrame( ) or processAudioBlock( ).
+NOTE: processAudioSample( ) is inoperable and only returns the input back.
+
+Control I/F:
+- Use LRCrossoverBankParameters structure to get/set object params.
+
+\version Revision : 1.0
+*/
+class LRCrossoverBank : public IAudioSignalProcessor
+{
+public:
+	LRCrossoverBank() {}	/* C-TOR */
+	~LRCrossoverBank() {}	/* D-TOR */
+
+	/** reset filter states and recalculate coefficients */
+	virtual bool reset(double _sampleRate)
+	{
+		sampleRate = _sampleRate;
+		calculateCoefficients();
+
+		memset(&splitState[0][0][0], 0, sizeof(splitState));
+		memset(&allpassState[0][0][0], 0, sizeof(allpassState));
+		return true;
+	}
+
+	/** return false: this object only processes samples */
+	virtual bool canProcessAudioFrame() { return false; }
+
+	/** this does nothing for this object, see processCrossoverFrame( ) below */
+	/**
+	\param xn input
+	\return the processed sample
+	*/
+	virtual double processAudioSample(double xn)
+	{
+		return xn;
+	}
+
+	/** split one frame into bands */
+	/**
+	\param input input frame, one sample per channel
+	\param bandOutputs band outputs; bandOutputs[band*MAX_CROSSOVER_CHANNELS + channel]
+	\param numChannels number of channels, up to MAX_CROSSOVER_CHANNELS
+	*/
+	inline void processCrossoverFrame(const double* input, double* bandOutputs, uint32_t numChannels)
+	{
+		// --- split lanes: [LP ch0, LP ch1, HP ch0, HP ch1]
+		double split[SPLIT_LANES];
+		double remainder[MAX_CROSSOVER_CHANNELS];
+		for (unsigned int ch = 0; ch < MAX_CROSSOVER_CHANNELS; ch++)
+			remainder[ch] = ch < numChannels ? input[ch] : 0.0;
+
+		unsigned int numSplits = parameters.numBands - 1;
+		for (unsigned int k = 0; k < numSplits; k++)
+		{
+			for (unsigned int ch = 0; ch < MAX_CROSSOVER_CHANNELS; ch++)
+			{
+				split[ch] = remainder[ch];
+				split[MAX_CROSSOVER_CHANNELS + ch] = remainder[ch];
+			}
+
+			// --- LR4 = two cascaded Butterworth sections
+			processSplitLanes(&splitCoeffs[k][0][0], &splitState[k][0][0], split);
+			processSplitLanes(&splitCoeffs[k][0][0], &splitState[k][1][0], split);
+
+			for (unsigned int ch = 0; ch < MAX_CROSSOVER_CHANNELS; ch++)
+			{
+				bandOutputs[k*MAX_CROSSOVER_CHANNELS + ch] = split[ch];
+				remainder[ch] = split[MAX_CROSSOVER_CHANNELS + ch];
+			}
+		}
+
+		// --- last band is the remaining upper band
+		for (unsigned int ch = 0; ch < MAX_CROSSOVER_CHANNELS; ch++)
+			bandOutputs[numSplits*MAX_CROSSOVER_CHANNELS + ch] = remainder[ch];
+
+		// --- phase compensation: bands below split j all share the allpass of split j
+		for (unsigned int j = 1; j < numSplits; j++)
+			processAllpassLanes(&allpassCoeffs[j][0], &allpassState[j][0][0], bandOutputs, j*MAX_CROSSOVER_CHANNELS);
+	}
+
+	/** split a block into bands */
+	/**
+	\param inputBuffers input buffers, one per channel
+	\param bandBuffers band output buffers; bandBuffers[band*numChannels + channel]
+	\param numChannels number of channels, up to MAX_CROSSOVER_CHANNELS
+	\param blockSize number of samples in each buffer
+	*/
+	void processAudioBlock(const double* const* inputBuffers, double** bandBuffers, uint32_t numChannels, uint32_t blockSize)
+	{
+		numChannels = numChannels > MAX_CROSSOVER_CHANNELS ? MAX_CROSSOVER_CHANNELS : numChannels;
+
+		double input[MAX_CROSSOVER_CHANNELS] = { 0.0 };
+		double bandOutputs[MAX_CROSSOVER_BANDS*MAX_CROSSOVER_CHANNELS] = { 0.0 };
+		for (uint32_t i = 0; i < blockSize; i++)
+		{
+			for (uint32_t ch = 0; ch < numChannels; ch++)
+				input[ch] = inputBuffers[ch][i];
+
+			processCrossoverFrame(input, bandOutputs, numChannels);
+
+			for (uint32_t band = 0; band < parameters.numBands; band++)
+			{
+				for (uint32_t ch = 0; ch < numChannels; ch++)
+					bandBuffers[band*numChannels + ch][i] = bandOutputs[band*MAX_CROSSOVER_CHANNELS + ch];
+			}
+		}
+	}
+
+	/** get parameters: note use of custom structure for passing param data */
+	/**
+	\return LRCrossoverBankParameters custom data structure
+	*/
+	LRCrossoverBankParameters getParameters()
+	{
+		return parameters;
+	}
+
+	/** set parameters: note use of custom structure for passing param data */
+	/**
+	\param LRCrossoverBankParameters custom data structure
+	*/
+	void setParameters(const LRCrossoverBankParameters& _parameters)
+	{
+		parameters = _parameters;
+		parameters.numBands = parameters.numBands < 2 ? 2 : parameters.numBands;
+		parameters.numBands = parameters.numBands > MAX_CROSSOVER_BANDS ? MAX_CROSSOVER_BANDS : parameters.numBands;
+
+		calculateCoefficients();
+	}
+
+	/** get the number of bands */
+	unsigned int getNumBands() { return parameters.numBands; }
+
+protected:
+	enum { SPLIT_LANES = 2 * MAX_CROSSOVER_CHANNELS };
+
+	LRCrossoverBankParameters parameters; ///< parameters for the object
+	double sampleRate = 44100.0; ///< current sample rate
+
+	// --- SoA coefficient and state storage
+	double splitCoeffs[MAX_CROSSOVER_BANDS - 1][numCoeffs][SPLIT_LANES] = { { { 0.0 } } };	///< [split][a0..b2][lane]
+	double splitState[MAX_CROSSOVER_BANDS - 1][2][2 * SPLIT_LANES] = { { { 0.0 } } };		///< [split][section][z1 lanes, z2 lanes]
+	double allpassCoeffs[MAX_CROSSOVER_BANDS - 1][numCoeffs] = { { 0.0 } };				///< [split][a0..b2]
+	double allpassState[MAX_CROSSOVER_BANDS - 1][2][MAX_CROSSOVER_BANDS*MAX_CROSSOVER_CHANNELS] = { { { 0.0 } } }; ///< [split][z1, z2][band lanes]
+
+	/** LP and HP lanes of one split section; each lane has its own coefficients */
+	inline void processSplitLanes(const double* coeffs, double* state, double* x)
+	{
+		double* z1 = state;
+		double* z2 = state + SPLIT_LANES;
+		for (unsigned int l = 0; l < SPLIT_LANES; l++)
+		{
+			double xn = x[l];
+			double yn = coeffs[a0*SPLIT_LANES + l] * xn + z1[l];
+			z1[l] = coeffs[a1*SPLIT_LANES + l] * xn - coeffs[b1*SPLIT_LANES + l] * yn + z2[l];
+			z2[l] = coeffs[a2*SPLIT_LANES + l] * xn - coeffs[b2*SPLIT_LANES + l] * yn;
+			x[l] = yn;
+		}
+	}
+
+	/** allpass lanes that share one set of coefficients */
+	inline void processAllpassLanes(const double* coeffs, double* state, double* x, unsigned int numLanes)
+	{
+		double* z1 = state;
+		double* z2 = state + MAX_CROSSOVER_BANDS*MAX_CROSSOVER_CHANNELS;
+		for (unsigned int l = 0; l < numLanes; l++)
+		{
+			double xn = x[l];
+			double yn = coeffs[a0] * xn + z1[l];
+			z1[l] = coeffs[a1] * xn - coeffs[b1] * yn + z2[l];
+			z2[l] = coeffs[a2] * xn - coeffs[b2] * yn;
+			x[l] = yn;
+		}
+	}
+
+	/** calculate the Butterworth LP/HP and matching allpass coefficients for each split */
+	void calculateCoefficients()
+	{
+		double lastFc = 0.0;
+		for (unsigned int k = 0; k < MAX_CROSSOVER_BANDS - 1; k++)
+		{
+			// --- keep splits ascending and below Nyquist
+			double fc = fmax(parameters.splitFrequency[k], lastFc);
+			fc = fmin(fmax(fc, 1.0), 0.49*sampleRate);
+			lastFc = fc;
+
+			// --- see AudioFilter kButterLPF2, kButterHPF2
+			double theta_c = kPi*fc / sampleRate;
+			double C = 1.0 / tan(theta_c);
+			double lpa0 = 1.0 / (1.0 + kSqrtTwo*C + C*C);
+			double lpb1 = 2.0*lpa0 * (1.0 - C*C);
+			double lpb2 = lpa0 * (1.0 - kSqrtTwo*C + C*C);
+
+			C = tan(theta_c);
+			double hpa0 = 1.0 / (1.0 + kSqrtTwo*C + C*C);
+
+			for (unsigned int ch = 0; ch < MAX_CROSSOVER_CHANNELS; ch++)
+			{
+				unsigned int lp = ch;
+				unsigned int hp = MAX_CROSSOVER_CHANNELS + ch;
+				splitCoeffs[k][a0][lp] = lpa0;
+				splitCoeffs[k][a1][lp] = 2.0*lpa0;
+				splitCoeffs[k][a2][lp] = lpa0;
+				splitCoeffs[k][b1][lp] = lpb1;
+				splitCoeffs[k][b2][lp] = lpb2;
+
+				splitCoeffs[k][a0][hp] = hpa0;
+				splitCoeffs[k][a1][hp] = -2.0*hpa0;
+				splitCoeffs[k][a2][hp] = hpa0;
+				splitCoeffs[k][b1][hp] = 2.0*hpa0 * (C*C - 1.0);
+				splitCoeffs[k][b2][hp] = hpa0 * (1.0 - kSqrtTwo*C + C*C);
+			}
+
+			// --- LP4 + HP4 = 2nd order allpass: numerator is the reversed denominator
+			allpassCoeffs[k][a0] = lpb2;
+			allpassCoeffs[k][a1] = lpb1;
+			allpassCoeffs[k][a2] = 1.0;
+			allpassCoeffs[k][b1] = lpb1;
+			allpassCoeffs[k][b2] = lpb2;
+		}
+	}
+};
+
 // --- constants
 const unsigned int TLD_AUDIO_DETECT_MODE_PEAK = 0;
 const unsigned int TLD_AUDIO_DETECT_MODE_MS = 1;
@@ -1800,6 +2235,7 @@ struct AudioDetectorParameters
 		detectMode = params.detectMode;
 		detect_dB = params.detect_dB;
 		clampToUnityMax = params.clampToUnityMax;
+		fastMath = params.fastMath;
 		return *this;
 	}
 
@@ -1809,6 +2245,7 @@ struct AudioDetectorParameters
 	unsigned int  detectMode = 0;///< detect mode, see TLD_ constants above
 	bool detect_dB = false;	///< detect in dB  DEFAULT  = false (linear NOT log)
 	bool clampToUnityMax = true;///< clamp output to 1.0 (set false for true log detectors)
+	bool fastMath = false;		///< use fastLog2( ) for dB output; max error 0.0001 dB
 };
 
 /**
@@ -1884,6 +2321,10 @@ public:
 		// --- store envelope prior to sqrt for RMS version
 		lastEnvelope = currEnvelope;
 
+		// --- fast log: the RMS sqrt is folded into the dB scaling
+		if (audioDetectorParameters.fastMath && audioDetectorParameters.detect_dB)
+			return envelopeToFast_dB(currEnvelope, audioDetectorParameters.detectMode == TLD_AUDIO_DETECT_MODE_RMS);
+
 		// --- if RMS, do the SQRT
 		if (audioDetectorParameters.detectMode == TLD_AUDIO_DETECT_MODE_RMS)
 			currEnvelope = pow(currEnvelope, 0.5);
@@ -1902,6 +2343,52 @@ public:
 		return 20.0*log10(currEnvelope);
 	}
 
+	/** run the detector over a block; the mode tests are made once per block */
+	/**
+	\param input input buffer
+	\param detectOutput output buffer for the detected values, same units as processAudioSample( )
+	\param blockSize number of samples
+	*/
+	void processAudioBlock(const double* input, double* detectOutput, uint32_t blockSize)
+	{
+		bool squareInput = audioDetectorParameters.detectMode == TLD_AUDIO_DETECT_MODE_MS ||
+						   audioDetectorParameters.detectMode == TLD_AUDIO_DETECT_MODE_RMS;
+		bool rms = audioDetectorParameters.detectMode == TLD_AUDIO_DETECT_MODE_RMS;
+		bool clamp = audioDetectorParameters.clampToUnityMax;
+		bool detect_dB = audioDetectorParameters.detect_dB;
+		bool fast_dB = detect_dB && audioDetectorParameters.fastMath;
+
+		double envelope = lastEnvelope;
+		for (uint32_t i = 0; i < blockSize; i++)
+		{
+			double in = fabs(input[i]);
+			if (squareInput)
+				in *= in;
+
+			// --- attack or release
+			if (in > envelope)
+				envelope = attackTime * (envelope - in) + in;
+			else
+				envelope = releaseTime * (envelope - in) + in;
+
+			checkFloatUnderflow(envelope);
+			if (clamp)
+				envelope = fmin(envelope, 1.0);
+			envelope = fmax(envelope, 0.0);
+
+			if (fast_dB)
+				detectOutput[i] = envelopeToFast_dB(envelope, rms);
+			else
+			{
+				double detect = rms ? pow(envelope, 0.5) : envelope;
+				if (detect_dB)
+					detect = detect <= 0 ? -96.0 : 20.0*log10(detect);
+				detectOutput[i] = detect;
+			}
+		}
+		lastEnvelope = envelope;
+	}
+
 	/** get parameters: note use of custom structure for passing param data */
 	/**
 	\return AudioDetectorParameters custom data structure
@@ -1945,6 +2432,16 @@ protected:
 	double sampleRate = 44100;	///< stored sample rate
 	double lastEnvelope = 0.0;	///< output register
 
+	/** envelope to dB with fastRaw2dB( ); for RMS, 20*log10(sqrt(x)) = 10*log10(x) */
+	inline double envelopeToFast_dB(double envelope, bool rms)
+	{
+		if (envelope <= 0)
+			return -96.0;
+
+		double detect_dB = fastRaw2dB(envelope);
+		return rms ? 0.5*detect_dB : detect_dB;
+	}
+
 	/** set our internal atack time coefficients based on times and sample rate */
 	void setAttackTime(double attack_in_ms, bool forceCalc = false);
 
@@ -1974,52 +2471,254 @@ enum class dynamicsProcessorType { kCompressor, kDownwardExpander };
 
 
 /**
-\struct DynamicsProcessorParameters
+\class SlidingWindowMax
 \ingroup FX-Objects
 \brief
-Custom parameter structure for the DynamicsProcessor object. Ths struct includes all information needed from GUI controls.
+The SlidingWindowMax object finds the maximum of the last N input values in amortized O(1) time per sample with a
+monotonic deque: each value is pushed once and popped at most once. The deque is stored in preallocated
+power-of-two ring arrays so no allocation happens on the audio thread. NOTE - this is NOT an IAudioSignalProcessor.
 
-\author Will Pirkle http://www.willpirkle.com
-\remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
 \version Revision : 1.0
-\date Date : 2018 / 09 / 7
 */
-struct DynamicsProcessorParameters
+class SlidingWindowMax
 {
-	DynamicsProcessorParameters() {}
-	/** all FXObjects parameter objects require overloaded= operator so remember to add new entries if you add new variables. */
-	DynamicsProcessorParameters& operator=(const DynamicsProcessorParameters& params)	// need this override for collections to work
+public:
+	SlidingWindowMax() {}	/* C-TOR */
+	~SlidingWindowMax() {}	/* D-TOR */
+
+	/** create the deque for windows up to maxWindowLength; do NOT call from realtime audio thread */
+	void createWindow(unsigned int maxWindowLength)
 	{
-		if (this == &params)
-			return *this;
+		// --- find nearest power of 2 that holds the whole window
+		capacity = (unsigned int)(pow(2, ceil(log(maxWindowLength + 1) / log(2))));
+		wrapMask = capacity - 1;
+		values.reset(new double[capacity]);
+		indexes.reset(new unsigned int[capacity]);
+		maxLength = maxWindowLength;
+		windowLength = windowLength > maxLength ? maxLength : windowLength;
+		windowLength = windowLength < 1 ? 1 : windowLength;
+		flush();
+	}
 
-		ratio = params.ratio;
-		threshold_dB = params.threshold_dB;
-		kneeWidth_dB = params.kneeWidth_dB;
-		hardLimitGate = params.hardLimitGate;
-		softKnee = params.softKnee;
-		enableSidechain = params.enableSidechain;
-		calculation = params.calculation;
-		attackTime_mSec = params.attackTime_mSec;
-		releaseTime_mSec = params.releaseTime_mSec;
-		outputGain_dB = params.outputGain_dB;
-		// --- NOTE: do not set outbound variables??
-		gainReduction = params.gainReduction;
-		gainReduction_dB = params.gainReduction_dB;
-		return *this;
+	/** clear the window */
+	void flush()
+	{
+		head = 0;
+		tail = 0;
+		sampleCount = 0;
 	}
 
-	// --- individual parameters
-	double ratio = 50.0;				///< processor I/O gain ratio
-	double threshold_dB = -10.0;		///< threshold in dB
-	double kneeWidth_dB = 10.0;			///< knee width in dB for soft-knee operation
-	bool hardLimitGate = false;			///< threshold in dB
+	/** set the window length in samples, bounded to [1, maxWindowLength]; the window is only cleared if the length changes */
+	void setWindowLength(unsigned int _windowLength)
+	{
+		unsigned int newLength = _windowLength > maxLength ? maxLength : _windowLength;
+		newLength = newLength < 1 ? 1 : newLength;
+		if (newLength == windowLength)
+			return;
+
+		windowLength = newLength;
+		flush();
+	}
+
+	/** get the window length in samples */
+	unsigned int getWindowLength() { return windowLength; }
+
+	/** push a new value and return the maximum of the last windowLength values */
+	double processSample(double xn)
+	{
+		// --- pop older values that can never be the max again
+		while (tail != head && values[(tail - 1) & wrapMask] <= xn)
+			tail--;
+
+		// --- push
+		values[tail & wrapMask] = xn;
+		indexes[tail & wrapMask] = sampleCount;
+		tail++;
+
+		// --- pop the front if it slid out of the window
+		if (sampleCount - indexes[head & wrapMask] >= windowLength)
+			head++;
+
+		sampleCount++;
+
+		// --- front is the max
+		return values[head & wrapMask];
+	}
+
+private:
+	std::unique_ptr<double[]> values = nullptr;			///< deque values
+	std::unique_ptr<unsigned int[]> indexes = nullptr;	///< deque sample indexes
+	unsigned int head = 0;			///< deque front (oldest, largest)
+	unsigned int tail = 0;			///< deque back (one past newest)
+	unsigned int capacity = 0;		///< ring size, power of 2
+	unsigned int wrapMask = 0;		///< must be (capacity - 1)
+	unsigned int sampleCount = 0;	///< running sample index
+	unsigned int windowLength = 1;	///< window length in samples
+	unsigned int maxLength = 0;		///< max window length
+};
+
+const double MAX_LOOKAHEAD_MSEC = 20.0; ///< longest lookahead time for dynamics objects
+
+/**
+\class LookaheadPeakDetector
+\ingroup FX-Objects
+\brief
+The LookaheadPeakDetector object delays the audio by the lookahead time and finds the peak of the detector
+signal over the lookahead window with a SlidingWindowMax, so that the peak is known before it reaches the
+output. In true-peak mode, the inter-sample peaks at 1/4, 1/2 and 3/4 of each sample interval are estimated
+with 4-point Hermite interpolation; this costs one more sample of latency. NOTE - this is NOT an IAudioSignalProcessor.
+
+\version Revision : 1.0
+*/
+class LookaheadPeakDetector
+{
+public:
+	LookaheadPeakDetector() {}	/* C-TOR */
+	~LookaheadPeakDetector() {}	/* D-TOR */
+
+	/** create the delay and window for MAX_LOOKAHEAD_MSEC; do NOT call from realtime audio thread */
+	void reset(double _sampleRate)
+	{
+		if (sampleRate != _sampleRate)
+		{
+			sampleRate = _sampleRate;
+			unsigned int maxLookahead = (unsigned int)(MAX_LOOKAHEAD_MSEC*sampleRate / 1000.0);
+			delayLength = (unsigned int)(pow(2, ceil(log(maxLookahead + 2) / log(2))));
+			delayMask = delayLength - 1;
+			audioDelay.reset(new double[delayLength]);
+			windowMax.createWindow(maxLookahead + 1);
+			setLookahead(lookahead_mSec, truePeak);
+		}
+
+		if (audioDelay)
+			memset(&audioDelay[0], 0, delayLength * sizeof(double));
+		delayWriteIndex = 0;
+		windowMax.flush();
+		memset(&detectHistory[0], 0, 4 * sizeof(double));
+	}
+
+	/** set the lookahead time and true-peak mode */
+	void setLookahead(double _lookahead_mSec, bool _truePeak)
+	{
+		lookahead_mSec = fmin(fmax(_lookahead_mSec, 0.0), MAX_LOOKAHEAD_MSEC);
+		truePeak = _truePeak;
+		lookahead_Samples = (unsigned int)(lookahead_mSec*sampleRate / 1000.0);
+
+		// --- window covers the delayed sample and all samples ahead of it
+		windowMax.setWindowLength(lookahead_Samples + 1);
+	}
+
+	/** the lookahead time in samples, not including the true-peak sample */
+	unsigned int getLookaheadSamples() { return lookahead_Samples; }
+
+	/** total added latency in samples */
+	unsigned int getLatencyInSamples() { return lookahead_Samples + (truePeak ? 1 : 0); }
+
+	/** push one audio and detector input; returns the delayed audio and the peak |detectInput| over the window */
+	/**
+	\param xn audio input
+	\param detectInput detector input (usually xn, or a sidechain)
+	\param windowPeak returns the peak over the lookahead window
+	\return the delayed audio sample
+	*/
+	double processAudioSample(double xn, double detectInput, double& windowPeak)
+	{
+		double peak = fabs(detectInput);
+
+		if (truePeak)
+		{
+			// --- shift history; peak is found for the interval ending one sample ago
+			detectHistory[0] = detectHistory[1];
+			detectHistory[1] = detectHistory[2];
+			detectHistory[2] = detectHistory[3];
+			detectHistory[3] = detectInput;
+
+			peak = fabs(detectHistory[2]);
+			for (unsigned int i = 1; i < 4; i++)
+			{
+				double interp = doHermiteInterpolation(detectHistory[0], detectHistory[1],
+													   detectHistory[2], detectHistory[3], 0.25*i);
+				peak = fmax(peak, fabs(interp));
+			}
+		}
+
+		windowPeak = windowMax.processSample(peak);
+
+		// --- write-before-read so that a delay of 0 is allowed
+		audioDelay[delayWriteIndex] = xn;
+		double yn = audioDelay[(delayWriteIndex - getLatencyInSamples()) & delayMask];
+		delayWriteIndex = (delayWriteIndex + 1) & delayMask;
+		return yn;
+	}
+
+private:
+	std::unique_ptr<double[]> audioDelay = nullptr;	///< lookahead delay, power of 2
+	unsigned int delayLength = 0;		///< lookahead delay length
+	unsigned int delayMask = 0;			///< must be (delayLength - 1)
+	unsigned int delayWriteIndex = 0;	///< lookahead delay write index
+	SlidingWindowMax windowMax;			///< peak over lookahead window
+	double detectHistory[4] = { 0.0 };	///< last four detector inputs for true-peak
+	double sampleRate = 0.0;			///< current sample rate
+	double lookahead_mSec = 5.0;		///< lookahead time
+	unsigned int lookahead_Samples = 0;	///< lookahead time in samples
+	bool truePeak = false;				///< true-peak detection flag
+};
+
+/**
+\struct DynamicsProcessorParameters
+\ingroup FX-Objects
+\brief
+Custom parameter structure for the DynamicsProcessor object. Ths struct includes all information needed from GUI controls.
+
+\author Will Pirkle http://www.willpirkle.com
+\remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
+\version Revision : 1.0
+\date Date : 2018 / 09 / 7
+*/
+struct DynamicsProcessorParameters
+{
+	DynamicsProcessorParameters() {}
+	/** all FXObjects parameter objects require overloaded= operator so remember to add new entries if you add new variables. */
+	DynamicsProcessorParameters& operator=(const DynamicsProcessorParameters& params)	// need this override for collections to work
+	{
+		if (this == &params)
+			return *this;
+
+		ratio = params.ratio;
+		threshold_dB = params.threshold_dB;
+		kneeWidth_dB = params.kneeWidth_dB;
+		hardLimitGate = params.hardLimitGate;
+		softKnee = params.softKnee;
+		enableSidechain = params.enableSidechain;
+		calculation = params.calculation;
+		attackTime_mSec = params.attackTime_mSec;
+		releaseTime_mSec = params.releaseTime_mSec;
+		outputGain_dB = params.outputGain_dB;
+		enableLookahead = params.enableLookahead;
+		lookahead_mSec = params.lookahead_mSec;
+		truePeakDetect = params.truePeakDetect;
+		fastMath = params.fastMath;
+		// --- NOTE: do not set outbound variables??
+		gainReduction = params.gainReduction;
+		gainReduction_dB = params.gainReduction_dB;
+		return *this;
+	}
+
+	// --- individual parameters
+	double ratio = 50.0;				///< processor I/O gain ratio
+	double threshold_dB = -10.0;		///< threshold in dB
+	double kneeWidth_dB = 10.0;			///< knee width in dB for soft-knee operation
+	bool hardLimitGate = false;			///< threshold in dB
 	bool softKnee = true;				///< soft knee flag
 	bool enableSidechain = false;		///< enable external sidechain input to object
 	dynamicsProcessorType calculation = dynamicsProcessorType::kCompressor; ///< processor calculation type
 	double attackTime_mSec = 0.0;		///< attack mSec
 	double releaseTime_mSec = 0.0;		///< release mSec
 	double outputGain_dB = 0.0;			///< make up gain
+	bool enableLookahead = false;		///< delay the audio and detect the peak over the lookahead window
+	double lookahead_mSec = 5.0;		///< lookahead time (adds latency), up to MAX_LOOKAHEAD_MSEC
+	bool truePeakDetect = false;		///< detect inter-sample peaks in lookahead mode (adds one sample latency)
+	bool fastMath = false;				///< use fast log/exp approximations in the detector and gain computer
 
 	// --- outbound values, for owner to use gain-reduction metering
 	double gainReduction = 1.0;			///< output value for gain reduction that occurred
@@ -2054,6 +2753,8 @@ public:
 	virtual bool reset(double _sampleRate)
 	{
 		sidechainInputSample = 0.0;
+		lookahead.reset(_sampleRate);
+		lookahead.setLookahead(parameters.lookahead_mSec, parameters.truePeakDetect);
 		detector.reset(_sampleRate);
 		AudioDetectorParameters detectorParams = detector.getParameters();
 		detectorParams.clampToUnityMax = false;
@@ -2087,14 +2788,24 @@ public:
 	*/
 	void setParameters(const DynamicsProcessorParameters& _parameters)
 	{
+		// --- only reconfigure the lookahead when it changes, so the peaks already in the delay are kept
+		bool lookaheadChanged = _parameters.lookahead_mSec != parameters.lookahead_mSec ||
+								_parameters.truePeakDetect != parameters.truePeakDetect;
 		parameters = _parameters;
 
 		AudioDetectorParameters detectorParams = detector.getParameters();
 		detectorParams.attackTime_mSec = parameters.attackTime_mSec;
 		detectorParams.releaseTime_mSec = parameters.releaseTime_mSec;
+		detectorParams.fastMath = parameters.fastMath;
 		detector.setParameters(detectorParams);
+
+		if (lookaheadChanged)
+			lookahead.setLookahead(parameters.lookahead_mSec, parameters.truePeakDetect);
 	}
 
+	/** added latency in samples; report this to the host via PluginBase::setLatencyInSamples( ) */
+	unsigned int getLatencyInSamples() { return parameters.enableLookahead ? lookahead.getLatencyInSamples() : 0; }
+
 	/** process audio using feed-forward dynamics processor flowchart */
 	/*
 		1. detect input signal
@@ -2110,8 +2821,15 @@ public:
 		// --- detect input
 		double detect_dB = 0.0;
 
+		// --- lookahead: delay the audio, detect the peak of the window ahead of it
+		if (parameters.enableLookahead)
+		{
+			double windowPeak = 0.0;
+			xn = lookahead.processAudioSample(xn, parameters.enableSidechain ? sidechainInputSample : xn, windowPeak);
+			detect_dB = detector.processAudioSample(windowPeak);
+		}
 		// --- if using the sidechain, process the aux input
-		if(parameters.enableSidechain)
+		else if(parameters.enableSidechain)
 			detect_dB = detector.processAudioSample(sidechainInputSample);
 		else
 			detect_dB = detector.processAudioSample(xn);
@@ -2120,7 +2838,7 @@ public:
 		double gr = computeGain(detect_dB);
 
 		// --- makeup gain
-		double makeupGain = pow(10.0, parameters.outputGain_dB / 20.0);
+		double makeupGain = parameters.fastMath ? fastDB2Raw(parameters.outputGain_dB) : pow(10.0, parameters.outputGain_dB / 20.0);
 
 		// --- do DCA + makeup gain
 		return xn * gr * makeupGain;
@@ -2129,6 +2847,7 @@ public:
 protected:
 	DynamicsProcessorParameters parameters; ///< object parameters
 	AudioDetector detector; ///< the sidechain audio detector
+	LookaheadPeakDetector lookahead; ///< lookahead delay and window peak
 
 	// --- storage for sidechain audio input (mono only)
 	double sidechainInputSample = 0.0; ///< storage for sidechain sample
@@ -2211,13 +2930,305 @@ protected:
 
 		// --- convert gain; store values for user meters
 		parameters.gainReduction_dB = output_dB - detect_dB;
-		parameters.gainReduction = pow(10.0, (parameters.gainReduction_dB) / 20.0);
+		parameters.gainReduction = parameters.fastMath ? fastDB2Raw(parameters.gainReduction_dB) : pow(10.0, (parameters.gainReduction_dB) / 20.0);
 
 		// --- the current gain coefficient value
 		return parameters.gainReduction;
 	}
 };
 
+/**
+\struct MultibandDynamicsParameters
+\ingroup FX-Objects
+\brief
+Custom parameter structure for the MultibandDynamicsProcessor object. Band settings are arrays indexed
+by band; the split frequencies are shared with the LRCrossoverBank.
+
+\version Revision : 1.0
+*/
+struct MultibandDynamicsParameters
+{
+	MultibandDynamicsParameters() {}
+	/** all FXObjects parameter objects require overloaded= operator so remember to add new entries if you add new variables. */
+	MultibandDynamicsParameters& operator=(const MultibandDynamicsParameters& params)	// need this override for collections to work
+	{
+		if (this == &params)
+			return *this;
+
+		numBands = params.numBands;
+		calculation = params.calculation;
+		rmsDetect = params.rmsDetect;
+		for (unsigned int i = 0; i < MAX_CROSSOVER_BANDS; i++)
+		{
+			if (i < MAX_CROSSOVER_BANDS - 1)
+				splitFrequency[i] = params.splitFrequency[i];
+			ratio[i] = params.ratio[i];
+			threshold_dB[i] = params.threshold_dB[i];
+			kneeWidth_dB[i] = params.kneeWidth_dB[i];
+			attackTime_mSec[i] = params.attackTime_mSec[i];
+			releaseTime_mSec[i] = params.releaseTime_mSec[i];
+			outputGain_dB[i] = params.outputGain_dB[i];
+		}
+		return *this;
+	}
+
+	// --- individual parameters
+	unsigned int numBands = 3;	///< number of bands, 2 to MAX_CROSSOVER_BANDS
+	dynamicsProcessorType calculation = dynamicsProcessorType::kCompressor; ///< processor calculation type (all bands)
+	bool rmsDetect = false;		///< RMS detection; default is peak
+	double splitFrequency[MAX_CROSSOVER_BANDS - 1] = { 200.0, 2000.0, 4000.0, 6000.0, 8000.0, 10000.0, 12000.0 }; ///< ascending split frequencies
+
+	// --- per-band parameters
+	double ratio[MAX_CROSSOVER_BANDS] = { 4.0, 4.0, 4.0, 4.0, 4.0, 4.0, 4.0, 4.0 };					///< processor I/O gain ratio
+	double threshold_dB[MAX_CROSSOVER_BANDS] = { -20.0, -20.0, -20.0, -20.0, -20.0, -20.0, -20.0, -20.0 };	///< threshold in dB
+	double kneeWidth_dB[MAX_CROSSOVER_BANDS] = { 6.0, 6.0, 6.0, 6.0, 6.0, 6.0, 6.0, 6.0 };				///< knee width in dB (compressor); 0 = hard knee
+	double attackTime_mSec[MAX_CROSSOVER_BANDS] = { 10.0, 10.0, 10.0, 10.0, 10.0, 10.0, 10.0, 10.0 };		///< attack mSec
+	double releaseTime_mSec[MAX_CROSSOVER_BANDS] = { 100.0, 100.0, 100.0, 100.0, 100.0, 100.0, 100.0, 100.0 };///< release mSec
+	double outputGain_dB[MAX_CROSSOVER_BANDS] = { 0.0 };	///< make up gain
+};
+
+/**
+\class MultibandDynamicsProcessor
+\ingroup FX-Objects
+\brief
+The MultibandDynamicsProcessor object splits the input with an LRCrossoverBank and runs a compressor or
+downward expander on each band. The detectors (stereo-linked), gain computers and gain stages keep their
+state and coefficients in per-band arrays and are processed in loops over the bands rather than through
+separate AudioDetector and DynamicsProcessor objects; the dB conversions use fastRaw2dB( ) and fastDB2Raw( ).
+
+The gain reduction of each band is available from getGainReduction_dB( ) for metering; after a call
+to processAudioBlock( ) it holds the deepest reduction in the block.
+
+Audio I/O:
+- Processes mono input to mono output, stereo input to stereo output.
+
+Control I/F:
+- Use MultibandDynamicsParameters structure to get/set object params.
+
+\version Revision : 1.0
+*/
+class MultibandDynamicsProcessor : public IAudioSignalProcessor
+{
+public:
+	MultibandDynamicsProcessor() {}	/* C-TOR */
+	~MultibandDynamicsProcessor() {}	/* D-TOR */
+
+	/** reset the crossover and detectors */
+	virtual bool reset(double _sampleRate)
+	{
+		sampleRate = _sampleRate;
+		crossover.reset(_sampleRate);
+		setParameters(parameters);
+
+		for (unsigned int b = 0; b < MAX_CROSSOVER_BANDS; b++)
+		{
+			envelope[b] = 0.0;
+			gainReduction_dB[b] = 0.0;
+		}
+		return true;
+	}
+
+	/** process mono audio */
+	/**
+	\param xn input
+	\return the processed sample
+	*/
+	virtual double processAudioSample(double xn)
+	{
+		// --- processDynamicsFrame( ) always writes both output channels
+		double output[2] = { 0.0 };
+		processDynamicsFrame(&xn, output, 1);
+		return output[0];
+	}
+
+	/** return true: this object can process frames */
+	virtual bool canProcessAudioFrame() { return true; }
+
+	/** process mono or stereo frame */
+	/**
+	\param inputFrame input frame of channels
+	\param outputFrame output frame of channels
+	\param inputChannels number of input channels
+	\param outputChannels number of output channels
+	\return true if processed
+	*/
+	virtual bool processAudioFrame(const float* inputFrame,
+								   float* outputFrame,
+								   uint32_t inputChannels,
+								   uint32_t outputChannels)
+	{
+		if (inputChannels == 0 || outputChannels == 0)
+			return false;
+
+		uint32_t numChannels = inputChannels > 1 && outputChannels > 1 ? 2 : 1;
+		double input[2] = { inputFrame[0], inputChannels > 1 ? inputFrame[1] : inputFrame[0] };
+		double output[2] = { 0.0 };
+		processDynamicsFrame(input, output, numChannels);
+
+		for (uint32_t ch = 0; ch < outputChannels && ch < 2; ch++)
+			outputFrame[ch] = (float)output[numChannels > 1 ? ch : 0];
+
+		return true;
+	}
+
+	/** process a block of mono or stereo audio */
+	/**
+	\param inputBuffers input channel buffers
+	\param outputBuffers output channel buffers
+	\param inputChannels number of input channels
+	\param outputChannels number of output channels
+	\param blockSize number of samples in the block
+	\return true if processed
+	*/
+	bool processAudioBlock(const float* const* inputBuffers, float** outputBuffers,
+						   uint32_t inputChannels, uint32_t outputChannels, uint32_t blockSize)
+	{
+		if (inputChannels == 0 || outputChannels == 0)
+			return false;
+
+		uint32_t numChannels = inputChannels > 1 && outputChannels > 1 ? 2 : 1;
+		double blockReduction_dB[MAX_CROSSOVER_BANDS] = { 0.0 };
+		double input[2] = { 0.0 };
+		double output[2] = { 0.0 };
+
+		for (uint32_t n = 0; n < blockSize; n++)
+		{
+			input[0] = inputBuffers[0][n];
+			input[1] = inputChannels > 1 ? inputBuffers[1][n] : input[0];
+
+			processDynamicsFrame(input, output, numChannels);
+
+			outputBuffers[0][n] = (float)output[0];
+			if (outputChannels > 1)
+				outputBuffers[1][n] = (float)output[numChannels > 1 ? 1 : 0];
+
+			// --- track deepest reduction for meters
+			for (unsigned int b = 0; b < numBands; b++)
+				blockReduction_dB[b] = fmin(blockReduction_dB[b], gainReduction_dB[b]);
+		}
+
+		for (unsigned int b = 0; b < numBands; b++)
+			gainReduction_dB[b] = blockReduction_dB[b];
+
+		return true;
+	}
+
+	/** get the gain reduction in dB for a band (0 or negative) */
+	double getGainReduction_dB(unsigned int band) { return band < MAX_CROSSOVER_BANDS ? gainReduction_dB[band] : 0.0; }
+
+	/** get the array of gain reduction values, one per band, for metering */
+	const double* getGainReductionArray_dB() { return &gainReduction_dB[0]; }
+
+	/** get parameters: note use of custom structure for passing param data */
+	/**
+	\return MultibandDynamicsParameters custom data structure
+	*/
+	MultibandDynamicsParameters getParameters() { return parameters; }
+
+	/** set parameters: note use of custom structure for passing param data */
+	/**
+	\param MultibandDynamicsParameters custom data structure
+	*/
+	void setParameters(const MultibandDynamicsParameters& _parameters)
+	{
+		parameters = _parameters;
+
+		// --- crossover
+		LRCrossoverBankParameters crossoverParams = crossover.getParameters();
+		crossoverParams.numBands = parameters.numBands;
+		for (unsigned int i = 0; i < MAX_CROSSOVER_BANDS - 1; i++)
+			crossoverParams.splitFrequency[i] = parameters.splitFrequency[i];
+		crossover.setParameters(crossoverParams);
+		numBands = crossover.getNumBands();
+
+		// --- band coefficients
+		bool compressor = parameters.calculation == dynamicsProcessorType::kCompressor;
+		for (unsigned int b = 0; b < MAX_CROSSOVER_BANDS; b++)
+		{
+			// --- same time constants as AudioDetector
+			attackCoeff[b] = exp(TLD_AUDIO_ENVELOPE_ANALOG_TC / (parameters.attackTime_mSec[b] * sampleRate * 0.001));
+			releaseCoeff[b] = exp(TLD_AUDIO_ENVELOPE_ANALOG_TC / (parameters.releaseTime_mSec[b] * sampleRate * 0.001));
+
+			threshold_dB[b] = parameters.threshold_dB[b];
+			halfKnee_dB[b] = compressor ? 0.5*fmax(parameters.kneeWidth_dB[b], 0.0) : 0.0;
+			slope[b] = compressor ? (1.0 / parameters.ratio[b]) - 1.0 : parameters.ratio[b] - 1.0;
+			makeupGain_dB[b] = parameters.outputGain_dB[b];
+		}
+		compress = compressor;
+	}
+
+protected:
+	MultibandDynamicsParameters parameters; ///< object parameters
+	LRCrossoverBank crossover;				///< band splitter
+	double sampleRate = 44100.0;			///< current sample rate
+	unsigned int numBands = 3;				///< current number of bands
+	bool compress = true;					///< compressor or downward expander
+
+	// --- per-band SoA state and coefficients
+	double envelope[MAX_CROSSOVER_BANDS] = { 0.0 };		///< detector output registers
+	double attackCoeff[MAX_CROSSOVER_BANDS] = { 0.0 };		///< detector attack coefficients
+	double releaseCoeff[MAX_CROSSOVER_BANDS] = { 0.0 };	///< detector release coefficients
+	double threshold_dB[MAX_CROSSOVER_BANDS] = { 0.0 };	///< thresholds
+	double halfKnee_dB[MAX_CROSSOVER_BANDS] = { 0.0 };		///< half the knee width
+	double slope[MAX_CROSSOVER_BANDS] = { 0.0 };			///< gain computer slope: 1/ratio - 1 or ratio - 1
+	double makeupGain_dB[MAX_CROSSOVER_BANDS] = { 0.0 };	///< makeup gains
+	double gainReduction_dB[MAX_CROSSOVER_BANDS] = { 0.0 };///< outbound gain reduction, for meters
+
+	/** split, detect, compute gain and recombine one frame */
+	inline void processDynamicsFrame(const double* input, double* output, uint32_t numChannels)
+	{
+		double bands[MAX_CROSSOVER_BANDS*MAX_CROSSOVER_CHANNELS];
+		crossover.processCrossoverFrame(input, bands, numChannels);
+
+		// --- stereo-linked detector input: peak = max(|L|, |R|), RMS = mean square
+		double detect[MAX_CROSSOVER_BANDS];
+		for (unsigned int b = 0; b < numBands; b++)
+		{
+			double L = bands[b*MAX_CROSSOVER_CHANNELS];
+			double R = numChannels > 1 ? bands[b*MAX_CROSSOVER_CHANNELS + 1] : L;
+			detect[b] = parameters.rmsDetect ? 0.5*(L*L + R*R) : fmax(fabs(L), fabs(R));
+		}
+
+		// --- envelopes
+		for (unsigned int b = 0; b < numBands; b++)
+		{
+			double coeff = detect[b] > envelope[b] ? attackCoeff[b] : releaseCoeff[b];
+			double env = coeff*(envelope[b] - detect[b]) + detect[b];
+			envelope[b] = env < kSmallestPositiveFloatValue ? 0.0 : env;
+		}
+
+		// --- gain computer in dB
+		double dBScale = parameters.rmsDetect ? 0.5 : 1.0;
+		for (unsigned int b = 0; b < numBands; b++)
+		{
+			double detect_dB = envelope[b] > 0.0 ? dBScale*fastRaw2dB(envelope[b]) : -96.0;
+			double over = detect_dB - threshold_dB[b];
+			double drive = 0.0;
+
+			if (compress)
+			{
+				// --- soft knee: quadratic in the knee, linear above it
+				double knee = over + halfKnee_dB[b];
+				drive = over > halfKnee_dB[b] ? over : (knee > 0.0 ? knee*knee / (4.0*halfKnee_dB[b]) : 0.0);
+			}
+			else
+				drive = over < 0.0 ? over : 0.0;
+
+			gainReduction_dB[b] = slope[b] * drive;
+		}
+
+		// --- apply gains and recombine
+		output[0] = 0.0;
+		output[1] = 0.0;
+		for (unsigned int b = 0; b < numBands; b++)
+		{
+			double gain = fastDB2Raw(gainReduction_dB[b] + makeupGain_dB[b]);
+			output[0] += gain*bands[b*MAX_CROSSOVER_CHANNELS];
+			output[1] += gain*bands[b*MAX_CROSSOVER_CHANNELS + 1];
+		}
+	}
+};
+
 /**
 \class LinearBuffer
 \ingroup FX-Objects
@@ -2277,6 +3288,21 @@ private:
 };
 
 
+/**
+\enum delayInterpolation
+\ingroup Constants-Enums
+\brief
+Use this strongly typed enum to set the fractional delay interpolation used by the CircularBuffer.
+The 4-point Hermite and Lagrange kernels need one newer and one older sample than linear, so delays
+of less than one sample revert to linear interpolation. The allpass interpolator is recursive and
+must be read exactly once per sample interval.
+
+- enum class delayInterpolation { kLinear, kHermite, kLagrange4, kAllpass };
+
+\version Revision : 1.0
+*/
+enum class delayInterpolation { kLinear, kHermite, kLagrange4, kAllpass };
+
 /**
 \class CircularBuffer
 \ingroup FX-Objects
@@ -2339,51 +3365,187 @@ public:
 		writeIndex &= wrapMask;
 	}
 
+	/** write a block of values into the buffer; use with readBufferBlock( ) for feed-forward delays */
+	void writeBufferBlock(const T* input, unsigned int blockSize)
+	{
+		for (unsigned int i = 0; i < blockSize; i++)
+		{
+			buffer[writeIndex++] = input[i];
+			writeIndex &= wrapMask;
+		}
+	}
+
 	/** read an arbitrary location that is delayInSamples old */
 	T readBuffer(int delayInSamples)//, bool readBeforeWrite = true)
 	{
-		// --- subtract to make read index
-		//     note: -1 here is because we read-before-write,
-		//           so the *last* write location is what we use for the calculation
-		int readIndex = (writeIndex - 1) - delayInSamples;
-
-		// --- autowrap index
-		readIndex &= wrapMask;
-
-		// --- read it
-		return buffer[readIndex];
+		return readAtWritePosition(writeIndex, delayInSamples);
 	}
 
 	/** read an arbitrary location that includes a fractional sample */
 	T readBuffer(double delayInFractionalSamples)
 	{
-		// --- truncate delayInFractionalSamples and read the int part
-		T y1 = readBuffer((int)delayInFractionalSamples);
-
-		// --- if no interpolation, just return value
-		if (!interpolate) return y1;
+		// --- if no interpolation, just truncate and return value
+		if (!interpolate) return readBuffer((int)delayInFractionalSamples);
 
 		// --- else do interpolation
-		//
-		// --- read the sample at n+1 (one sample OLDER)
-		T y2 = readBuffer((int)delayInFractionalSamples + 1);
-
-		// --- get fractional part
-		double fraction = delayInFractionalSamples - (int)delayInFractionalSamples;
-
-		// --- do the interpolation (you could try different types here)
-		return doLinearInterpolation(y1, y2, fraction);
+		switch (interpolationType)
+		{
+			case delayInterpolation::kHermite:
+				return readHermite(writeIndex, delayInFractionalSamples);
+			case delayInterpolation::kLagrange4:
+				return readLagrange4(writeIndex, delayInFractionalSamples);
+			case delayInterpolation::kAllpass:
+				return readAllpass(writeIndex, delayInFractionalSamples);
+			default:
+				return readLinear(writeIndex, delayInFractionalSamples);
+		}
 	}
 
-	/** enable or disable interpolation; usually used for diagnostics or in algorithms that require strict integer samples times */
-	void setInterpolate(bool b) { interpolate = b; }
+	/** read a block of fractional delay times in one pass; the block of input samples must already
+	    have been written with writeBufferBlock( ) so that delaysInFractionalSamples[i] is measured from
+	    the write location of sample i, exactly as if readBuffer( ) was called before each write.
+	    The interpolation type is decoded once per block; the buffer must be at least
+	    (blockSize + max delay + 2) samples long. */
+	void readBufferBlock(const double* delaysInFractionalSamples, T* output, unsigned int blockSize)
+	{
+		// --- write position of the first sample in the block
+		unsigned int blockStart = writeIndex - blockSize;
 
-private:
+		if (!interpolate)
+		{
+			for (unsigned int i = 0; i < blockSize; i++)
+				output[i] = readAtWritePosition(blockStart + i, (int)delaysInFractionalSamples[i]);
+			return;
+		}
+
+		switch (interpolationType)
+		{
+			case delayInterpolation::kHermite:
+			{
+				for (unsigned int i = 0; i < blockSize; i++)
+					output[i] = readHermite(blockStart + i, delaysInFractionalSamples[i]);
+				break;
+			}
+			case delayInterpolation::kLagrange4:
+			{
+				for (unsigned int i = 0; i < blockSize; i++)
+					output[i] = readLagrange4(blockStart + i, delaysInFractionalSamples[i]);
+				break;
+			}
+			case delayInterpolation::kAllpass:
+			{
+				for (unsigned int i = 0; i < blockSize; i++)
+					output[i] = readAllpass(blockStart + i, delaysInFractionalSamples[i]);
+				break;
+			}
+			default:
+			{
+				for (unsigned int i = 0; i < blockSize; i++)
+					output[i] = readLinear(blockStart + i, delaysInFractionalSamples[i]);
+				break;
+			}
+		}
+	}
+
+	/** enable or disable interpolation; usually used for diagnostics or in algorithms that require strict integer samples times */
+	void setInterpolate(bool b) { interpolate = b; }
+
+	/** set the fractional delay interpolation type; resets the allpass interpolator state */
+	void setInterpolationType(delayInterpolation type)
+	{
+		if (type == interpolationType) return;
+		interpolationType = type;
+		allpassState = 0.0;
+	}
+
+	/** get the fractional delay interpolation type */
+	delayInterpolation getInterpolationType() { return interpolationType; }
+
+private:
 	std::unique_ptr<T[]> buffer = nullptr;	///< smart pointer will auto-delete
 	unsigned int writeIndex = 0;		///> write index
 	unsigned int bufferLength = 1024;	///< must be nearest power of 2
 	unsigned int wrapMask = 1023;		///< must be (bufferLength - 1)
 	bool interpolate = true;			///< interpolation (default is ON)
+	delayInterpolation interpolationType = delayInterpolation::kLinear; ///< interpolation type (default is linear)
+	T allpassState = 0.0;				///< previous output of allpass interpolator
+
+	/** read the location that is delayInSamples old relative to an arbitrary write position */
+	inline T readAtWritePosition(unsigned int writePosition, int delayInSamples)
+	{
+		// --- subtract to make read index
+		//     note: -1 here is because we read-before-write,
+		//           so the *last* write location is what we use for the calculation
+		int readIndex = (writePosition - 1) - delayInSamples;
+
+		// --- autowrap index
+		readIndex &= wrapMask;
+
+		// --- read it
+		return buffer[readIndex];
+	}
+
+	/** 2-point linear interpolation */
+	inline T readLinear(unsigned int writePosition, double delayInFractionalSamples)
+	{
+		int intDelay = (int)delayInFractionalSamples;
+		T y1 = readAtWritePosition(writePosition, intDelay);
+
+		// --- read the sample at n+1 (one sample OLDER)
+		T y2 = readAtWritePosition(writePosition, intDelay + 1);
+
+		return doLinearInterpolation(y1, y2, delayInFractionalSamples - intDelay);
+	}
+
+	/** 4-point Hermite interpolation; needs one NEWER sample, so reverts to linear below 1 sample */
+	inline T readHermite(unsigned int writePosition, double delayInFractionalSamples)
+	{
+		int intDelay = (int)delayInFractionalSamples;
+		if (intDelay < 1)
+			return readLinear(writePosition, delayInFractionalSamples);
+
+		return doHermiteInterpolation(readAtWritePosition(writePosition, intDelay - 1),
+									  readAtWritePosition(writePosition, intDelay),
+									  readAtWritePosition(writePosition, intDelay + 1),
+									  readAtWritePosition(writePosition, intDelay + 2),
+									  delayInFractionalSamples - intDelay);
+	}
+
+	/** 4-point Lagrange interpolation; needs one NEWER sample, so reverts to linear below 1 sample */
+	inline T readLagrange4(unsigned int writePosition, double delayInFractionalSamples)
+	{
+		int intDelay = (int)delayInFractionalSamples;
+		if (intDelay < 1)
+			return readLinear(writePosition, delayInFractionalSamples);
+
+		return doLagrange4Interpolation(readAtWritePosition(writePosition, intDelay - 1),
+										readAtWritePosition(writePosition, intDelay),
+										readAtWritePosition(writePosition, intDelay + 1),
+										readAtWritePosition(writePosition, intDelay + 2),
+										delayInFractionalSamples - intDelay);
+	}
+
+	/** 1st order allpass interpolation; the fraction is kept in [0.5, 1.5) where possible so that
+	    the allpass pole stays well away from z = -1 */
+	inline T readAllpass(unsigned int writePosition, double delayInFractionalSamples)
+	{
+		int intDelay = (int)delayInFractionalSamples;
+		double fraction = delayInFractionalSamples - intDelay;
+		if (fraction < 0.5 && intDelay > 0)
+		{
+			intDelay--;
+			fraction += 1.0;
+		}
+
+		// --- allpass coefficient for a phase delay of fraction samples at DC
+		double eta = (1.0 - fraction) / (1.0 + fraction);
+
+		// --- y(n) = eta*x(n) + x(n-1) - eta*y(n-1)
+		allpassState = eta*readAtWritePosition(writePosition, intDelay) +
+					   readAtWritePosition(writePosition, intDelay + 1) - eta*allpassState;
+
+		return allpassState;
+	}
 };
 
 
@@ -2653,6 +3815,8 @@ of GUI controls. See the book reference for more details.
 */
 enum class delayUpdateType { kLeftAndRight, kLeftPlusRatio };
 
+const unsigned int DELAY_BLOCK_SIZE = 64; ///< max sub-block length for block-processed delays
+
 
 /**
 \struct AudioDelayParameters
@@ -2683,6 +3847,7 @@ struct AudioDelayParameters
 		leftDelay_mSec = params.leftDelay_mSec;
 		rightDelay_mSec = params.rightDelay_mSec;
 		delayRatio_Pct = params.delayRatio_Pct;
+		interpolationType = params.interpolationType;
 
 		return *this;
 	}
@@ -2697,6 +3862,7 @@ struct AudioDelayParameters
 	double leftDelay_mSec = 0.0;	///< left delay time
 	double rightDelay_mSec = 0.0;	///< right delay time
 	double delayRatio_Pct = 100.0;	///< dela ratio: right length = (delayRatio)*(left length)
+	delayInterpolation interpolationType = delayInterpolation::kLinear; ///< fractional delay interpolation
 };
 
 /**
@@ -2844,6 +4010,103 @@ public:
 		return true;
 	}
 
+	/** process a block of audio with per-sample delay times in samples, for modulated delays; without feedback
+	    the delay lines are written once per sub-block and read back with CircularBuffer::readBufferBlock( ),
+	    otherwise each sample is processed with processAudioFrame( ) */
+	/**
+	\param inputBuffers input channel buffers
+	\param outputBuffers output channel buffers
+	\param inputChannels number of input channels
+	\param outputChannels number of output channels
+	\param modDelayInSamples_L left channel delay time for each sample in the block
+	\param modDelayInSamples_R right channel delay time for each sample in the block
+	\param blockSize number of samples in the block
+	\return true if processed
+	*/
+	bool processAudioBlock(const float* const* inputBuffers, float** outputBuffers,
+						   uint32_t inputChannels, uint32_t outputChannels,
+						   const double* modDelayInSamples_L, const double* modDelayInSamples_R,
+						   uint32_t blockSize)
+	{
+		// --- make sure we have input and outputs
+		if (inputChannels == 0 || outputChannels == 0)
+			return false;
+
+		for (uint32_t offset = 0; offset < blockSize; offset += DELAY_BLOCK_SIZE)
+		{
+			uint32_t subBlockSize = blockSize - offset < DELAY_BLOCK_SIZE ? blockSize - offset : DELAY_BLOCK_SIZE;
+			const double* delays_L = modDelayInSamples_L + offset;
+			const double* delays_R = modDelayInSamples_R + offset;
+
+			// --- the whole sub-block must fit behind the write index
+			double maxDelay = 0.0;
+			for (uint32_t i = 0; i < subBlockSize; i++)
+				maxDelay = fmax(maxDelay, fmax(delays_L[i], delays_R[i]));
+
+			bool feedForward = parameters.feedback_Pct == 0.0 &&
+							   parameters.algorithm == delayAlgorithm::kNormal &&
+							   subBlockSize + maxDelay + 3 < bufferLength;
+
+			if (!feedForward)
+			{
+				float inputFrame[2] = { 0.0 };
+				float outputFrame[2] = { 0.0 };
+				for (uint32_t i = 0; i < subBlockSize; i++)
+				{
+					inputFrame[0] = inputBuffers[0][offset + i];
+					inputFrame[1] = inputChannels > 1 ? inputBuffers[1][offset + i] : inputFrame[0];
+					delayInSamples_L = delays_L[i];
+					delayInSamples_R = delays_R[i];
+
+					processAudioFrame(inputFrame, outputFrame, inputChannels, outputChannels);
+
+					outputBuffers[0][offset + i] = outputFrame[0];
+					if (outputChannels > 1)
+						outputBuffers[1][offset + i] = outputFrame[1];
+				}
+				continue;
+			}
+
+			// --- LEFT channel
+			double xn[DELAY_BLOCK_SIZE] = { 0.0 };
+			double yn[DELAY_BLOCK_SIZE] = { 0.0 };
+			for (uint32_t i = 0; i < subBlockSize; i++)
+				xn[i] = inputBuffers[0][offset + i];
+
+			delayBuffer_L.writeBufferBlock(xn, subBlockSize);
+			delayBuffer_L.readBufferBlock(delays_L, yn, subBlockSize);
+
+			for (uint32_t i = 0; i < subBlockSize; i++)
+				outputBuffers[0][offset + i] = dryMix*xn[i] + wetMix*yn[i];
+
+			// --- mono output uses the left channel only
+			if (outputChannels == 1)
+				continue;
+
+			// --- RIGHT channel (duplicate left input if mono-in)
+			if (inputChannels > 1)
+			{
+				for (uint32_t i = 0; i < subBlockSize; i++)
+					xn[i] = inputBuffers[1][offset + i];
+			}
+
+			delayBuffer_R.writeBufferBlock(xn, subBlockSize);
+			delayBuffer_R.readBufferBlock(delays_R, yn, subBlockSize);
+
+			for (uint32_t i = 0; i < subBlockSize; i++)
+				outputBuffers[1][offset + i] = dryMix*xn[i] + wetMix*yn[i];
+		}
+
+		// --- leave the last delay times in place for sample processing
+		if (blockSize > 0)
+		{
+			delayInSamples_L = modDelayInSamples_L[blockSize - 1];
+			delayInSamples_R = modDelayInSamples_R[blockSize - 1];
+		}
+
+		return true;
+	}
+
 	/** get parameters: note use of custom structure for passing param data */
 	/**
 	\return AudioDelayParameters custom data structure
@@ -2865,6 +4128,10 @@ public:
 		// --- save; rest of updates are cheap on CPU
 		parameters = _parameters;
 
+		// --- interpolation
+		delayBuffer_L.setInterpolationType(parameters.interpolationType);
+		delayBuffer_R.setInterpolationType(parameters.interpolationType);
+
 		// --- check update type first:
 		if (parameters.updateType == delayUpdateType::kLeftAndRight)
 		{
@@ -2963,12 +4230,14 @@ struct OscillatorParameters
 
 		waveform = params.waveform;
 		frequency_Hz = params.frequency_Hz;
+		controlRateInterval = params.controlRateInterval;
 		return *this;
 	}
 
 	// --- individual parameters
 	generatorWaveform waveform = generatorWaveform::kTriangle; ///< the current waveform
 	double frequency_Hz = 0.0;	///< oscillator frequency
+	uint32_t controlRateInterval = 1;	///< LFO only: samples between evaluations for renderControlRateOutput( ); 1 = audio rate
 };
 
 /**
@@ -2984,6 +4253,13 @@ Audio I/O:
 Control I/F:
 - Use OscillatorParameters structure to get/set object params.
 
+Control rate operation:
+- renderAudioOutput( ) evaluates the waveform every sample (audio rate)
+- renderControlRateOutput( ) and renderControlRateBlock( ) evaluate it every controlRateInterval samples
+  and ramp linearly in between; the ramp passes exactly through the audio rate values at each evaluation
+- a destination that needs audio rate modulation simply uses an LFO with controlRateInterval = 1
+- if the LFO would complete a cycle or more within one interval, it falls back to audio rate
+
 \author Will Pirkle http://www.willpirkle.com
 \remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
 \version Revision : 1.0
@@ -3005,6 +4281,10 @@ public:
 		modCounter = 0.0;			///< modulo counter [0.0, +1.0]
 		modCounterQP = 0.25;		///<Quad Phase modulo counter [0.0, +1.0]
 
+		// --- control rate ramp restarts
+		controlRateCounter = 0;
+		controlRatePrimed = false;
+
 		return true;
 	}
 
@@ -3024,12 +4304,72 @@ public:
 			// --- update phase inc based on osc freq and fs
 			phaseInc = params.frequency_Hz / sampleRate;
 
+		// --- new ramp on the next sample; frequency and waveform changes are picked up at the next evaluation
+		if (params.controlRateInterval != lfoParameters.controlRateInterval)
+			controlRateCounter = 0;
+
 		lfoParameters = params;
 	}
 
 	/** render a new audio output structure */
 	virtual const SignalGenData renderAudioOutput();
 
+	/** render a new output structure at control rate: the waveform is evaluated every controlRateInterval samples
+	    and the outputs are linearly ramped in between */
+	inline const SignalGenData renderControlRateOutput()
+	{
+		if (!useControlRate())
+			return renderAudioOutput();
+
+		if (controlRateCounter == 0)
+			startControlRateRamp();
+
+		SignalGenData output = controlRateValue;
+		controlRateValue.normalOutput += controlRateInc.normalOutput;
+		controlRateValue.invertedOutput += controlRateInc.invertedOutput;
+		controlRateValue.quadPhaseOutput_pos += controlRateInc.quadPhaseOutput_pos;
+		controlRateValue.quadPhaseOutput_neg += controlRateInc.quadPhaseOutput_neg;
+		controlRateCounter--;
+
+		return output;
+	}
+
+	/** render a block of the normal output at control rate
+	\param output buffer for the normal output
+	\param blockSize number of samples
+	*/
+	void renderControlRateBlock(double* output, uint32_t blockSize)
+	{
+		if (!useControlRate())
+		{
+			for (uint32_t i = 0; i < blockSize; i++)
+				output[i] = renderAudioOutput().normalOutput;
+			return;
+		}
+
+		uint32_t i = 0;
+		while (i < blockSize)
+		{
+			if (controlRateCounter == 0)
+				startControlRateRamp();
+
+			// --- one straight line segment
+			uint32_t count = controlRateCounter < blockSize - i ? controlRateCounter : blockSize - i;
+			double value = controlRateValue.normalOutput;
+			double inc = controlRateInc.normalOutput;
+			for (uint32_t n = 0; n < count; n++)
+				output[i + n] = value + n*inc;
+
+			// --- keep all four outputs on the ramp
+			controlRateValue.normalOutput += count*controlRateInc.normalOutput;
+			controlRateValue.invertedOutput += count*controlRateInc.invertedOutput;
+			controlRateValue.quadPhaseOutput_pos += count*controlRateInc.quadPhaseOutput_pos;
+			controlRateValue.quadPhaseOutput_neg += count*controlRateInc.quadPhaseOutput_neg;
+			controlRateCounter -= count;
+			i += count;
+		}
+	}
+
 protected:
 	// --- parameters
 	OscillatorParameters lfoParameters; ///< obejcgt parameters
@@ -3042,6 +4382,53 @@ protected:
 	double phaseInc = 0.0;				///< phase inc = fo/fs
 	double modCounterQP = 0.25;			///<Quad Phase modulo counter [0.0, +1.0]
 
+	// --- control rate
+	uint32_t controlRateCounter = 0;	///< samples left in the current ramp
+	bool controlRatePrimed = false;		///< controlRateTarget holds a valid evaluation
+	SignalGenData controlRateValue;		///< current ramp value
+	SignalGenData controlRateInc;		///< ramp increment per sample
+	SignalGenData controlRateTarget;	///< evaluation at the end of the ramp
+
+	/** control rate needs an interval > 1 and less than one cycle per interval, since the modulo
+	    counter is only wrapped once per evaluation; otherwise fall back to audio rate and
+	    restart the ramp when control rate becomes usable again */
+	inline bool useControlRate()
+	{
+		if (lfoParameters.controlRateInterval > 1 && fabs(phaseInc)*lfoParameters.controlRateInterval < 1.0)
+			return true;
+
+		controlRateCounter = 0;
+		controlRatePrimed = false;
+		return false;
+	}
+
+	/** evaluate the waveform one interval ahead and set up the ramp toward it */
+	inline void startControlRateRamp()
+	{
+		uint32_t interval = lfoParameters.controlRateInterval;
+		double savedPhaseInc = phaseInc;
+		phaseInc *= interval;
+
+		// --- first ramp: the starting point is evaluated here too
+		if (!controlRatePrimed)
+		{
+			controlRateTarget = renderAudioOutput();
+			controlRatePrimed = true;
+		}
+
+		// --- start from the previous evaluation, so the ramp is exact at each evaluation point
+		controlRateValue = controlRateTarget;
+		controlRateTarget = renderAudioOutput();
+		phaseInc = savedPhaseInc;
+
+		double scale = 1.0 / interval;
+		controlRateInc.normalOutput = (controlRateTarget.normalOutput - controlRateValue.normalOutput)*scale;
+		controlRateInc.invertedOutput = (controlRateTarget.invertedOutput - controlRateValue.invertedOutput)*scale;
+		controlRateInc.quadPhaseOutput_pos = (controlRateTarget.quadPhaseOutput_pos - controlRateValue.quadPhaseOutput_pos)*scale;
+		controlRateInc.quadPhaseOutput_neg = (controlRateTarget.quadPhaseOutput_neg - controlRateValue.quadPhaseOutput_neg)*scale;
+		controlRateCounter = interval;
+	}
+
 	/** check the modulo counter and wrap if needed */
 	inline bool checkAndWrapModulo(double& moduloCounter, double phaseInc)
 	{
@@ -3251,4559 +4638,7336 @@ protected:
 	double sampleRate = 0.0;			///< sample rate
 };
 
-
 /**
-\enum modDelaylgorithm
+\enum noiseType
 \ingroup Constants-Enums
 \brief
-Use this strongly typed enum to easily set modulated delay algorithm.
+Use this strongly typed enum to set the NoiseGenerator output type.
 
-- enum class modDelaylgorithm { kFlanger, kChorus, kVibrato };
+- kWhite: bipolar uniform on [-1.0, +1.0)
+- kPink: Voss-McCartney pink noise (-3dB/octave), approximately [-1.0, +1.0]
+- kUniform: unipolar uniform on [0.0, +1.0)
+- kGaussian: normal distribution, mean = 0.0, standard deviation = 1.0
 
-\author Will Pirkle http://www.willpirkle.com
-\remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
 \version Revision : 1.0
-\date Date : 2018 / 09 / 7
 */
-enum class modDelaylgorithm { kFlanger, kChorus, kVibrato };
+enum class noiseType { kWhite, kPink, kUniform, kGaussian };
 
+const unsigned int NOISE_LANES = 4;			///< independent FastRandom generators in NoiseGenerator
+const unsigned int NOISE_PINK_ROWS = 16;	///< Voss-McCartney rows for pink noise
 
 /**
-\struct ModulatedDelayParameters
+\class NoiseGenerator
 \ingroup FX-Objects
 \brief
-Custom parameter structure for the ModulatedDelay object.
-
-\author Will Pirkle http://www.willpirkle.com
-\remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
-\version Revision : 1.0
-\date Date : 2018 / 09 / 7
-*/
-struct ModulatedDelayParameters
-{
-	ModulatedDelayParameters() {}
-	/** all FXObjects parameter objects require overloaded= operator so remember to add new entries if you add new variables. */
-	ModulatedDelayParameters& operator=(const ModulatedDelayParameters& params)	// need this override for collections to work
-	{
-		if (this == &params)
-			return *this;
-
-		algorithm = params.algorithm;
-		lfoRate_Hz = params.lfoRate_Hz;
-		lfoDepth_Pct = params.lfoDepth_Pct;
-		feedback_Pct = params.feedback_Pct;
-		return *this;
-	}
-
-	// --- individual parameters
-	modDelaylgorithm algorithm = modDelaylgorithm::kFlanger; ///< mod delay algorithm
-	double lfoRate_Hz = 0.0;	///< mod delay LFO rate in Hz
-	double lfoDepth_Pct = 0.0;	///< mod delay LFO depth in %
-	double feedback_Pct = 0.0;	///< feedback in %
-};
+The NoiseGenerator object renders white, pink, uniform or gaussian noise from per-instance FastRandom
+generators; unlike doWhiteNoise( ) it shares no state with other instances, takes no lock, and is
+deterministic for a given seed.
 
-/**
-\class ModulatedDelay
-\ingroup FX-Objects
-\brief
-The ModulatedDelay object implements the three basic algorithms: flanger, chorus, vibrato.
+There are NOISE_LANES independent generators used round-robin, so renderNoiseBlock( ) updates all
+lanes together in a loop that the compiler can vectorize; the block and single-sample outputs are
+the same sequence. The block fill takes any double buffer (the buffers in this library come from
+new[]); it does not need or assume any extra alignment. Pink noise uses the Voss-McCartney algorithm
+with NOISE_PINK_ROWS rows.
 
-Audio I / O :
-	-Processes mono input to mono OR stereo output.
+Audio I/O:
+- Output only object: noise generator.
 
-Control I / F :
-	-Use ModulatedDelayParameters structure to get / set object params.
+Control I/F:
+- setNoiseType(noiseType type), setSeed(uint32_t seed)
 
-\author Will Pirkle http ://www.willpirkle.com
-\remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed.by Will Pirkle
 \version Revision : 1.0
-\date Date : 2018 / 09 / 7
 */
-class ModulatedDelay : public IAudioSignalProcessor
+class NoiseGenerator : public IAudioSignalGenerator
 {
 public:
-	ModulatedDelay() {
-	}		/* C-TOR */
-	~ModulatedDelay() {}	/* D-TOR */
+	NoiseGenerator(uint32_t seed = 22222) { setSeed(seed); }	/* C-TOR */
+	virtual ~NoiseGenerator() {}	/* D-TOR */
 
-public:
-	/** reset members to initialized state */
+	/** restart the sequence from the current seed */
 	virtual bool reset(double _sampleRate)
 	{
-		// --- create new buffer, 100mSec long
-		delay.reset(_sampleRate);
-		delay.createDelayBuffers(_sampleRate, 100.0);
+		setSeed(seed);
+		return true;
+	}
 
-		// --- lfo
-		lfo.reset(_sampleRate);
-		OscillatorParameters params = lfo.getParameters();
-		params.waveform = generatorWaveform::kTriangle;
-		lfo.setParameters(params);
+	/** set the seed; each lane is seeded from it with a splitmix32 hash */
+	void setSeed(uint32_t _seed)
+	{
+		seed = _seed;
+		uint32_t hash = seed;
+		for (unsigned int l = 0; l < NOISE_LANES; l++)
+		{
+			hash += 0x9E3779B9;
+			uint32_t z = hash;
+			z = (z ^ (z >> 16)) * 0x85EBCA6B;
+			z = (z ^ (z >> 13)) * 0xC2B2AE35;
+			z ^= z >> 16;
+			lanes[l].setSeed(z);
+		}
+		lane = 0;
 
-		return true;
+		// --- clear pink noise rows
+		pinkCounter = 0;
+		pinkRunningSum = 0.0;
+		for (unsigned int r = 0; r < NOISE_PINK_ROWS; r++)
+			pinkRows[r] = 0.0;
+		hasSpareGaussian = false;
 	}
 
-	/** process input sample */
-	/**
-	\param xn input
-	\return the processed sample
-	*/
-	virtual double processAudioSample(double xn)
+	/** set the output type */
+	void setNoiseType(noiseType _type) { type = _type; }
+
+	/** get the output type */
+	noiseType getNoiseType() { return type; }
+
+	/** render one noise sample; normal and inverted outputs are set */
+	virtual const SignalGenData renderAudioOutput()
 	{
-		float input = xn;
-		float output = 0.0;
-		processAudioFrame(&input, &output, 1, 1);
+		SignalGenData output;
+		output.normalOutput = renderNoiseSample();
+		output.invertedOutput = -output.normalOutput;
 		return output;
 	}
 
-	/** return true: this object can process frames */
-	virtual bool canProcessAudioFrame() { return true; }
+	/** render one noise sample */
+	inline double renderNoiseSample()
+	{
+		switch (type)
+		{
+			case noiseType::kPink: return pinkSample(nextBipolar(), nextBipolar());
+			case noiseType::kUniform: return nextUnipolar();
+			case noiseType::kGaussian: return gaussianSample();
+			default: return nextBipolar();
+		}
+	}
 
-	/** process STEREO audio delay of frames */
-	virtual bool processAudioFrame(const float* inputFrame,		/* ptr to one frame of data: pInputFrame[0] = left, pInputFrame[1] = right, etc...*/
-		float* outputFrame,
-		uint32_t inputChannels,
-		uint32_t outputChannels)
+	/** fill a buffer with noise */
+	/**
+	\param output output buffer
+	\param blockSize number of samples
+	*/
+	void renderNoiseBlock(double* output, uint32_t blockSize)
 	{
-		// --- make sure we have input and outputs
-		if (inputChannels == 0 || outputChannels == 0)
-			return false;
+		if (type == noiseType::kWhite || type == noiseType::kUniform)
+		{
+			// --- step single samples until lane 0 is next so the block lines up with the lanes
+			uint32_t i = 0;
+			for (; i < blockSize && lane != 0; i++)
+				output[i] = renderNoiseSample();
 
-		// --- render LFO
-		SignalGenData lfoOutput = lfo.renderAudioOutput();
+			double scale = type == noiseType::kWhite ? (1.0 / 2147483648.0) : (1.0 / 4294967296.0);
+			bool bipolar = type == noiseType::kWhite;
 
-		// --- setup delay modulation
-		AudioDelayParameters params = delay.getParameters();
-		double minDelay_mSec = 0.0;
-		double maxDepth_mSec = 0.0;
+			for (; i + NOISE_LANES <= blockSize; i += NOISE_LANES)
+			{
+				// --- all lanes together
+				for (unsigned int l = 0; l < NOISE_LANES; l++)
+				{
+					uint32_t x = lanes[l].nextUInt();
+					output[i + l] = bipolar ? (double)(int32_t)x * scale : (double)x * scale;
+				}
+			}
 
-		// --- set delay times, wet/dry and feedback
-		if (parameters.algorithm == modDelaylgorithm::kFlanger)
-		{
-			minDelay_mSec = 0.1;
-			maxDepth_mSec = 7.0;
-			params.wetLevel_dB = -3.0;
-			params.dryLevel_dB = -3.0;
+			for (; i < blockSize; i++)
+				output[i] = renderNoiseSample();
 		}
-		if (parameters.algorithm == modDelaylgorithm::kChorus)
+		else
 		{
-			minDelay_mSec = 10.0;
-			maxDepth_mSec = 30.0;
-			params.wetLevel_dB = -3.0;
-			params.dryLevel_dB = -0.0;
-			params.feedback_Pct = 0.0;
-		}
-		if (parameters.algorithm == modDelaylgorithm::kVibrato)
-		{
-			minDelay_mSec = 0.0;
-			maxDepth_mSec = 7.0;
-			params.wetLevel_dB = 0.0;
-			params.dryLevel_dB = -96.0;
-			params.feedback_Pct = 0.0;
+			// --- pink and gaussian are built on the single-sample generators
+			for (uint32_t i = 0; i < blockSize; i++)
+				output[i] = renderNoiseSample();
 		}
+	}
 
-		// --- calc modulated delay times
-		double depth = parameters.lfoDepth_Pct / 100.0;
-		double modulationMin = minDelay_mSec;
-		double modulationMax = minDelay_mSec + maxDepth_mSec;
-
-		// --- flanger - unipolar
-		if (parameters.algorithm == modDelaylgorithm::kFlanger)
-			params.leftDelay_mSec = doUnipolarModulationFromMin(bipolarToUnipolar(depth * lfoOutput.normalOutput),
-															     modulationMin, modulationMax);
-		else
-			params.leftDelay_mSec = doBipolarModulation(depth * lfoOutput.normalOutput, modulationMin, modulationMax);
+	/** next value on the range [-1.0, +1.0) */
+	inline double nextBipolar() { return (double)(int32_t)nextUInt() * (1.0 / 2147483648.0); }
 
+	/** next value on the range [0.0, +1.0) */
+	inline double nextUnipolar() { return (double)nextUInt() * (1.0 / 4294967296.0); }
 
-		// --- set right delay to match (*Hint Homework!)
-		params.rightDelay_mSec = params.leftDelay_mSec;
+	/** next 32-bit value from the next lane */
+	inline uint32_t nextUInt()
+	{
+		uint32_t x = lanes[lane].nextUInt();
+		lane = (lane + 1) & (NOISE_LANES - 1);
+		return x;
+	}
 
-		// --- modulate the delay
-		delay.setParameters(params);
+protected:
+	noiseType type = noiseType::kWhite;		///< output type
+	uint32_t seed = 22222;					///< seed
+	FastRandom lanes[NOISE_LANES];			///< xorshift32 generators
+	unsigned int lane = 0;					///< next lane for single samples
 
-		// --- just call the function and pass our info in/out
-		return delay.processAudioFrame(inputFrame, outputFrame, inputChannels, outputChannels);
-	}
+	// --- pink noise
+	uint32_t pinkCounter = 0;					///< Voss-McCartney counter
+	double pinkRows[NOISE_PINK_ROWS] = { 0.0 };///< row values
+	double pinkRunningSum = 0.0;				///< sum of rows
 
-	/** get parameters: note use of custom structure for passing param data */
-	/**
-	\return ModulatedDelayParameters custom data structure
-	*/
-	ModulatedDelayParameters getParameters() { return parameters; }
+	// --- gaussian
+	bool hasSpareGaussian = false;	///< Box-Muller makes two values at a time
+	double spareGaussian = 0.0;		///< the second value
 
-	/** set parameters: note use of custom structure for passing param data */
-	/**
-	\param ModulatedDelayParameters custom data structure
-	*/
-	void setParameters(ModulatedDelayParameters _parameters)
+	/** Voss-McCartney: the row given by the number of trailing zeros of the counter is updated */
+	inline double pinkSample(double rowValue, double whiteValue)
 	{
-		// --- bulk copy
-		parameters = _parameters;
-
-		OscillatorParameters lfoParams = lfo.getParameters();
-		lfoParams.frequency_Hz = parameters.lfoRate_Hz;
-		if (parameters.algorithm == modDelaylgorithm::kVibrato)
-			lfoParams.waveform = generatorWaveform::kSin;
-		else
-			lfoParams.waveform = generatorWaveform::kTriangle;
+		pinkCounter = (pinkCounter + 1) & ((1 << NOISE_PINK_ROWS) - 1);
+		if (pinkCounter != 0)
+		{
+			unsigned int row = 0;
+			uint32_t n = pinkCounter;
+			while ((n & 1) == 0)
+			{
+				n >>= 1;
+				row++;
+			}
 
-		lfo.setParameters(lfoParams);
+			pinkRunningSum += rowValue - pinkRows[row];
+			pinkRows[row] = rowValue;
+		}
 
-		AudioDelayParameters adParams = delay.getParameters();
-		adParams.feedback_Pct = parameters.feedback_Pct;
-		delay.setParameters(adParams);
+		return (pinkRunningSum + whiteValue) * (1.0 / (NOISE_PINK_ROWS + 1));
 	}
 
-private:
-	ModulatedDelayParameters parameters; ///< object parameters
-	AudioDelay delay;	///< the delay to modulate
-	LFO lfo;			///< the modulator
+	/** Box-Muller transform */
+	inline double gaussianSample()
+	{
+		if (hasSpareGaussian)
+		{
+			hasSpareGaussian = false;
+			return spareGaussian;
+		}
+
+		// --- u1 on (0, 1] to keep log( ) finite
+		double u1 = 1.0 - nextUnipolar();
+		double u2 = nextUnipolar();
+		double radius = sqrt(-2.0*log(u1));
+		double theta = kTwoPi*u2;
+
+		spareGaussian = radius*sin(theta);
+		hasSpareGaussian = true;
+		return radius*cos(theta);
+	}
 };
 
+
+const unsigned int MPE_MAX_VOICES = 16;		///< voices tracked by MPEVoiceRouter
+const unsigned int MPE_NUM_CHANNELS = 16;	///< MIDI channels
+const int MPE_NO_VOICE = -1;				///< channel has no voice
+
 /**
-\struct PhaseShifterParameters
+\struct MPEVoiceRouterParameters
 \ingroup FX-Objects
 \brief
-Custom parameter structure for the PhaseShifter object.
+Custom parameter structure for the MPEVoiceRouter object.
 
-\author Will Pirkle http://www.willpirkle.com
-\remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
 \version Revision : 1.0
-\date Date : 2018 / 09 / 7
 */
-struct PhaseShifterParameters
+struct MPEVoiceRouterParameters
 {
-	PhaseShifterParameters() {}
+	MPEVoiceRouterParameters() {}
 	/** all FXObjects parameter objects require overloaded= operator so remember to add new entries if you add new variables. */
-	PhaseShifterParameters& operator=(const PhaseShifterParameters& params)
+	MPEVoiceRouterParameters& operator=(const MPEVoiceRouterParameters& params)	// need this override for collections to work
 	{
 		if (this == &params)
 			return *this;
 
-		lfoRate_Hz = params.lfoRate_Hz;
-		lfoDepth_Pct = params.lfoDepth_Pct;
-		intensity_Pct = params.intensity_Pct;
-		quadPhaseLFO = params.quadPhaseLFO;
+		masterChannel = params.masterChannel;
+		numMemberChannels = params.numMemberChannels;
+		memberPitchBendRange_semitones = params.memberPitchBendRange_semitones;
+		masterPitchBendRange_semitones = params.masterPitchBendRange_semitones;
+		smoothingTime_mSec = params.smoothingTime_mSec;
 		return *this;
 	}
 
 	// --- individual parameters
-	double lfoRate_Hz = 0.0;	///< phaser LFO rate in Hz
-	double lfoDepth_Pct = 0.0;	///< phaser LFO depth in %
-	double intensity_Pct = 0.0;	///< phaser feedback in %
-	bool quadPhaseLFO = false;	///< quad phase LFO flag
+	unsigned int masterChannel = 0;					///< zone master channel, 0-based: 0 = lower zone, 15 = upper zone
+	unsigned int numMemberChannels = 15;			///< zone size: member channels next to the master (MPE configuration message)
+	double memberPitchBendRange_semitones = 48.0;	///< per-note pitch bend range (MPE default 48)
+	double masterPitchBendRange_semitones = 2.0;	///< zone-wide pitch bend range (MPE default 2)
+	double smoothingTime_mSec = 10.0;				///< expression smoothing time constant
 };
 
-// --- constants for Phaser
-const unsigned int PHASER_STAGES = 6;
-
-// --- these are the ideal band definitions
-//const double apf0_minF = 16.0;
-//const double apf0_maxF = 1600.0;
-//
-//const double apf1_minF = 33.0;
-//const double apf1_maxF = 3300.0;
-//
-//const double apf2_minF = 48.0;
-//const double apf2_maxF = 4800.0;
-//
-//const double apf3_minF = 98.0;
-//const double apf3_maxF = 9800.0;
-//
-//const double apf4_minF = 160.0;
-//const double apf4_maxF = 16000.0;
-//
-//const double apf5_minF = 260.0;
-//const double apf5_maxF = 20480.0;
-
-// --- these are the exact values from the National Semiconductor Phaser design
-const double apf0_minF = 32.0;
-const double apf0_maxF = 1500.0;
-
-const double apf1_minF = 68.0;
-const double apf1_maxF = 3400.0;
-
-const double apf2_minF = 96.0;
-const double apf2_maxF = 4800.0;
-
-const double apf3_minF = 212.0;
-const double apf3_maxF = 10000.0;
-
-const double apf4_minF = 320.0;
-const double apf4_maxF = 16000.0;
-
-const double apf5_minF = 636.0;
-const double apf5_maxF = 20480.0;
-
 /**
-\class PhaseShifter
+\class MPEVoiceRouter
 \ingroup FX-Objects
 \brief
-The PhaseShifter object implements a six-stage phaser.
+The MPEVoiceRouter object routes MPE per-note expression (pitch bend, channel pressure and CC74 timbre) from
+the member channels to the voice that owns the channel, and zone-wide expression from the master channel to
+all voices. The zone is the master channel plus numMemberChannels member channels above it (lower zone) or
+below it (upper zone); expression on channels outside the zone is not routed.
+
+Zone-wide pitch bend adds to the per-note bend; zone-wide pressure adds to the per-note pressure, and zone-wide
+timbre offsets the per-note timbre from its 0.5 center, both clamped to [0.0, +1.0].
+
+The voice engine keeps its own note allocation and calls noteOn(channel, voice) and noteOff(voice); the
+router then finds the owning voice for each expression message with one table lookup. Expression sent on
+a channel before its note-on is captured and becomes the voice's starting state. Per-voice expression is
+smoothed with a one-pole filter, once per block, in structure-of-arrays form.
 
 Audio I/O:
-- Processes mono input to mono output.
+- None; processes MIDI messages, provides per-voice modulation values.
 
 Control I/F:
-- Use BiquadParameters structure to get/set object params.
+- Use MPEVoiceRouterParameters structure to get/set object params.
+- processMIDIMessage( ), noteOn( ), noteOff( ), updateExpression( )
 
-\author Will Pirkle http://www.willpirkle.com
-\remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
 \version Revision : 1.0
-\date Date : 2018 / 09 / 7
 */
-class PhaseShifter : public IAudioSignalProcessor
+class MPEVoiceRouter
 {
 public:
-	PhaseShifter(void) {
-		OscillatorParameters lfoparams = lfo.getParameters();
-		lfoparams.waveform = generatorWaveform::kTriangle;	// kTriangle LFO for phaser
-	//	lfoparams.waveform = generatorWaveform::kSin;		// kTriangle LFO for phaser
-		lfo.setParameters(lfoparams);
-
-		AudioFilterParameters params = apf[0].getParameters();
-		params.algorithm = filterAlgorithm::kAPF1; // can also use 2nd order
-		// params.Q = 0.001; use low Q if using 2nd order APFs
-
-		for (int i = 0; i < PHASER_STAGES; i++)
-		{
-			apf[i].setParameters(params);
-		}
-	}	/* C-TOR */
-
-	~PhaseShifter(void) {}	/* D-TOR */
+	MPEVoiceRouter() { clearExpression(); }	/* C-TOR */
+	~MPEVoiceRouter() {}					/* D-TOR */
 
-public:
 	/** reset members to initialized state */
-	virtual bool reset(double _sampleRate)
+	bool reset(double _sampleRate)
 	{
-		// --- reset LFO
-		lfo.reset(_sampleRate);
-
-		// --- reset APFs
-		for (int i = 0; i < PHASER_STAGES; i++){
-			apf[i].reset(_sampleRate);
-		}
-
+		sampleRate = _sampleRate;
+		smoothingBlockSize = 0;
+		clearExpression();
 		return true;
 	}
 
-	/** process autio through phaser */
+	/** get parameters: note use of custom structure for passing param data */
 	/**
-	\param xn input
-	\return the processed sample
+	\return MPEVoiceRouterParameters custom data structure
 	*/
-	virtual double processAudioSample(double xn)
+	MPEVoiceRouterParameters getParameters() { return parameters; }
+
+	/** set parameters: note use of custom structure for passing param data */
+	/**
+	\param MPEVoiceRouterParameters custom data structure
+	*/
+	void setParameters(const MPEVoiceRouterParameters& params)
 	{
-		SignalGenData lfoData = lfo.renderAudioOutput();
+		if (params.smoothingTime_mSec != parameters.smoothingTime_mSec)
+			smoothingBlockSize = 0; // --- force coefficient update
 
-		// --- create the bipolar modulator value
-		double lfoValue = lfoData.normalOutput;
-		if (parameters.quadPhaseLFO)
-			lfoValue = lfoData.quadPhaseOutput_pos;
+		parameters = params;
+		if (parameters.masterChannel >= MPE_NUM_CHANNELS)
+			parameters.masterChannel = 0;
 
-		double depth = parameters.lfoDepth_Pct / 100.0;
-		double modulatorValue = lfoValue*depth;
+		// --- member channels must fit between the master channel and the end of the channel range
+		unsigned int maxMembers = parameters.masterChannel == MPE_NUM_CHANNELS - 1 ? MPE_NUM_CHANNELS - 1 : MPE_NUM_CHANNELS - 1 - parameters.masterChannel;
+		if (parameters.numMemberChannels > maxMembers)
+			parameters.numMemberChannels = maxMembers;
+	}
 
-		// --- calculate modulated values for each APF; note they have different ranges
-		AudioFilterParameters params = apf[0].getParameters();
-		params.fc = doBipolarModulation(modulatorValue, apf0_minF, apf0_maxF);
-		apf[0].setParameters(params);
+	/** true if the channel is a member channel of the zone */
+	inline bool isMemberChannel(unsigned int channel)
+	{
+		// --- upper zone counts down from the master channel, lower zone counts up
+		if (parameters.masterChannel == MPE_NUM_CHANNELS - 1)
+			return channel < parameters.masterChannel && channel >= parameters.masterChannel - parameters.numMemberChannels;
 
-		params = apf[1].getParameters();
-		params.fc = doBipolarModulation(modulatorValue, apf1_minF, apf1_maxF);
-		apf[1].setParameters(params);
+		return channel > parameters.masterChannel && channel <= parameters.masterChannel + parameters.numMemberChannels;
+	}
 
-		params = apf[2].getParameters();
-		params.fc = doBipolarModulation(modulatorValue, apf2_minF, apf2_maxF);
-		apf[2].setParameters(params);
+	/** the voice engine started a note on this channel with this voice */
+	void noteOn(unsigned int channel, unsigned int voice)
+	{
+		if (channel >= MPE_NUM_CHANNELS || voice >= MPE_MAX_VOICES)
+			return;
 
-		params = apf[3].getParameters();
-		params.fc = doBipolarModulation(modulatorValue, apf3_minF, apf3_maxF);
-		apf[3].setParameters(params);
+		// --- a voice can only own one channel
+		if (voiceChannel[voice] != MPE_NO_VOICE && channelVoice[voiceChannel[voice]] == (int)voice)
+			channelVoice[voiceChannel[voice]] = MPE_NO_VOICE;
 
-		params = apf[4].getParameters();
-		params.fc = doBipolarModulation(modulatorValue, apf4_minF, apf4_maxF);
-		apf[4].setParameters(params);
+		channelVoice[channel] = voice;
+		voiceChannel[voice] = channel;
 
-		params = apf[5].getParameters();
-		params.fc = doBipolarModulation(modulatorValue, apf5_minF, apf5_maxF);
-		apf[5].setParameters(params);
+		// --- start from the channel's pre-note expression, no glide
+		bendTarget[voice] = bend[voice] = channelBend[channel];
+		pressureTarget[voice] = pressure[voice] = channelPressure[channel];
+		timbreTarget[voice] = timbre[voice] = channelTimbre[channel];
+	}
 
-		// --- calculate gamma values
-		double gamma1 = apf[5].getG_value();
-		double gamma2 = apf[4].getG_value() * gamma1;
-		double gamma3 = apf[3].getG_value() * gamma2;
-		double gamma4 = apf[2].getG_value() * gamma3;
-		double gamma5 = apf[1].getG_value() * gamma4;
-		double gamma6 = apf[0].getG_value() * gamma5;
+	/** the voice engine stopped this voice; its expression stays frozen for the release */
+	void noteOff(unsigned int voice)
+	{
+		if (voice >= MPE_MAX_VOICES || voiceChannel[voice] == MPE_NO_VOICE)
+			return;
 
-		// --- set the alpha0 value
-		double K = parameters.intensity_Pct / 100.0;
-		double alpha0 = 1.0 / (1.0 + K*gamma6);
+		if (channelVoice[voiceChannel[voice]] == (int)voice)
+			channelVoice[voiceChannel[voice]] = MPE_NO_VOICE;
+		voiceChannel[voice] = MPE_NO_VOICE;
+	}
 
-		// --- create combined feedback
-		double Sn = gamma5*apf[0].getS_value() + gamma4*apf[1].getS_value() + gamma3*apf[2].getS_value() + gamma2*apf[3].getS_value() + gamma1*apf[4].getS_value() + apf[5].getS_value();
+	/** get the voice that owns a channel, or MPE_NO_VOICE */
+	inline int getChannelVoice(unsigned int channel) { return channel < MPE_NUM_CHANNELS ? channelVoice[channel] : MPE_NO_VOICE; }
 
-		// --- form input to first APF
-		double u = alpha0*(xn + K*Sn);
+	/** route one expression message; note on/off are left to the voice engine
+	\param message status byte without channel (0xB0, 0xD0, 0xE0)
+	\param channel 0-based MIDI channel
+	\return true if the message was an expression message
+	*/
+	inline bool processMIDIMessage(uint32_t message, uint32_t channel, uint32_t data1, uint32_t data2)
+	{
+		if (channel >= MPE_NUM_CHANNELS)
+			return false;
 
-		// --- cascade of APFs (could also nest these in one massive line of code)
-		double APF1 = apf[0].processAudioSample(u);
-		double APF2 = apf[1].processAudioSample(APF1);
-		double APF3 = apf[2].processAudioSample(APF2);
-		double APF4 = apf[3].processAudioSample(APF3);
-		double APF5 = apf[4].processAudioSample(APF4);
-		double APF6 = apf[5].processAudioSample(APF5);
+		// --- zone master channel: zone-wide pitch bend, pressure and timbre
+		if (channel == parameters.masterChannel)
+		{
+			switch (message)
+			{
+				case 0xE0:
+					masterBendTarget = (double)((int)((data2 << 7) | data1) - 8192) / 8192.0;
+					return true;
+
+				case 0xD0:
+					masterPressureTarget = (double)data1 / 127.0;
+					return true;
+
+				case 0xB0:
+					if (data1 != 74)
+						return false;
+					masterTimbreTarget = (double)data2 / 127.0;
+					return true;
+
+				default:
+					return false;
+			}
+		}
 
-		// --- sum with -3dB coefficients
-		//	double output = 0.707*xn + 0.707*APF6;
+		// --- not in the zone
+		if (!isMemberChannel(channel))
+			return false;
 
-		// --- sum with National Semiconductor design ratio:
-		//	   dry = 0.5, wet = 5.0
-		// double output = 0.5*xn + 5.0*APF6;
-		// double output = 0.25*xn + 2.5*APF6;
-		double output = 0.125*xn + 1.25*APF6;
+		double* channelTarget = nullptr;
+		double* voiceTarget = nullptr;
+		double value = 0.0;
 
-		return output;
-	}
+		switch (message)
+		{
+			case 0xE0: // --- pitch bend: bipolar
+				value = (double)((int)((data2 << 7) | data1) - 8192) / 8192.0;
+				channelTarget = channelBend;
+				voiceTarget = bendTarget;
+				break;
 
-	/** return false: this object only processes samples */
-	virtual bool canProcessAudioFrame() { return false; }
+			case 0xD0: // --- channel pressure: unipolar
+				value = (double)data1 / 127.0;
+				channelTarget = channelPressure;
+				voiceTarget = pressureTarget;
+				break;
 
-	/** get parameters: note use of custom structure for passing param data */
-	/**
-	\return PhaseShifterParameters custom data structure
-	*/
-	PhaseShifterParameters getParameters() { return parameters; }
+			case 0xB0: // --- CC74 timbre: unipolar
+				if (data1 != 74)
+					return false;
+				value = (double)data2 / 127.0;
+				channelTarget = channelTimbre;
+				voiceTarget = timbreTarget;
+				break;
 
-	/** set parameters: note use of custom structure for passing param data */
-	/**
-	\param PhaseShifterParameters custom data structure
+			default:
+				return false;
+		}
+
+		// --- O(1): channel state for the next note, plus the owning voice
+		channelTarget[channel] = value;
+		if (channelVoice[channel] != MPE_NO_VOICE)
+			voiceTarget[channelVoice[channel]] = value;
+
+		return true;
+	}
+
+	/** smooth the per-voice expression toward the targets; call once per block
+	\param blockSize number of samples in the block
 	*/
-	void setParameters(const PhaseShifterParameters& params)
+	void updateExpression(uint32_t blockSize)
 	{
-		// --- update LFO rate
-		if (params.lfoRate_Hz != parameters.lfoRate_Hz)
+		if (blockSize != smoothingBlockSize)
 		{
-			OscillatorParameters lfoparams = lfo.getParameters();
-			lfoparams.frequency_Hz = params.lfoRate_Hz;
-			lfo.setParameters(lfoparams);
+			smoothingBlockSize = blockSize;
+			double tau = parameters.smoothingTime_mSec*0.001*sampleRate;
+			smoothingCoeff = tau > 0.0 ? exp(-(double)blockSize / tau) : 0.0;
 		}
 
-		// --- save new
-		parameters = params;
+		double b = 1.0 - smoothingCoeff;
+		for (unsigned int v = 0; v < MPE_MAX_VOICES; v++)
+		{
+			bend[v] += b*(bendTarget[v] - bend[v]);
+			pressure[v] += b*(pressureTarget[v] - pressure[v]);
+			timbre[v] += b*(timbreTarget[v] - timbre[v]);
+		}
+		masterBend += b*(masterBendTarget - masterBend);
+		masterPressure += b*(masterPressureTarget - masterPressure);
+		masterTimbre += b*(masterTimbreTarget - masterTimbre);
+	}
+
+	/** total pitch bend for a voice: per-note plus zone-wide */
+	inline double getPitchBend_semitones(unsigned int voice)
+	{
+		return bend[voice] * parameters.memberPitchBendRange_semitones + masterBend * parameters.masterPitchBendRange_semitones;
 	}
+
+	/** smoothed pressure [0.0, +1.0]: per-note plus zone-wide */
+	inline double getPressure(unsigned int voice) { return fmin(pressure[voice] + masterPressure, 1.0); }
+
+	/** smoothed CC74 timbre [0.0, +1.0]: per-note, offset by the zone-wide timbre */
+	inline double getTimbre(unsigned int voice) { return fmin(fmax(timbre[voice] + masterTimbre - 0.5, 0.0), 1.0); }
+
+	/** smoothed zone-wide values from the master channel */
+	inline double getZonePitchBend() { return masterBend; }
+	inline double getZonePressure() { return masterPressure; }
+	inline double getZoneTimbre() { return masterTimbre; }
+
+	/** per-voice arrays (per-note expression only), for voice engines that read all voices at once */
+	const double* getPitchBendArray() { return bend; }
+	const double* getPressureArray() { return pressure; }
+	const double* getTimbreArray() { return timbre; }
+
 protected:
-	PhaseShifterParameters parameters;  ///< the object parameters
-	AudioFilter apf[PHASER_STAGES];		///< six APF objects
-	LFO lfo;							///< the one and only LFO
+	MPEVoiceRouterParameters parameters; ///< object parameters
+	double sampleRate = 44100.0;		///< sample rate
+
+	// --- O(1) lookup, both ways
+	int channelVoice[MPE_NUM_CHANNELS];	///< owning voice per channel
+	int voiceChannel[MPE_MAX_VOICES];	///< channel per voice
+
+	// --- last expression per channel (captured at note-on)
+	double channelBend[MPE_NUM_CHANNELS];		///< bipolar
+	double channelPressure[MPE_NUM_CHANNELS];	///< unipolar
+	double channelTimbre[MPE_NUM_CHANNELS];		///< unipolar
+
+	// --- per-voice expression, SoA
+	double bendTarget[MPE_MAX_VOICES];		///< target pitch bend
+	double pressureTarget[MPE_MAX_VOICES];	///< target pressure
+	double timbreTarget[MPE_MAX_VOICES];	///< target timbre
+	double bend[MPE_MAX_VOICES];			///< smoothed pitch bend
+	double pressure[MPE_MAX_VOICES];		///< smoothed pressure
+	double timbre[MPE_MAX_VOICES];			///< smoothed timbre
+
+	// --- zone-wide
+	double masterBendTarget = 0.0;		///< master channel pitch bend
+	double masterBend = 0.0;			///< smoothed
+	double masterPressureTarget = 0.0;	///< master channel pressure
+	double masterPressure = 0.0;		///< smoothed
+	double masterTimbreTarget = 0.5;	///< master channel CC74 timbre
+	double masterTimbre = 0.5;			///< smoothed
+
+	// --- block-rate smoother
+	uint32_t smoothingBlockSize = 0;	///< block size the coefficient was calculated for
+	double smoothingCoeff = 0.0;		///< one-pole coefficient for one block
+
+	/** unmap all channels and set the MPE defaults: bend centered, no pressure, timbre centered */
+	void clearExpression()
+	{
+		for (unsigned int c = 0; c < MPE_NUM_CHANNELS; c++)
+		{
+			channelVoice[c] = MPE_NO_VOICE;
+			channelBend[c] = 0.0;
+			channelPressure[c] = 0.0;
+			channelTimbre[c] = 0.5;
+		}
+		for (unsigned int v = 0; v < MPE_MAX_VOICES; v++)
+		{
+			voiceChannel[v] = MPE_NO_VOICE;
+			bendTarget[v] = bend[v] = 0.0;
+			pressureTarget[v] = pressure[v] = 0.0;
+			timbreTarget[v] = timbre[v] = 0.5;
+		}
+		masterBendTarget = masterBend = 0.0;
+		masterPressureTarget = masterPressure = 0.0;
+		masterTimbreTarget = masterTimbre = 0.5;
+	}
 };
 
+
 /**
-\struct SimpleLPFParameters
+\enum modDelaylgorithm
+\ingroup Constants-Enums
+\brief
+Use this strongly typed enum to easily set modulated delay algorithm.
+
+- enum class modDelaylgorithm { kFlanger, kChorus, kVibrato };
+
+\author Will Pirkle http://www.willpirkle.com
+\remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
+\version Revision : 1.0
+\date Date : 2018 / 09 / 7
+*/
+enum class modDelaylgorithm { kFlanger, kChorus, kVibrato };
+
+
+/**
+\struct ModulatedDelayParameters
 \ingroup FX-Objects
 \brief
-Custom parameter structure for the SimpleLPFP object. Used for reverb algorithms in book.
+Custom parameter structure for the ModulatedDelay object.
 
 \author Will Pirkle http://www.willpirkle.com
 \remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
 \version Revision : 1.0
 \date Date : 2018 / 09 / 7
 */
-struct SimpleLPFParameters
+struct ModulatedDelayParameters
 {
-	SimpleLPFParameters() {}
+	ModulatedDelayParameters() {}
 	/** all FXObjects parameter objects require overloaded= operator so remember to add new entries if you add new variables. */
-	SimpleLPFParameters& operator=(const SimpleLPFParameters& params)	// need this override for collections to work
+	ModulatedDelayParameters& operator=(const ModulatedDelayParameters& params)	// need this override for collections to work
 	{
 		if (this == &params)
 			return *this;
 
-		g = params.g;
+		algorithm = params.algorithm;
+		lfoRate_Hz = params.lfoRate_Hz;
+		lfoDepth_Pct = params.lfoDepth_Pct;
+		feedback_Pct = params.feedback_Pct;
+		interpolationType = params.interpolationType;
 		return *this;
 	}
 
 	// --- individual parameters
-	double g = 0.0; ///< simple LPF g value
+	modDelaylgorithm algorithm = modDelaylgorithm::kFlanger; ///< mod delay algorithm
+	double lfoRate_Hz = 0.0;	///< mod delay LFO rate in Hz
+	double lfoDepth_Pct = 0.0;	///< mod delay LFO depth in %
+	double feedback_Pct = 0.0;	///< feedback in %
+	delayInterpolation interpolationType = delayInterpolation::kLinear; ///< interpolation for the modulated delay reads
 };
 
 /**
-\class SimpleLPF
+\class ModulatedDelay
 \ingroup FX-Objects
 \brief
-The SimpleLPF object implements a first order one-pole LPF using one coefficient "g" value.
+The ModulatedDelay object implements the three basic algorithms: flanger, chorus, vibrato.
 
-Audio I/O:
-- Processes mono input to mono output.
+Audio I / O :
+	-Processes mono input to mono OR stereo output.
 
-Control I/F:
-- Use SimpleLPFParameters structure to get/set object params.
+Control I / F :
+	-Use ModulatedDelayParameters structure to get / set object params.
 
-\author Will Pirkle http://www.willpirkle.com
-\remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
+\author Will Pirkle http ://www.willpirkle.com
+\remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed.by Will Pirkle
 \version Revision : 1.0
 \date Date : 2018 / 09 / 7
 */
-class SimpleLPF : public IAudioSignalProcessor
+class ModulatedDelay : public IAudioSignalProcessor
 {
 public:
-	SimpleLPF(void) {}	/* C-TOR */
-	~SimpleLPF(void) {}	/* D-TOR */
+	ModulatedDelay() {
+	}		/* C-TOR */
+	~ModulatedDelay() {}	/* D-TOR */
 
 public:
 	/** reset members to initialized state */
 	virtual bool reset(double _sampleRate)
 	{
-		state = 0.0;
-		return true;
-	}
+		// --- create new buffer, 100mSec long
+		delay.reset(_sampleRate);
+		delay.createDelayBuffers(_sampleRate, 100.0);
 
-	/** get parameters: note use of custom structure for passing param data */
-	/**
-	\return SimpleLPFParameters custom data structure
-	*/
-	SimpleLPFParameters getParameters()
-	{
-		return simpleLPFParameters;
-	}
+		// --- lfo
+		lfo.reset(_sampleRate);
+		OscillatorParameters params = lfo.getParameters();
+		params.waveform = generatorWaveform::kTriangle;
+		lfo.setParameters(params);
 
-	/** set parameters: note use of custom structure for passing param data */
-	/**
-	\param SimpleLPFParameters custom data structure
-	*/
-	void setParameters(const SimpleLPFParameters& params)
-	{
-		simpleLPFParameters = params;
+		// --- for block processing
+		samplesPerMSec = _sampleRate / 1000.0;
+
+		return true;
 	}
 
-	/** process simple one pole FB back filter */
+	/** process input sample */
 	/**
 	\param xn input
 	\return the processed sample
 	*/
 	virtual double processAudioSample(double xn)
 	{
-		double g = simpleLPFParameters.g;
-		double yn = (1.0 - g)*xn + g*state;
-		state = yn;
-		return yn;
+		float input = xn;
+		float output = 0.0;
+		processAudioFrame(&input, &output, 1, 1);
+		return output;
 	}
 
-	/** return false: this object only processes samples */
-	virtual bool canProcessAudioFrame() { return false; }
+	/** return true: this object can process frames */
+	virtual bool canProcessAudioFrame() { return true; }
 
-private:
-	SimpleLPFParameters simpleLPFParameters;	///< object parameters
-	double state = 0.0;							///< single state (z^-1) register
-};
+	/** process STEREO audio delay of frames */
+	virtual bool processAudioFrame(const float* inputFrame,		/* ptr to one frame of data: pInputFrame[0] = left, pInputFrame[1] = right, etc...*/
+		float* outputFrame,
+		uint32_t inputChannels,
+		uint32_t outputChannels)
+	{
+		// --- make sure we have input and outputs
+		if (inputChannels == 0 || outputChannels == 0)
+			return false;
 
-/**
-\struct SimpleDelayParameters
-\ingroup FX-Objects
-\brief
-Custom parameter structure for the SimpleDelay object. Used for reverb algorithms in book.
+		// --- render LFO
+		SignalGenData lfoOutput = lfo.renderAudioOutput();
 
-\author Will Pirkle http://www.willpirkle.com
-\remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
-\version Revision : 1.0
-\date Date : 2018 / 09 / 7
-*/
-struct SimpleDelayParameters
-{
-	SimpleDelayParameters() {}
-	/** all FXObjects parameter objects require overloaded= operator so remember to add new entries if you add new variables. */
-	SimpleDelayParameters& operator=(const SimpleDelayParameters& params)	// need this override for collections to work
-	{
-		if (this == &params)
-			return *this;
+		// --- setup delay modulation
+		AudioDelayParameters params = delay.getParameters();
+		double modulationMin = 0.0;
+		double modulationMax = 0.0;
+		setupModulation(params, modulationMin, modulationMax);
 
-		delayTime_mSec = params.delayTime_mSec;
-		interpolate = params.interpolate;
-		delay_Samples = params.delay_Samples;
-		return *this;
+		// --- calc modulated delay time
+		params.leftDelay_mSec = calculateModDelay_mSec(lfoOutput.normalOutput, modulationMin, modulationMax);
+
+		// --- set right delay to match (*Hint Homework!)
+		params.rightDelay_mSec = params.leftDelay_mSec;
+
+		// --- modulate the delay
+		delay.setParameters(params);
+
+		// --- just call the function and pass our info in/out
+		return delay.processAudioFrame(inputFrame, outputFrame, inputChannels, outputChannels);
 	}
 
-	// --- individual parameters
-	double delayTime_mSec = 0.0;	///< delay tine in mSec
-	bool interpolate = false;		///< interpolation flag (diagnostics usually)
+	/** process a block of audio; the LFO renders a sub-block of delay times that are then read from
+	    the delay lines in one pass with the selected interpolation type */
+	/**
+	\param inputBuffers input channel buffers
+	\param outputBuffers output channel buffers
+	\param inputChannels number of input channels
+	\param outputChannels number of output channels
+	\param blockSize number of samples in the block
+	\return true if processed
+	*/
+	bool processAudioBlock(const float* const* inputBuffers, float** outputBuffers,
+						   uint32_t inputChannels, uint32_t outputChannels, uint32_t blockSize)
+	{
+		// --- make sure we have input and outputs
+		if (inputChannels == 0 || outputChannels == 0)
+			return false;
 
-	// --- outbound parameters
-	double delay_Samples = 0.0;		///< current delay in samples; other objects may need to access this information
-};
+		// --- setup delay modulation once per block
+		AudioDelayParameters params = delay.getParameters();
+		double modulationMin = 0.0;
+		double modulationMax = 0.0;
+		setupModulation(params, modulationMin, modulationMax);
 
-/**
-\class SimpleDelay
-\ingroup FX-Objects
-\brief
-The SimpleDelay object implements a basic delay line without feedback.
+		double modDelayInSamples[DELAY_BLOCK_SIZE] = { 0.0 };
+		for (uint32_t offset = 0; offset < blockSize; offset += DELAY_BLOCK_SIZE)
+		{
+			uint32_t subBlockSize = blockSize - offset < DELAY_BLOCK_SIZE ? blockSize - offset : DELAY_BLOCK_SIZE;
 
-Audio I/O:
-- Processes mono input to mono output.
+			// --- render the LFO into delay times
+			for (uint32_t i = 0; i < subBlockSize; i++)
+			{
+				SignalGenData lfoOutput = lfo.renderAudioOutput();
+				modDelayInSamples[i] = samplesPerMSec*calculateModDelay_mSec(lfoOutput.normalOutput, modulationMin, modulationMax);
+			}
 
-Control I/F:
-- Use SimpleDelayParameters structure to get/set object params.
+			// --- last delay time is stored for sample processing
+			params.leftDelay_mSec = modDelayInSamples[subBlockSize - 1] / samplesPerMSec;
+			params.rightDelay_mSec = params.leftDelay_mSec;
+			delay.setParameters(params);
 
-\author Will Pirkle http://www.willpirkle.com
-\remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
-\version Revision : 1.0
-\date Date : 2018 / 09 / 7
-*/
-class SimpleDelay : public IAudioSignalProcessor
-{
-public:
-	SimpleDelay(void) {}	/* C-TOR */
-	~SimpleDelay(void) {}	/* D-TOR */
+			// --- offset the channel pointers
+			const float* inputs[2] = { inputBuffers[0] + offset, inputChannels > 1 ? inputBuffers[1] + offset : nullptr };
+			float* outputs[2] = { outputBuffers[0] + offset, outputChannels > 1 ? outputBuffers[1] + offset : nullptr };
 
-public:
-	/** reset members to initialized state */
-	virtual bool reset(double _sampleRate)
-	{
-		// --- if sample rate did not change
-		if (sampleRate == _sampleRate)
-		{
-			// --- just flush buffer and return
-			delayBuffer.flushBuffer();
-			return true;
+			// --- left and right delays match
+			delay.processAudioBlock(inputs, outputs, inputChannels, outputChannels, modDelayInSamples, modDelayInSamples, subBlockSize);
 		}
 
-		// --- create new buffer, will store sample rate and length(mSec)
-		createDelayBuffer(_sampleRate, bufferLength_mSec);
-
 		return true;
 	}
 
 	/** get parameters: note use of custom structure for passing param data */
 	/**
-	\return SimpleDelayParameters custom data structure
+	\return ModulatedDelayParameters custom data structure
 	*/
-	SimpleDelayParameters getParameters()
-	{
-		return simpleDelayParameters;
-	}
+	ModulatedDelayParameters getParameters() { return parameters; }
 
 	/** set parameters: note use of custom structure for passing param data */
 	/**
-	\param SimpleDelayParameters custom data structure
+	\param ModulatedDelayParameters custom data structure
 	*/
-	void setParameters(const SimpleDelayParameters& params)
+	void setParameters(ModulatedDelayParameters _parameters)
 	{
-		simpleDelayParameters = params;
-		simpleDelayParameters.delay_Samples = simpleDelayParameters.delayTime_mSec*(samplesPerMSec);
-		delayBuffer.setInterpolate(simpleDelayParameters.interpolate);
-	}
+		// --- bulk copy
+		parameters = _parameters;
 
-	/** process MONO audio delay */
-	/**
-	\param xn input
-	\return the processed sample
-	*/
-	virtual double processAudioSample(double xn)
-	{
-		// --- read delay
-		if (simpleDelayParameters.delay_Samples == 0)
-			return xn;
-
-		double yn = delayBuffer.readBuffer(simpleDelayParameters.delay_Samples);
+		OscillatorParameters lfoParams = lfo.getParameters();
+		lfoParams.frequency_Hz = parameters.lfoRate_Hz;
+		if (parameters.algorithm == modDelaylgorithm::kVibrato)
+			lfoParams.waveform = generatorWaveform::kSin;
+		else
+			lfoParams.waveform = generatorWaveform::kTriangle;
 
-		// --- write to delay buffer
-		delayBuffer.writeBuffer(xn);
+		lfo.setParameters(lfoParams);
 
-		// --- done
-		return yn;
+		AudioDelayParameters adParams = delay.getParameters();
+		adParams.feedback_Pct = parameters.feedback_Pct;
+		adParams.interpolationType = parameters.interpolationType;
+		delay.setParameters(adParams);
 	}
 
-	/** reset members to initialized state */
-	virtual bool canProcessAudioFrame() { return false; }
+private:
+	ModulatedDelayParameters parameters; ///< object parameters
+	AudioDelay delay;	///< the delay to modulate
+	LFO lfo;			///< the modulator
+	double samplesPerMSec = 0.0;	///< for block processing delay times
 
-	/** create a new delay buffer */
-	void createDelayBuffer(double _sampleRate, double _bufferLength_mSec)
+	/** set the wet/dry/feedback for the current algorithm and find the modulation range in mSec */
+	void setupModulation(AudioDelayParameters& params, double& modulationMin, double& modulationMax)
 	{
-		// --- store for math
-		bufferLength_mSec = _bufferLength_mSec;
-		sampleRate = _sampleRate;
-		samplesPerMSec = sampleRate / 1000.0;
-
-		// --- total buffer length including fractional part
-		bufferLength = (unsigned int)(bufferLength_mSec*(samplesPerMSec)) + 1; // +1 for fractional part
+		double minDelay_mSec = 0.0;
+		double maxDepth_mSec = 0.0;
 
-		// --- create new buffer
-		delayBuffer.createCircularBuffer(bufferLength);
-	}
+		// --- set delay times, wet/dry and feedback
+		if (parameters.algorithm == modDelaylgorithm::kFlanger)
+		{
+			minDelay_mSec = 0.1;
+			maxDepth_mSec = 7.0;
+			params.wetLevel_dB = -3.0;
+			params.dryLevel_dB = -3.0;
+		}
+		if (parameters.algorithm == modDelaylgorithm::kChorus)
+		{
+			minDelay_mSec = 10.0;
+			maxDepth_mSec = 30.0;
+			params.wetLevel_dB = -3.0;
+			params.dryLevel_dB = -0.0;
+			params.feedback_Pct = 0.0;
+		}
+		if (parameters.algorithm == modDelaylgorithm::kVibrato)
+		{
+			minDelay_mSec = 0.0;
+			maxDepth_mSec = 7.0;
+			params.wetLevel_dB = 0.0;
+			params.dryLevel_dB = -96.0;
+			params.feedback_Pct = 0.0;
+		}
 
-	/** read delay at current location */
-	double readDelay()
-	{
-		// --- simple read
-		return delayBuffer.readBuffer(simpleDelayParameters.delay_Samples);
+		// --- calc modulation range
+		modulationMin = minDelay_mSec;
+		modulationMax = minDelay_mSec + maxDepth_mSec;
 	}
 
-	/** read delay at current location */
-	double readDelayAtTime_mSec(double _delay_mSec)
+	/** calculate the modulated delay time from the bipolar LFO output */
+	inline double calculateModDelay_mSec(double lfoOutput, double modulationMin, double modulationMax)
 	{
-		// --- calculate total delay time in samples + fraction
-		double _delay_Samples = _delay_mSec*(samplesPerMSec);
-
-		// --- simple read
-		return delayBuffer.readBuffer(_delay_Samples);
-	}
+		double depth = parameters.lfoDepth_Pct / 100.0;
 
-	/** read delay at a percentage of total length */
-	double readDelayAtPercentage(double delayPercent)
-	{
-		// --- simple read
-		return delayBuffer.readBuffer((delayPercent / 100.0)*simpleDelayParameters.delay_Samples);
-	}
+		// --- flanger - unipolar
+		if (parameters.algorithm == modDelaylgorithm::kFlanger)
+			return doUnipolarModulationFromMin(bipolarToUnipolar(depth * lfoOutput), modulationMin, modulationMax);
 
-	/** write a new value into the delay */
-	void writeDelay(double xn)
-	{
-		// --- simple write
-		delayBuffer.writeBuffer(xn);
+		return doBipolarModulation(depth * lfoOutput, modulationMin, modulationMax);
 	}
-
-private:
-	SimpleDelayParameters simpleDelayParameters; ///< object parameters
-
-	double sampleRate = 0.0;		///< sample rate
-	double samplesPerMSec = 0.0;	///< samples per millisecond (for arbitrary access)
-	double bufferLength_mSec = 0.0; ///< total buffer lenth in mSec
-	unsigned int bufferLength = 0;	///< buffer length in samples
-
-	// --- delay buffer of doubles
-	CircularBuffer<double> delayBuffer; ///< circular buffer for delay
 };
 
-
 /**
-\struct CombFilterParameters
+\struct PhaseShifterParameters
 \ingroup FX-Objects
 \brief
-Custom parameter structure for the CombFilter object. Used for reverb algorithms in book.
+Custom parameter structure for the PhaseShifter object.
 
 \author Will Pirkle http://www.willpirkle.com
 \remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
 \version Revision : 1.0
 \date Date : 2018 / 09 / 7
 */
-struct CombFilterParameters
+struct PhaseShifterParameters
 {
-	CombFilterParameters() {}
+	PhaseShifterParameters() {}
 	/** all FXObjects parameter objects require overloaded= operator so remember to add new entries if you add new variables. */
-	CombFilterParameters& operator=(const CombFilterParameters& params)	// need this override for collections to work
+	PhaseShifterParameters& operator=(const PhaseShifterParameters& params)
 	{
 		if (this == &params)
 			return *this;
 
-		delayTime_mSec = params.delayTime_mSec;
-		RT60Time_mSec = params.RT60Time_mSec;
-		enableLPF = params.enableLPF;
-		lpf_g = params.lpf_g;
-		interpolate = params.interpolate;
+		lfoRate_Hz = params.lfoRate_Hz;
+		lfoDepth_Pct = params.lfoDepth_Pct;
+		intensity_Pct = params.intensity_Pct;
+		quadPhaseLFO = params.quadPhaseLFO;
 		return *this;
 	}
 
 	// --- individual parameters
-	double delayTime_mSec = 0.0;	///< delay time in mSec
-	double RT60Time_mSec = 0.0;		///< RT 60 time ini mSec
-	bool enableLPF = false;			///< enable LPF flag
-	double lpf_g = 0.0;				///< gain value for LPF (if enabled)
-	bool interpolate = false;		///< interpolation flag (diagnostics)
+	double lfoRate_Hz = 0.0;	///< phaser LFO rate in Hz
+	double lfoDepth_Pct = 0.0;	///< phaser LFO depth in %
+	double intensity_Pct = 0.0;	///< phaser feedback in %
+	bool quadPhaseLFO = false;	///< quad phase LFO flag
 };
 
+// --- constants for Phaser
+const unsigned int PHASER_STAGES = 6;
+
+// --- these are the ideal band definitions
+//const double apf0_minF = 16.0;
+//const double apf0_maxF = 1600.0;
+//
+//const double apf1_minF = 33.0;
+//const double apf1_maxF = 3300.0;
+//
+//const double apf2_minF = 48.0;
+//const double apf2_maxF = 4800.0;
+//
+//const double apf3_minF = 98.0;
+//const double apf3_maxF = 9800.0;
+//
+//const double apf4_minF = 160.0;
+//const double apf4_maxF = 16000.0;
+//
+//const double apf5_minF = 260.0;
+//const double apf5_maxF = 20480.0;
+
+// --- these are the exact values from the National Semiconductor Phaser design
+const double apf0_minF = 32.0;
+const double apf0_maxF = 1500.0;
+
+const double apf1_minF = 68.0;
+const double apf1_maxF = 3400.0;
+
+const double apf2_minF = 96.0;
+const double apf2_maxF = 4800.0;
+
+const double apf3_minF = 212.0;
+const double apf3_maxF = 10000.0;
+
+const double apf4_minF = 320.0;
+const double apf4_maxF = 16000.0;
+
+const double apf5_minF = 636.0;
+const double apf5_maxF = 20480.0;
 
 /**
-\class CombFilter
+\class PhaseShifter
 \ingroup FX-Objects
 \brief
-The CombFilter object implements a comb filter with optional LPF in feedback loop. Used for reverb algorithms in book.
+The PhaseShifter object implements a six-stage phaser.
 
 Audio I/O:
 - Processes mono input to mono output.
 
 Control I/F:
-- Use CombFilterParameters structure to get/set object params.
+- Use BiquadParameters structure to get/set object params.
 
 \author Will Pirkle http://www.willpirkle.com
 \remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
 \version Revision : 1.0
 \date Date : 2018 / 09 / 7
 */
-class CombFilter : public IAudioSignalProcessor
+class PhaseShifter : public IAudioSignalProcessor
 {
 public:
-	CombFilter(void) {}		/* C-TOR */
-	~CombFilter(void) {}	/* D-TOR */
+	PhaseShifter(void) {
+		OscillatorParameters lfoparams = lfo.getParameters();
+		lfoparams.waveform = generatorWaveform::kTriangle;	// kTriangle LFO for phaser
+	//	lfoparams.waveform = generatorWaveform::kSin;		// kTriangle LFO for phaser
+		lfo.setParameters(lfoparams);
+
+		AudioFilterParameters params = apf[0].getParameters();
+		params.algorithm = filterAlgorithm::kAPF1; // can also use 2nd order
+		// params.Q = 0.001; use low Q if using 2nd order APFs
+
+		for (int i = 0; i < PHASER_STAGES; i++)
+		{
+			apf[i].setParameters(params);
+		}
+	}	/* C-TOR */
+
+	~PhaseShifter(void) {}	/* D-TOR */
 
 public:
 	/** reset members to initialized state */
 	virtual bool reset(double _sampleRate)
 	{
-		// --- flush
-		lpf_state = 0.0;
+		// --- reset LFO
+		lfo.reset(_sampleRate);
 
-		// --- create new buffer, will store sample rate and length(mSec)
-		createDelayBuffer(sampleRate, bufferLength_mSec);
+		// --- reset APFs
+		for (int i = 0; i < PHASER_STAGES; i++){
+			apf[i].reset(_sampleRate);
+		}
 
 		return true;
 	}
 
-	/** process CombFilter */
+	/** process autio through phaser */
 	/**
 	\param xn input
 	\return the processed sample
 	*/
 	virtual double processAudioSample(double xn)
 	{
-		double yn = delay.readDelay();
-		double input = 0.0;
+		SignalGenData lfoData = lfo.renderAudioOutput();
 
-		// --- form input & write
-		if (combFilterParameters.enableLPF)
-		{
-			// --- apply simple 1st order pole LPF
-			double g2 = lpf_g*(1.0 - comb_g); // see book for equation 11.27 (old book)
-			double filteredSignal = yn + g2*lpf_state;
-			input = xn + comb_g*(filteredSignal);
-			lpf_state = filteredSignal;
-		}
-		else
-		{
-			input = xn + comb_g*yn;
-		}
+		// --- create the bipolar modulator value
+		double lfoValue = lfoData.normalOutput;
+		if (parameters.quadPhaseLFO)
+			lfoValue = lfoData.quadPhaseOutput_pos;
 
-		delay.writeDelay(input);
+		double depth = parameters.lfoDepth_Pct / 100.0;
+		double modulatorValue = lfoValue*depth;
 
-		// --- done
-		return yn;
-	}
+		// --- calculate modulated values for each APF; note they have different ranges
+		AudioFilterParameters params = apf[0].getParameters();
+		params.fc = doBipolarModulation(modulatorValue, apf0_minF, apf0_maxF);
+		apf[0].setParameters(params);
 
-	/** return false: this object only processes samples */
-	virtual bool canProcessAudioFrame() { return false; }
+		params = apf[1].getParameters();
+		params.fc = doBipolarModulation(modulatorValue, apf1_minF, apf1_maxF);
+		apf[1].setParameters(params);
 
-	/** get parameters: note use of custom structure for passing param data */
-	/**
-	\return CombFilterParameters custom data structure
-	*/
-	CombFilterParameters getParameters()
-	{
-		return combFilterParameters;
-	}
+		params = apf[2].getParameters();
+		params.fc = doBipolarModulation(modulatorValue, apf2_minF, apf2_maxF);
+		apf[2].setParameters(params);
 
-	/** set parameters: note use of custom structure for passing param data */
-	/**
-	\param CombFilterParameters custom data structure
-	*/
-	void setParameters(const CombFilterParameters& params)
-	{
-		combFilterParameters = params;
+		params = apf[3].getParameters();
+		params.fc = doBipolarModulation(modulatorValue, apf3_minF, apf3_maxF);
+		apf[3].setParameters(params);
 
-		// --- update the delay line parameters first
-		SimpleDelayParameters delayParams = delay.getParameters();
-		delayParams.delayTime_mSec = combFilterParameters.delayTime_mSec;
-		delayParams.interpolate = combFilterParameters.interpolate;
-		delay.setParameters(delayParams); // this will set the delay time in samples
+		params = apf[4].getParameters();
+		params.fc = doBipolarModulation(modulatorValue, apf4_minF, apf4_maxF);
+		apf[4].setParameters(params);
 
-										  // --- calculate g with RT60 time (requires updated delay above^^)
-		double exponent = -3.0*delayParams.delay_Samples*(1.0 / sampleRate);
-		double rt60_mSec = combFilterParameters.RT60Time_mSec / 1000.0; // RT is in mSec!
-		comb_g = pow(10.0, exponent / rt60_mSec);
+		params = apf[5].getParameters();
+		params.fc = doBipolarModulation(modulatorValue, apf5_minF, apf5_maxF);
+		apf[5].setParameters(params);
 
-		// --- set LPF g
-		lpf_g = combFilterParameters.lpf_g;
-	}
+		// --- calculate gamma values
+		double gamma1 = apf[5].getG_value();
+		double gamma2 = apf[4].getG_value() * gamma1;
+		double gamma3 = apf[3].getG_value() * gamma2;
+		double gamma4 = apf[2].getG_value() * gamma3;
+		double gamma5 = apf[1].getG_value() * gamma4;
+		double gamma6 = apf[0].getG_value() * gamma5;
 
-	/** create new buffers */
-	void createDelayBuffer(double _sampleRate, double delay_mSec)
-	{
-		sampleRate = _sampleRate;
-		bufferLength_mSec = delay_mSec;
+		// --- set the alpha0 value
+		double K = parameters.intensity_Pct / 100.0;
+		double alpha0 = 1.0 / (1.0 + K*gamma6);
 
-		// --- create new buffer, will store sample rate and length(mSec)
-		delay.createDelayBuffer(_sampleRate, delay_mSec);
+		// --- create combined feedback
+		double Sn = gamma5*apf[0].getS_value() + gamma4*apf[1].getS_value() + gamma3*apf[2].getS_value() + gamma2*apf[3].getS_value() + gamma1*apf[4].getS_value() + apf[5].getS_value();
+
+		// --- form input to first APF
+		double u = alpha0*(xn + K*Sn);
+
+		// --- cascade of APFs (could also nest these in one massive line of code)
+		double APF1 = apf[0].processAudioSample(u);
+		double APF2 = apf[1].processAudioSample(APF1);
+		double APF3 = apf[2].processAudioSample(APF2);
+		double APF4 = apf[3].processAudioSample(APF3);
+		double APF5 = apf[4].processAudioSample(APF4);
+		double APF6 = apf[5].processAudioSample(APF5);
+
+		// --- sum with -3dB coefficients
+		//	double output = 0.707*xn + 0.707*APF6;
+
+		// --- sum with National Semiconductor design ratio:
+		//	   dry = 0.5, wet = 5.0
+		// double output = 0.5*xn + 5.0*APF6;
+		// double output = 0.25*xn + 2.5*APF6;
+		double output = 0.125*xn + 1.25*APF6;
+
+		return output;
 	}
 
-private:
-	CombFilterParameters combFilterParameters; ///< object parameters
-	double sampleRate = 0.0;	///< sample rate
-	double comb_g = 0.0;		///< g value for comb filter (feedback, not %)
-	double bufferLength_mSec = 0.0; ///< total buffer length
+	/** return false: this object only processes samples */
+	virtual bool canProcessAudioFrame() { return false; }
 
-	// --- LPF support
-	double lpf_g = 0.0;		///< LPF g value
-	double lpf_state = 0.0; ///< state register for LPF (z^-1)
+	/** get parameters: note use of custom structure for passing param data */
+	/**
+	\return PhaseShifterParameters custom data structure
+	*/
+	PhaseShifterParameters getParameters() { return parameters; }
 
-	// --- delay buffer of doubles
-	SimpleDelay delay;		///< delay for comb filter
+	/** set parameters: note use of custom structure for passing param data */
+	/**
+	\param PhaseShifterParameters custom data structure
+	*/
+	void setParameters(const PhaseShifterParameters& params)
+	{
+		// --- update LFO rate
+		if (params.lfoRate_Hz != parameters.lfoRate_Hz)
+		{
+			OscillatorParameters lfoparams = lfo.getParameters();
+			lfoparams.frequency_Hz = params.lfoRate_Hz;
+			lfo.setParameters(lfoparams);
+		}
+
+		// --- save new
+		parameters = params;
+	}
+protected:
+	PhaseShifterParameters parameters;  ///< the object parameters
+	AudioFilter apf[PHASER_STAGES];		///< six APF objects
+	LFO lfo;							///< the one and only LFO
 };
 
 /**
-\struct DelayAPFParameters
+\struct SimpleLPFParameters
 \ingroup FX-Objects
 \brief
-Custom parameter structure for the DelayAPF object. Used for reverb algorithms in book.
+Custom parameter structure for the SimpleLPFP object. Used for reverb algorithms in book.
 
 \author Will Pirkle http://www.willpirkle.com
 \remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
 \version Revision : 1.0
 \date Date : 2018 / 09 / 7
 */
-struct DelayAPFParameters
+struct SimpleLPFParameters
 {
-	DelayAPFParameters() {}
+	SimpleLPFParameters() {}
 	/** all FXObjects parameter objects require overloaded= operator so remember to add new entries if you add new variables. */
-	DelayAPFParameters& operator=(const DelayAPFParameters& params)	// need this override for collections to work
+	SimpleLPFParameters& operator=(const SimpleLPFParameters& params)	// need this override for collections to work
 	{
 		if (this == &params)
 			return *this;
 
-		delayTime_mSec = params.delayTime_mSec;
-		apf_g = params.apf_g;
-		enableLPF = params.enableLPF;
-		lpf_g = params.lpf_g;
-		interpolate = params.interpolate;
-		enableLFO = params.enableLFO;
-		lfoRate_Hz = params.lfoRate_Hz;
-		lfoDepth = params.lfoDepth;
-		lfoMaxModulation_mSec = params.lfoMaxModulation_mSec;
+		g = params.g;
 		return *this;
 	}
 
 	// --- individual parameters
-	double delayTime_mSec = 0.0;	///< APF delay time
-	double apf_g = 0.0;				///< APF g coefficient
-	bool enableLPF = false;			///< flag to enable LPF in structure
-	double lpf_g = 0.0;				///< LPF g coefficient (if enabled)
-	bool interpolate = false;		///< interpolate flag (diagnostics)
-	bool enableLFO = false;			///< flag to enable LFO
-	double lfoRate_Hz = 0.0;		///< LFO rate in Hz, if enabled
-	double lfoDepth = 0.0;			///< LFO deoth (not in %) if enabled
-	double lfoMaxModulation_mSec = 0.0;	///< LFO maximum modulation time in mSec
-
+	double g = 0.0; ///< simple LPF g value
 };
 
 /**
-\class DelayAPF
+\class SimpleLPF
 \ingroup FX-Objects
 \brief
-The DelayAPF object implements a delaying APF with optional LPF and optional modulated delay time with LFO.
+The SimpleLPF object implements a first order one-pole LPF using one coefficient "g" value.
 
 Audio I/O:
 - Processes mono input to mono output.
 
 Control I/F:
-- Use DelayAPFParameters structure to get/set object params.
+- Use SimpleLPFParameters structure to get/set object params.
 
 \author Will Pirkle http://www.willpirkle.com
 \remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
 \version Revision : 1.0
 \date Date : 2018 / 09 / 7
 */
-class DelayAPF : public IAudioSignalProcessor
+class SimpleLPF : public IAudioSignalProcessor
 {
 public:
-	DelayAPF(void) {}	/* C-TOR */
-	~DelayAPF(void) {}	/* D-TOR */
+	SimpleLPF(void) {}	/* C-TOR */
+	~SimpleLPF(void) {}	/* D-TOR */
 
 public:
 	/** reset members to initialized state */
 	virtual bool reset(double _sampleRate)
 	{
-		// --- reset children
-		modLFO.reset(_sampleRate);
-
-		// --- flush
-		lpf_state = 0.0;
-
-		// --- create new buffer, will store sample rate and length(mSec)
-		createDelayBuffer(sampleRate, bufferLength_mSec);
-
+		state = 0.0;
 		return true;
 	}
 
-	/** process one input sample through object */
+	/** get parameters: note use of custom structure for passing param data */
 	/**
-	\param xn input
-	\return the processed sample
+	\return SimpleLPFParameters custom data structure
 	*/
-	virtual double processAudioSample(double xn)
+	SimpleLPFParameters getParameters()
 	{
-		SimpleDelayParameters delayParams = delay.getParameters();
-		if (delayParams.delay_Samples == 0)
-			return xn;
-
-		// --- delay line output
-		double wnD = 0.0;
-		double apf_g = delayAPFParameters.apf_g;
-		double lpf_g = delayAPFParameters.lpf_g;
-		double lfoDepth = delayAPFParameters.lfoDepth;
-
-		// --- for modulated APFs
-		if (delayAPFParameters.enableLFO)
-		{
-			SignalGenData lfoOutput = modLFO.renderAudioOutput();
-			double maxDelay = delayParams.delayTime_mSec;
-			double minDelay = maxDelay - delayAPFParameters.lfoMaxModulation_mSec;
-			minDelay = fmax(0.0, minDelay); // bound minDelay to 0 as minimum
-
-			// --- calc max-down modulated value with unipolar converted LFO output
-			//     NOTE: LFO output is scaled by lfoDepth
-			double modDelay_mSec = doUnipolarModulationFromMax(bipolarToUnipolar(lfoDepth*lfoOutput.normalOutput),
-				minDelay, maxDelay);
-
-			// --- read modulated value to get w(n-D);
-			wnD = delay.readDelayAtTime_mSec(modDelay_mSec);
-		}
-		else
-			// --- read the delay line to get w(n-D)
-			wnD = delay.readDelay();
-
-		if (delayAPFParameters.enableLPF)
-		{
-			// --- apply simple 1st order pole LPF, overwrite wnD
-			wnD = wnD*(1.0 - lpf_g) + lpf_g*lpf_state;
-			lpf_state = wnD;
-		}
-
-		// form w(n) = x(n) + gw(n-D)
-		double wn = xn + apf_g*wnD;
-
-		// form y(n) = -gw(n) + w(n-D)
-		double yn = -apf_g*wn + wnD;
-
-		// underflow check
-		checkFloatUnderflow(yn);
-
-		// write delay line
-		delay.writeDelay(wn);
-
-		return yn;
+		return simpleLPFParameters;
 	}
 
-	/** return false: this object only processes samples */
-	virtual bool canProcessAudioFrame() { return false; }
-
-	/** get parameters: note use of custom structure for passing param data */
+	/** set parameters: note use of custom structure for passing param data */
 	/**
-	\return DelayAPFParameters custom data structure
+	\param SimpleLPFParameters custom data structure
 	*/
-	DelayAPFParameters getParameters()
+	void setParameters(const SimpleLPFParameters& params)
 	{
-		return delayAPFParameters;
+		simpleLPFParameters = params;
 	}
 
-	/** set parameters: note use of custom structure for passing param data */
+	/** process simple one pole FB back filter */
 	/**
-	\param DelayAPFParameters custom data structure
+	\param xn input
+	\return the processed sample
 	*/
-	void setParameters(const DelayAPFParameters& params)
+	virtual double processAudioSample(double xn)
 	{
-		delayAPFParameters = params;
-
-		// --- update delay line
-		SimpleDelayParameters delayParams = delay.getParameters();
-		delayParams.delayTime_mSec = delayAPFParameters.delayTime_mSec;
-		delay.setParameters(delayParams);
+		double g = simpleLPFParameters.g;
+		double yn = (1.0 - g)*xn + g*state;
+		state = yn;
+		return yn;
 	}
 
-	/** create the delay buffer in mSec */
-	void createDelayBuffer(double _sampleRate, double delay_mSec)
-	{
-		sampleRate = _sampleRate;
-		bufferLength_mSec = delay_mSec;
+	/** return false: this object only processes samples */
+	virtual bool canProcessAudioFrame() { return false; }
 
-		// --- create new buffer, will store sample rate and length(mSec)
-		delay.createDelayBuffer(_sampleRate, delay_mSec);
-	}
-
-protected:
-	// --- component parameters
-	DelayAPFParameters delayAPFParameters;	///< obeject parameters
-	double sampleRate = 0.0;				///< current sample rate
-	double bufferLength_mSec = 0.0;			///< total buffer length in mSec
-
-	// --- delay buffer of doubles
-	SimpleDelay delay;						///< delay
-
-	// --- optional LFO
-	LFO modLFO;								///< LFO
-
-	// --- LPF support
-	double lpf_state = 0.0;					///< LPF state register (z^-1)
+private:
+	SimpleLPFParameters simpleLPFParameters;	///< object parameters
+	double state = 0.0;							///< single state (z^-1) register
 };
 
-
 /**
-\struct NestedDelayAPFParameters
+\struct SimpleDelayParameters
 \ingroup FX-Objects
 \brief
-Custom parameter structure for the NestedDelayAPF object. Used for reverb algorithms in book.
+Custom parameter structure for the SimpleDelay object. Used for reverb algorithms in book.
 
 \author Will Pirkle http://www.willpirkle.com
 \remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
 \version Revision : 1.0
 \date Date : 2018 / 09 / 7
 */
-struct NestedDelayAPFParameters
+struct SimpleDelayParameters
 {
-	NestedDelayAPFParameters() {}
+	SimpleDelayParameters() {}
 	/** all FXObjects parameter objects require overloaded= operator so remember to add new entries if you add new variables. */
-	NestedDelayAPFParameters& operator=(const NestedDelayAPFParameters& params)	// need this override for collections to work
+	SimpleDelayParameters& operator=(const SimpleDelayParameters& params)	// need this override for collections to work
 	{
 		if (this == &params)
 			return *this;
 
-		outerAPFdelayTime_mSec = params.outerAPFdelayTime_mSec;
-		innerAPFdelayTime_mSec = params.innerAPFdelayTime_mSec;
-		outerAPF_g = params.outerAPF_g;
-		innerAPF_g = params.innerAPF_g;
-
-		// --- outer LFO
-		enableLFO = params.enableLFO;
-		lfoRate_Hz = params.lfoRate_Hz;
-		lfoDepth = params.lfoDepth;
-		lfoMaxModulation_mSec = params.lfoMaxModulation_mSec;
-
+		delayTime_mSec = params.delayTime_mSec;
+		interpolate = params.interpolate;
+		interpolationType = params.interpolationType;
+		delay_Samples = params.delay_Samples;
 		return *this;
 	}
 
 	// --- individual parameters
-	double outerAPFdelayTime_mSec = 0.0;	///< delay time for outer APF
-	double innerAPFdelayTime_mSec = 0.0;	///< delay time for inner APF
-	double outerAPF_g = 0.0;				///< g coefficient for outer APF
-	double innerAPF_g = 0.0;				///< g coefficient for inner APF
-
-	// --- this LFO belongs to the outer APF only
-	bool enableLFO = false;					///< flag to enable the modulated delay
-	double lfoRate_Hz = 0.0;				///< LFO rate in Hz (if enabled)
-	double lfoDepth = 1.0;					///< LFO depth (not in %) (if enabled)
-	double lfoMaxModulation_mSec = 0.0;		///< max modulation time if LFO is enabled
+	double delayTime_mSec = 0.0;	///< delay tine in mSec
+	bool interpolate = false;		///< interpolation flag (diagnostics usually)
+	delayInterpolation interpolationType = delayInterpolation::kLinear; ///< interpolation type, if enabled
 
+	// --- outbound parameters
+	double delay_Samples = 0.0;		///< current delay in samples; other objects may need to access this information
 };
 
 /**
-\class NestedDelayAPF
+\class SimpleDelay
 \ingroup FX-Objects
 \brief
-The NestedDelayAPF object implements a pair of nested Delaying APF structures. These are labled the
-outer and inner APFs. The outer APF's LPF and LFO may be optionally enabled. You might want
-to extend this object to enable and use the inner LPF and LFO as well.
+The SimpleDelay object implements a basic delay line without feedback.
 
 Audio I/O:
 - Processes mono input to mono output.
 
 Control I/F:
-- Use BiquadParameters structure to get/set object params.
+- Use SimpleDelayParameters structure to get/set object params.
 
 \author Will Pirkle http://www.willpirkle.com
 \remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
 \version Revision : 1.0
 \date Date : 2018 / 09 / 7
 */
-class NestedDelayAPF : public DelayAPF
+class SimpleDelay : public IAudioSignalProcessor
 {
 public:
-	NestedDelayAPF(void) { }	/* C-TOR */
-	~NestedDelayAPF(void) { }	/* D-TOR */
+	SimpleDelay(void) {}	/* C-TOR */
+	~SimpleDelay(void) {}	/* D-TOR */
 
 public:
 	/** reset members to initialized state */
 	virtual bool reset(double _sampleRate)
 	{
-		// --- call base class reset first
-		DelayAPF::reset(_sampleRate);
+		// --- if sample rate did not change
+		if (sampleRate == _sampleRate)
+		{
+			// --- just flush buffer and return
+			delayBuffer.flushBuffer();
+			return true;
+		}
 
-		// --- then do our stuff
-		nestedAPF.reset(_sampleRate);
+		// --- create new buffer, will store sample rate and length(mSec)
+		createDelayBuffer(_sampleRate, bufferLength_mSec);
 
 		return true;
 	}
 
-	/** process mono audio input */
+	/** get parameters: note use of custom structure for passing param data */
+	/**
+	\return SimpleDelayParameters custom data structure
+	*/
+	SimpleDelayParameters getParameters()
+	{
+		return simpleDelayParameters;
+	}
+
+	/** set parameters: note use of custom structure for passing param data */
+	/**
+	\param SimpleDelayParameters custom data structure
+	*/
+	void setParameters(const SimpleDelayParameters& params)
+	{
+		simpleDelayParameters = params;
+		simpleDelayParameters.delay_Samples = simpleDelayParameters.delayTime_mSec*(samplesPerMSec);
+		delayBuffer.setInterpolate(simpleDelayParameters.interpolate);
+		delayBuffer.setInterpolationType(simpleDelayParameters.interpolationType);
+	}
+
+	/** process MONO audio delay */
 	/**
 	\param xn input
 	\return the processed sample
 	*/
 	virtual double processAudioSample(double xn)
 	{
-		// --- delay line output
-		double wnD = 0.0;
-
-		SimpleDelayParameters delayParams = delay.getParameters();
-		if (delayParams.delay_Samples == 0)
+		// --- read delay
+		if (simpleDelayParameters.delay_Samples == 0)
 			return xn;
 
-		double apf_g = delayAPFParameters.apf_g;
-		double lpf_g = delayAPFParameters.lpf_g;
-
-		// --- for modulated APFs
-		if (delayAPFParameters.enableLFO)
-		{
-			SignalGenData lfoOutput = modLFO.renderAudioOutput();
-			double maxDelay = delayParams.delayTime_mSec;
-			double minDelay = maxDelay - delayAPFParameters.lfoMaxModulation_mSec;
-			minDelay = fmax(0.0, minDelay); // bound minDelay to 0 as minimum
-			double lfoDepth = delayAPFParameters.lfoDepth;
-
-			// --- calc max-down modulated value with unipolar converted LFO output
-			//     NOTE: LFO output is scaled by lfoDepth
-			double modDelay_mSec = doUnipolarModulationFromMax(bipolarToUnipolar(lfoDepth*lfoOutput.normalOutput),
-				minDelay, maxDelay);
-
-			// --- read modulated value to get w(n-D);
-			wnD = delay.readDelayAtTime_mSec(modDelay_mSec);
-		}
-		else
-			// --- read the delay line to get w(n-D)
-			wnD = delay.readDelay();
-
-		if (delayAPFParameters.enableLPF)
-		{
-			// --- apply simple 1st order pole LPF, overwrite wnD
-			wnD = wnD*(1.0 - lpf_g) + lpf_g*lpf_state;
-			lpf_state = wnD;
-		}
-
-		// --- form w(n) = x(n) + gw(n-D)
-		double wn = xn + apf_g*wnD;
-
-		// --- process wn through inner APF
-		double ynInner = nestedAPF.processAudioSample(wn);
-
-		// --- form y(n) = -gw(n) + w(n-D)
-		double yn = -apf_g*wn + wnD;
-
-		// --- underflow check
-		checkFloatUnderflow(yn);
+		double yn = delayBuffer.readBuffer(simpleDelayParameters.delay_Samples);
 
-		// --- write delay line
-		delay.writeDelay(ynInner);
+		// --- write to delay buffer
+		delayBuffer.writeBuffer(xn);
 
+		// --- done
 		return yn;
 	}
 
-	/** get parameters: note use of custom structure for passing param data */
-	/**
-	\return BiquadParameters custom data structure
-	*/
-	NestedDelayAPFParameters getParameters() { return nestedAPFParameters; }
+	/** reset members to initialized state */
+	virtual bool canProcessAudioFrame() { return false; }
 
-	/** set parameters: note use of custom structure for passing param data */
-	/**
-	\param BiquadParameters custom data structure
-	*/
-	void setParameters(const NestedDelayAPFParameters& params)
+	/** create a new delay buffer */
+	void createDelayBuffer(double _sampleRate, double _bufferLength_mSec)
 	{
-		nestedAPFParameters = params;
+		// --- store for math
+		bufferLength_mSec = _bufferLength_mSec;
+		sampleRate = _sampleRate;
+		samplesPerMSec = sampleRate / 1000.0;
 
-		DelayAPFParameters outerAPFParameters = DelayAPF::getParameters();
-		DelayAPFParameters innerAPFParameters = nestedAPF.getParameters();
+		// --- total buffer length including fractional part
+		bufferLength = (unsigned int)(bufferLength_mSec*(samplesPerMSec)) + 1; // +1 for fractional part
 
-		// --- outer APF
-		outerAPFParameters.apf_g = nestedAPFParameters.outerAPF_g;
-		outerAPFParameters.delayTime_mSec = nestedAPFParameters.outerAPFdelayTime_mSec;
+		// --- create new buffer
+		delayBuffer.createCircularBuffer(bufferLength);
+	}
 
-		// --- LFO support
-		outerAPFParameters.enableLFO = nestedAPFParameters.enableLFO;
-		outerAPFParameters.lfoDepth = nestedAPFParameters.lfoDepth;
-		outerAPFParameters.lfoRate_Hz = nestedAPFParameters.lfoRate_Hz;
-		outerAPFParameters.lfoMaxModulation_mSec = nestedAPFParameters.lfoMaxModulation_mSec;
+	/** read delay at current location */
+	double readDelay()
+	{
+		// --- simple read
+		return delayBuffer.readBuffer(simpleDelayParameters.delay_Samples);
+	}
 
-		// --- inner APF
-		innerAPFParameters.apf_g = nestedAPFParameters.innerAPF_g;
-		innerAPFParameters.delayTime_mSec = nestedAPFParameters.innerAPFdelayTime_mSec;
+	/** read delay at current location */
+	double readDelayAtTime_mSec(double _delay_mSec)
+	{
+		// --- calculate total delay time in samples + fraction
+		double _delay_Samples = _delay_mSec*(samplesPerMSec);
 
-		DelayAPF::setParameters(outerAPFParameters);
-		nestedAPF.setParameters(innerAPFParameters);
+		// --- simple read
+		return delayBuffer.readBuffer(_delay_Samples);
 	}
 
-	/** createDelayBuffers -- note there are two delay times here for inner and outer APFs*/
-	void createDelayBuffers(double _sampleRate, double delay_mSec, double nestedAPFDelay_mSec)
+	/** read delay at a percentage of total length */
+	double readDelayAtPercentage(double delayPercent)
 	{
-		// --- base class
-		DelayAPF::createDelayBuffer(_sampleRate, delay_mSec);
+		// --- simple read
+		return delayBuffer.readBuffer((delayPercent / 100.0)*simpleDelayParameters.delay_Samples);
+	}
 
-		// --- then our stuff
-		nestedAPF.createDelayBuffer(_sampleRate, nestedAPFDelay_mSec);
+	/** write a new value into the delay */
+	void writeDelay(double xn)
+	{
+		// --- simple write
+		delayBuffer.writeBuffer(xn);
 	}
 
 private:
-	NestedDelayAPFParameters nestedAPFParameters; ///< object parameters
-	DelayAPF nestedAPF;	///< nested APF object
+	SimpleDelayParameters simpleDelayParameters; ///< object parameters
+
+	double sampleRate = 0.0;		///< sample rate
+	double samplesPerMSec = 0.0;	///< samples per millisecond (for arbitrary access)
+	double bufferLength_mSec = 0.0; ///< total buffer lenth in mSec
+	unsigned int bufferLength = 0;	///< buffer length in samples
+
+	// --- delay buffer of doubles
+	CircularBuffer<double> delayBuffer; ///< circular buffer for delay
 };
 
+
 /**
-\struct TwoBandShelvingFilterParameters
+\struct CombFilterParameters
 \ingroup FX-Objects
 \brief
-Custom parameter structure for the TwoBandShelvingFilter object. Used for reverb algorithms in book.
+Custom parameter structure for the CombFilter object. Used for reverb algorithms in book.
 
 \author Will Pirkle http://www.willpirkle.com
 \remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
 \version Revision : 1.0
 \date Date : 2018 / 09 / 7
 */
-struct TwoBandShelvingFilterParameters
+struct CombFilterParameters
 {
-	TwoBandShelvingFilterParameters() {}
+	CombFilterParameters() {}
 	/** all FXObjects parameter objects require overloaded= operator so remember to add new entries if you add new variables. */
-	TwoBandShelvingFilterParameters& operator=(const TwoBandShelvingFilterParameters& params)	// need this override for collections to work
+	CombFilterParameters& operator=(const CombFilterParameters& params)	// need this override for collections to work
 	{
 		if (this == &params)
 			return *this;
 
-		lowShelf_fc = params.lowShelf_fc;
-		lowShelfBoostCut_dB = params.lowShelfBoostCut_dB;
-		highShelf_fc = params.highShelf_fc;
-		highShelfBoostCut_dB = params.highShelfBoostCut_dB;
-		return *this;
+		delayTime_mSec = params.delayTime_mSec;
+		RT60Time_mSec = params.RT60Time_mSec;
+		enableLPF = params.enableLPF;
+		lpf_g = params.lpf_g;
+		interpolate = params.interpolate;
+		return *this;
 	}
 
 	// --- individual parameters
-	double lowShelf_fc = 0.0;			///< fc for low shelf
-	double lowShelfBoostCut_dB = 0.0;	///< low shelf gain
-	double highShelf_fc = 0.0;			///< fc for high shelf
-	double highShelfBoostCut_dB = 0.0;	///< high shelf gain
+	double delayTime_mSec = 0.0;	///< delay time in mSec
+	double RT60Time_mSec = 0.0;		///< RT 60 time ini mSec
+	bool enableLPF = false;			///< enable LPF flag
+	double lpf_g = 0.0;				///< gain value for LPF (if enabled)
+	bool interpolate = false;		///< interpolation flag (diagnostics)
 };
 
+
 /**
-\class TwoBandShelvingFilter
+\class CombFilter
 \ingroup FX-Objects
 \brief
-The TwoBandShelvingFilter object implements two shelving filters in series in the standard "Bass and Treble" configuration.
+The CombFilter object implements a comb filter with optional LPF in feedback loop. Used for reverb algorithms in book.
 
 Audio I/O:
 - Processes mono input to mono output.
 
 Control I/F:
-- Use TwoBandShelvingFilterParameters structure to get/set object params.
+- Use CombFilterParameters structure to get/set object params.
 
 \author Will Pirkle http://www.willpirkle.com
 \remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
 \version Revision : 1.0
 \date Date : 2018 / 09 / 7
 */
-class TwoBandShelvingFilter : public IAudioSignalProcessor
+class CombFilter : public IAudioSignalProcessor
 {
 public:
-	TwoBandShelvingFilter()
-	{
-		AudioFilterParameters params = lowShelfFilter.getParameters();
-		params.algorithm = filterAlgorithm::kLowShelf;
-		lowShelfFilter.setParameters(params);
-
-		params = highShelfFilter.getParameters();
-		params.algorithm = filterAlgorithm::kHiShelf;
-		highShelfFilter.setParameters(params);
-	}		/* C-TOR */
-
-	~TwoBandShelvingFilter() {}		/* D-TOR */
+	CombFilter(void) {}		/* C-TOR */
+	~CombFilter(void) {}	/* D-TOR */
 
+public:
 	/** reset members to initialized state */
 	virtual bool reset(double _sampleRate)
 	{
-		lowShelfFilter.reset(_sampleRate);
-		highShelfFilter.reset(_sampleRate);
+		// --- flush
+		lpf_state = 0.0;
+
+		// --- create new buffer, will store sample rate and length(mSec)
+		createDelayBuffer(sampleRate, bufferLength_mSec);
+
 		return true;
 	}
 
-	/** return false: this object only processes samples */
-	virtual bool canProcessAudioFrame() { return false; }
-
-	/** process a single input through the two filters in series */
+	/** process CombFilter */
 	/**
 	\param xn input
 	\return the processed sample
 	*/
 	virtual double processAudioSample(double xn)
 	{
-		// --- all modes do Full Wave Rectification
-		double filteredSignal = lowShelfFilter.processAudioSample(xn);
-		filteredSignal = highShelfFilter.processAudioSample(filteredSignal);
+		double yn = delay.readDelay();
+		double input = 0.0;
 
-		return filteredSignal;
+		// --- form input & write
+		if (combFilterParameters.enableLPF)
+		{
+			// --- apply simple 1st order pole LPF
+			double g2 = lpf_g*(1.0 - comb_g); // see book for equation 11.27 (old book)
+			double filteredSignal = yn + g2*lpf_state;
+			input = xn + comb_g*(filteredSignal);
+			lpf_state = filteredSignal;
+		}
+		else
+		{
+			input = xn + comb_g*yn;
+		}
+
+		delay.writeDelay(input);
+
+		// --- done
+		return yn;
 	}
 
+	/** return false: this object only processes samples */
+	virtual bool canProcessAudioFrame() { return false; }
+
 	/** get parameters: note use of custom structure for passing param data */
 	/**
-	\return TwoBandShelvingFilterParameters custom data structure
+	\return CombFilterParameters custom data structure
 	*/
-	TwoBandShelvingFilterParameters getParameters()
+	CombFilterParameters getParameters()
 	{
-		return parameters;
+		return combFilterParameters;
 	}
 
 	/** set parameters: note use of custom structure for passing param data */
 	/**
-	\param TwoBandShelvingFilterParameters custom data structure
+	\param CombFilterParameters custom data structure
 	*/
-	void setParameters(const TwoBandShelvingFilterParameters& params)
+	void setParameters(const CombFilterParameters& params)
 	{
-		parameters = params;
-		AudioFilterParameters filterParams = lowShelfFilter.getParameters();
-		filterParams.fc = parameters.lowShelf_fc;
-		filterParams.boostCut_dB = parameters.lowShelfBoostCut_dB;
-		lowShelfFilter.setParameters(filterParams);
+		combFilterParameters = params;
 
-		filterParams = highShelfFilter.getParameters();
-		filterParams.fc = parameters.highShelf_fc;
-		filterParams.boostCut_dB = parameters.highShelfBoostCut_dB;
-		highShelfFilter.setParameters(filterParams);
+		// --- update the delay line parameters first
+		SimpleDelayParameters delayParams = delay.getParameters();
+		delayParams.delayTime_mSec = combFilterParameters.delayTime_mSec;
+		delayParams.interpolate = combFilterParameters.interpolate;
+		delay.setParameters(delayParams); // this will set the delay time in samples
+
+										  // --- calculate g with RT60 time (requires updated delay above^^)
+		double exponent = -3.0*delayParams.delay_Samples*(1.0 / sampleRate);
+		double rt60_mSec = combFilterParameters.RT60Time_mSec / 1000.0; // RT is in mSec!
+		comb_g = pow(10.0, exponent / rt60_mSec);
+
+		// --- set LPF g
+		lpf_g = combFilterParameters.lpf_g;
 	}
 
-private:
-	TwoBandShelvingFilterParameters parameters; ///< object parameters
-	AudioFilter lowShelfFilter;					///< filter for low shelf
-	AudioFilter highShelfFilter;				///< filter for high shelf
-};
+	/** create new buffers */
+	void createDelayBuffer(double _sampleRate, double delay_mSec)
+	{
+		sampleRate = _sampleRate;
+		bufferLength_mSec = delay_mSec;
 
-/**
-\enum reverbDensity
-\ingroup Constants-Enums
-\brief
-Use this strongly typed enum to easily set the density in the reverb object.
+		// --- create new buffer, will store sample rate and length(mSec)
+		delay.createDelayBuffer(_sampleRate, delay_mSec);
+	}
 
-- enum class reverbDensity { kThick, kSparse };
+private:
+	CombFilterParameters combFilterParameters; ///< object parameters
+	double sampleRate = 0.0;	///< sample rate
+	double comb_g = 0.0;		///< g value for comb filter (feedback, not %)
+	double bufferLength_mSec = 0.0; ///< total buffer length
 
-\author Will Pirkle http://www.willpirkle.com
-\remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
-\version Revision : 1.0
-\date Date : 2018 / 09 / 7
-*/
-enum class reverbDensity { kThick, kSparse };
+	// --- LPF support
+	double lpf_g = 0.0;		///< LPF g value
+	double lpf_state = 0.0; ///< state register for LPF (z^-1)
+
+	// --- delay buffer of doubles
+	SimpleDelay delay;		///< delay for comb filter
+};
 
 /**
-\struct ReverbTankParameters
+\struct DelayAPFParameters
 \ingroup FX-Objects
 \brief
-Custom parameter structure for the ReverbTank object.
+Custom parameter structure for the DelayAPF object. Used for reverb algorithms in book.
 
 \author Will Pirkle http://www.willpirkle.com
 \remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
 \version Revision : 1.0
 \date Date : 2018 / 09 / 7
 */
-struct ReverbTankParameters
+struct DelayAPFParameters
 {
-	ReverbTankParameters() {}
+	DelayAPFParameters() {}
 	/** all FXObjects parameter objects require overloaded= operator so remember to add new entries if you add new variables. */
-	ReverbTankParameters& operator=(const ReverbTankParameters& params)	// need this override for collections to work
+	DelayAPFParameters& operator=(const DelayAPFParameters& params)	// need this override for collections to work
 	{
 		if (this == &params)
 			return *this;
 
-		density = params.density;
-
-		// --- tweaker variables
-		apfDelayMax_mSec = params.apfDelayMax_mSec;
-		apfDelayWeight_Pct = params.apfDelayWeight_Pct;
-		fixeDelayMax_mSec = params.fixeDelayMax_mSec;
-		fixeDelayWeight_Pct = params.fixeDelayWeight_Pct;
-		preDelayTime_mSec = params.preDelayTime_mSec;
-
+		delayTime_mSec = params.delayTime_mSec;
+		apf_g = params.apf_g;
+		enableLPF = params.enableLPF;
 		lpf_g = params.lpf_g;
-		kRT = params.kRT;
-
-		lowShelf_fc = params.lowShelf_fc;
-		lowShelfBoostCut_dB = params.lowShelfBoostCut_dB;
-		highShelf_fc = params.highShelf_fc;
-		highShelfBoostCut_dB = params.highShelfBoostCut_dB;
-
-		wetLevel_dB = params.wetLevel_dB;
-		dryLevel_dB = params.dryLevel_dB;
+		interpolate = params.interpolate;
+		interpolationType = params.interpolationType;
+		enableLFO = params.enableLFO;
+		lfoRate_Hz = params.lfoRate_Hz;
+		lfoDepth = params.lfoDepth;
+		lfoMaxModulation_mSec = params.lfoMaxModulation_mSec;
 		return *this;
 	}
 
 	// --- individual parameters
-	reverbDensity density = reverbDensity::kThick;	///< density setting thick or thin
-
-	// --- tweaking parameters - you may not want to expose these
-	//     in the final plugin!
-	// --- See the book for all the details on how these tweakers work!!
-	double apfDelayMax_mSec = 5.0;					///< APF max delay time
-	double apfDelayWeight_Pct = 100.0;				///< APF max delay weighying
-	double fixeDelayMax_mSec = 50.0;				///< fixed delay max time
-	double fixeDelayWeight_Pct = 100.0;				///< fixed delay max weighying
-
-	// --- direct control parameters
-	double preDelayTime_mSec = 0.0;					///< pre-delay time in mSec
-	double lpf_g = 0.0;								///< LPF g coefficient
-	double kRT = 0.0;								///< reverb time, 0 to 1
-
-	double lowShelf_fc = 0.0;						///< low shelf fc
-	double lowShelfBoostCut_dB = 0.0;				///< low shelf gain
-	double highShelf_fc = 0.0;						///< high shelf fc
-	double highShelfBoostCut_dB = 0.0;				///< high shelf gain
+	double delayTime_mSec = 0.0;	///< APF delay time
+	double apf_g = 0.0;				///< APF g coefficient
+	bool enableLPF = false;			///< flag to enable LPF in structure
+	double lpf_g = 0.0;				///< LPF g coefficient (if enabled)
+	bool interpolate = false;		///< interpolate flag (diagnostics)
+	delayInterpolation interpolationType = delayInterpolation::kLinear; ///< interpolation type for modulated reads, if enabled
+	bool enableLFO = false;			///< flag to enable LFO
+	double lfoRate_Hz = 0.0;		///< LFO rate in Hz, if enabled
+	double lfoDepth = 0.0;			///< LFO deoth (not in %) if enabled
+	double lfoMaxModulation_mSec = 0.0;	///< LFO maximum modulation time in mSec
 
-	double wetLevel_dB = -3.0;						///< wet output level in dB
-	double dryLevel_dB = -3.0;						///< dry output level in dB
 };
 
-// --- constants for reverb tank
-const unsigned int NUM_BRANCHES = 4;
-const unsigned int NUM_CHANNELS = 2; // stereo
-
 /**
-\class ReverbTank
+\class DelayAPF
 \ingroup FX-Objects
 \brief
-The ReverbTank object implements the cyclic reverb tank in the FX book listed below.
+The DelayAPF object implements a delaying APF with optional LPF and optional modulated delay time with LFO.
 
 Audio I/O:
-- Processes mono input to mono OR stereo output.
+- Processes mono input to mono output.
 
 Control I/F:
-- Use ReverbTankParameters structure to get/set object params.
+- Use DelayAPFParameters structure to get/set object params.
 
 \author Will Pirkle http://www.willpirkle.com
 \remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
 \version Revision : 1.0
 \date Date : 2018 / 09 / 7
 */
-class ReverbTank : public IAudioSignalProcessor
+class DelayAPF : public IAudioSignalProcessor
 {
 public:
-	ReverbTank() {}		/* C-TOR */
-	~ReverbTank() {}	/* D-TOR */
+	DelayAPF(void) {}	/* C-TOR */
+	~DelayAPF(void) {}	/* D-TOR */
 
+public:
 	/** reset members to initialized state */
 	virtual bool reset(double _sampleRate)
 	{
-		// ---store
-		sampleRate = _sampleRate;
+		// --- reset children
+		modLFO.reset(_sampleRate);
 
-		// ---set up preDelay
-		preDelay.reset(_sampleRate);
-		preDelay.createDelayBuffer(_sampleRate, 100.0);
+		// --- flush
+		lpf_state = 0.0;
 
-		for (int i = 0; i < NUM_BRANCHES; i++)
-		{
-			branchDelays[i].reset(_sampleRate);
-			branchDelays[i].createDelayBuffer(_sampleRate, 100.0);
+		// --- create new buffer, will store sample rate and length(mSec)
+		createDelayBuffer(sampleRate, bufferLength_mSec);
 
-			branchNestedAPFs[i].reset(_sampleRate);
-			branchNestedAPFs[i].createDelayBuffers(_sampleRate, 100.0, 100.0);
+		return true;
+	}
 
-			branchLPFs[i].reset(_sampleRate);
-		}
-		for (int i = 0; i < NUM_CHANNELS; i++)
-		{
-			shelvingFilters[i].reset(_sampleRate);
-		}
-
-		return true;
-	}
-
-	/** return true: this object can process frames */
-	virtual bool canProcessAudioFrame() { return true; }
-
-	/** process mono reverb tank */
+	/** process one input sample through object */
 	/**
 	\param xn input
 	\return the processed sample
 	*/
 	virtual double processAudioSample(double xn)
 	{
-		float inputs[2] = { 0.0 };
-		float outputs[2] = { 0.0 };
-		processAudioFrame(inputs, outputs, 1, 1);
-		return outputs[0];
-	}
-
-	/** process stereo reverb tank */
-	virtual bool processAudioFrame(const float* inputFrame,
-		float* outputFrame,
-		uint32_t inputChannels,
-		uint32_t outputChannels)
-	{
-		// --- global feedback from delay in last branch
-		double globFB = branchDelays[NUM_BRANCHES-1].readDelay();
-
-		// --- feedback value
-		double fb = parameters.kRT*(globFB);
-
-		// --- mono-ized input signal
-		double xnL = inputFrame[0];
-		double xnR = inputChannels > 1 ? inputFrame[1] : 0.0;
-		double monoXn = double(1.0 / inputChannels)*xnL + double(1.0 / inputChannels)*xnR;
+		SimpleDelayParameters delayParams = delay.getParameters();
+		if (delayParams.delay_Samples == 0)
+			return xn;
 
-		// --- pre delay output
-		double preDelayOut = preDelay.processAudioSample(monoXn);
+		// --- delay line output
+		double wnD = 0.0;
+		double apf_g = delayAPFParameters.apf_g;
+		double lpf_g = delayAPFParameters.lpf_g;
+		double lfoDepth = delayAPFParameters.lfoDepth;
 
-		// --- input to first branch = preDalay + globFB
-		double input = preDelayOut + fb;
-		for (int i = 0; i < NUM_BRANCHES; i++)
+		// --- for modulated APFs
+		if (delayAPFParameters.enableLFO)
 		{
-			double apfOut = branchNestedAPFs[i].processAudioSample(input);
-			double lpfOut = branchLPFs[i].processAudioSample(apfOut);
-			double delayOut = parameters.kRT*branchDelays[i].processAudioSample(lpfOut);
-			input = delayOut + preDelayOut;
-		}
-		// --- gather outputs
-		/*
-		There are 25 prime numbers between 1 and 100.
-		They are 2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37, 41,
-		43, 47, 53, 59, 61, 67, 71, 73, 79, 83, 89, and 97
-
-		we want 16 of them: 23, 29, 31, 37, 41,
-		43, 47, 53, 59, 61, 67, 71, 73, 79, 83, 89, and 97
-		*/
-
-		double weight = 0.707;
+			SignalGenData lfoOutput = modLFO.renderAudioOutput();
+			double maxDelay = delayParams.delayTime_mSec;
+			double minDelay = maxDelay - delayAPFParameters.lfoMaxModulation_mSec;
+			minDelay = fmax(0.0, minDelay); // bound minDelay to 0 as minimum
 
-		double outL= 0.0;
-		outL += weight*branchDelays[0].readDelayAtPercentage(23.0);
-		outL -= weight*branchDelays[1].readDelayAtPercentage(41.0);
-		outL += weight*branchDelays[2].readDelayAtPercentage(59.0);
-		outL -= weight*branchDelays[3].readDelayAtPercentage(73.0);
+			// --- calc max-down modulated value with unipolar converted LFO output
+			//     NOTE: LFO output is scaled by lfoDepth
+			double modDelay_mSec = doUnipolarModulationFromMax(bipolarToUnipolar(lfoDepth*lfoOutput.normalOutput),
+				minDelay, maxDelay);
 
-		double outR = 0.0;
-		outR -= weight*branchDelays[0].readDelayAtPercentage(29.0);
-		outR += weight*branchDelays[1].readDelayAtPercentage(43.0);
-		outR -= weight*branchDelays[2].readDelayAtPercentage(61.0);
-		outR += weight*branchDelays[3].readDelayAtPercentage(79.0);
+			// --- read modulated value to get w(n-D);
+			wnD = delay.readDelayAtTime_mSec(modDelay_mSec);
+		}
+		else
+			// --- read the delay line to get w(n-D)
+			wnD = delay.readDelay();
 
-		if (parameters.density == reverbDensity::kThick)
+		if (delayAPFParameters.enableLPF)
 		{
-			outL += weight*branchDelays[0].readDelayAtPercentage(31.0);
-			outL -= weight*branchDelays[1].readDelayAtPercentage(47.0);
-			outL += weight*branchDelays[2].readDelayAtPercentage(67.0);
-			outL -= weight*branchDelays[3].readDelayAtPercentage(83.0);
-
-			outR -= weight*branchDelays[0].readDelayAtPercentage(37.0);
-			outR += weight*branchDelays[1].readDelayAtPercentage(53.0);
-			outR -= weight*branchDelays[2].readDelayAtPercentage(71.0);
-			outR += weight*branchDelays[3].readDelayAtPercentage(89.0);
+			// --- apply simple 1st order pole LPF, overwrite wnD
+			wnD = wnD*(1.0 - lpf_g) + lpf_g*lpf_state;
+			lpf_state = wnD;
 		}
 
-		// ---  filter
-		double tankOutL = shelvingFilters[0].processAudioSample(outL);
-		double tankOutR = shelvingFilters[1].processAudioSample(outR);
+		// form w(n) = x(n) + gw(n-D)
+		double wn = xn + apf_g*wnD;
 
-		// --- sum with dry
-		double dry = pow(10.0, parameters.dryLevel_dB / 20.0);
-		double wet = pow(10.0, parameters.wetLevel_dB / 20.0);
+		// form y(n) = -gw(n) + w(n-D)
+		double yn = -apf_g*wn + wnD;
 
-		if (outputChannels == 1)
-			outputFrame[0] = dry*xnL + wet*(0.5*tankOutL + 0.5*tankOutR);
-		else
-		{
-			outputFrame[0] = dry*xnL + wet*tankOutL;
-			outputFrame[1] = dry*xnR + wet*tankOutR;
-		}
+		// underflow check
+		checkFloatUnderflow(yn);
 
-		return true;
+		// write delay line
+		delay.writeDelay(wn);
+
+		return yn;
 	}
 
+	/** return false: this object only processes samples */
+	virtual bool canProcessAudioFrame() { return false; }
+
 	/** get parameters: note use of custom structure for passing param data */
 	/**
-	\return ReverbTankParameters custom data structure
+	\return DelayAPFParameters custom data structure
 	*/
-	ReverbTankParameters getParameters() { return parameters; }
+	DelayAPFParameters getParameters()
+	{
+		return delayAPFParameters;
+	}
 
 	/** set parameters: note use of custom structure for passing param data */
 	/**
-	\param ReverbTankParameters custom data structure
+	\param DelayAPFParameters custom data structure
 	*/
-	void setParameters(const ReverbTankParameters& params)
+	void setParameters(const DelayAPFParameters& params)
 	{
-		// --- do the updates here, the sub-components will only update themselves if
-		//     their parameters changed, so we let those object handle that chore
-		TwoBandShelvingFilterParameters filterParams = shelvingFilters[0].getParameters();
-		filterParams.highShelf_fc = params.highShelf_fc;
-		filterParams.highShelfBoostCut_dB = params.highShelfBoostCut_dB;
-		filterParams.lowShelf_fc = params.lowShelf_fc;
-		filterParams.lowShelfBoostCut_dB = params.lowShelfBoostCut_dB;
-
-		// --- copy to both channels
-		shelvingFilters[0].setParameters(filterParams);
-		shelvingFilters[1].setParameters(filterParams);
-
-		SimpleLPFParameters  lpfParams = branchLPFs[0].getParameters();
-		lpfParams.g = params.lpf_g;
-
-		for (int i = 0; i < NUM_BRANCHES; i++)
-		{
-			branchLPFs[i].setParameters(lpfParams);
-		}
-
-		// --- update pre delay
-		SimpleDelayParameters delayParams = preDelay.getParameters();
-		delayParams.delayTime_mSec = params.preDelayTime_mSec;
-		preDelay.setParameters(delayParams);
-
-		// --- set apf and delay parameters
-		int m = 0;
-		NestedDelayAPFParameters apfParams = branchNestedAPFs[0].getParameters();
-		delayParams = branchDelays[0].getParameters();
-
-		// --- global max Delay times
-		double globalAPFMaxDelay = (parameters.apfDelayWeight_Pct / 100.0)*parameters.apfDelayMax_mSec;
-		double globalFixedMaxDelay = (parameters.fixeDelayWeight_Pct / 100.0)*parameters.fixeDelayMax_mSec;
-
-		// --- lfo
-		apfParams.enableLFO = true;
-		apfParams.lfoMaxModulation_mSec = 0.3;
-		apfParams.lfoDepth = 1.0;
-
-		for (int i = 0; i < NUM_BRANCHES; i++)
-		{
-			// --- setup APFs
-			apfParams.outerAPFdelayTime_mSec = globalAPFMaxDelay*apfDelayWeight[m++];
-			apfParams.innerAPFdelayTime_mSec = globalAPFMaxDelay*apfDelayWeight[m++];
-			apfParams.innerAPF_g = -0.5;
-			apfParams.outerAPF_g = 0.5;
-			if (i == 0)
-				apfParams.lfoRate_Hz = 0.15;
-			else if (i == 1)
-				apfParams.lfoRate_Hz = 0.33;
-			else if (i == 2)
-				apfParams.lfoRate_Hz = 0.57;
-			else if (i == 3)
-				apfParams.lfoRate_Hz = 0.73;
+		delayAPFParameters = params;
 
-			branchNestedAPFs[i].setParameters(apfParams);
+		// --- update delay line
+		SimpleDelayParameters delayParams = delay.getParameters();
+		delayParams.delayTime_mSec = delayAPFParameters.delayTime_mSec;
+		delayParams.interpolate = delayAPFParameters.interpolate;
+		delayParams.interpolationType = delayAPFParameters.interpolationType;
+		delay.setParameters(delayParams);
+	}
 
-			// --- fixedDelayWeight
-			delayParams.delayTime_mSec = globalFixedMaxDelay*fixedDelayWeight[i];
-			branchDelays[i].setParameters(delayParams);
-		}
+	/** create the delay buffer in mSec */
+	void createDelayBuffer(double _sampleRate, double delay_mSec)
+	{
+		sampleRate = _sampleRate;
+		bufferLength_mSec = delay_mSec;
 
-		// --- save our copy
-		parameters = params;
+		// --- create new buffer, will store sample rate and length(mSec)
+		delay.createDelayBuffer(_sampleRate, delay_mSec);
 	}
 
+protected:
+	// --- component parameters
+	DelayAPFParameters delayAPFParameters;	///< obeject parameters
+	double sampleRate = 0.0;				///< current sample rate
+	double bufferLength_mSec = 0.0;			///< total buffer length in mSec
 
-private:
-	ReverbTankParameters parameters;				///< object parameters
-
-	SimpleDelay  preDelay;							///< pre delay object
-	SimpleDelay  branchDelays[NUM_BRANCHES];		///< branch delay objects
-	NestedDelayAPF branchNestedAPFs[NUM_BRANCHES];	///< nested APFs for each branch
-	SimpleLPF  branchLPFs[NUM_BRANCHES];			///< LPFs in each branch
+	// --- delay buffer of doubles
+	SimpleDelay delay;						///< delay
 
-	TwoBandShelvingFilter shelvingFilters[NUM_CHANNELS]; ///< shelving filters 0 = left; 1 = right
+	// --- optional LFO
+	LFO modLFO;								///< LFO
 
-	// --- weighting values to make various and low-correlated APF delay values easily
-	double apfDelayWeight[NUM_BRANCHES * 2] = { 0.317, 0.873, 0.477, 0.291, 0.993, 0.757, 0.179, 0.575 };///< weighting values to make various and low-correlated APF delay values easily
-	double fixedDelayWeight[NUM_BRANCHES] = { 1.0, 0.873, 0.707, 0.667 };	///< weighting values to make various and fixed delay values easily
-	double sampleRate = 0.0;	///< current sample rate
+	// --- LPF support
+	double lpf_state = 0.0;					///< LPF state register (z^-1)
 };
 
 
 /**
-\class PeakLimiter
+\struct NestedDelayAPFParameters
 \ingroup FX-Objects
 \brief
-The PeakLimiter object implements a simple peak limiter; it is really a simplified and hard-wired
-versio of the DynamicsProcessor
-
-Audio I/O:
-- Processes mono input to mono output.
-
-Control I/F:
-- setThreshold_dB(double _threshold_dB) to adjust the limiter threshold
-- setMakeUpGain_dB(double _makeUpGain_dB) to adjust the makeup gain
+Custom parameter structure for the NestedDelayAPF object. Used for reverb algorithms in book.
 
 \author Will Pirkle http://www.willpirkle.com
 \remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
 \version Revision : 1.0
 \date Date : 2018 / 09 / 7
 */
-class PeakLimiter : public IAudioSignalProcessor
+struct NestedDelayAPFParameters
 {
-public:
-	PeakLimiter() { setThreshold_dB(-3.0); }
-	~PeakLimiter() {}
-
-	/** reset members to initialized state */
+	NestedDelayAPFParameters() {}
+	/** all FXObjects parameter objects require overloaded= operator so remember to add new entries if you add new variables. */
+	NestedDelayAPFParameters& operator=(const NestedDelayAPFParameters& params)	// need this override for collections to work
+	{
+		if (this == &params)
+			return *this;
+
+		outerAPFdelayTime_mSec = params.outerAPFdelayTime_mSec;
+		innerAPFdelayTime_mSec = params.innerAPFdelayTime_mSec;
+		outerAPF_g = params.outerAPF_g;
+		innerAPF_g = params.innerAPF_g;
+
+		// --- outer LFO
+		enableLFO = params.enableLFO;
+		lfoRate_Hz = params.lfoRate_Hz;
+		lfoDepth = params.lfoDepth;
+		lfoMaxModulation_mSec = params.lfoMaxModulation_mSec;
+		interpolate = params.interpolate;
+		interpolationType = params.interpolationType;
+
+		return *this;
+	}
+
+	// --- individual parameters
+	double outerAPFdelayTime_mSec = 0.0;	///< delay time for outer APF
+	double innerAPFdelayTime_mSec = 0.0;	///< delay time for inner APF
+	double outerAPF_g = 0.0;				///< g coefficient for outer APF
+	double innerAPF_g = 0.0;				///< g coefficient for inner APF
+
+	// --- this LFO belongs to the outer APF only
+	bool enableLFO = false;					///< flag to enable the modulated delay
+	double lfoRate_Hz = 0.0;				///< LFO rate in Hz (if enabled)
+	double lfoDepth = 1.0;					///< LFO depth (not in %) (if enabled)
+	double lfoMaxModulation_mSec = 0.0;		///< max modulation time if LFO is enabled
+	bool interpolate = false;				///< interpolate flag for the outer APF modulated reads
+	delayInterpolation interpolationType = delayInterpolation::kLinear; ///< outer APF interpolation type, if enabled
+
+};
+
+/**
+\class NestedDelayAPF
+\ingroup FX-Objects
+\brief
+The NestedDelayAPF object implements a pair of nested Delaying APF structures. These are labled the
+outer and inner APFs. The outer APF's LPF and LFO may be optionally enabled. You might want
+to extend this object to enable and use the inner LPF and LFO as well.
+
+Audio I/O:
+- Processes mono input to mono output.
+
+Control I/F:
+- Use BiquadParameters structure to get/set object params.
+
+\author Will Pirkle http://www.willpirkle.com
+\remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
+\version Revision : 1.0
+\date Date : 2018 / 09 / 7
+*/
+class NestedDelayAPF : public DelayAPF
+{
+public:
+	NestedDelayAPF(void) { }	/* C-TOR */
+	~NestedDelayAPF(void) { }	/* D-TOR */
+
+public:
+	/** reset members to initialized state */
 	virtual bool reset(double _sampleRate)
 	{
-		// --- init; true = analog time-constant
-		detector.setSampleRate(_sampleRate);
+		// --- call base class reset first
+		DelayAPF::reset(_sampleRate);
 
-		AudioDetectorParameters detectorParams = detector.getParameters();
-		detectorParams.detect_dB = true;
-		detectorParams.attackTime_mSec = 5.0;
-		detectorParams.releaseTime_mSec = 25.0;
-		detectorParams.clampToUnityMax = false;
-		detectorParams.detectMode = ENVELOPE_DETECT_MODE_PEAK;
-		detector.setParameters(detectorParams);
+		// --- then do our stuff
+		nestedAPF.reset(_sampleRate);
 
 		return true;
 	}
 
-	/** return false: this object only processes samples */
-	virtual bool canProcessAudioFrame() { return false; }
-
-	/** process audio: implement hard limiter */
+	/** process mono audio input */
 	/**
 	\param xn input
 	\return the processed sample
 	*/
 	virtual double processAudioSample(double xn)
 	{
-		return dB2Raw(makeUpGain_dB)*xn*computeGain(detector.processAudioSample(xn));
-	}
+		// --- delay line output
+		double wnD = 0.0;
 
-	/** compute the gain reductino value based on detected value in dB */
-	double computeGain(double detect_dB)
-	{
-		double output_dB = 0.0;
+		SimpleDelayParameters delayParams = delay.getParameters();
+		if (delayParams.delay_Samples == 0)
+			return xn;
 
-		// --- defaults - you can change these here
-		bool softknee = true;
-		double kneeWidth_dB = 10.0;
+		double apf_g = delayAPFParameters.apf_g;
+		double lpf_g = delayAPFParameters.lpf_g;
 
-		// --- hard knee
-		if (!softknee)
+		// --- for modulated APFs
+		if (delayAPFParameters.enableLFO)
 		{
-			// --- below threshold, unity
-			if (detect_dB <= threshold_dB)
-				output_dB = detect_dB;
-			// --- above threshold, compress
-			else
-				output_dB = threshold_dB;
+			SignalGenData lfoOutput = modLFO.renderAudioOutput();
+			double maxDelay = delayParams.delayTime_mSec;
+			double minDelay = maxDelay - delayAPFParameters.lfoMaxModulation_mSec;
+			minDelay = fmax(0.0, minDelay); // bound minDelay to 0 as minimum
+			double lfoDepth = delayAPFParameters.lfoDepth;
+
+			// --- calc max-down modulated value with unipolar converted LFO output
+			//     NOTE: LFO output is scaled by lfoDepth
+			double modDelay_mSec = doUnipolarModulationFromMax(bipolarToUnipolar(lfoDepth*lfoOutput.normalOutput),
+				minDelay, maxDelay);
+
+			// --- read modulated value to get w(n-D);
+			wnD = delay.readDelayAtTime_mSec(modDelay_mSec);
 		}
 		else
+			// --- read the delay line to get w(n-D)
+			wnD = delay.readDelay();
+
+		if (delayAPFParameters.enableLPF)
 		{
-			// --- calc gain with knee
-			// --- left side of knee, outside of width, unity gain zone
-			if (2.0*(detect_dB - threshold_dB) < -kneeWidth_dB)
-				output_dB = detect_dB;
-			// --- inside the knee,
-			else if (2.0*(fabs(detect_dB - threshold_dB)) <= kneeWidth_dB)
-				output_dB = detect_dB - pow((detect_dB - threshold_dB + (kneeWidth_dB / 2.0)), 2.0) / (2.0*kneeWidth_dB);
-			// --- right of knee, compression zone
-			else if (2.0*(detect_dB - threshold_dB) > kneeWidth_dB)
-				output_dB = threshold_dB;
+			// --- apply simple 1st order pole LPF, overwrite wnD
+			wnD = wnD*(1.0 - lpf_g) + lpf_g*lpf_state;
+			lpf_state = wnD;
 		}
 
-		// --- convert difference between threshold and detected to raw
-		return  pow(10.0, (output_dB - detect_dB) / 20.0);
+		// --- form w(n) = x(n) + gw(n-D)
+		double wn = xn + apf_g*wnD;
+
+		// --- process wn through inner APF
+		double ynInner = nestedAPF.processAudioSample(wn);
+
+		// --- form y(n) = -gw(n) + w(n-D)
+		double yn = -apf_g*wn + wnD;
+
+		// --- underflow check
+		checkFloatUnderflow(yn);
+
+		// --- write delay line
+		delay.writeDelay(ynInner);
+
+		return yn;
 	}
 
-	/** adjust threshold in dB */
-	void setThreshold_dB(double _threshold_dB) { threshold_dB = _threshold_dB; }
+	/** get parameters: note use of custom structure for passing param data */
+	/**
+	\return BiquadParameters custom data structure
+	*/
+	NestedDelayAPFParameters getParameters() { return nestedAPFParameters; }
 
-	/** adjust makeup gain in dB*/
-	void setMakeUpGain_dB(double _makeUpGain_dB) { makeUpGain_dB = _makeUpGain_dB; }
+	/** set parameters: note use of custom structure for passing param data */
+	/**
+	\param BiquadParameters custom data structure
+	*/
+	void setParameters(const NestedDelayAPFParameters& params)
+	{
+		nestedAPFParameters = params;
 
-protected:
-	AudioDetector detector;		///< the detector object
-	double threshold_dB = 0.0;	///< stored threshold (dB)
-	double makeUpGain_dB = 0.0;	///< stored makeup gain (dB)
-};
+		DelayAPFParameters outerAPFParameters = DelayAPF::getParameters();
+		DelayAPFParameters innerAPFParameters = nestedAPF.getParameters();
 
+		// --- outer APF
+		outerAPFParameters.apf_g = nestedAPFParameters.outerAPF_g;
+		outerAPFParameters.delayTime_mSec = nestedAPFParameters.outerAPFdelayTime_mSec;
 
-/**
-\enum vaFilterAlgorithm
-\ingroup Constants-Enums
-\brief
-Use this strongly typed enum to easily set the virtual analog filter algorithm
+		// --- LFO support
+		outerAPFParameters.enableLFO = nestedAPFParameters.enableLFO;
+		outerAPFParameters.lfoDepth = nestedAPFParameters.lfoDepth;
+		outerAPFParameters.lfoRate_Hz = nestedAPFParameters.lfoRate_Hz;
+		outerAPFParameters.lfoMaxModulation_mSec = nestedAPFParameters.lfoMaxModulation_mSec;
+		outerAPFParameters.interpolate = nestedAPFParameters.interpolate;
+		outerAPFParameters.interpolationType = nestedAPFParameters.interpolationType;
 
-- enum class vaFilterAlgorithm { kLPF1, kHPF1, kAPF1, kSVF_LP, kSVF_HP, kSVF_BP, kSVF_BS };
+		// --- inner APF
+		innerAPFParameters.apf_g = nestedAPFParameters.innerAPF_g;
+		innerAPFParameters.delayTime_mSec = nestedAPFParameters.innerAPFdelayTime_mSec;
 
-\author Will Pirkle http://www.willpirkle.com
-\remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
-\version Revision : 1.0
-\date Date : 2018 / 09 / 7
-*/
-enum class vaFilterAlgorithm {
-	kLPF1, kHPF1, kAPF1, kSVF_LP, kSVF_HP, kSVF_BP, kSVF_BS
-}; // --- you will add more here...
+		DelayAPF::setParameters(outerAPFParameters);
+		nestedAPF.setParameters(innerAPFParameters);
+	}
+
+	/** createDelayBuffers -- note there are two delay times here for inner and outer APFs*/
+	void createDelayBuffers(double _sampleRate, double delay_mSec, double nestedAPFDelay_mSec)
+	{
+		// --- base class
+		DelayAPF::createDelayBuffer(_sampleRate, delay_mSec);
+
+		// --- then our stuff
+		nestedAPF.createDelayBuffer(_sampleRate, nestedAPFDelay_mSec);
+	}
 
+private:
+	NestedDelayAPFParameters nestedAPFParameters; ///< object parameters
+	DelayAPF nestedAPF;	///< nested APF object
+};
 
 /**
-\struct ZVAFilterParameters
+\struct TwoBandShelvingFilterParameters
 \ingroup FX-Objects
 \brief
-Custom parameter structure for the ZVAFilter object.
+Custom parameter structure for the TwoBandShelvingFilter object. Used for reverb algorithms in book.
 
 \author Will Pirkle http://www.willpirkle.com
 \remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
 \version Revision : 1.0
 \date Date : 2018 / 09 / 7
 */
-struct ZVAFilterParameters
+struct TwoBandShelvingFilterParameters
 {
-	ZVAFilterParameters() {}
+	TwoBandShelvingFilterParameters() {}
 	/** all FXObjects parameter objects require overloaded= operator so remember to add new entries if you add new variables. */
-	ZVAFilterParameters& operator=(const ZVAFilterParameters& params)	// need this override for collections to work
+	TwoBandShelvingFilterParameters& operator=(const TwoBandShelvingFilterParameters& params)	// need this override for collections to work
 	{
 		if (this == &params)
 			return *this;
 
-		filterAlgorithm = params.filterAlgorithm;
-		fc = params.fc;
-		Q = params.Q;
-		filterOutputGain_dB = params.filterOutputGain_dB;
-		enableGainComp = params.enableGainComp;
-		matchAnalogNyquistLPF = params.matchAnalogNyquistLPF;
-		selfOscillate = params.selfOscillate;
-		enableNLP = params.enableNLP;
+		lowShelf_fc = params.lowShelf_fc;
+		lowShelfBoostCut_dB = params.lowShelfBoostCut_dB;
+		highShelf_fc = params.highShelf_fc;
+		highShelfBoostCut_dB = params.highShelfBoostCut_dB;
 		return *this;
 	}
 
 	// --- individual parameters
-	vaFilterAlgorithm filterAlgorithm = vaFilterAlgorithm::kSVF_LP;	///< va filter algorithm
-	double fc = 1000.0;						///< va filter fc
-	double Q = 0.707;						///< va filter Q
-	double filterOutputGain_dB = 0.0;		///< va filter gain (normally unused)
-	bool enableGainComp = false;			///< enable gain compensation (see book)
-	bool matchAnalogNyquistLPF = false;		///< match analog gain at Nyquist
-	bool selfOscillate = false;				///< enable selfOscillation
-	bool enableNLP = false;					///< enable non linear processing (use oversampling for best results)
+	double lowShelf_fc = 0.0;			///< fc for low shelf
+	double lowShelfBoostCut_dB = 0.0;	///< low shelf gain
+	double highShelf_fc = 0.0;			///< fc for high shelf
+	double highShelfBoostCut_dB = 0.0;	///< high shelf gain
 };
 
-
 /**
-\class ZVAFilter
+\class TwoBandShelvingFilter
 \ingroup FX-Objects
 \brief
-The ZVAFilter object implements multpile Zavalishin VA Filters.
+The TwoBandShelvingFilter object implements two shelving filters in series in the standard "Bass and Treble" configuration.
+
 Audio I/O:
 - Processes mono input to mono output.
 
 Control I/F:
-- Use BiquadParameters structure to get/set object params.
+- Use TwoBandShelvingFilterParameters structure to get/set object params.
 
 \author Will Pirkle http://www.willpirkle.com
 \remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
 \version Revision : 1.0
 \date Date : 2018 / 09 / 7
 */
-class ZVAFilter : public IAudioSignalProcessor
+class TwoBandShelvingFilter : public IAudioSignalProcessor
 {
 public:
-	ZVAFilter() {}		/* C-TOR */
-	~ZVAFilter() {}		/* D-TOR */
-
-	/** reset members to initialized state */
-	virtual bool reset(double _sampleRate)
+	TwoBandShelvingFilter()
 	{
-		sampleRate = _sampleRate;
-		integrator_z[0] = 0.0;
-		integrator_z[1] = 0.0;
+		AudioFilterParameters params = lowShelfFilter.getParameters();
+		params.algorithm = filterAlgorithm::kLowShelf;
+		lowShelfFilter.setParameters(params);
 
-		return true;
-	}
+		params = highShelfFilter.getParameters();
+		params.algorithm = filterAlgorithm::kHiShelf;
+		highShelfFilter.setParameters(params);
+	}		/* C-TOR */
 
-	/** get parameters: note use of custom structure for passing param data */
-	/**
-	\return ZVAFilterParameters custom data structure
-	*/
-	ZVAFilterParameters getParameters()
-	{
-		return zvaFilterParameters;
-	}
+	~TwoBandShelvingFilter() {}		/* D-TOR */
 
-	/** set parameters: note use of custom structure for passing param data */
-	/**
-	\param ZVAFilterParameters custom data structure
-	*/
-	void setParameters(const ZVAFilterParameters& params)
+	/** reset members to initialized state */
+	virtual bool reset(double _sampleRate)
 	{
-		if (params.fc != zvaFilterParameters.fc ||
-			params.Q != zvaFilterParameters.Q ||
-			params.selfOscillate != zvaFilterParameters.selfOscillate ||
-			params.matchAnalogNyquistLPF != zvaFilterParameters.matchAnalogNyquistLPF)
-		{
-				zvaFilterParameters = params;
-				calculateFilterCoeffs();
-		}
-		else
-			zvaFilterParameters = params;
+		lowShelfFilter.reset(_sampleRate);
+		highShelfFilter.reset(_sampleRate);
+		return true;
 	}
 
 	/** return false: this object only processes samples */
 	virtual bool canProcessAudioFrame() { return false; }
 
-	/** process input x(n) through the VA filter to produce return value y(n) */
+	/** process a single input through the two filters in series */
 	/**
 	\param xn input
 	\return the processed sample
 	*/
 	virtual double processAudioSample(double xn)
 	{
-		// --- with gain comp enabled, we reduce the input by
-		//     half the gain in dB at resonant peak
-		//     NOTE: you can change that logic here!
-		vaFilterAlgorithm filterAlgorithm = zvaFilterParameters.filterAlgorithm;
-		bool matchAnalogNyquistLPF = zvaFilterParameters.matchAnalogNyquistLPF;
-
-		if (zvaFilterParameters.enableGainComp)
-		{
-			double peak_dB = dBPeakGainFor_Q(zvaFilterParameters.Q);
-			if (peak_dB > 0.0)
-			{
-				double halfPeak_dBGain = dB2Raw(-peak_dB / 2.0);
-				xn *= halfPeak_dBGain;
-			}
-		}
-
-		// --- for 1st order filters:
-		if (filterAlgorithm == vaFilterAlgorithm::kLPF1 ||
-			filterAlgorithm == vaFilterAlgorithm::kHPF1 ||
-			filterAlgorithm == vaFilterAlgorithm::kAPF1)
-		{
-			// --- create vn node
-			double vn = (xn - integrator_z[0])*alpha;
-
-			// --- form LP output
-			double lpf = ((xn - integrator_z[0])*alpha) + integrator_z[0];
-
-			// double sn = integrator_z[0];
-
-			// --- update memory
-			integrator_z[0] = vn + lpf;
-
-			// --- form the HPF = INPUT = LPF
-			double hpf = xn - lpf;
-
-			// --- form the APF = LPF - HPF
-			double apf = lpf - hpf;
-
-			// --- set the outputs
-			if (filterAlgorithm == vaFilterAlgorithm::kLPF1)
-			{
-				// --- this is a very close match as-is at Nyquist!
-				if (matchAnalogNyquistLPF)
-					return lpf + alpha*hpf;
-				else
-					return lpf;
-			}
-			else if (filterAlgorithm == vaFilterAlgorithm::kHPF1)
-				return hpf;
-			else if (filterAlgorithm == vaFilterAlgorithm::kAPF1)
-				return apf;
-
-			// --- unknown filter
-			return xn;
-		}
-
-		// --- form the HP output first
-		double hpf = alpha0*(xn - rho*integrator_z[0] - integrator_z[1]);
-
-		// --- BPF Out
-		double bpf = alpha*hpf + integrator_z[0];
-		if (zvaFilterParameters.enableNLP)
-			bpf = softClipWaveShaper(bpf, 1.0);
-
-		// --- LPF Out
-		double lpf = alpha*bpf + integrator_z[1];
-
-		// --- BSF Out
-		double bsf = hpf + lpf;
-
-		// --- finite gain at Nyquist; slight error at VHF
-		double sn = integrator_z[0];
-
-		// update memory
-		integrator_z[0] = alpha*hpf + bpf;
-		integrator_z[1] = alpha*bpf + lpf;
-
-		double filterOutputGain = pow(10.0, zvaFilterParameters.filterOutputGain_dB / 20.0);
-
-		// return our selected type
-		if (filterAlgorithm == vaFilterAlgorithm::kSVF_LP)
-		{
-			if (matchAnalogNyquistLPF)
-				lpf += analogMatchSigma*(sn);
-			return filterOutputGain*lpf;
-		}
-		else if (filterAlgorithm == vaFilterAlgorithm::kSVF_HP)
-			return filterOutputGain*hpf;
-		else if (filterAlgorithm == vaFilterAlgorithm::kSVF_BP)
-			return filterOutputGain*bpf;
-		else if (filterAlgorithm == vaFilterAlgorithm::kSVF_BS)
-			return filterOutputGain*bsf;
+		// --- all modes do Full Wave Rectification
+		double filteredSignal = lowShelfFilter.processAudioSample(xn);
+		filteredSignal = highShelfFilter.processAudioSample(filteredSignal);
 
-		// --- unknown filter
-		return filterOutputGain*lpf;
+		return filteredSignal;
 	}
 
-	/** recalculate the filter coefficients*/
-	void calculateFilterCoeffs()
+	/** get parameters: note use of custom structure for passing param data */
+	/**
+	\return TwoBandShelvingFilterParameters custom data structure
+	*/
+	TwoBandShelvingFilterParameters getParameters()
 	{
-		double fc = zvaFilterParameters.fc;
-		double Q = zvaFilterParameters.Q;
-		vaFilterAlgorithm filterAlgorithm = zvaFilterParameters.filterAlgorithm;
-
-		// --- normal Zavalishin SVF calculations here
-		//     prewarp the cutoff- these are bilinear-transform filters
-		double wd = kTwoPi*fc;
-		double T = 1.0 / sampleRate;
-		double wa = (2.0 / T)*tan(wd*T / 2.0);
-		double g = wa*T / 2.0;
-
-		// --- for 1st order filters:
-		if (filterAlgorithm == vaFilterAlgorithm::kLPF1 ||
-			filterAlgorithm == vaFilterAlgorithm::kHPF1 ||
-			filterAlgorithm == vaFilterAlgorithm::kAPF1)
-		{
-			// --- calculate alpha
-			alpha = g / (1.0 + g);
-		}
-		else // state variable variety
-		{
-			// --- note R is the traditional analog damping factor zeta
-			double R = zvaFilterParameters.selfOscillate ? 0.0 : 1.0 / (2.0*Q);
-			alpha0 = 1.0 / (1.0 + 2.0*R*g + g*g);
-			alpha = g;
-			rho = 2.0*R + g;
-
-			// --- sigma for analog matching version
-			double f_o = (sampleRate / 2.0) / fc;
-			analogMatchSigma = 1.0 / (alpha*f_o*f_o);
-		}
+		return parameters;
 	}
 
-	/** set beta value, for filters that aggregate 1st order VA sections*/
-	void setBeta(double _beta) { beta = _beta; }
-
-	/** get beta value,not used in book projects; for future use*/
-	double getBeta() { return beta; }
-
-protected:
-	ZVAFilterParameters zvaFilterParameters;	///< object parameters
-	double sampleRate = 44100.0;				///< current sample rate
+	/** set parameters: note use of custom structure for passing param data */
+	/**
+	\param TwoBandShelvingFilterParameters custom data structure
+	*/
+	void setParameters(const TwoBandShelvingFilterParameters& params)
+	{
+		parameters = params;
+		AudioFilterParameters filterParams = lowShelfFilter.getParameters();
+		filterParams.fc = parameters.lowShelf_fc;
+		filterParams.boostCut_dB = parameters.lowShelfBoostCut_dB;
+		lowShelfFilter.setParameters(filterParams);
 
-	// --- state storage
-	double integrator_z[2];						///< state variables
+		filterParams = highShelfFilter.getParameters();
+		filterParams.fc = parameters.highShelf_fc;
+		filterParams.boostCut_dB = parameters.highShelfBoostCut_dB;
+		highShelfFilter.setParameters(filterParams);
+	}
 
-	// --- filter coefficients
-	double alpha0 = 0.0;		///< input scalar, correct delay-free loop
-	double alpha = 0.0;			///< alpha is (wcT/2)
-	double rho = 0.0;			///< p = 2R + g (feedback)
+private:
+	TwoBandShelvingFilterParameters parameters; ///< object parameters
+	AudioFilter lowShelfFilter;					///< filter for low shelf
+	AudioFilter highShelfFilter;				///< filter for high shelf
+};
 
-	double beta = 0.0;			///< beta value, not used
+/**
+\enum reverbDensity
+\ingroup Constants-Enums
+\brief
+Use this strongly typed enum to easily set the density in the reverb object.
 
-	// --- for analog Nyquist matching
-	double analogMatchSigma = 0.0; ///< analog matching Sigma value (see book)
+- enum class reverbDensity { kThick, kSparse };
 
-};
+\author Will Pirkle http://www.willpirkle.com
+\remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
+\version Revision : 1.0
+\date Date : 2018 / 09 / 7
+*/
+enum class reverbDensity { kThick, kSparse };
 
 /**
-\struct EnvelopeFollowerParameters
+\struct ReverbTankParameters
 \ingroup FX-Objects
 \brief
-Custom parameter structure for the EnvelopeFollower object.
+Custom parameter structure for the ReverbTank object.
 
 \author Will Pirkle http://www.willpirkle.com
 \remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
 \version Revision : 1.0
 \date Date : 2018 / 09 / 7
 */
-struct EnvelopeFollowerParameters
+struct ReverbTankParameters
 {
-	EnvelopeFollowerParameters() {}
+	ReverbTankParameters() {}
 	/** all FXObjects parameter objects require overloaded= operator so remember to add new entries if you add new variables. */
-	EnvelopeFollowerParameters& operator=(const EnvelopeFollowerParameters& params)	// need this override for collections to work
+	ReverbTankParameters& operator=(const ReverbTankParameters& params)	// need this override for collections to work
 	{
 		if (this == &params)
 			return *this;
 
-		fc = params.fc;
-		Q = params.Q;
-		attackTime_mSec = params.attackTime_mSec;
-		releaseTime_mSec = params.releaseTime_mSec;
-		threshold_dB = params.threshold_dB;
-		sensitivity = params.sensitivity;
+		density = params.density;
+
+		// --- tweaker variables
+		apfDelayMax_mSec = params.apfDelayMax_mSec;
+		apfDelayWeight_Pct = params.apfDelayWeight_Pct;
+		fixeDelayMax_mSec = params.fixeDelayMax_mSec;
+		fixeDelayWeight_Pct = params.fixeDelayWeight_Pct;
+		preDelayTime_mSec = params.preDelayTime_mSec;
+
+		lpf_g = params.lpf_g;
+		kRT = params.kRT;
+
+		lowShelf_fc = params.lowShelf_fc;
+		lowShelfBoostCut_dB = params.lowShelfBoostCut_dB;
+		highShelf_fc = params.highShelf_fc;
+		highShelfBoostCut_dB = params.highShelfBoostCut_dB;
 
+		wetLevel_dB = params.wetLevel_dB;
+		dryLevel_dB = params.dryLevel_dB;
 		return *this;
 	}
 
 	// --- individual parameters
-	double fc = 0.0;				///< filter fc
-	double Q = 0.707;				///< filter Q
-	double attackTime_mSec = 10.0;	///< detector attack time
-	double releaseTime_mSec = 10.0;	///< detector release time
-	double threshold_dB = 0.0;		///< detector threshold in dB
-	double sensitivity = 1.0;		///< detector sensitivity
+	reverbDensity density = reverbDensity::kThick;	///< density setting thick or thin
+
+	// --- tweaking parameters - you may not want to expose these
+	//     in the final plugin!
+	// --- See the book for all the details on how these tweakers work!!
+	double apfDelayMax_mSec = 5.0;					///< APF max delay time
+	double apfDelayWeight_Pct = 100.0;				///< APF max delay weighying
+	double fixeDelayMax_mSec = 50.0;				///< fixed delay max time
+	double fixeDelayWeight_Pct = 100.0;				///< fixed delay max weighying
+
+	// --- direct control parameters
+	double preDelayTime_mSec = 0.0;					///< pre-delay time in mSec
+	double lpf_g = 0.0;								///< LPF g coefficient
+	double kRT = 0.0;								///< reverb time, 0 to 1
+
+	double lowShelf_fc = 0.0;						///< low shelf fc
+	double lowShelfBoostCut_dB = 0.0;				///< low shelf gain
+	double highShelf_fc = 0.0;						///< high shelf fc
+	double highShelfBoostCut_dB = 0.0;				///< high shelf gain
+
+	double wetLevel_dB = -3.0;						///< wet output level in dB
+	double dryLevel_dB = -3.0;						///< dry output level in dB
 };
 
+// --- constants for reverb tank
+const unsigned int NUM_BRANCHES = 4;
+const unsigned int NUM_CHANNELS = 2; // stereo
+
 /**
-\class EnvelopeFollower
+\class ReverbTank
 \ingroup FX-Objects
 \brief
-The EnvelopeFollower object implements a traditional envelope follower effect modulating a LPR fc value
-using the strength of the detected input.
+The ReverbTank object implements the cyclic reverb tank in the FX book listed below.
 
 Audio I/O:
-- Processes mono input to mono output.
+- Processes mono input to mono OR stereo output.
 
 Control I/F:
-- Use EnvelopeFollowerParameters structure to get/set object params.
+- Use ReverbTankParameters structure to get/set object params.
 
 \author Will Pirkle http://www.willpirkle.com
 \remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
 \version Revision : 1.0
 \date Date : 2018 / 09 / 7
 */
-class EnvelopeFollower : public IAudioSignalProcessor
+class ReverbTank : public IAudioSignalProcessor
 {
 public:
-	EnvelopeFollower() {
-		// --- setup the filter
-		ZVAFilterParameters filterParams;
-		filterParams.filterAlgorithm = vaFilterAlgorithm::kSVF_LP;
-		filterParams.fc = 1000.0;
-		filterParams.enableGainComp = true;
-		filterParams.enableNLP = true;
-		filterParams.matchAnalogNyquistLPF = true;
-		filter.setParameters(filterParams);
-
-		// --- setup the detector
-		AudioDetectorParameters adParams;
-		adParams.attackTime_mSec = -1.0;
-		adParams.releaseTime_mSec = -1.0;
-		adParams.detectMode = TLD_AUDIO_DETECT_MODE_RMS;
-		adParams.detect_dB = true;
-		adParams.clampToUnityMax = false;
-		detector.setParameters(adParams);
-
-	}		/* C-TOR */
-	~EnvelopeFollower() {}		/* D-TOR */
+	ReverbTank() {}		/* C-TOR */
+	~ReverbTank() {}	/* D-TOR */
 
 	/** reset members to initialized state */
 	virtual bool reset(double _sampleRate)
 	{
-		filter.reset(_sampleRate);
-		detector.reset(_sampleRate);
-		return true;
-	}
-
-	/** get parameters: note use of custom structure for passing param data */
-	/**
-	\return EnvelopeFollowerParameters custom data structure
-	*/
-	EnvelopeFollowerParameters getParameters() { return parameters; }
+		// ---store
+		sampleRate = _sampleRate;
 
-	/** set parameters: note use of custom structure for passing param data */
-	/**
-	\param EnvelopeFollowerParameters custom data structure
-	*/
-	void setParameters(const EnvelopeFollowerParameters& params)
-	{
-		ZVAFilterParameters filterParams = filter.getParameters();
-		AudioDetectorParameters adParams = detector.getParameters();
+		// ---set up preDelay
+		preDelay.reset(_sampleRate);
+		preDelay.createDelayBuffer(_sampleRate, 100.0);
 
-		if (params.fc != parameters.fc || params.Q != parameters.Q)
+		for (int i = 0; i < NUM_BRANCHES; i++)
 		{
-			filterParams.fc = params.fc;
-			filterParams.Q = params.Q;
-			filter.setParameters(filterParams);
+			branchDelays[i].reset(_sampleRate);
+			branchDelays[i].createDelayBuffer(_sampleRate, 100.0);
+
+			branchNestedAPFs[i].reset(_sampleRate);
+			branchNestedAPFs[i].createDelayBuffers(_sampleRate, 100.0, 100.0);
+
+			branchLPFs[i].reset(_sampleRate);
 		}
-		if (params.attackTime_mSec != parameters.attackTime_mSec ||
-			params.releaseTime_mSec != parameters.releaseTime_mSec)
+		for (int i = 0; i < NUM_CHANNELS; i++)
 		{
-			adParams.attackTime_mSec = params.attackTime_mSec;
-			adParams.releaseTime_mSec = params.releaseTime_mSec;
-			detector.setParameters(adParams);
+			shelvingFilters[i].reset(_sampleRate);
 		}
 
-		// --- save
-		parameters = params;
+		return true;
 	}
 
-	/** return false: this object only processes samples */
-	virtual bool canProcessAudioFrame() { return false; }
+	/** return true: this object can process frames */
+	virtual bool canProcessAudioFrame() { return true; }
 
-	/** process input x(n) through the envelope follower to produce return value y(n) */
+	/** process mono reverb tank */
 	/**
 	\param xn input
 	\return the processed sample
 	*/
 	virtual double processAudioSample(double xn)
 	{
-		// --- calc threshold
-		double threshValue = pow(10.0, parameters.threshold_dB / 20.0);
+		float inputs[2] = { (float)xn, 0.0f };
+		float outputs[2] = { 0.0 };
+		processAudioFrame(inputs, outputs, 1, 1);
+		return outputs[0];
+	}
 
-		// --- detect the signal
-		double detect_dB = detector.processAudioSample(xn);
-		double detectValue = pow(10.0, detect_dB / 20.0);
-		double deltaValue = detectValue - threshValue;
+	/** process stereo reverb tank */
+	virtual bool processAudioFrame(const float* inputFrame,
+		float* outputFrame,
+		uint32_t inputChannels,
+		uint32_t outputChannels)
+	{
+		// --- global feedback from delay in last branch
+		double globFB = branchDelays[NUM_BRANCHES-1].readDelay();
 
-		ZVAFilterParameters filterParams = filter.getParameters();
-		filterParams.fc = parameters.fc;
+		// --- feedback value
+		double fb = parameters.kRT*(globFB);
 
-		// --- if above the threshold, modulate the filter fc
-		if (deltaValue > 0.0)// || delta_dB > 0.0)
-		{
-			// --- fc Computer
-			double modulatorValue = 0.0;
+		// --- mono-ized input signal
+		double xnL = inputFrame[0];
+		double xnR = inputChannels > 1 ? inputFrame[1] : 0.0;
+		double monoXn = double(1.0 / inputChannels)*xnL + double(1.0 / inputChannels)*xnR;
 
-			// --- best results are with linear values when detector is in dB mode
-			modulatorValue = (deltaValue * parameters.sensitivity);
+		// --- pre delay output
+		double preDelayOut = preDelay.processAudioSample(monoXn);
 
-			// --- calculate modulated frequency
-			filterParams.fc = doUnipolarModulationFromMin(modulatorValue, parameters.fc, kMaxFilterFrequency);
+		// --- input to first branch = preDalay + globFB
+		double input = preDelayOut + fb;
+		for (int i = 0; i < NUM_BRANCHES; i++)
+		{
+			double apfOut = branchNestedAPFs[i].processAudioSample(input);
+			double lpfOut = branchLPFs[i].processAudioSample(apfOut);
+			double delayOut = parameters.kRT*branchDelays[i].processAudioSample(lpfOut);
+			input = delayOut + preDelayOut;
 		}
+		// --- gather outputs
+		/*
+		There are 25 prime numbers between 1 and 100.
+		They are 2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37, 41,
+		43, 47, 53, 59, 61, 67, 71, 73, 79, 83, 89, and 97
 
-		// --- update with new modulated frequency
-		filter.setParameters(filterParams);
+		we want 16 of them: 23, 29, 31, 37, 41,
+		43, 47, 53, 59, 61, 67, 71, 73, 79, 83, 89, and 97
+		*/
 
-		// --- perform the filtering operation
-		return filter.processAudioSample(xn);
-	}
+		double weight = 0.707;
 
-protected:
-	EnvelopeFollowerParameters parameters; ///< object parameters
+		double outL= 0.0;
+		outL += weight*branchDelays[0].readDelayAtPercentage(23.0);
+		outL -= weight*branchDelays[1].readDelayAtPercentage(41.0);
+		outL += weight*branchDelays[2].readDelayAtPercentage(59.0);
+		outL -= weight*branchDelays[3].readDelayAtPercentage(73.0);
 
-	// --- 1 filter and 1 detector
-	ZVAFilter filter;		///< filter to modulate
-	AudioDetector detector; ///< detector to track input signal
-};
+		double outR = 0.0;
+		outR -= weight*branchDelays[0].readDelayAtPercentage(29.0);
+		outR += weight*branchDelays[1].readDelayAtPercentage(43.0);
+		outR -= weight*branchDelays[2].readDelayAtPercentage(61.0);
+		outR += weight*branchDelays[3].readDelayAtPercentage(79.0);
 
-/**
-\enum distortionModel
-\ingroup Constants-Enums
-\brief
-Use this strongly typed enum to easily set the waveshaper model for the Triode objects
+		if (parameters.density == reverbDensity::kThick)
+		{
+			outL += weight*branchDelays[0].readDelayAtPercentage(31.0);
+			outL -= weight*branchDelays[1].readDelayAtPercentage(47.0);
+			outL += weight*branchDelays[2].readDelayAtPercentage(67.0);
+			outL -= weight*branchDelays[3].readDelayAtPercentage(83.0);
 
-- enum class distortionModel { kSoftClip, kArcTan, kFuzzAsym };
+			outR -= weight*branchDelays[0].readDelayAtPercentage(37.0);
+			outR += weight*branchDelays[1].readDelayAtPercentage(53.0);
+			outR -= weight*branchDelays[2].readDelayAtPercentage(71.0);
+			outR += weight*branchDelays[3].readDelayAtPercentage(89.0);
+		}
 
-\author Will Pirkle http://www.willpirkle.com
-\remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
-\version Revision : 1.0
-\date Date : 2018 / 09 / 7
-*/
-enum class distortionModel { kSoftClip, kArcTan, kFuzzAsym };
+		// ---  filter
+		double tankOutL = shelvingFilters[0].processAudioSample(outL);
+		double tankOutR = shelvingFilters[1].processAudioSample(outR);
 
-/**
-\struct TriodeClassAParameters
-\ingroup FX-Objects
-\brief
-Custom parameter structure for the TriodeClassA object.
+		// --- sum with dry
+		double dry = pow(10.0, parameters.dryLevel_dB / 20.0);
+		double wet = pow(10.0, parameters.wetLevel_dB / 20.0);
 
-\author Will Pirkle http://www.willpirkle.com
-\remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
-\version Revision : 1.0
-\date Date : 2018 / 09 / 7
-*/
-struct TriodeClassAParameters
-{
-	TriodeClassAParameters() {}
-	/** all FXObjects parameter objects require overloaded= operator so remember to add new entries if you add new variables. */
-	TriodeClassAParameters& operator=(const TriodeClassAParameters& params)	// need this override for collections to work
+		if (outputChannels == 1)
+			outputFrame[0] = dry*xnL + wet*(0.5*tankOutL + 0.5*tankOutR);
+		else
+		{
+			outputFrame[0] = dry*xnL + wet*tankOutL;
+			outputFrame[1] = dry*xnR + wet*tankOutR;
+		}
+
+		return true;
+	}
+
+	/** get parameters: note use of custom structure for passing param data */
+	/**
+	\return ReverbTankParameters custom data structure
+	*/
+	ReverbTankParameters getParameters() { return parameters; }
+
+	/** set parameters: note use of custom structure for passing param data */
+	/**
+	\param ReverbTankParameters custom data structure
+	*/
+	void setParameters(const ReverbTankParameters& params)
 	{
-		if (this == &params)
-			return *this;
+		// --- do the updates here, the sub-components will only update themselves if
+		//     their parameters changed, so we let those object handle that chore
+		TwoBandShelvingFilterParameters filterParams = shelvingFilters[0].getParameters();
+		filterParams.highShelf_fc = params.highShelf_fc;
+		filterParams.highShelfBoostCut_dB = params.highShelfBoostCut_dB;
+		filterParams.lowShelf_fc = params.lowShelf_fc;
+		filterParams.lowShelfBoostCut_dB = params.lowShelfBoostCut_dB;
 
-		waveshaper = params.waveshaper;
-		saturation = params.saturation;
-		asymmetry = params.asymmetry;
-		outputGain = params.outputGain;
+		// --- copy to both channels
+		shelvingFilters[0].setParameters(filterParams);
+		shelvingFilters[1].setParameters(filterParams);
 
-		invertOutput = params.invertOutput;
-		enableHPF = params.enableHPF;
-		enableLSF = params.enableLSF;
+		SimpleLPFParameters  lpfParams = branchLPFs[0].getParameters();
+		lpfParams.g = params.lpf_g;
 
-		hpf_Fc = params.hpf_Fc;
-		lsf_Fshelf = params.lsf_Fshelf;
-		lsf_BoostCut_dB = params.lsf_BoostCut_dB;
+		for (int i = 0; i < NUM_BRANCHES; i++)
+		{
+			branchLPFs[i].setParameters(lpfParams);
+		}
 
-		return *this;
+		// --- update pre delay
+		SimpleDelayParameters delayParams = preDelay.getParameters();
+		delayParams.delayTime_mSec = params.preDelayTime_mSec;
+		preDelay.setParameters(delayParams);
+
+		// --- set apf and delay parameters
+		int m = 0;
+		NestedDelayAPFParameters apfParams = branchNestedAPFs[0].getParameters();
+		delayParams = branchDelays[0].getParameters();
+
+		// --- global max Delay times
+		double globalAPFMaxDelay = (parameters.apfDelayWeight_Pct / 100.0)*parameters.apfDelayMax_mSec;
+		double globalFixedMaxDelay = (parameters.fixeDelayWeight_Pct / 100.0)*parameters.fixeDelayMax_mSec;
+
+		// --- lfo
+		apfParams.enableLFO = true;
+		apfParams.lfoMaxModulation_mSec = 0.3;
+		apfParams.lfoDepth = 1.0;
+
+		for (int i = 0; i < NUM_BRANCHES; i++)
+		{
+			// --- setup APFs
+			apfParams.outerAPFdelayTime_mSec = globalAPFMaxDelay*apfDelayWeight[m++];
+			apfParams.innerAPFdelayTime_mSec = globalAPFMaxDelay*apfDelayWeight[m++];
+			apfParams.innerAPF_g = -0.5;
+			apfParams.outerAPF_g = 0.5;
+			if (i == 0)
+				apfParams.lfoRate_Hz = 0.15;
+			else if (i == 1)
+				apfParams.lfoRate_Hz = 0.33;
+			else if (i == 2)
+				apfParams.lfoRate_Hz = 0.57;
+			else if (i == 3)
+				apfParams.lfoRate_Hz = 0.73;
+
+			branchNestedAPFs[i].setParameters(apfParams);
+
+			// --- fixedDelayWeight
+			delayParams.delayTime_mSec = globalFixedMaxDelay*fixedDelayWeight[i];
+			branchDelays[i].setParameters(delayParams);
+		}
+
+		// --- save our copy
+		parameters = params;
 	}
 
-	// --- individual parameters
-	distortionModel waveshaper = distortionModel::kSoftClip; ///< waveshaper
 
-	double saturation = 1.0;	///< saturation level
-	double asymmetry = 0.0;		///< asymmetry level
-	double outputGain = 1.0;	///< outputGain level
+private:
+	ReverbTankParameters parameters;				///< object parameters
 
-	bool invertOutput = true;	///< invertOutput - triodes invert output
-	bool enableHPF = true;		///< HPF simulates DC blocking cap on output
-	bool enableLSF = false;		///< LSF simulates shelf due to cathode self biasing
+	SimpleDelay  preDelay;							///< pre delay object
+	SimpleDelay  branchDelays[NUM_BRANCHES];		///< branch delay objects
+	NestedDelayAPF branchNestedAPFs[NUM_BRANCHES];	///< nested APFs for each branch
+	SimpleLPF  branchLPFs[NUM_BRANCHES];			///< LPFs in each branch
 
-	double hpf_Fc = 1.0;		///< fc of DC blocking cap
-	double lsf_Fshelf = 80.0;	///< shelf fc from self bias cap
-	double lsf_BoostCut_dB = 0.0;///< boost/cut due to cathode self biasing
+	TwoBandShelvingFilter shelvingFilters[NUM_CHANNELS]; ///< shelving filters 0 = left; 1 = right
+
+	// --- weighting values to make various and low-correlated APF delay values easily
+	double apfDelayWeight[NUM_BRANCHES * 2] = { 0.317, 0.873, 0.477, 0.291, 0.993, 0.757, 0.179, 0.575 };///< weighting values to make various and low-correlated APF delay values easily
+	double fixedDelayWeight[NUM_BRANCHES] = { 1.0, 0.873, 0.707, 0.667 };	///< weighting values to make various and fixed delay values easily
+	double sampleRate = 0.0;	///< current sample rate
 };
 
 /**
-\class TriodeClassA
+\class ReverbTankSoA
 \ingroup FX-Objects
 \brief
-The TriodeClassA object simulates a triode in class A configuration. This is a very simple and basic simulation
-and a starting point for other designs; it is not intended to be a full-fledged triode simulator.
+The ReverbTankSoA object implements the same cyclic reverb tank as the ReverbTank object, but stores the
+NUM_BRANCHES identical branches as structure-of-arrays so that all branches are advanced together.
+
+Each branch input depends only on the *delayed* output of the previous branch, so the nested APFs, LPFs
+and fixed delays of all branches can be computed in lanes. The branch delay lines are interleaved
+(one frame of NUM_BRANCHES values per sample) and share a single write index; the lane loops operate on
+small fixed arrays that the compiler can map onto SIMD registers. Output matches ReverbTank to within
+floating point tolerance, except that zero-length branch delays are clamped to one sample.
+
+ReverbTank never sets the rate of its outer APF LFOs, so their modulated delays sit at a fixed value;
+ReverbTankSoA does the same by default. setAPFModulation(true) runs the LFOs at their rates instead
+(this output no longer matches ReverbTank).
 
 Audio I/O:
-- Processes mono input to mono output.
+- Processes mono input to mono OR stereo output.
 
 Control I/F:
-- Use TriodeClassAParameters structure to get/set object params.
+- Use ReverbTankParameters structure to get/set object params.
 
-\author Will Pirkle http://www.willpirkle.com
-\remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
 \version Revision : 1.0
-\date Date : 2018 / 09 / 7
 */
-class TriodeClassA : public IAudioSignalProcessor
+class ReverbTankSoA : public IAudioSignalProcessor
 {
 public:
-	TriodeClassA() {
-		AudioFilterParameters params;
-		params.algorithm = filterAlgorithm::kHPF1;
-		params.fc = parameters.hpf_Fc;
-		outputHPF.setParameters(params);
-
-		params.algorithm = filterAlgorithm::kLowShelf;
-		params.fc = parameters.lsf_Fshelf;
-		params.boostCut_dB = parameters.lsf_BoostCut_dB;
-		outputLSF.setParameters(params);
-	}		/* C-TOR */
-	~TriodeClassA() {}		/* D-TOR */
+	ReverbTankSoA() {}		/* C-TOR */
+	~ReverbTankSoA() {}		/* D-TOR */
 
 	/** reset members to initialized state */
 	virtual bool reset(double _sampleRate)
 	{
-		outputHPF.reset(_sampleRate);
-		outputLSF.reset(_sampleRate);
+		// --- create new buffers if needed
+		if (sampleRate != _sampleRate)
+		{
+			sampleRate = _sampleRate;
+			samplesPerMSec = sampleRate / 1000.0;
 
-		// ---
-		return true;
-	}
+			// --- all branch delays are 100 mSec long, so they share a length and write index
+			unsigned int length = (unsigned int)(100.0*samplesPerMSec) + 1;
+			bufferLength = (unsigned int)(pow(2, ceil(log(length) / log(2))));
+			wrapMask = bufferLength - 1;
 
-	/** get parameters: note use of custom structure for passing param data */
-	/**
-	\return TriodeClassAParameters custom data structure
-	*/
-	TriodeClassAParameters getParameters() { return parameters; }
+			outerAPFBuffer.reset(new double[bufferLength*NUM_BRANCHES]);
+			innerAPFBuffer.reset(new double[bufferLength*NUM_BRANCHES]);
+			branchDelayBuffer.reset(new double[bufferLength*NUM_BRANCHES]);
+		}
 
-	/** set parameters: note use of custom structure for passing param data */
-	/**
-	\param TriodeClassAParameters custom data structure
-	*/
-	void setParameters(const TriodeClassAParameters& params)
-	{
-		parameters = params;
+		// --- flush
+		memset(&outerAPFBuffer[0], 0, bufferLength*NUM_BRANCHES*sizeof(double));
+		memset(&innerAPFBuffer[0], 0, bufferLength*NUM_BRANCHES*sizeof(double));
+		memset(&branchDelayBuffer[0], 0, bufferLength*NUM_BRANCHES*sizeof(double));
+		writeIndex = 0;
 
-		AudioFilterParameters filterParams;
-		filterParams.algorithm = filterAlgorithm::kHPF1;
-		filterParams.fc = parameters.hpf_Fc;
-		outputHPF.setParameters(filterParams);
+		for (unsigned int i = 0; i < NUM_BRANCHES; i++)
+		{
+			lpfState[i] = 0.0;
+			lfoModCounter[i] = 0.0;
+		}
 
-		filterParams.algorithm = filterAlgorithm::kLowShelf;
-		filterParams.fc = parameters.lsf_Fshelf;
-		filterParams.boostCut_dB = parameters.lsf_BoostCut_dB;
-		outputLSF.setParameters(filterParams);
+		// ---set up preDelay
+		preDelay.reset(_sampleRate);
+		preDelay.createDelayBuffer(_sampleRate, 100.0);
+
+		for (unsigned int i = 0; i < NUM_CHANNELS; i++)
+		{
+			shelvingFilters[i].reset(_sampleRate);
+		}
+
+		// --- delay times depend on sample rate
+		setParameters(parameters);
+
+		return true;
 	}
 
-	/** return false: this object only processes samples */
-	virtual bool canProcessAudioFrame() { return false; }
+	/** return true: this object can process frames */
+	virtual bool canProcessAudioFrame() { return true; }
 
-	/** do the triode simulation to process one input to one output*/
+	/** process mono reverb tank */
 	/**
 	\param xn input
 	\return the processed sample
 	*/
 	virtual double processAudioSample(double xn)
 	{
-		// --- perform waveshaping
-		double output = 0.0;
-
-		if (parameters.waveshaper == distortionModel::kSoftClip)
-			output = softClipWaveShaper(xn, parameters.saturation);
-		else if (parameters.waveshaper == distortionModel::kArcTan)
-			output = atanWaveShaper(xn, parameters.saturation);
-		else if (parameters.waveshaper == distortionModel::kFuzzAsym)
-			output = fuzzExp1WaveShaper(xn, parameters.saturation, parameters.asymmetry);
-
-		// --- inversion, normal for plate of class A triode
-		if (parameters.invertOutput)
-			output *= -1.0;
+		float inputs[2] = { (float)xn, 0.0f };
+		float outputs[2] = { 0.0 };
+		processAudioFrame(inputs, outputs, 1, 1);
+		return outputs[0];
+	}
 
-		// --- Output (plate) capacitor = HPF, remove DC offset
-		if (parameters.enableHPF)
-			output = outputHPF.processAudioSample(output);
+	/** process stereo reverb tank */
+	virtual bool processAudioFrame(const float* inputFrame,
+		float* outputFrame,
+		uint32_t inputChannels,
+		uint32_t outputChannels)
+	{
+		// --- mono-ized input signal
+		double xnL = inputFrame[0];
+		double xnR = inputChannels > 1 ? inputFrame[1] : 0.0;
+		double monoXn = double(1.0 / inputChannels)*xnL + double(1.0 / inputChannels)*xnR;
 
-		// --- if cathode resistor bypass, will create low shelf
-		if (parameters.enableLSF)
-			output = outputLSF.processAudioSample(output);
+		double tankOutL = 0.0;
+		double tankOutR = 0.0;
+		processTank(monoXn, tankOutL, tankOutR);
 
-		// --- final resistor divider/potentiometer
-		output *= parameters.outputGain;
+		if (outputChannels == 1)
+			outputFrame[0] = dry*xnL + wet*(0.5*tankOutL + 0.5*tankOutR);
+		else
+		{
+			outputFrame[0] = dry*xnL + wet*tankOutL;
+			outputFrame[1] = dry*xnR + wet*tankOutR;
+		}
 
-		return output;
+		return true;
 	}
 
-protected:
-	TriodeClassAParameters parameters;	///< object parameters
-	AudioFilter outputHPF;				///< HPF to simulate output DC blocking cap
-	AudioFilter outputLSF;				///< LSF to simulate shelf caused by cathode self-biasing cap
-};
+	/** process a block of mono or stereo audio */
+	/**
+	\param inputBuffers input channel buffers
+	\param outputBuffers output channel buffers
+	\param inputChannels number of input channels
+	\param outputChannels number of output channels
+	\param blockSize number of samples in the block
+	\return true if processed
+	*/
+	bool processAudioBlock(const float* const* inputBuffers, float** outputBuffers,
+						   uint32_t inputChannels, uint32_t outputChannels, uint32_t blockSize)
+	{
+		// --- make sure we have input and outputs
+		if (inputChannels == 0 || outputChannels == 0)
+			return false;
 
-const unsigned int NUM_TUBES = 4;
+		double inputScalar = 1.0 / inputChannels;
+		for (uint32_t n = 0; n < blockSize; n++)
+		{
+			double xnL = inputBuffers[0][n];
+			double xnR = inputChannels > 1 ? inputBuffers[1][n] : 0.0;
 
-/**
-\struct ClassATubePreParameters
-\ingroup FX-Objects
-\brief
-Custom parameter structure for the ClassATubePre object.
+			double tankOutL = 0.0;
+			double tankOutR = 0.0;
+			processTank(inputScalar*xnL + inputScalar*xnR, tankOutL, tankOutR);
 
-\author Will Pirkle http://www.willpirkle.com
-\remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
-\version Revision : 1.0
-\date Date : 2018 / 09 / 7
-*/
-struct ClassATubePreParameters
-{
-	ClassATubePreParameters() {}
-	/** all FXObjects parameter objects require overloaded= operator so remember to add new entries if you add new variables. */
-	ClassATubePreParameters& operator=(const ClassATubePreParameters& params)	// need this override for collections to work
+			if (outputChannels == 1)
+				outputBuffers[0][n] = dry*xnL + wet*(0.5*tankOutL + 0.5*tankOutR);
+			else
+			{
+				outputBuffers[0][n] = dry*xnL + wet*tankOutL;
+				outputBuffers[1][n] = dry*xnR + wet*tankOutR;
+			}
+		}
+
+		return true;
+	}
+
+	/** run the outer APF LFOs at their rates; off by default to match ReverbTank, whose LFOs do not move */
+	/**
+	\param enable true to modulate the outer APF delays
+	*/
+	void setAPFModulation(bool enable)
 	{
-		if (this == &params)
-			return *this;
+		enableAPFModulation = enable;
+		setParameters(parameters);
+	}
 
-		inputLevel_dB = params.inputLevel_dB;
-		saturation = params.saturation;
-		asymmetry = params.asymmetry;
-		outputLevel_dB = params.outputLevel_dB;
+	/** get parameters: note use of custom structure for passing param data */
+	/**
+	\return ReverbTankParameters custom data structure
+	*/
+	ReverbTankParameters getParameters() { return parameters; }
 
-		lowShelf_fc = params.lowShelf_fc;
-		lowShelfBoostCut_dB = params.lowShelfBoostCut_dB;
-		highShelf_fc = params.highShelf_fc;
-		highShelfBoostCut_dB = params.highShelfBoostCut_dB;
+	/** set parameters: note use of custom structure for passing param data */
+	/**
+	\param ReverbTankParameters custom data structure
+	*/
+	void setParameters(const ReverbTankParameters& params)
+	{
+		// --- save our copy
+		parameters = params;
 
-		return *this;
+		TwoBandShelvingFilterParameters filterParams = shelvingFilters[0].getParameters();
+		filterParams.highShelf_fc = parameters.highShelf_fc;
+		filterParams.highShelfBoostCut_dB = parameters.highShelfBoostCut_dB;
+		filterParams.lowShelf_fc = parameters.lowShelf_fc;
+		filterParams.lowShelfBoostCut_dB = parameters.lowShelfBoostCut_dB;
+
+		// --- copy to both channels
+		shelvingFilters[0].setParameters(filterParams);
+		shelvingFilters[1].setParameters(filterParams);
+
+		// --- update pre delay
+		SimpleDelayParameters delayParams = preDelay.getParameters();
+		delayParams.delayTime_mSec = parameters.preDelayTime_mSec;
+		preDelay.setParameters(delayParams);
+
+		// --- wet/dry
+		dry = pow(10.0, parameters.dryLevel_dB / 20.0);
+		wet = pow(10.0, parameters.wetLevel_dB / 20.0);
+
+		// --- global max Delay times
+		double globalAPFMaxDelay = (parameters.apfDelayWeight_Pct / 100.0)*parameters.apfDelayMax_mSec;
+		double globalFixedMaxDelay = (parameters.fixeDelayWeight_Pct / 100.0)*parameters.fixeDelayMax_mSec;
+		double maxDelay_Samples = bufferLength - 1;
+
+		for (unsigned int i = 0; i < NUM_BRANCHES; i++)
+		{
+			// --- APFs
+			outerAPFDelay_mSec[i] = globalAPFMaxDelay*apfDelayWeight[2 * i];
+			outerAPFMinDelay_mSec[i] = fmax(0.0, outerAPFDelay_mSec[i] - lfoMaxModulation_mSec);
+			innerAPFDelay_Samples[i] = (int)fmin(globalAPFMaxDelay*apfDelayWeight[2 * i + 1] * samplesPerMSec, maxDelay_Samples);
+			innerAPFDelay_Samples[i] = innerAPFDelay_Samples[i] < 1 ? 1 : innerAPFDelay_Samples[i];
+
+			// --- LFOs
+			lfoPhaseInc[i] = enableAPFModulation && sampleRate > 0.0 ? lfoRate_Hz[i] / sampleRate : 0.0;
+
+			// --- fixed delays
+			double delay_Samples = fmin(globalFixedMaxDelay*fixedDelayWeight[i] * samplesPerMSec, maxDelay_Samples);
+			branchDelay_Samples[i] = (int)delay_Samples;
+			branchDelay_Samples[i] = branchDelay_Samples[i] < 1 ? 1 : branchDelay_Samples[i];
+
+			// --- output taps
+			for (unsigned int j = 0; j < NUM_TAPS_PER_BRANCH; j++)
+				tapDelay_Samples[j][i] = (int)((tapPercentage[j][i] / 100.0)*delay_Samples);
+		}
 	}
 
-	// --- individual parameters
-	double inputLevel_dB = 0.0;		///< input level in dB
-	double saturation = 0.0;		///< input level in dB
-	double asymmetry = 0.0;			///< input level in dB
-	double outputLevel_dB = 0.0;	///< input level in dB
+private:
+	ReverbTankParameters parameters;				///< object parameters
 
-	// --- shelving filter params
-	double lowShelf_fc = 0.0;			///< LSF shelf frequency
-	double lowShelfBoostCut_dB = 0.0;	///< LSF shelf gain/cut
-	double highShelf_fc = 0.0;			///< HSF shelf frequency
-	double highShelfBoostCut_dB = 0.0;	///< HSF shelf frequency
+	SimpleDelay  preDelay;							///< pre delay object
+	TwoBandShelvingFilter shelvingFilters[NUM_CHANNELS]; ///< shelving filters 0 = left; 1 = right
 
-};
+	// --- interleaved delay lines: sample n of branch i is at [n*NUM_BRANCHES + i]
+	std::unique_ptr<double[]> outerAPFBuffer = nullptr;		///< outer APF delay lines
+	std::unique_ptr<double[]> innerAPFBuffer = nullptr;		///< inner APF delay lines
+	std::unique_ptr<double[]> branchDelayBuffer = nullptr;	///< fixed branch delay lines
+	unsigned int bufferLength = 0;	///< length of each delay line, power of 2
+	unsigned int wrapMask = 0;		///< must be (bufferLength - 1)
+	unsigned int writeIndex = 0;	///< shared write index
+
+	// --- branch state and coefficients in lanes
+	double outerAPFDelay_mSec[NUM_BRANCHES] = { 0.0 };		///< outer APF (max) delay times
+	double outerAPFMinDelay_mSec[NUM_BRANCHES] = { 0.0 };	///< outer APF min modulated delay times
+	int innerAPFDelay_Samples[NUM_BRANCHES] = { 1, 1, 1, 1 };	///< inner APF delay times
+	int branchDelay_Samples[NUM_BRANCHES] = { 1, 1, 1, 1 };	///< fixed delay times
+	double lpfState[NUM_BRANCHES] = { 0.0 };				///< LPF state registers (z^-1)
+	double lfoModCounter[NUM_BRANCHES] = { 0.0 };			///< outer APF LFO modulo counters
+	double lfoPhaseInc[NUM_BRANCHES] = { 0.0 };				///< outer APF LFO phase increments
+
+	// --- fixed branch settings, identical to ReverbTank
+	const double outerAPF_g = 0.5;				///< outer APF g coefficient
+	const double innerAPF_g = -0.5;				///< inner APF g coefficient
+	const double lfoDepth = 1.0;				///< outer APF LFO depth
+	const double lfoMaxModulation_mSec = 0.3;	///< outer APF LFO max modulation
+	double lfoRate_Hz[NUM_BRANCHES] = { 0.15, 0.33, 0.57, 0.73 }; ///< outer APF LFO rates
+	bool enableAPFModulation = false;			///< run the outer APF LFOs (ReverbTank does not)
 
-/**
-\class ClassATubePre
-\ingroup FX-Objects
-\brief
-The ClassATubePre object implements a simple cascade of four (4) triode tube models.
+	// --- weighting values to make various and low-correlated APF delay values easily
+	double apfDelayWeight[NUM_BRANCHES * 2] = { 0.317, 0.873, 0.477, 0.291, 0.993, 0.757, 0.179, 0.575 };///< weighting values to make various and low-correlated APF delay values easily
+	double fixedDelayWeight[NUM_BRANCHES] = { 1.0, 0.873, 0.707, 0.667 };	///< weighting values to make various and fixed delay values easily
 
-Audio I/O:
-- Processes mono input to mono output.
+	// --- output taps: first two rows are sparse, all four rows are thick
+	static const unsigned int NUM_TAPS_PER_BRANCH = 4;
+	double tapPercentage[NUM_TAPS_PER_BRANCH][NUM_BRANCHES] = { { 23.0, 41.0, 59.0, 73.0 },		///< left, sparse
+																{ 29.0, 43.0, 61.0, 79.0 },		///< right, sparse
+																{ 31.0, 47.0, 67.0, 83.0 },		///< left, thick
+																{ 37.0, 53.0, 71.0, 89.0 } };	///< right, thick
+	int tapDelay_Samples[NUM_TAPS_PER_BRANCH][NUM_BRANCHES] = { { 0 } }; ///< output tap delays in samples
 
-Control I/F:
-- Use ClassATubePreParameters structure to get/set object params.
+	double sampleRate = 0.0;		///< current sample rate
+	double samplesPerMSec = 0.0;	///< samples per millisecond
+	double dry = 0.0;				///< dry level (raw)
+	double wet = 0.0;				///< wet level (raw)
 
-\author Will Pirkle http://www.willpirkle.com
-\remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
-\version Revision : 1.0
-\date Date : 2018 / 09 / 7
-*/
-class ClassATubePre : public IAudioSignalProcessor
-{
-public:
-	ClassATubePre() {}		/* C-TOR */
-	~ClassATubePre() {}		/* D-TOR */
+	/** read lane i of an interleaved delay line */
+	inline double readLane(const std::unique_ptr<double[]>& buffer, unsigned int i, int delayInSamples)
+	{
+		// --- -1 because we read-before-write
+		int readIndex = (writeIndex - 1) - delayInSamples;
+		readIndex &= wrapMask;
+		return buffer[readIndex*NUM_BRANCHES + i];
+	}
 
-	/** reset members to initialized state */
-	virtual bool reset(double _sampleRate)
+	/** run the tank for one sample interval; all branches are advanced together */
+	inline void processTank(double monoXn, double& tankOutL, double& tankOutR)
 	{
-		TriodeClassAParameters tubeParams = triodes[0].getParameters();
-		tubeParams.invertOutput = true;
-		tubeParams.enableHPF = true; // remove DC offsets
-		tubeParams.outputGain = 1.0;
-		tubeParams.saturation = 1.0;
-		tubeParams.asymmetry = 0.0;
-		tubeParams.enableLSF = true;
-		tubeParams.lsf_Fshelf = 88.0;
-		tubeParams.lsf_BoostCut_dB = -12.0;
-		tubeParams.waveshaper = distortionModel::kFuzzAsym;
+		// --- pre delay output
+		double preDelayOut = preDelay.processAudioSample(monoXn);
 
-		for (int i = 0; i < NUM_TUBES; i++)
-		{
-			triodes[i].reset(_sampleRate);
-			triodes[i].setParameters(tubeParams);
-		}
+		// --- delayed branch outputs are known before any branch is processed
+		double delayOut[NUM_BRANCHES];
+		for (unsigned int i = 0; i < NUM_BRANCHES; i++)
+			delayOut[i] = parameters.kRT*readLane(branchDelayBuffer, i, branchDelay_Samples[i]);
 
-		shelvingFilter.reset(_sampleRate);
+		// --- branch inputs: first branch takes the global feedback from the last one
+		double input[NUM_BRANCHES];
+		input[0] = preDelayOut + delayOut[NUM_BRANCHES - 1];
+		for (unsigned int i = 1; i < NUM_BRANCHES; i++)
+			input[i] = delayOut[i - 1] + preDelayOut;
 
-		return true;
-	}
+		// --- outer APF modulated delay times from triangle LFOs
+		int outerDelay_Samples[NUM_BRANCHES];
+		for (unsigned int i = 0; i < NUM_BRANCHES; i++)
+		{
+			if (lfoModCounter[i] >= 1.0)
+				lfoModCounter[i] -= 1.0;
 
-	/** get parameters: note use of custom structure for passing param data */
-	/**
-	\return ClassATubePreParameters custom data structure
-	*/
-	ClassATubePreParameters getParameters() { return parameters; }
+			double lfo = 2.0*fabs(unipolarToBipolar(lfoModCounter[i])) - 1.0;
+			lfoModCounter[i] += lfoPhaseInc[i];
 
-	/** set parameters: note use of custom structure for passing param data */
-	/**
-	\param ClassATubePreParameters custom data structure
-	*/
-	void setParameters(const ClassATubePreParameters& params)
-	{
-		// --- check for re-calc
-		if (params.inputLevel_dB != parameters.inputLevel_dB)
-			inputLevel = pow(10.0, params.inputLevel_dB / 20.0);
-		if (params.outputLevel_dB != parameters.outputLevel_dB)
-			outputLevel = pow(10.0, params.outputLevel_dB / 20.0);
+			double modDelay_mSec = doUnipolarModulationFromMax(bipolarToUnipolar(lfoDepth*lfo),
+				outerAPFMinDelay_mSec[i], outerAPFDelay_mSec[i]);
+			outerDelay_Samples[i] = (int)(modDelay_mSec*samplesPerMSec);
+		}
 
-		// --- store
-		parameters = params;
+		// --- gather delayed APF values
+		double outerWnD[NUM_BRANCHES];
+		double innerWnD[NUM_BRANCHES];
+		for (unsigned int i = 0; i < NUM_BRANCHES; i++)
+		{
+			outerWnD[i] = readLane(outerAPFBuffer, i, outerDelay_Samples[i]);
+			innerWnD[i] = readLane(innerAPFBuffer, i, innerAPFDelay_Samples[i]);
+		}
 
-		// --- shelving filter update
-		TwoBandShelvingFilterParameters sfParams = shelvingFilter.getParameters();
-		sfParams.lowShelf_fc = parameters.lowShelf_fc;
-		sfParams.lowShelfBoostCut_dB = parameters.lowShelfBoostCut_dB;
-		sfParams.highShelf_fc = parameters.highShelf_fc;
-		sfParams.highShelfBoostCut_dB = parameters.highShelfBoostCut_dB;
-		shelvingFilter.setParameters(sfParams);
+		// --- nested APFs, LPFs
+		double outerWn[NUM_BRANCHES];
+		double innerWn[NUM_BRANCHES];
+		double innerYn[NUM_BRANCHES];
+		double lpfOut[NUM_BRANCHES];
+		for (unsigned int i = 0; i < NUM_BRANCHES; i++)
+		{
+			// --- outer APF w(n) = x(n) + gw(n-D)
+			outerWn[i] = input[i] + outerAPF_g*outerWnD[i];
 
-		// --- triode updates
-		TriodeClassAParameters tubeParams = triodes[0].getParameters();
-		tubeParams.saturation = parameters.saturation;
-		tubeParams.asymmetry = parameters.asymmetry;
+			// --- inner APF
+			innerWn[i] = outerWn[i] + innerAPF_g*innerWnD[i];
+			innerYn[i] = -innerAPF_g*innerWn[i] + innerWnD[i];
+			checkFloatUnderflow(innerYn[i]);
 
-		for (int i = 0; i < NUM_TUBES; i++)
-			triodes[i].setParameters(tubeParams);
-	}
+			// --- outer APF y(n) = -gw(n) + w(n-D)
+			double apfOut = -outerAPF_g*outerWn[i] + outerWnD[i];
+			checkFloatUnderflow(apfOut);
 
-	/** return false: this object only processes samples */
-	virtual bool canProcessAudioFrame() { return false; }
+			// --- LPF
+			lpfOut[i] = (1.0 - parameters.lpf_g)*apfOut + parameters.lpf_g*lpfState[i];
+			lpfState[i] = lpfOut[i];
+		}
 
-	/** process the input through the four tube models in series */
-	/**
-	\param xn input
-	\return the processed sample
-	*/
-	virtual double processAudioSample(double xn)
-	{
-		double output1 = triodes[0].processAudioSample(xn*inputLevel);
-		double output2 = triodes[1].processAudioSample(output1);
-		double output3 = triodes[2].processAudioSample(output2);
+		// --- write one interleaved frame to each delay line
+		unsigned int writeFrame = writeIndex*NUM_BRANCHES;
+		for (unsigned int i = 0; i < NUM_BRANCHES; i++)
+		{
+			innerAPFBuffer[writeFrame + i] = innerWn[i];
+			outerAPFBuffer[writeFrame + i] = innerYn[i];
+			branchDelayBuffer[writeFrame + i] = lpfOut[i];
+		}
+		writeIndex = (writeIndex + 1) & wrapMask;
 
-		// --- filter stage is between 3 and 4
-		double outputEQ = shelvingFilter.processAudioSample(output3);
-		double output4 = triodes[3].processAudioSample(outputEQ);
+		// --- gather outputs with alternating signs
+		double weight = 0.707;
+		double outL = 0.0;
+		double outR = 0.0;
+		unsigned int numTaps = parameters.density == reverbDensity::kThick ? NUM_TAPS_PER_BRANCH : 2;
+		for (unsigned int j = 0; j < numTaps; j += 2)
+		{
+			for (unsigned int i = 0; i < NUM_BRANCHES; i++)
+			{
+				double sign = (i & 1) ? -1.0 : 1.0;
+				outL += sign*weight*readLane(branchDelayBuffer, i, tapDelay_Samples[j][i]);
+				outR -= sign*weight*readLane(branchDelayBuffer, i, tapDelay_Samples[j + 1][i]);
+			}
+		}
 
-		return output4*outputLevel;
+		// ---  filter
+		tankOutL = shelvingFilters[0].processAudioSample(outL);
+		tankOutR = shelvingFilters[1].processAudioSample(outR);
 	}
+};
 
-protected:
-	ClassATubePreParameters parameters;		///< object parameters
-	TriodeClassA triodes[NUM_TUBES];		///< array of triode tube objects
-	TwoBandShelvingFilter shelvingFilter;	///< shelving filters
 
-	double inputLevel = 1.0;	///< input level (not in dB)
-	double outputLevel = 1.0;	///< output level (not in dB)
-};
+/**
+\enum fdnMatrix
+\ingroup Constants-Enums
+\brief
+Use this strongly typed enum to set the feedback matrix of the FDNReverb object. Both are lossless
+(orthogonal) matrices that are applied without a matrix multiply:
+- kHadamard: fast Walsh-Hadamard transform, O(N log N), maximally dense mixing
+- kHouseholder: reflection I - (2/N)11', O(N), cheaper with slightly less mixing
 
+- enum class fdnMatrix { kHadamard, kHouseholder };
+
+\version Revision : 1.0
+*/
+enum class fdnMatrix { kHadamard, kHouseholder };
+
+// --- constants for FDN reverb
+const unsigned int MAX_FDN_DELAY_LINES = 16;	///< max number of delay lines, must be a power of 2
+const double MAX_FDN_DELAY_MSEC = 250.0;		///< longest delay line in mSec, including modulation
 
 /**
-\struct BitCrusherParameters
+\struct FDNReverbParameters
 \ingroup FX-Objects
 \brief
-Custom parameter structure for the BitCrusher object.
+Custom parameter structure for the FDNReverb object.
 
-\author Will Pirkle http://www.willpirkle.com
-\remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
 \version Revision : 1.0
-\date Date : 2018 / 09 / 7
 */
-struct BitCrusherParameters
+struct FDNReverbParameters
 {
-	BitCrusherParameters() {}
+	FDNReverbParameters() {}
 	/** all FXObjects parameter objects require overloaded= operator so remember to add new entries if you add new variables. */
-	BitCrusherParameters& operator=(const BitCrusherParameters& params)	// need this override for collections to work
+	FDNReverbParameters& operator=(const FDNReverbParameters& params)	// need this override for collections to work
 	{
 		if (this == &params)
 			return *this;
 
-		quantizedBitDepth = params.quantizedBitDepth;
-
+		numDelayLines = params.numDelayLines;
+		matrix = params.matrix;
+		minDelay_mSec = params.minDelay_mSec;
+		maxDelay_mSec = params.maxDelay_mSec;
+		RT60Time_mSec = params.RT60Time_mSec;
+		damping_g = params.damping_g;
+		lfoRate_Hz = params.lfoRate_Hz;
+		lfoDepth_mSec = params.lfoDepth_mSec;
+		preDelayTime_mSec = params.preDelayTime_mSec;
+		wetLevel_dB = params.wetLevel_dB;
+		dryLevel_dB = params.dryLevel_dB;
 		return *this;
 	}
 
-	double quantizedBitDepth = 4.0; ///< bid depth of quantizer
+	// --- individual parameters
+	unsigned int numDelayLines = 8;			///< number of delay lines: 8 or 16
+	fdnMatrix matrix = fdnMatrix::kHadamard;///< feedback matrix
+	double minDelay_mSec = 20.0;			///< shortest delay line
+	double maxDelay_mSec = 80.0;			///< longest delay line
+	double RT60Time_mSec = 2000.0;			///< reverb time (RT60) in mSec
+	double damping_g = 0.3;					///< g coefficient of the damping LPF in each line [0, 1)
+	double lfoRate_Hz = 0.5;				///< delay modulation rate
+	double lfoDepth_mSec = 0.2;				///< delay modulation depth (0 = no modulation, max = MAX_FDN_DELAY_MSEC/2)
+	double preDelayTime_mSec = 0.0;			///< pre-delay time in mSec
+	double wetLevel_dB = -3.0;				///< wet output level in dB
+	double dryLevel_dB = -3.0;				///< dry output level in dB
 };
 
 /**
-\class BitCrusher
+\class FDNReverb
 \ingroup FX-Objects
 \brief
-The BitCrusher object implements a quantizing bitcrusher algorithm.
+The FDNReverb object implements a feedback delay network reverb with 8 or 16 delay lines, a Hadamard
+or Householder feedback matrix, a damping LPF and an RT60 gain in each line, and LFO modulation of
+the delay times.
+
+The delay lines are stored interleaved (one frame of MAX_FDN_DELAY_LINES values per sample) with a
+shared write index and every per-line operation is a loop over contiguous lane arrays, so the network is
+advanced as a whole for each sample. Delay line lengths are spread exponentially between min and max
+delay and rounded to prime numbers of samples.
 
 Audio I/O:
-- Processes mono input to mono output.
+- Processes mono input to mono OR stereo output.
 
 Control I/F:
-- Use BitCrusherParameters structure to get/set object params.
+- Use FDNReverbParameters structure to get/set object params.
 
-\author Will Pirkle http://www.willpirkle.com
-\remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
 \version Revision : 1.0
-\date Date : 2018 / 09 / 7
 */
-class BitCrusher : public IAudioSignalProcessor
+class FDNReverb : public IAudioSignalProcessor
 {
 public:
-	BitCrusher() {}		/* C-TOR */
-	~BitCrusher() {}		/* D-TOR */
+	FDNReverb() {}		/* C-TOR */
+	~FDNReverb() {}		/* D-TOR */
 
 	/** reset members to initialized state */
-	virtual bool reset(double _sampleRate){ return true; }
+	virtual bool reset(double _sampleRate)
+	{
+		// --- create new buffer if needed
+		if (sampleRate != _sampleRate)
+		{
+			sampleRate = _sampleRate;
+			samplesPerMSec = sampleRate / 1000.0;
 
-	/** get parameters: note use of custom structure for passing param data */
-	/**
-	\return BitCrusherParameters custom data structure
-	*/
-	BitCrusherParameters getParameters() { return parameters; }
+			unsigned int length = (unsigned int)(MAX_FDN_DELAY_MSEC*samplesPerMSec) + 2;
+			bufferLength = (unsigned int)(pow(2, ceil(log(length) / log(2))));
+			wrapMask = bufferLength - 1;
+			delayBuffer.reset(new double[bufferLength*MAX_FDN_DELAY_LINES]);
+		}
 
-	/** set parameters: note use of custom structure for passing param data */
-	/**
-	\param BitCrusherParameters custom data structure
-	*/
-	void setParameters(const BitCrusherParameters& params)
-	{
-		// --- calculate and store
-		if (params.quantizedBitDepth != parameters.quantizedBitDepth)
-			QL = 2.0 / (pow(2.0, params.quantizedBitDepth) - 1.0);
+		// --- flush
+		memset(&delayBuffer[0], 0, bufferLength*MAX_FDN_DELAY_LINES*sizeof(double));
+		writeIndex = 0;
 
-		parameters = params;
-	}
+		for (unsigned int i = 0; i < MAX_FDN_DELAY_LINES; i++)
+		{
+			lpfState[i] = 0.0;
 
-	/** return false: this object only processes samples */
-	virtual bool canProcessAudioFrame() { return false; }
+			// --- spread the LFO phases across the lines
+			lfoModCounter[i] = (double)i / MAX_FDN_DELAY_LINES;
+		}
 
-	/** perform the bitcrushing operation (see FX book for back story and details) */
+		// ---set up preDelay
+		preDelay.reset(_sampleRate);
+		preDelay.createDelayBuffer(_sampleRate, 100.0);
+
+		// --- delay times depend on sample rate
+		setParameters(parameters);
+
+		return true;
+	}
+
+	/** return true: this object can process frames */
+	virtual bool canProcessAudioFrame() { return true; }
+
+	/** process mono reverb */
 	/**
 	\param xn input
 	\return the processed sample
 	*/
 	virtual double processAudioSample(double xn)
 	{
-		return QL*(int(xn / QL));
+		float inputs[2] = { (float)xn, 0.0 };
+		float outputs[2] = { 0.0 };
+		processAudioFrame(inputs, outputs, 1, 1);
+		return outputs[0];
 	}
 
-protected:
-	BitCrusherParameters parameters; ///< object parameters
-	double QL = 1.0;				 ///< the quantization level
-};
-
-
-// ------------------------------------------------------------------ //
-// --- WDF LIBRARY -------------------------------------------------- //
-// ------------------------------------------------------------------ //
-
-/**
-\class IComponentAdaptor
-\ingroup Interfaces
-\brief
-Use this interface for objects in the WDF Ladder Filter library; see book for more information.
-
-\author Will Pirkle http://www.willpirkle.com
-\remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
-\version Revision : 1.0
-\date Date : 2018 / 09 / 7
-*/
-class IComponentAdaptor
-{
-public:
-	/** initialize with source resistor R1 */
-	virtual void initialize(double _R1) {}
+	/** process stereo reverb */
+	virtual bool processAudioFrame(const float* inputFrame,
+		float* outputFrame,
+		uint32_t inputChannels,
+		uint32_t outputChannels)
+	{
+		double xnL = inputFrame[0];
+		double xnR = inputChannels > 1 ? inputFrame[1] : xnL;
 
-	/** initialize all downstream adaptors in the chain */
-	virtual void initializeAdaptorChain() {}
+		double outL = 0.0;
+		double outR = 0.0;
+		processNetwork(xnL, xnR, outL, outR);
 
-	/** set input value into component port  */
-	virtual void setInput(double _in) {}
+		if (outputChannels == 1)
+			outputFrame[0] = dry*xnL + wet*(0.5*outL + 0.5*outR);
+		else
+		{
+			outputFrame[0] = dry*xnL + wet*outL;
+			outputFrame[1] = dry*xnR + wet*outR;
+		}
 
-	/** get output value from component port  */
-	virtual double getOutput() { return 0.0; }
+		return true;
+	}
 
-	// --- for adaptors
-	/** ADAPTOR: set input port 1  */
-	virtual void setInput1(double _in1) = 0;
+	/** process a block of mono or stereo audio */
+	/**
+	\param inputBuffers input channel buffers
+	\param outputBuffers output channel buffers
+	\param inputChannels number of input channels
+	\param outputChannels number of output channels
+	\param blockSize number of samples in the block
+	\return true if processed
+	*/
+	bool processAudioBlock(const float* const* inputBuffers, float** outputBuffers,
+						   uint32_t inputChannels, uint32_t outputChannels, uint32_t blockSize)
+	{
+		// --- make sure we have input and outputs
+		if (inputChannels == 0 || outputChannels == 0)
+			return false;
 
-	/** ADAPTOR: set input port 2  */
-	virtual void setInput2(double _in2) = 0;
+		for (uint32_t n = 0; n < blockSize; n++)
+		{
+			double xnL = inputBuffers[0][n];
+			double xnR = inputChannels > 1 ? inputBuffers[1][n] : xnL;
 
-	/** ADAPTOR: set input port 3 */
-	virtual void setInput3(double _in3) = 0;
+			double outL = 0.0;
+			double outR = 0.0;
+			processNetwork(xnL, xnR, outL, outR);
 
-	/** ADAPTOR: get output port 1 value */
-	virtual double getOutput1() = 0;
+			if (outputChannels == 1)
+				outputBuffers[0][n] = dry*xnL + wet*(0.5*outL + 0.5*outR);
+			else
+			{
+				outputBuffers[0][n] = dry*xnL + wet*outL;
+				outputBuffers[1][n] = dry*xnR + wet*outR;
+			}
+		}
 
-	/** ADAPTOR: get output port 2 value */
-	virtual double getOutput2() = 0;
+		return true;
+	}
 
-	/** ADAPTOR: get output port 3 value */
-	virtual double getOutput3() = 0;
+	/** get parameters: note use of custom structure for passing param data */
+	/**
+	\return FDNReverbParameters custom data structure
+	*/
+	FDNReverbParameters getParameters() { return parameters; }
 
-	/** reset the object with new sample rate */
-	virtual void reset(double _sampleRate) {}
+	/** set parameters: note use of custom structure for passing param data */
+	/**
+	\param FDNReverbParameters custom data structure
+	*/
+	void setParameters(const FDNReverbParameters& params)
+	{
+		parameters = params;
 
-	/** get the commponent resistance from the attached object at Port3 */
-	virtual double getComponentResistance() { return 0.0; }
+		// --- 8 or 16 lines
+		numLines = parameters.numDelayLines > 8 ? MAX_FDN_DELAY_LINES : 8;
 
-	/** get the commponent conductance from the attached object at Port3 */
-	virtual double getComponentConductance() { return 0.0; }
+		// --- update pre delay
+		SimpleDelayParameters delayParams = preDelay.getParameters();
+		delayParams.delayTime_mSec = parameters.preDelayTime_mSec;
+		preDelay.setParameters(delayParams);
 
-	/** update the commponent resistance at Port3 */
-	virtual void updateComponentResistance() {}
+		// --- wet/dry
+		dry = pow(10.0, parameters.dryLevel_dB / 20.0);
+		wet = pow(10.0, parameters.wetLevel_dB / 20.0);
 
-	/** set an individual component value (may be R, L, or C */
-	virtual void setComponentValue(double _componentValue) { }
+		// --- lossless matrix, so input/output scaling keeps unity energy
+		ioGain = 1.0 / sqrt((double)numLines);
 
-	/** set LC combined values */
-	virtual void setComponentValue_LC(double componentValue_L, double componentValue_C) { }
+		if (samplesPerMSec == 0.0)
+			return;
 
-	/** set RL combined values */
-	virtual void setComponentValue_RL(double componentValue_R, double componentValue_L) { }
+		// --- modulation
+		double lfoPhaseInc = parameters.lfoRate_Hz / sampleRate;
+		double lfoDepth_mSec = fmin(fmax(parameters.lfoDepth_mSec, 0.0), MAX_FDN_DELAY_MSEC / 2.0);
+		double lfoDepth_Samples = lfoDepth_mSec*samplesPerMSec;
 
-	/** set RC combined values */
-	virtual void setComponentValue_RC(double componentValue_R, double componentValue_C) { }
+		// --- bound delay range so that max delay + modulation fits the buffer
+		double maxDelay_mSec = fmax(fmin(parameters.maxDelay_mSec, MAX_FDN_DELAY_MSEC - 1.0 - lfoDepth_mSec), 1.0);
+		double minDelay_mSec = fmin(fmax(parameters.minDelay_mSec, 1.0), maxDelay_mSec);
+		double damping_g = fmin(fmax(parameters.damping_g, 0.0), 0.999);
 
-	/** get a component value */
-	virtual double getComponentValue() { return 0.0; }
-};
+		for (unsigned int i = 0; i < numLines; i++)
+		{
+			// --- exponential spread, rounded up to a prime length
+			double delay_mSec = minDelay_mSec*pow(maxDelay_mSec / minDelay_mSec, (double)i / (numLines - 1));
+			unsigned int delay_Samples = findNextPrime((unsigned int)(delay_mSec*samplesPerMSec));
+			delayLine_Samples[i] = delay_Samples;
+
+			// --- g = 10^(-3D/(fs*RT60)) gives -60dB after RT60 seconds
+			double rt60_Sec = fmax(parameters.RT60Time_mSec, 1.0) / 1000.0;
+			rt60Gain[i] = pow(10.0, -3.0*delay_Samples / (sampleRate*rt60_Sec));
+
+			lpf_g[i] = damping_g;
+			lfoInc[i] = lfoPhaseInc;
+			// --- keep delay - depth >= 1 sample so the read never passes the write head
+			lfoDepth[i] = fmax(fmin(lfoDepth_Samples, delay_Samples - 1.0), 0.0);
+		}
+	}
 
-// ------------------------------------------------------------------ //
-// --- WDF COMPONENTS & COMMBO COMPONENTS --------------------------- //
-// ------------------------------------------------------------------ //
-/**
-\class WdfResistor
-\ingroup WDF-Objects
-\brief
-The WdfResistor object implements the reflection coefficient and signal flow through
-a WDF simulated resistor.
+private:
+	FDNReverbParameters parameters;	///< object parameters
+	SimpleDelay preDelay;			///< pre delay object
+
+	// --- interleaved delay lines: sample n of line i is at [n*MAX_FDN_DELAY_LINES + i]
+	std::unique_ptr<double[]> delayBuffer = nullptr;	///< delay lines
+	unsigned int bufferLength = 0;	///< length of each delay line, power of 2
+	unsigned int wrapMask = 0;		///< must be (bufferLength - 1)
+	unsigned int writeIndex = 0;	///< shared write index
+	unsigned int numLines = 8;		///< active delay lines
+
+	// --- per line coefficients and state in lanes
+	double delayLine_Samples[MAX_FDN_DELAY_LINES] = { 0.0 };	///< nominal delay times
+	double rt60Gain[MAX_FDN_DELAY_LINES] = { 0.0 };	///< decay gain per pass through the line
+	double lpf_g[MAX_FDN_DELAY_LINES] = { 0.0 };		///< damping LPF g coefficients
+	double lpfState[MAX_FDN_DELAY_LINES] = { 0.0 };	///< damping LPF state registers (z^-1)
+	double lfoModCounter[MAX_FDN_DELAY_LINES] = { 0.0 };///< LFO modulo counters
+	double lfoInc[MAX_FDN_DELAY_LINES] = { 0.0 };		///< LFO phase increments
+	double lfoDepth[MAX_FDN_DELAY_LINES] = { 0.0 };	///< LFO depth in samples
 
-\author Will Pirkle http://www.willpirkle.com
-\remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
-\version Revision : 1.0
-\date Date : 2018 / 09 / 7
-*/
-class WdfResistor : public IComponentAdaptor
-{
-public:
-	WdfResistor(double _componentValue) { componentValue = _componentValue; }
-	WdfResistor() { }
-	virtual ~WdfResistor() {}
+	double sampleRate = 0.0;		///< current sample rate
+	double samplesPerMSec = 0.0;	///< samples per millisecond
+	double ioGain = 1.0;			///< input and output scaling
+	double dry = 0.707;				///< dry level (raw)
+	double wet = 0.707;				///< wet level (raw)
 
-	/** set sample rate and update component */
-	void setSampleRate(double _sampleRate)
+	/** find the smallest prime >= n; only called from setParameters( ) */
+	unsigned int findNextPrime(unsigned int n)
 	{
-		sampleRate = _sampleRate;
-		updateComponentResistance();
+		if (n < 2) return 2;
+		for (;; n++)
+		{
+			bool isPrime = true;
+			for (unsigned int d = 2; d*d <= n; d++)
+			{
+				if (n % d == 0)
+				{
+					isPrime = false;
+					break;
+				}
+			}
+			if (isPrime) return n;
+		}
 	}
 
-	/** get component's value as a resistance */
-	virtual double getComponentResistance() { return componentResistance; }
-
-	/** get component's value as a conducatance (or admittance) */
-	virtual double getComponentConductance() { return 1.0 / componentResistance; }
-
-	/** get the component value */
-	virtual double getComponentValue() { return componentValue; }
-
-	/** set the component value */
-	virtual void setComponentValue(double _componentValue)
+	/** in-place, normalized fast Walsh-Hadamard transform of numLines values */
+	inline void doHadamard(double* x)
 	{
-		componentValue = _componentValue;
-		updateComponentResistance();
+		for (unsigned int h = 1; h < numLines; h *= 2)
+		{
+			for (unsigned int i = 0; i < numLines; i += 2 * h)
+			{
+				for (unsigned int j = i; j < i + h; j++)
+				{
+					double a = x[j];
+					double b = x[j + h];
+					x[j] = a + b;
+					x[j + h] = a - b;
+				}
+			}
+		}
+
+		for (unsigned int i = 0; i < numLines; i++)
+			x[i] *= ioGain;
 	}
 
-	/** change the resistance of component */
-	virtual void updateComponentResistance() { componentResistance = componentValue; }
+	/** in-place Householder reflection (I - (2/N)11') of numLines values */
+	inline void doHouseholder(double* x)
+	{
+		double sum = 0.0;
+		for (unsigned int i = 0; i < numLines; i++)
+			sum += x[i];
 
-	/** reset the component; clear registers */
-	virtual void reset(double _sampleRate) { setSampleRate(_sampleRate);  zRegister = 0.0; }
+		sum *= 2.0 / numLines;
+		for (unsigned int i = 0; i < numLines; i++)
+			x[i] -= sum;
+	}
 
-	/** set input value into component; NOTE: resistor is dead-end energy sink so this function does nothing */
-	virtual void setInput(double in) {}
+	/** run the network for one sample interval */
+	inline void processNetwork(double xnL, double xnR, double& outL, double& outR)
+	{
+		double input = ioGain*preDelay.processAudioSample(0.5*(xnL + xnR));
 
-	/** get output value; NOTE: a WDF resistor produces no reflected output */
-	virtual double getOutput() { return 0.0; }
+		// --- modulated delay times from triangle LFOs
+		double delay_Samples[MAX_FDN_DELAY_LINES];
+		for (unsigned int i = 0; i < numLines; i++)
+		{
+			if (lfoModCounter[i] >= 1.0)
+				lfoModCounter[i] -= 1.0;
 
-	/** get output1 value; only one resistor output (not used) */
-	virtual double getOutput1() { return  getOutput(); }
+			double lfo = 2.0*fabs(unipolarToBipolar(lfoModCounter[i])) - 1.0;
+			lfoModCounter[i] += lfoInc[i];
+			delay_Samples[i] = delayLine_Samples[i] + lfoDepth[i]*lfo;
+		}
 
-	/** get output2 value; only one resistor output (not used) */
-	virtual double getOutput2() { return  getOutput(); }
+		// --- read the lines with linear interpolation
+		double lineOut[MAX_FDN_DELAY_LINES];
+		for (unsigned int i = 0; i < numLines; i++)
+		{
+			int intDelay = (int)delay_Samples[i];
+			double fraction = delay_Samples[i] - intDelay;
+			int readIndex = ((writeIndex - 1) - intDelay) & wrapMask;
+			int readIndexOlder = (readIndex - 1) & wrapMask;
+			lineOut[i] = doLinearInterpolation(delayBuffer[readIndex*MAX_FDN_DELAY_LINES + i],
+											   delayBuffer[readIndexOlder*MAX_FDN_DELAY_LINES + i], fraction);
+		}
 
-	/** get output3 value; only one resistor output (not used) */
-	virtual double getOutput3() { return  getOutput(); }
+		// --- damping LPF and RT60 gain
+		double feedback[MAX_FDN_DELAY_LINES];
+		for (unsigned int i = 0; i < numLines; i++)
+		{
+			double yn = (1.0 - lpf_g[i])*lineOut[i] + lpf_g[i] * lpfState[i];
+			checkFloatUnderflow(yn);
+			lpfState[i] = yn;
+			feedback[i] = rt60Gain[i] * yn;
+		}
 
-	/** set input1 value; not used for components */
-	virtual void setInput1(double _in1) {}
+		// --- outputs: even lines to left, odd lines to right, alternating signs
+		outL = 0.0;
+		outR = 0.0;
+		for (unsigned int i = 0; i < numLines; i += 4)
+		{
+			outL += feedback[i] - feedback[i + 2];
+			outR += feedback[i + 1] - feedback[i + 3];
+		}
+		outL *= 2.0*ioGain;
+		outR *= 2.0*ioGain;
 
-	/** set input2 value; not used for components */
-	virtual void setInput2(double _in2) {}
+		// --- mix
+		if (parameters.matrix == fdnMatrix::kHadamard)
+			doHadamard(feedback);
+		else
+			doHouseholder(feedback);
 
-	/** set input3 value; not used for components */
-	virtual void setInput3(double _in3) {}
+		// --- write one interleaved frame; input with alternating signs for decorrelation
+		unsigned int writeFrame = writeIndex*MAX_FDN_DELAY_LINES;
+		for (unsigned int i = 0; i < numLines; i++)
+			delayBuffer[writeFrame + i] = feedback[i] + ((i & 2) ? -input : input);
 
-protected:
-	double zRegister = 0.0;			///< storage register (not used with resistor)
-	double componentValue = 0.0;	///< component value in electronic form (ohm, farad, henry)
-	double componentResistance = 0.0;///< simulated resistance
-	double sampleRate = 0.0;		///< sample rate
+		writeIndex = (writeIndex + 1) & wrapMask;
+	}
 };
 
-
 /**
-\class WdfCapacitor
-\ingroup WDF-Objects
+\class PeakLimiter
+\ingroup FX-Objects
 \brief
-The WdfCapacitor object implements the reflection coefficient and signal flow through
-a WDF simulated capacitor.
+The PeakLimiter object implements a simple peak limiter; it is really a simplified and hard-wired
+versio of the DynamicsProcessor
+
+In lookahead mode the limiter is a brickwall: the gain for the peak over the lookahead window is
+min-held for the window and then averaged over the lookahead time, so the gain has fully ramped
+down before the peak leaves the delay line; the output never exceeds the threshold
+(plus makeup gain). The added latency is available with getLatencyInSamples( ).
+
+Audio I/O:
+- Processes mono input to mono output.
+
+Control I/F:
+- setThreshold_dB(double _threshold_dB) to adjust the limiter threshold
+- setMakeUpGain_dB(double _makeUpGain_dB) to adjust the makeup gain
+- setLookahead(bool _enableLookahead, double _lookahead_mSec, bool _truePeak) to set up lookahead mode
 
 \author Will Pirkle http://www.willpirkle.com
 \remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
 \version Revision : 1.0
 \date Date : 2018 / 09 / 7
 */
-class WdfCapacitor : public IComponentAdaptor
+class PeakLimiter : public IAudioSignalProcessor
 {
 public:
-	WdfCapacitor(double _componentValue) { componentValue = _componentValue; }
-	WdfCapacitor() { }
-	virtual ~WdfCapacitor() {}
+	PeakLimiter() { setThreshold_dB(-3.0); }
+	~PeakLimiter() {}
 
-	/** set sample rate and update component */
-	void setSampleRate(double _sampleRate)
+	/** reset members to initialized state */
+	virtual bool reset(double _sampleRate)
 	{
-		sampleRate = _sampleRate;
-		updateComponentResistance();
-	}
+		// --- lookahead
+		if (sampleRate != _sampleRate)
+		{
+			sampleRate = _sampleRate;
+			gainAverage.createCircularBuffer((unsigned int)(MAX_LOOKAHEAD_MSEC*sampleRate / 1000.0) + 1);
+			gainAverage.setInterpolate(false);
+			releaseCoeff = exp(TLD_AUDIO_ENVELOPE_ANALOG_TC / (25.0 * sampleRate * 0.001));
+		}
+		lookahead.reset(_sampleRate);
+		lookahead.setLookahead(lookahead_mSec, truePeak);
+		averageLength = lookahead.getLookaheadSamples() < 1 ? 1 : lookahead.getLookaheadSamples();
+		restartGainAverage();
 
-	/** get component's value as a resistance */
-	virtual double getComponentResistance() { return componentResistance; }
+		// --- init; true = analog time-constant
+		detector.setSampleRate(_sampleRate);
 
-	/** get component's value as a conducatance (or admittance) */
-	virtual double getComponentConductance() { return 1.0 / componentResistance; }
+		AudioDetectorParameters detectorParams = detector.getParameters();
+		detectorParams.detect_dB = true;
+		detectorParams.attackTime_mSec = 5.0;
+		detectorParams.releaseTime_mSec = 25.0;
+		detectorParams.clampToUnityMax = false;
+		detectorParams.detectMode = ENVELOPE_DETECT_MODE_PEAK;
+		detector.setParameters(detectorParams);
 
-	/** get the component value */
-	virtual double getComponentValue() { return componentValue; }
+		return true;
+	}
 
-	/** set the component value */
-	virtual void setComponentValue(double _componentValue)
+	/** return false: this object only processes samples */
+	virtual bool canProcessAudioFrame() { return false; }
+
+	/** process audio: implement hard limiter */
+	/**
+	\param xn input
+	\return the processed sample
+	*/
+	virtual double processAudioSample(double xn)
 	{
-		componentValue = _componentValue;
-		updateComponentResistance();
+		if (enableLookahead)
+			return processLookahead(xn);
+
+		return dB2Raw(makeUpGain_dB)*xn*computeGain(detector.processAudioSample(xn));
 	}
 
-	/** change the resistance of component */
-	virtual void updateComponentResistance()
+	/** set up lookahead mode; the lookahead time is bounded to MAX_LOOKAHEAD_MSEC */
+	void setLookahead(bool _enableLookahead, double _lookahead_mSec, bool _truePeak)
 	{
-		componentResistance = 1.0 / (2.0*componentValue*sampleRate);
+		// --- nothing to do if unchanged; keeps the lookahead and gain average state across buffers
+		if (_enableLookahead == enableLookahead && _lookahead_mSec == lookahead_mSec && _truePeak == truePeak)
+			return;
+
+		enableLookahead = _enableLookahead;
+		lookahead_mSec = _lookahead_mSec;
+		truePeak = _truePeak;
+
+		lookahead.setLookahead(lookahead_mSec, truePeak);
+		unsigned int newAverageLength = lookahead.getLookaheadSamples() < 1 ? 1 : lookahead.getLookaheadSamples();
+		if (newAverageLength == averageLength)
+			return;
+
+		averageLength = newAverageLength;
+		restartGainAverage();
 	}
 
-	/** reset the component; clear registers */
-	virtual void reset(double _sampleRate) { setSampleRate(_sampleRate); zRegister = 0.0; }
+	/** restart the gain average at unity */
+	void restartGainAverage()
+	{
+		// --- buffers are created in reset( )
+		if (sampleRate == 0.0)
+			return;
 
-	/** set input value into component; NOTE: capacitor sets value into register*/
-	virtual void setInput(double in) { zRegister = in; }
+		gainAverage.flushBuffer();
+		for (unsigned int i = 0; i < averageLength; i++)
+			gainAverage.writeBuffer(1.0);
+		gainSum = averageLength;
+		gainSumCount = 0;
+		lastGain = 1.0;
+	}
 
-	/** get output value; NOTE: capacitor produces reflected output */
-	virtual double getOutput() { return zRegister; }	// z^-1
+	/** added latency in samples; report this to the host via PluginBase::setLatencyInSamples( ) */
+	unsigned int getLatencyInSamples() { return enableLookahead ? lookahead.getLatencyInSamples() : 0; }
 
-	/** get output1 value; only one capacitor output (not used) */
-	virtual double getOutput1() { return  getOutput(); }
+	/** compute the gain reductino value based on detected value in dB */
+	double computeGain(double detect_dB)
+	{
+		double output_dB = 0.0;
 
-	/** get output2 value; only one capacitor output (not used) */
-	virtual double getOutput2() { return  getOutput(); }
+		// --- defaults - you can change these here
+		bool softknee = true;
+		double kneeWidth_dB = 10.0;
 
-	/** get output3 value; only one capacitor output (not used) */
-	virtual double getOutput3() { return  getOutput(); }
+		// --- hard knee
+		if (!softknee)
+		{
+			// --- below threshold, unity
+			if (detect_dB <= threshold_dB)
+				output_dB = detect_dB;
+			// --- above threshold, compress
+			else
+				output_dB = threshold_dB;
+		}
+		else
+		{
+			// --- calc gain with knee
+			// --- left side of knee, outside of width, unity gain zone
+			if (2.0*(detect_dB - threshold_dB) < -kneeWidth_dB)
+				output_dB = detect_dB;
+			// --- inside the knee,
+			else if (2.0*(fabs(detect_dB - threshold_dB)) <= kneeWidth_dB)
+				output_dB = detect_dB - pow((detect_dB - threshold_dB + (kneeWidth_dB / 2.0)), 2.0) / (2.0*kneeWidth_dB);
+			// --- right of knee, compression zone
+			else if (2.0*(detect_dB - threshold_dB) > kneeWidth_dB)
+				output_dB = threshold_dB;
+		}
 
-	/** set input1 value; not used for components */
-	virtual void setInput1(double _in1) {}
+		// --- convert difference between threshold and detected to raw
+		return  pow(10.0, (output_dB - detect_dB) / 20.0);
+	}
 
-	/** set input2 value; not used for components */
-	virtual void setInput2(double _in2) {}
+	/** adjust threshold in dB */
+	void setThreshold_dB(double _threshold_dB) { threshold_dB = _threshold_dB; }
 
-	/** set input3 value; not used for components */
-	virtual void setInput3(double _in3) {}
+	/** adjust makeup gain in dB*/
+	void setMakeUpGain_dB(double _makeUpGain_dB) { makeUpGain_dB = _makeUpGain_dB; }
 
 protected:
-	double zRegister = 0.0;			///< storage register (not used with resistor)
-	double componentValue = 0.0;	///< component value in electronic form (ohm, farad, henry)
-	double componentResistance = 0.0;///< simulated resistance
-	double sampleRate = 0.0;		///< sample rate
+	AudioDetector detector;		///< the detector object
+	double threshold_dB = 0.0;	///< stored threshold (dB)
+	double makeUpGain_dB = 0.0;	///< stored makeup gain (dB)
+
+	// --- lookahead mode
+	LookaheadPeakDetector lookahead;	///< lookahead delay and window peak
+	CircularBuffer<double> gainAverage;	///< moving average of held gain values
+	bool enableLookahead = false;		///< lookahead flag
+	bool truePeak = false;				///< true-peak detection flag
+	double lookahead_mSec = 5.0;		///< lookahead time
+	double sampleRate = 0.0;			///< current sample rate
+	unsigned int averageLength = 1;		///< moving average length = lookahead in samples
+	unsigned int gainSumCount = 0;		///< samples since the running sum was recalculated
+	double gainSum = 1.0;				///< running sum for moving average
+	double lastGain = 1.0;				///< last output gain for release
+	double releaseCoeff = 0.0;			///< release time coefficient
+
+	/** lookahead brickwall: the held gain for the window peak is averaged over the lookahead so that every
+	    value in the average already includes the peak of the sample that is leaving the delay */
+	inline double processLookahead(double xn)
+	{
+		double windowPeak = 0.0;
+		double yn = lookahead.processAudioSample(xn, xn, windowPeak);
+
+		// --- gain for the peak over the window
+		double heldGain = computeGain(raw2dB(fmax(windowPeak, kSmallestPositiveFloatValue)));
+
+		// --- O(1) moving average
+		gainSum += heldGain - gainAverage.readBuffer((int)averageLength - 1);
+		gainAverage.writeBuffer(heldGain);
+
+		// --- recalculate the sum once per window to stop roundoff from accumulating
+		if (++gainSumCount >= averageLength)
+		{
+			gainSumCount = 0;
+			gainSum = 0.0;
+			for (unsigned int i = 0; i < averageLength; i++)
+				gainSum += gainAverage.readBuffer((int)i);
+		}
+
+		// --- instant attack, analog release; the average is always an upper bound
+		double gain = fmin(gainSum / averageLength, 1.0);
+		if (gain > lastGain)
+			gain = releaseCoeff*(lastGain - gain) + gain;
+		lastGain = gain;
+
+		return dB2Raw(makeUpGain_dB)*yn*gain;
+	}
 };
 
+
 /**
-\class WdfInductor
-\ingroup WDF-Objects
+\enum vaFilterAlgorithm
+\ingroup Constants-Enums
 \brief
-The WdfInductor object implements the reflection coefficient and signal flow through
-a WDF simulated inductor.
+Use this strongly typed enum to easily set the virtual analog filter algorithm
+
+- enum class vaFilterAlgorithm { kLPF1, kHPF1, kAPF1, kSVF_LP, kSVF_HP, kSVF_BP, kSVF_BS };
 
 \author Will Pirkle http://www.willpirkle.com
 \remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
 \version Revision : 1.0
 \date Date : 2018 / 09 / 7
 */
-class WdfInductor : public IComponentAdaptor
-{
-public:
-	WdfInductor(double _componentValue) { componentValue = _componentValue; }
-	WdfInductor() { }
-	virtual ~WdfInductor() {}
-
-	/** set sample rate and update component */
-	void setSampleRate(double _sampleRate)
-	{
-		sampleRate = _sampleRate;
-		updateComponentResistance();
-	}
-
-	/** get component's value as a resistance */
-	virtual double getComponentResistance() { return componentResistance; }
+enum class vaFilterAlgorithm {
+	kLPF1, kHPF1, kAPF1, kSVF_LP, kSVF_HP, kSVF_BP, kSVF_BS
+}; // --- you will add more here...
 
-	/** get component's value as a conducatance (or admittance) */
-	virtual double getComponentConductance() { return 1.0 / componentResistance; }
 
-	/** get the component value */
-	virtual double getComponentValue() { return componentValue; }
+/**
+\struct ZVAFilterParameters
+\ingroup FX-Objects
+\brief
+Custom parameter structure for the ZVAFilter object.
 
-	/** set the component value */
-	virtual void setComponentValue(double _componentValue)
+\author Will Pirkle http://www.willpirkle.com
+\remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
+\version Revision : 1.0
+\date Date : 2018 / 09 / 7
+*/
+struct ZVAFilterParameters
+{
+	ZVAFilterParameters() {}
+	/** all FXObjects parameter objects require overloaded= operator so remember to add new entries if you add new variables. */
+	ZVAFilterParameters& operator=(const ZVAFilterParameters& params)	// need this override for collections to work
 	{
-		componentValue = _componentValue;
-		updateComponentResistance();
-	}
-
-	/** change the resistance of component R(L) = 2Lfs */
-	virtual void updateComponentResistance(){ componentResistance = 2.0*componentValue*sampleRate;}
-
-	/** reset the component; clear registers */
-	virtual void reset(double _sampleRate) { setSampleRate(_sampleRate); zRegister = 0.0; }
-
-	/** set input value into component; NOTE: inductor sets value into storage register */
-	virtual void setInput(double in) { zRegister = in; }
-
-	/** get output value; NOTE: a WDF inductor produces reflected output that is inverted */
-	virtual double getOutput() { return -zRegister; } // -z^-1
-
-	/** get output1 value; only one resistor output (not used) */
-	virtual double getOutput1() { return  getOutput(); }
-
-	/** get output2 value; only one resistor output (not used) */
-	virtual double getOutput2() { return  getOutput(); }
-
-	/** get output3 value; only one resistor output (not used) */
-	virtual double getOutput3() { return  getOutput(); }
-
-	/** set input1 value; not used for components */
-	virtual void setInput1(double _in1) {}
-
-	/** set input2 value; not used for components */
-	virtual void setInput2(double _in2) {}
+		if (this == &params)
+			return *this;
 
-	/** set input3 value; not used for components */
-	virtual void setInput3(double _in3) {}
+		filterAlgorithm = params.filterAlgorithm;
+		fc = params.fc;
+		Q = params.Q;
+		filterOutputGain_dB = params.filterOutputGain_dB;
+		enableGainComp = params.enableGainComp;
+		matchAnalogNyquistLPF = params.matchAnalogNyquistLPF;
+		selfOscillate = params.selfOscillate;
+		enableNLP = params.enableNLP;
+		return *this;
+	}
 
-protected:
-	double zRegister = 0.0;			///< storage register (not used with resistor)
-	double componentValue = 0.0;	///< component value in electronic form (ohm, farad, henry)
-	double componentResistance = 0.0;///< simulated resistance
-	double sampleRate = 0.0;		///< sample rate
+	// --- individual parameters
+	vaFilterAlgorithm filterAlgorithm = vaFilterAlgorithm::kSVF_LP;	///< va filter algorithm
+	double fc = 1000.0;						///< va filter fc
+	double Q = 0.707;						///< va filter Q
+	double filterOutputGain_dB = 0.0;		///< va filter gain (normally unused)
+	bool enableGainComp = false;			///< enable gain compensation (see book)
+	bool matchAnalogNyquistLPF = false;		///< match analog gain at Nyquist
+	bool selfOscillate = false;				///< enable selfOscillation
+	bool enableNLP = false;					///< enable non linear processing (use oversampling for best results)
 };
 
 
 /**
-\class WdfSeriesLC
-\ingroup WDF-Objects
+\class ZVAFilter
+\ingroup FX-Objects
 \brief
-The WdfSeriesLC object implements the reflection coefficient and signal flow through
-a WDF simulated series LC pair.
+The ZVAFilter object implements multpile Zavalishin VA Filters.
+Audio I/O:
+- Processes mono input to mono output.
+
+Control I/F:
+- Use BiquadParameters structure to get/set object params.
 
 \author Will Pirkle http://www.willpirkle.com
 \remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
-SEE: p143 "Design of Wave Digital Filters" Psenicka, Ugalde, Romero M.
 \version Revision : 1.0
 \date Date : 2018 / 09 / 7
 */
-class WdfSeriesLC : public IComponentAdaptor
+class ZVAFilter : public IAudioSignalProcessor
 {
 public:
-	WdfSeriesLC() {}
-	WdfSeriesLC(double _componentValue_L, double _componentValue_C)
-	{
-		componentValue_L = _componentValue_L;
-		componentValue_C = _componentValue_C;
-	}
-	virtual ~WdfSeriesLC() {}
+	ZVAFilter() {}		/* C-TOR */
+	~ZVAFilter() {}		/* D-TOR */
 
-	/** set sample rate and update component */
-	void setSampleRate(double _sampleRate)
+	/** reset members to initialized state */
+	virtual bool reset(double _sampleRate)
 	{
 		sampleRate = _sampleRate;
-		updateComponentResistance();
-	}
-
-	/** get component's value as a resistance */
-	virtual double getComponentResistance() { return componentResistance; }
+		integrator_z[0] = 0.0;
+		integrator_z[1] = 0.0;
 
-	/** get component's value as a conducatance (or admittance) */
-	virtual double getComponentConductance() { return 1.0 / componentResistance; }
+		return true;
+	}
 
-	/** change the resistance of component; see FX book for details */
-	virtual void updateComponentResistance()
+	/** get parameters: note use of custom structure for passing param data */
+	/**
+	\return ZVAFilterParameters custom data structure
+	*/
+	ZVAFilterParameters getParameters()
 	{
-		RL = 2.0*componentValue_L*sampleRate;
-		RC = 1.0 / (2.0*componentValue_C*sampleRate);
-		componentResistance = RL + (1.0 / RC);
+		return zvaFilterParameters;
 	}
 
-	/** set both LC components at once */
-	virtual void setComponentValue_LC(double _componentValue_L, double _componentValue_C)
+	/** set parameters: note use of custom structure for passing param data */
+	/**
+	\param ZVAFilterParameters custom data structure
+	*/
+	void setParameters(const ZVAFilterParameters& params)
 	{
-		componentValue_L = _componentValue_L;
-		componentValue_C = _componentValue_C;
-		updateComponentResistance();
+		if (params.fc != zvaFilterParameters.fc ||
+			params.Q != zvaFilterParameters.Q ||
+			params.selfOscillate != zvaFilterParameters.selfOscillate ||
+			params.matchAnalogNyquistLPF != zvaFilterParameters.matchAnalogNyquistLPF)
+		{
+				zvaFilterParameters = params;
+				calculateFilterCoeffs();
+		}
+		else
+			zvaFilterParameters = params;
 	}
 
-	/** set L component */
-	virtual void setComponentValue_L(double _componentValue_L)
-	{
-		componentValue_L = _componentValue_L;
-		updateComponentResistance();
-	}
+	/** return false: this object only processes samples */
+	virtual bool canProcessAudioFrame() { return false; }
 
-	/** set C component */
-	virtual void setComponentValue_C(double _componentValue_C)
+	/** process input x(n) through the VA filter to produce return value y(n) */
+	/**
+	\param xn input
+	\return the processed sample
+	*/
+	virtual double processAudioSample(double xn)
 	{
-		componentValue_C = _componentValue_C;
-		updateComponentResistance();
-	}
+		// --- with gain comp enabled, we reduce the input by
+		//     half the gain in dB at resonant peak
+		//     NOTE: you can change that logic here!
+		vaFilterAlgorithm filterAlgorithm = zvaFilterParameters.filterAlgorithm;
+		bool matchAnalogNyquistLPF = zvaFilterParameters.matchAnalogNyquistLPF;
 
-	/** get L component value */
-	virtual double getComponentValue_L() { return componentValue_L; }
+		if (zvaFilterParameters.enableGainComp)
+		{
+			double peak_dB = dBPeakGainFor_Q(zvaFilterParameters.Q);
+			if (peak_dB > 0.0)
+			{
+				double halfPeak_dBGain = dB2Raw(-peak_dB / 2.0);
+				xn *= halfPeak_dBGain;
+			}
+		}
 
-	/** get C component value */
-	virtual double getComponentValue_C() { return componentValue_C; }
+		// --- for 1st order filters:
+		if (filterAlgorithm == vaFilterAlgorithm::kLPF1 ||
+			filterAlgorithm == vaFilterAlgorithm::kHPF1 ||
+			filterAlgorithm == vaFilterAlgorithm::kAPF1)
+		{
+			// --- create vn node
+			double vn = (xn - integrator_z[0])*alpha;
 
-	/** reset the component; clear registers */
-	virtual void reset(double _sampleRate) { setSampleRate(_sampleRate); zRegister_L = 0.0; zRegister_C = 0.0; }
+			// --- form LP output
+			double lpf = ((xn - integrator_z[0])*alpha) + integrator_z[0];
 
-	/** set input value into component; NOTE: K is calculated here */
-	virtual void setInput(double in)
-	{
-		double YC = 1.0 / RC;
-		double K = (1.0 - RL*YC) / (1.0 + RL*YC);
-		double N1 = K*(in - zRegister_L);
-		zRegister_L = N1 + zRegister_C;
-		zRegister_C = in;
-	}
+			// double sn = integrator_z[0];
 
-	/** get output value; NOTE: utput is located in zReg_L */
-	virtual double getOutput(){ return zRegister_L; }
+			// --- update memory
+			integrator_z[0] = vn + lpf;
 
-	/** get output1 value; only one resistor output (not used) */
-	virtual double getOutput1() { return  getOutput(); }
+			// --- form the HPF = INPUT = LPF
+			double hpf = xn - lpf;
 
-	/** get output2 value; only one resistor output (not used) */
-	virtual double getOutput2() { return  getOutput(); }
+			// --- form the APF = LPF - HPF
+			double apf = lpf - hpf;
 
-	/** get output3 value; only one resistor output (not used) */
-	virtual double getOutput3() { return  getOutput(); }
+			// --- set the outputs
+			if (filterAlgorithm == vaFilterAlgorithm::kLPF1)
+			{
+				// --- this is a very close match as-is at Nyquist!
+				if (matchAnalogNyquistLPF)
+					return lpf + alpha*hpf;
+				else
+					return lpf;
+			}
+			else if (filterAlgorithm == vaFilterAlgorithm::kHPF1)
+				return hpf;
+			else if (filterAlgorithm == vaFilterAlgorithm::kAPF1)
+				return apf;
 
-	/** set input1 value; not used for components */
-	virtual void setInput1(double _in1) {}
+			// --- unknown filter
+			return xn;
+		}
 
-	/** set input2 value; not used for components */
-	virtual void setInput2(double _in2) {}
+		// --- form the HP output first
+		double hpf = alpha0*(xn - rho*integrator_z[0] - integrator_z[1]);
 
-	/** set input3 value; not used for components */
-	virtual void setInput3(double _in3) {}
+		// --- BPF Out
+		double bpf = alpha*hpf + integrator_z[0];
+		if (zvaFilterParameters.enableNLP)
+			bpf = softClipWaveShaper(bpf, 1.0);
+
+		// --- LPF Out
+		double lpf = alpha*bpf + integrator_z[1];
+
+		// --- BSF Out
+		double bsf = hpf + lpf;
+
+		// --- finite gain at Nyquist; slight error at VHF
+		double sn = integrator_z[0];
+
+		// update memory
+		integrator_z[0] = alpha*hpf + bpf;
+		integrator_z[1] = alpha*bpf + lpf;
+
+		double filterOutputGain = pow(10.0, zvaFilterParameters.filterOutputGain_dB / 20.0);
+
+		// return our selected type
+		if (filterAlgorithm == vaFilterAlgorithm::kSVF_LP)
+		{
+			if (matchAnalogNyquistLPF)
+				lpf += analogMatchSigma*(sn);
+			return filterOutputGain*lpf;
+		}
+		else if (filterAlgorithm == vaFilterAlgorithm::kSVF_HP)
+			return filterOutputGain*hpf;
+		else if (filterAlgorithm == vaFilterAlgorithm::kSVF_BP)
+			return filterOutputGain*bpf;
+		else if (filterAlgorithm == vaFilterAlgorithm::kSVF_BS)
+			return filterOutputGain*bsf;
+
+		// --- unknown filter
+		return filterOutputGain*lpf;
+	}
+
+	/** recalculate the filter coefficients*/
+	void calculateFilterCoeffs()
+	{
+		double fc = zvaFilterParameters.fc;
+		double Q = zvaFilterParameters.Q;
+		vaFilterAlgorithm filterAlgorithm = zvaFilterParameters.filterAlgorithm;
+
+		// --- normal Zavalishin SVF calculations here
+		//     prewarp the cutoff- these are bilinear-transform filters
+		double wd = kTwoPi*fc;
+		double T = 1.0 / sampleRate;
+		double wa = (2.0 / T)*tan(wd*T / 2.0);
+		double g = wa*T / 2.0;
+
+		// --- for 1st order filters:
+		if (filterAlgorithm == vaFilterAlgorithm::kLPF1 ||
+			filterAlgorithm == vaFilterAlgorithm::kHPF1 ||
+			filterAlgorithm == vaFilterAlgorithm::kAPF1)
+		{
+			// --- calculate alpha
+			alpha = g / (1.0 + g);
+		}
+		else // state variable variety
+		{
+			// --- note R is the traditional analog damping factor zeta
+			double R = zvaFilterParameters.selfOscillate ? 0.0 : 1.0 / (2.0*Q);
+			alpha0 = 1.0 / (1.0 + 2.0*R*g + g*g);
+			alpha = g;
+			rho = 2.0*R + g;
+
+			// --- sigma for analog matching version
+			double f_o = (sampleRate / 2.0) / fc;
+			analogMatchSigma = 1.0 / (alpha*f_o*f_o);
+		}
+	}
+
+	/** set beta value, for filters that aggregate 1st order VA sections*/
+	void setBeta(double _beta) { beta = _beta; }
+
+	/** get beta value,not used in book projects; for future use*/
+	double getBeta() { return beta; }
 
 protected:
-	double zRegister_L = 0.0; ///< storage register for L
-	double zRegister_C = 0.0; ///< storage register for C
+	ZVAFilterParameters zvaFilterParameters;	///< object parameters
+	double sampleRate = 44100.0;				///< current sample rate
 
-	double componentValue_L = 0.0; ///< component value L
-	double componentValue_C = 0.0; ///< component value C
+	// --- state storage
+	double integrator_z[2];						///< state variables
+
+	// --- filter coefficients
+	double alpha0 = 0.0;		///< input scalar, correct delay-free loop
+	double alpha = 0.0;			///< alpha is (wcT/2)
+	double rho = 0.0;			///< p = 2R + g (feedback)
+
+	double beta = 0.0;			///< beta value, not used
+
+	// --- for analog Nyquist matching
+	double analogMatchSigma = 0.0; ///< analog matching Sigma value (see book)
 
-	double RL = 0.0; ///< RL value
-	double RC = 0.0; ///< RC value
-	double componentResistance = 0.0; ///< equivalent resistance of pair of components
-	double sampleRate = 0.0; ///< sample rate
 };
 
 /**
-\class WdfParallelLC
-\ingroup WDF-Objects
+\struct EnvelopeFollowerParameters
+\ingroup FX-Objects
 \brief
-The WdfParallelLC object implements the reflection coefficient and signal flow through
-a WDF simulated parallel LC pair.
+Custom parameter structure for the EnvelopeFollower object.
 
 \author Will Pirkle http://www.willpirkle.com
 \remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
-SEE: p143 "Design of Wave Digital Filters" Psenicka, Ugalde, Romero M.
 \version Revision : 1.0
 \date Date : 2018 / 09 / 7
 */
-class WdfParallelLC : public IComponentAdaptor
+struct EnvelopeFollowerParameters
 {
-public:
-	WdfParallelLC() {}
-	WdfParallelLC(double _componentValue_L, double _componentValue_C)
+	EnvelopeFollowerParameters() {}
+	/** all FXObjects parameter objects require overloaded= operator so remember to add new entries if you add new variables. */
+	EnvelopeFollowerParameters& operator=(const EnvelopeFollowerParameters& params)	// need this override for collections to work
 	{
-		componentValue_L = _componentValue_L;
-		componentValue_C = _componentValue_C;
-	}
-	virtual ~WdfParallelLC() {}
+		if (this == &params)
+			return *this;
 
-	/** set sample rate and update component */
-	void setSampleRate(double _sampleRate)
-	{
-		sampleRate = _sampleRate;
-		updateComponentResistance();
-	}
+		fc = params.fc;
+		Q = params.Q;
+		attackTime_mSec = params.attackTime_mSec;
+		releaseTime_mSec = params.releaseTime_mSec;
+		threshold_dB = params.threshold_dB;
+		sensitivity = params.sensitivity;
 
-	/** get component's value as a resistance */
-	virtual double getComponentResistance() { return componentResistance; }
+		return *this;
+	}
 
-	/** get component's value as a conducatance (or admittance) */
-	virtual double getComponentConductance() { return 1.0 / componentResistance; }
+	// --- individual parameters
+	double fc = 0.0;				///< filter fc
+	double Q = 0.707;				///< filter Q
+	double attackTime_mSec = 10.0;	///< detector attack time
+	double releaseTime_mSec = 10.0;	///< detector release time
+	double threshold_dB = 0.0;		///< detector threshold in dB
+	double sensitivity = 1.0;		///< detector sensitivity
+};
 
-	/** change the resistance of component; see FX book for details */
-	virtual void updateComponentResistance()
-	{
-		RL = 2.0*componentValue_L*sampleRate;
-		RC = 1.0 / (2.0*componentValue_C*sampleRate);
-		componentResistance = (RC + 1.0 / RL);
-	}
+/**
+\class EnvelopeFollower
+\ingroup FX-Objects
+\brief
+The EnvelopeFollower object implements a traditional envelope follower effect modulating a LPR fc value
+using the strength of the detected input.
 
-	/** set both LC components at once */
-	virtual void setComponentValue_LC(double _componentValue_L, double _componentValue_C)
-	{
-		componentValue_L = _componentValue_L;
-		componentValue_C = _componentValue_C;
-		updateComponentResistance();
-	}
+Audio I/O:
+- Processes mono input to mono output.
 
-	/** set L component */
-	virtual void setComponentValue_L(double _componentValue_L)
+Control I/F:
+- Use EnvelopeFollowerParameters structure to get/set object params.
+
+\author Will Pirkle http://www.willpirkle.com
+\remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
+\version Revision : 1.0
+\date Date : 2018 / 09 / 7
+*/
+class EnvelopeFollower : public IAudioSignalProcessor
+{
+public:
+	EnvelopeFollower() {
+		// --- setup the filter
+		ZVAFilterParameters filterParams;
+		filterParams.filterAlgorithm = vaFilterAlgorithm::kSVF_LP;
+		filterParams.fc = 1000.0;
+		filterParams.enableGainComp = true;
+		filterParams.enableNLP = true;
+		filterParams.matchAnalogNyquistLPF = true;
+		filter.setParameters(filterParams);
+
+		// --- setup the detector
+		AudioDetectorParameters adParams;
+		adParams.attackTime_mSec = -1.0;
+		adParams.releaseTime_mSec = -1.0;
+		adParams.detectMode = TLD_AUDIO_DETECT_MODE_RMS;
+		adParams.detect_dB = true;
+		adParams.clampToUnityMax = false;
+		detector.setParameters(adParams);
+
+	}		/* C-TOR */
+	~EnvelopeFollower() {}		/* D-TOR */
+
+	/** reset members to initialized state */
+	virtual bool reset(double _sampleRate)
 	{
-		componentValue_L = _componentValue_L;
-		updateComponentResistance();
+		filter.reset(_sampleRate);
+		detector.reset(_sampleRate);
+		return true;
 	}
 
-	/** set C component */
-	virtual void setComponentValue_C(double _componentValue_C)
+	/** get parameters: note use of custom structure for passing param data */
+	/**
+	\return EnvelopeFollowerParameters custom data structure
+	*/
+	EnvelopeFollowerParameters getParameters() { return parameters; }
+
+	/** set parameters: note use of custom structure for passing param data */
+	/**
+	\param EnvelopeFollowerParameters custom data structure
+	*/
+	void setParameters(const EnvelopeFollowerParameters& params)
 	{
-		componentValue_C = _componentValue_C;
-		updateComponentResistance();
-	}
+		ZVAFilterParameters filterParams = filter.getParameters();
+		AudioDetectorParameters adParams = detector.getParameters();
 
-	/** get L component value */
-	virtual double getComponentValue_L() { return componentValue_L; }
+		if (params.fc != parameters.fc || params.Q != parameters.Q)
+		{
+			filterParams.fc = params.fc;
+			filterParams.Q = params.Q;
+			filter.setParameters(filterParams);
+		}
+		if (params.attackTime_mSec != parameters.attackTime_mSec ||
+			params.releaseTime_mSec != parameters.releaseTime_mSec)
+		{
+			adParams.attackTime_mSec = params.attackTime_mSec;
+			adParams.releaseTime_mSec = params.releaseTime_mSec;
+			detector.setParameters(adParams);
+		}
 
-	/** get C component value */
-	virtual double getComponentValue_C() { return componentValue_C; }
+		// --- save
+		parameters = params;
+	}
 
-	/** reset the component; clear registers */
-	virtual void reset(double _sampleRate) { setSampleRate(_sampleRate); zRegister_L = 0.0; zRegister_C = 0.0; }
+	/** return false: this object only processes samples */
+	virtual bool canProcessAudioFrame() { return false; }
 
-	/** set input value into component; NOTE: K is calculated here */
-	virtual void setInput(double in)
+	/** process input x(n) through the envelope follower to produce return value y(n) */
+	/**
+	\param xn input
+	\return the processed sample
+	*/
+	virtual double processAudioSample(double xn)
 	{
-		double YL = 1.0 / RL;
-		double K = (YL*RC - 1.0) / (YL*RC + 1.0);
-		double N1 = K*(in - zRegister_L);
-		zRegister_L = N1 + zRegister_C;
-		zRegister_C = in;
-	}
+		// --- calc threshold
+		double threshValue = pow(10.0, parameters.threshold_dB / 20.0);
 
-	/** get output value; NOTE: output is located in -zReg_L */
-	virtual double getOutput(){ return -zRegister_L; }
+		// --- detect the signal
+		double detect_dB = detector.processAudioSample(xn);
+		double detectValue = pow(10.0, detect_dB / 20.0);
+		double deltaValue = detectValue - threshValue;
 
-	/** get output1 value; only one resistor output (not used) */
-	virtual double getOutput1() { return  getOutput(); }
+		ZVAFilterParameters filterParams = filter.getParameters();
+		filterParams.fc = parameters.fc;
 
-	/** get output2 value; only one resistor output (not used) */
-	virtual double getOutput2() { return  getOutput(); }
+		// --- if above the threshold, modulate the filter fc
+		if (deltaValue > 0.0)// || delta_dB > 0.0)
+		{
+			// --- fc Computer
+			double modulatorValue = 0.0;
 
-	/** get output3 value; only one resistor output (not used) */
-	virtual double getOutput3() { return  getOutput(); }
+			// --- best results are with linear values when detector is in dB mode
+			modulatorValue = (deltaValue * parameters.sensitivity);
 
-	/** set input1 value; not used for components */
-	virtual void setInput1(double _in1) {}
+			// --- calculate modulated frequency
+			filterParams.fc = doUnipolarModulationFromMin(modulatorValue, parameters.fc, kMaxFilterFrequency);
+		}
 
-	/** set input2 value; not used for components */
-	virtual void setInput2(double _in2) {}
+		// --- update with new modulated frequency
+		filter.setParameters(filterParams);
 
-	/** set input3 value; not used for components */
-	virtual void setInput3(double _in3) {}
+		// --- perform the filtering operation
+		return filter.processAudioSample(xn);
+	}
 
 protected:
-	double zRegister_L = 0.0; ///< storage register for L
-	double zRegister_C = 0.0; ///< storage register for C
-
-	double componentValue_L = 0.0; ///< component value L
-	double componentValue_C = 0.0; ///< component value C
+	EnvelopeFollowerParameters parameters; ///< object parameters
 
-	double RL = 0.0; ///< RL value
-	double RC = 0.0; ///< RC value
-	double componentResistance = 0.0; ///< equivalent resistance of pair of components
-	double sampleRate = 0.0; ///< sample rate
+	// --- 1 filter and 1 detector
+	ZVAFilter filter;		///< filter to modulate
+	AudioDetector detector; ///< detector to track input signal
 };
 
+/**
+\enum distortionModel
+\ingroup Constants-Enums
+\brief
+Use this strongly typed enum to easily set the waveshaper model for the Triode objects
+
+- enum class distortionModel { kSoftClip, kArcTan, kFuzzAsym };
+
+\author Will Pirkle http://www.willpirkle.com
+\remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
+\version Revision : 1.0
+\date Date : 2018 / 09 / 7
+*/
+enum class distortionModel { kSoftClip, kArcTan, kFuzzAsym };
 
 /**
-\class WdfSeriesRL
-\ingroup WDF-Objects
+\struct TriodeClassAParameters
+\ingroup FX-Objects
 \brief
-The WdfSeriesRL object implements the reflection coefficient and signal flow through
-a WDF simulated series RL pair.
+Custom parameter structure for the TriodeClassA object.
 
 \author Will Pirkle http://www.willpirkle.com
 \remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
-SEE: p143 "Design of Wave Digital Filters" Psenicka, Ugalde, Romero M.
 \version Revision : 1.0
 \date Date : 2018 / 09 / 7
 */
-class WdfSeriesRL : public IComponentAdaptor
+struct TriodeClassAParameters
 {
-public:
-	WdfSeriesRL() {}
-	WdfSeriesRL(double _componentValue_R, double _componentValue_L)
+	TriodeClassAParameters() {}
+	/** all FXObjects parameter objects require overloaded= operator so remember to add new entries if you add new variables. */
+	TriodeClassAParameters& operator=(const TriodeClassAParameters& params)	// need this override for collections to work
 	{
-		componentValue_L = _componentValue_L;
-		componentValue_R = _componentValue_R;
-	}
-	virtual ~WdfSeriesRL() {}
+		if (this == &params)
+			return *this;
 
-	/** set sample rate and update component */
-	void setSampleRate(double _sampleRate)
-	{
-		sampleRate = _sampleRate;
-		updateComponentResistance();
-	}
+		waveshaper = params.waveshaper;
+		saturation = params.saturation;
+		asymmetry = params.asymmetry;
+		outputGain = params.outputGain;
 
-	/** get component's value as a resistance */
-	virtual double getComponentResistance() { return componentResistance; }
+		invertOutput = params.invertOutput;
+		enableHPF = params.enableHPF;
+		enableLSF = params.enableLSF;
 
-	/** get component's value as a conducatance (or admittance) */
-	virtual double getComponentConductance() { return 1.0 / componentResistance; }
+		hpf_Fc = params.hpf_Fc;
+		lsf_Fshelf = params.lsf_Fshelf;
+		lsf_BoostCut_dB = params.lsf_BoostCut_dB;
 
-	/** change the resistance of component; see FX book for details */
-	virtual void updateComponentResistance()
-	{
-		RR = componentValue_R;
-		RL = 2.0*componentValue_L*sampleRate;
-		componentResistance = RR + RL;
-		K = RR / componentResistance;
+		return *this;
 	}
 
-	/** set both RL components at once */
-	virtual void setComponentValue_RL(double _componentValue_R, double _componentValue_L)
-	{
-		componentValue_L = _componentValue_L;
-		componentValue_R = _componentValue_R;
-		updateComponentResistance();
-	}
+	// --- individual parameters
+	distortionModel waveshaper = distortionModel::kSoftClip; ///< waveshaper
 
-	/** set L component */
-	virtual void setComponentValue_L(double _componentValue_L)
-	{
-		componentValue_L = _componentValue_L;
-		updateComponentResistance();
-	}
-
-	/** set R component */
-	virtual void setComponentValue_R(double _componentValue_R)
-	{
-		componentValue_R = _componentValue_R;
-		updateComponentResistance();
-	}
-
-	/** get L component value */
-	virtual double getComponentValue_L() { return componentValue_L; }
-
-	/** get R component value */
-	virtual double getComponentValue_R() { return componentValue_R; }
-
-	/** reset the component; clear registers */
-	virtual void reset(double _sampleRate) { setSampleRate(_sampleRate); zRegister_L = 0.0; zRegister_C = 0.0; }
-
-	/** set input value into component */
-	virtual void setInput(double in){ zRegister_L = in; }
-
-	/** get output value; NOTE: see FX book for details */
-	virtual double getOutput()
-	{
-		double NL = -zRegister_L;
-		double out = NL*(1.0 - K) - K*zRegister_C;
-		zRegister_C = out;
-
-		return out;
-	}
-
-	/** get output1 value; only one resistor output (not used) */
-	virtual double getOutput1() { return  getOutput(); }
-
-	/** get output2 value; only one resistor output (not used) */
-	virtual double getOutput2() { return  getOutput(); }
-
-	/** get output3 value; only one resistor output (not used) */
-	virtual double getOutput3() { return  getOutput(); }
-
-	/** set input1 value; not used for components */
-	virtual void setInput1(double _in1) {}
-
-	/** set input2 value; not used for components */
-	virtual void setInput2(double _in2) {}
-
-	/** set input3 value; not used for components */
-	virtual void setInput3(double _in3) {}
-
-protected:
-	double zRegister_L = 0.0; ///< storage register for L
-	double zRegister_C = 0.0;///< storage register for C (not used)
-	double K = 0.0;
-
-	double componentValue_L = 0.0;///< component value L
-	double componentValue_R = 0.0;///< component value R
+	double saturation = 1.0;	///< saturation level
+	double asymmetry = 0.0;		///< asymmetry level
+	double outputGain = 1.0;	///< outputGain level
 
-	double RL = 0.0; ///< RL value
-	double RC = 0.0; ///< RC value
-	double RR = 0.0; ///< RR value
+	bool invertOutput = true;	///< invertOutput - triodes invert output
+	bool enableHPF = true;		///< HPF simulates DC blocking cap on output
+	bool enableLSF = false;		///< LSF simulates shelf due to cathode self biasing
 
-	double componentResistance = 0.0; ///< equivalent resistance of pair of componen
-	double sampleRate = 0.0; ///< sample rate
+	double hpf_Fc = 1.0;		///< fc of DC blocking cap
+	double lsf_Fshelf = 80.0;	///< shelf fc from self bias cap
+	double lsf_BoostCut_dB = 0.0;///< boost/cut due to cathode self biasing
 };
 
 /**
-\class WdfParallelRL
-\ingroup WDF-Objects
+\class TriodeClassA
+\ingroup FX-Objects
 \brief
-The WdfParallelRL object implements the reflection coefficient and signal flow through
-a WDF simulated parallel RL pair.
+The TriodeClassA object simulates a triode in class A configuration. This is a very simple and basic simulation
+and a starting point for other designs; it is not intended to be a full-fledged triode simulator.
+
+Audio I/O:
+- Processes mono input to mono output.
+
+Control I/F:
+- Use TriodeClassAParameters structure to get/set object params.
 
 \author Will Pirkle http://www.willpirkle.com
 \remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
 \version Revision : 1.0
 \date Date : 2018 / 09 / 7
 */
-class WdfParallelRL : public IComponentAdaptor
+class TriodeClassA : public IAudioSignalProcessor
 {
 public:
-	WdfParallelRL() {}
-	WdfParallelRL(double _componentValue_R, double _componentValue_L)
-	{
-		componentValue_L = _componentValue_L;
-		componentValue_R = _componentValue_R;
-	}
-	virtual ~WdfParallelRL() {}
-
-	/** set sample rate and update component */
-	void setSampleRate(double _sampleRate)
-	{
-		sampleRate = _sampleRate;
-		updateComponentResistance();
-	}
-
-	/** get component's value as a resistance */
-	virtual double getComponentResistance() { return componentResistance; }
+	TriodeClassA() {
+		AudioFilterParameters params;
+		params.algorithm = filterAlgorithm::kHPF1;
+		params.fc = parameters.hpf_Fc;
+		outputHPF.setParameters(params);
 
-	/** get component's value as a conducatance (or admittance) */
-	virtual double getComponentConductance() { return 1.0 / componentResistance; }
+		params.algorithm = filterAlgorithm::kLowShelf;
+		params.fc = parameters.lsf_Fshelf;
+		params.boostCut_dB = parameters.lsf_BoostCut_dB;
+		outputLSF.setParameters(params);
+	}		/* C-TOR */
+	~TriodeClassA() {}		/* D-TOR */
 
-	/** change the resistance of component; see FX book for details */
-	virtual void updateComponentResistance()
+	/** reset members to initialized state */
+	virtual bool reset(double _sampleRate)
 	{
-		RR = componentValue_R;
-		RL = 2.0*componentValue_L*sampleRate;
-		componentResistance = 1.0 / ((1.0 / RR) + (1.0 / RL));
-		K = componentResistance / RR;
-	}
-
+		outputHPF.reset(_sampleRate);
+		outputLSF.reset(_sampleRate);
 
-	/** set both RL components at once */
-	virtual void setComponentValue_RL(double _componentValue_R, double _componentValue_L)
-	{
-		componentValue_L = _componentValue_L;
-		componentValue_R = _componentValue_R;
-		updateComponentResistance();
+		// ---
+		return true;
 	}
 
-	/** set L component */
-	virtual void setComponentValue_L(double _componentValue_L)
-	{
-		componentValue_L = _componentValue_L;
-		updateComponentResistance();
-	}
+	/** get parameters: note use of custom structure for passing param data */
+	/**
+	\return TriodeClassAParameters custom data structure
+	*/
+	TriodeClassAParameters getParameters() { return parameters; }
 
-	/** set R component */
-	virtual void setComponentValue_R(double _componentValue_R)
+	/** set parameters: note use of custom structure for passing param data */
+	/**
+	\param TriodeClassAParameters custom data structure
+	*/
+	void setParameters(const TriodeClassAParameters& params)
 	{
-		componentValue_R = _componentValue_R;
-		updateComponentResistance();
-	}
-
-	/** get L component value */
-	virtual double getComponentValue_L() { return componentValue_L; }
+		parameters = params;
 
-	/** get R component value */
-	virtual double getComponentValue_R() { return componentValue_R; }
+		AudioFilterParameters filterParams;
+		filterParams.algorithm = filterAlgorithm::kHPF1;
+		filterParams.fc = parameters.hpf_Fc;
+		outputHPF.setParameters(filterParams);
 
-	/** reset the component; clear registers */
-	virtual void reset(double _sampleRate) { setSampleRate(_sampleRate); zRegister_L = 0.0; zRegister_C = 0.0; }
+		filterParams.algorithm = filterAlgorithm::kLowShelf;
+		filterParams.fc = parameters.lsf_Fshelf;
+		filterParams.boostCut_dB = parameters.lsf_BoostCut_dB;
+		outputLSF.setParameters(filterParams);
+	}
 
-	/** set input value into component */
-	virtual void setInput(double in){ zRegister_L = in; }
+	/** return false: this object only processes samples */
+	virtual bool canProcessAudioFrame() { return false; }
 
-	/** get output value; NOTE: see FX book for details */
-	virtual double getOutput()
+	/** do the triode simulation to process one input to one output*/
+	/**
+	\param xn input
+	\return the processed sample
+	*/
+	virtual double processAudioSample(double xn)
 	{
-		double NL = -zRegister_L;
-		double out = NL*(1.0 - K) + K*zRegister_C;
-		zRegister_C = out;
-		return out;
-	}
+		// --- perform waveshaping
+		double output = 0.0;
 
-	/** get output1 value; only one resistor output (not used) */
-	virtual double getOutput1() { return  getOutput(); }
+		if (parameters.waveshaper == distortionModel::kSoftClip)
+			output = softClipWaveShaper(xn, parameters.saturation);
+		else if (parameters.waveshaper == distortionModel::kArcTan)
+			output = atanWaveShaper(xn, parameters.saturation);
+		else if (parameters.waveshaper == distortionModel::kFuzzAsym)
+			output = fuzzExp1WaveShaper(xn, parameters.saturation, parameters.asymmetry);
 
-	/** get output2 value; only one resistor output (not used) */
-	virtual double getOutput2() { return  getOutput(); }
+		// --- inversion, normal for plate of class A triode
+		if (parameters.invertOutput)
+			output *= -1.0;
 
-	/** get output3 value; only one resistor output (not used) */
-	virtual double getOutput3() { return  getOutput(); }
+		// --- Output (plate) capacitor = HPF, remove DC offset
+		if (parameters.enableHPF)
+			output = outputHPF.processAudioSample(output);
 
-	/** set input1 value; not used for components */
-	virtual void setInput1(double _in1) {}
+		// --- if cathode resistor bypass, will create low shelf
+		if (parameters.enableLSF)
+			output = outputLSF.processAudioSample(output);
 
-	/** set input2 value; not used for components */
-	virtual void setInput2(double _in2) {}
+		// --- final resistor divider/potentiometer
+		output *= parameters.outputGain;
 
-	/** set input3 value; not used for components */
-	virtual void setInput3(double _in3) {}
+		return output;
+	}
 
 protected:
-	double zRegister_L = 0.0;	///< storage register for L
-	double zRegister_C = 0.0;	///< storage register for L
-	double K = 0.0;				///< K value
-
-	double componentValue_L = 0.0;	///< component value L
-	double componentValue_R = 0.0;	///< component value R
-
-	double RL = 0.0;	///< RL value
-	double RC = 0.0;	///< RC value
-	double RR = 0.0;	///< RR value
-
-	double componentResistance = 0.0; ///< equivalent resistance of pair of components
-	double sampleRate = 0.0; ///< sample rate
+	TriodeClassAParameters parameters;	///< object parameters
+	AudioFilter outputHPF;				///< HPF to simulate output DC blocking cap
+	AudioFilter outputLSF;				///< LSF to simulate shelf caused by cathode self-biasing cap
 };
 
+const unsigned int NUM_TUBES = 4;
+
 /**
-\class WdfSeriesRC
-\ingroup WDF-Objects
+\struct ClassATubePreParameters
+\ingroup FX-Objects
 \brief
-The WdfSeriesRC object implements the reflection coefficient and signal flow through
-a WDF simulated series RC pair.
+Custom parameter structure for the ClassATubePre object.
 
 \author Will Pirkle http://www.willpirkle.com
 \remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
-SEE: p143 "Design of Wave Digital Filters" Psenicka, Ugalde, Romero M.
 \version Revision : 1.0
 \date Date : 2018 / 09 / 7
 */
-class WdfSeriesRC : public IComponentAdaptor
+struct ClassATubePreParameters
 {
-public:
-	WdfSeriesRC() {}
-	WdfSeriesRC(double _componentValue_R, double _componentValue_C)
+	ClassATubePreParameters() {}
+	/** all FXObjects parameter objects require overloaded= operator so remember to add new entries if you add new variables. */
+	ClassATubePreParameters& operator=(const ClassATubePreParameters& params)	// need this override for collections to work
 	{
-		componentValue_C = _componentValue_C;
-		componentValue_R = _componentValue_R;
-	}
-	virtual ~WdfSeriesRC() {}
+		if (this == &params)
+			return *this;
 
-	/** set sample rate and update component */
-	void setSampleRate(double _sampleRate)
-	{
-		sampleRate = _sampleRate;
-		updateComponentResistance();
+		inputLevel_dB = params.inputLevel_dB;
+		saturation = params.saturation;
+		asymmetry = params.asymmetry;
+		outputLevel_dB = params.outputLevel_dB;
+
+		lowShelf_fc = params.lowShelf_fc;
+		lowShelfBoostCut_dB = params.lowShelfBoostCut_dB;
+		highShelf_fc = params.highShelf_fc;
+		highShelfBoostCut_dB = params.highShelfBoostCut_dB;
+
+		return *this;
 	}
 
-	/** get component's value as a resistance */
-	virtual double getComponentResistance() { return componentResistance; }
+	// --- individual parameters
+	double inputLevel_dB = 0.0;		///< input level in dB
+	double saturation = 0.0;		///< input level in dB
+	double asymmetry = 0.0;			///< input level in dB
+	double outputLevel_dB = 0.0;	///< input level in dB
 
-	/** get component's value as a conducatance (or admittance) */
-	virtual double getComponentConductance() { return 1.0 / componentResistance; }
+	// --- shelving filter params
+	double lowShelf_fc = 0.0;			///< LSF shelf frequency
+	double lowShelfBoostCut_dB = 0.0;	///< LSF shelf gain/cut
+	double highShelf_fc = 0.0;			///< HSF shelf frequency
+	double highShelfBoostCut_dB = 0.0;	///< HSF shelf frequency
 
-	/** change the resistance of component; see FX book for details */
-	virtual void updateComponentResistance()
-	{
-		RR = componentValue_R;
-		RC = 1.0 / (2.0*componentValue_C*sampleRate);
-		componentResistance = RR + RC;
-		K = RR / componentResistance;
-	}
+};
 
-	/** set both RC components at once */
-	virtual void setComponentValue_RC(double _componentValue_R, double _componentValue_C)
-	{
-		componentValue_R = _componentValue_R;
-		componentValue_C = _componentValue_C;
-		updateComponentResistance();
-	}
+/**
+\class ClassATubePre
+\ingroup FX-Objects
+\brief
+The ClassATubePre object implements a simple cascade of four (4) triode tube models.
 
-	/** set R component */
-	virtual void setComponentValue_R(double _componentValue_R)
-	{
-		componentValue_R = _componentValue_R;
-		updateComponentResistance();
-	}
+Audio I/O:
+- Processes mono input to mono output.
 
-	/** set C component */
-	virtual void setComponentValue_C(double _componentValue_C)
+Control I/F:
+- Use ClassATubePreParameters structure to get/set object params.
+
+\author Will Pirkle http://www.willpirkle.com
+\remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
+\version Revision : 1.0
+\date Date : 2018 / 09 / 7
+*/
+class ClassATubePre : public IAudioSignalProcessor
+{
+public:
+	ClassATubePre() {}		/* C-TOR */
+	~ClassATubePre() {}		/* D-TOR */
+
+	/** reset members to initialized state */
+	virtual bool reset(double _sampleRate)
 	{
-		componentValue_C = _componentValue_C;
-		updateComponentResistance();
-	}
+		TriodeClassAParameters tubeParams = triodes[0].getParameters();
+		tubeParams.invertOutput = true;
+		tubeParams.enableHPF = true; // remove DC offsets
+		tubeParams.outputGain = 1.0;
+		tubeParams.saturation = 1.0;
+		tubeParams.asymmetry = 0.0;
+		tubeParams.enableLSF = true;
+		tubeParams.lsf_Fshelf = 88.0;
+		tubeParams.lsf_BoostCut_dB = -12.0;
+		tubeParams.waveshaper = distortionModel::kFuzzAsym;
 
-	/** get R component value */
-	virtual double getComponentValue_R() { return componentValue_R; }
+		for (int i = 0; i < NUM_TUBES; i++)
+		{
+			triodes[i].reset(_sampleRate);
+			triodes[i].setParameters(tubeParams);
+		}
 
-	/** get C component value */
-	virtual double getComponentValue_C() { return componentValue_C; }
+		shelvingFilter.reset(_sampleRate);
 
-	/** reset the component; clear registers */
-	virtual void reset(double _sampleRate) { setSampleRate(_sampleRate); zRegister_L = 0.0; zRegister_C = 0.0; }
+		return true;
+	}
 
-	/** set input value into component */
-	virtual void setInput(double in){ zRegister_L = in; }
+	/** get parameters: note use of custom structure for passing param data */
+	/**
+	\return ClassATubePreParameters custom data structure
+	*/
+	ClassATubePreParameters getParameters() { return parameters; }
 
-	/** get output value; NOTE: see FX book for details */
-	virtual double getOutput()
+	/** set parameters: note use of custom structure for passing param data */
+	/**
+	\param ClassATubePreParameters custom data structure
+	*/
+	void setParameters(const ClassATubePreParameters& params)
 	{
-		double NL = zRegister_L;
-		double out = NL*(1.0 - K) + K*zRegister_C;
-		zRegister_C = out;
-		return out;
-	}
+		// --- check for re-calc
+		if (params.inputLevel_dB != parameters.inputLevel_dB)
+			inputLevel = pow(10.0, params.inputLevel_dB / 20.0);
+		if (params.outputLevel_dB != parameters.outputLevel_dB)
+			outputLevel = pow(10.0, params.outputLevel_dB / 20.0);
 
-	/** get output1 value; only one resistor output (not used) */
-	virtual double getOutput1() { return  getOutput(); }
+		// --- store
+		parameters = params;
 
-	/** get output2 value; only one resistor output (not used) */
-	virtual double getOutput2() { return  getOutput(); }
+		// --- shelving filter update
+		TwoBandShelvingFilterParameters sfParams = shelvingFilter.getParameters();
+		sfParams.lowShelf_fc = parameters.lowShelf_fc;
+		sfParams.lowShelfBoostCut_dB = parameters.lowShelfBoostCut_dB;
+		sfParams.highShelf_fc = parameters.highShelf_fc;
+		sfParams.highShelfBoostCut_dB = parameters.highShelfBoostCut_dB;
+		shelvingFilter.setParameters(sfParams);
 
-	/** get output3 value; only one resistor output (not used) */
-	virtual double getOutput3() { return  getOutput(); }
+		// --- triode updates
+		TriodeClassAParameters tubeParams = triodes[0].getParameters();
+		tubeParams.saturation = parameters.saturation;
+		tubeParams.asymmetry = parameters.asymmetry;
 
-	/** set input1 value; not used for components */
-	virtual void setInput1(double _in1) {}
+		for (int i = 0; i < NUM_TUBES; i++)
+			triodes[i].setParameters(tubeParams);
+	}
 
-	/** set input2 value; not used for components */
-	virtual void setInput2(double _in2) {}
+	/** return false: this object only processes samples */
+	virtual bool canProcessAudioFrame() { return false; }
 
-	/** set input3 value; not used for components */
-	virtual void setInput3(double _in3) {}
+	/** process the input through the four tube models in series */
+	/**
+	\param xn input
+	\return the processed sample
+	*/
+	virtual double processAudioSample(double xn)
+	{
+		double output1 = triodes[0].processAudioSample(xn*inputLevel);
+		double output2 = triodes[1].processAudioSample(output1);
+		double output3 = triodes[2].processAudioSample(output2);
 
-protected:
-	double zRegister_L = 0.0; ///< storage register for L
-	double zRegister_C = 0.0; ///< storage register for C
-	double K = 0.0;
+		// --- filter stage is between 3 and 4
+		double outputEQ = shelvingFilter.processAudioSample(output3);
+		double output4 = triodes[3].processAudioSample(outputEQ);
 
-	double componentValue_R = 0.0;///< component value R
-	double componentValue_C = 0.0;///< component value C
+		return output4*outputLevel;
+	}
 
-	double RL = 0.0;	///< RL value
-	double RC = 0.0;	///< RC value
-	double RR = 0.0;	///< RR value
+protected:
+	ClassATubePreParameters parameters;		///< object parameters
+	TriodeClassA triodes[NUM_TUBES];		///< array of triode tube objects
+	TwoBandShelvingFilter shelvingFilter;	///< shelving filters
 
-	double componentResistance = 0.0; ///< equivalent resistance of pair of components
-	double sampleRate = 0.0; ///< sample rate
+	double inputLevel = 1.0;	///< input level (not in dB)
+	double outputLevel = 1.0;	///< output level (not in dB)
 };
 
+
 /**
-\class WdfParallelRC
-\ingroup WDF-Objects
+\struct BitCrusherParameters
+\ingroup FX-Objects
 \brief
-The WdfParallelRC object implements the reflection coefficient and signal flow through
-a WDF simulated parallal RC pair.
+Custom parameter structure for the BitCrusher object.
 
 \author Will Pirkle http://www.willpirkle.com
 \remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
-SEE: p143 "Design of Wave Digital Filters" Psenicka, Ugalde, Romero M.
 \version Revision : 1.0
 \date Date : 2018 / 09 / 7
 */
-class WdfParallelRC : public IComponentAdaptor
+struct BitCrusherParameters
 {
-public:
-	WdfParallelRC() {}
-	WdfParallelRC(double _componentValue_R, double _componentValue_C)
+	BitCrusherParameters() {}
+	/** all FXObjects parameter objects require overloaded= operator so remember to add new entries if you add new variables. */
+	BitCrusherParameters& operator=(const BitCrusherParameters& params)	// need this override for collections to work
 	{
-		componentValue_C = _componentValue_C;
-		componentValue_R = _componentValue_R;
-	}
-	virtual ~WdfParallelRC() {}
+		if (this == &params)
+			return *this;
 
-	/** set sample rate and update component */
-	void setSampleRate(double _sampleRate)
-	{
-		sampleRate = _sampleRate;
-		updateComponentResistance();
+		quantizedBitDepth = params.quantizedBitDepth;
+		enableDither = params.enableDither;
+		downsampleFactor = params.downsampleFactor;
+
+		return *this;
 	}
 
-	/** get component's value as a resistance */
-	virtual double getComponentResistance() { return componentResistance; }
+	double quantizedBitDepth = 4.0; ///< bid depth of quantizer
+	bool enableDither = false;		///< add TPDF dither (+/- 1 LSB) before quantizing
+	double downsampleFactor = 1.0;	///< sample-and-hold rate reduction: 1.0 = off, 2.0 = half rate, etc. (may be fractional)
+};
 
-	/** get component's value as a conducatance (or admittance) */
-	virtual double getComponentConductance() { return 1.0 / componentResistance; }
+/**
+\class BitCrusher
+\ingroup FX-Objects
+\brief
+The BitCrusher object implements a quantizing bitcrusher algorithm, with optional TPDF dither
+and a sample-and-hold sample rate reducer. The quantizer multiplies by the reciprocal of the
+quantization level and rounds to the nearest level, so the TPDF dither has no dead zone or bias around zero.
 
-	/** change the resistance of component; see FX book for details */
-	virtual void updateComponentResistance()
-	{
-		RR = componentValue_R;
-		RC = 1.0 / (2.0*componentValue_C*sampleRate);
-		componentResistance = 1.0 / ((1.0 / RR) + (1.0 / RC));
-		K = componentResistance / RR;
-	}
+Audio I/O:
+- Processes mono input to mono output.
+- Processes blocks of mono or stereo audio with processAudioBlock( ).
 
-	/** set both RC components at once */
-	virtual void setComponentValue_RC(double _componentValue_R, double _componentValue_C)
-	{
-		componentValue_R = _componentValue_R;
-		componentValue_C = _componentValue_C;
-		updateComponentResistance();
-	}
+Control I/F:
+- Use BitCrusherParameters structure to get/set object params.
 
-	/** set R component */
-	virtual void setComponentValue_R(double _componentValue_R)
+\author Will Pirkle http://www.willpirkle.com
+\remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
+\version Revision : 1.0
+\date Date : 2018 / 09 / 7
+*/
+class BitCrusher : public IAudioSignalProcessor
+{
+public:
+	BitCrusher() { calculateQuantizer(); }		/* C-TOR */
+	~BitCrusher() {}		/* D-TOR */
+
+	/** reset members to initialized state */
+	virtual bool reset(double _sampleRate)
 	{
-		componentValue_R = _componentValue_R;
-		updateComponentResistance();
+		holdPhase = 0.0;
+		heldSample[0] = 0.0;
+		heldSample[1] = 0.0;
+		return true;
 	}
 
-	/** set C component */
-	virtual void setComponentValue_C(double _componentValue_C)
+	/** get parameters: note use of custom structure for passing param data */
+	/**
+	\return BitCrusherParameters custom data structure
+	*/
+	BitCrusherParameters getParameters() { return parameters; }
+
+	/** set parameters: note use of custom structure for passing param data */
+	/**
+	\param BitCrusherParameters custom data structure
+	*/
+	void setParameters(const BitCrusherParameters& params)
 	{
-		componentValue_C = _componentValue_C;
-		updateComponentResistance();
+		parameters = params;
+		parameters.downsampleFactor = fmax(parameters.downsampleFactor, 1.0);
+
+		// --- calculate and store
+		calculateQuantizer();
 	}
 
-	/** get R component value */
-	virtual double getComponentValue_R() { return componentValue_R; }
+	/** set the dither generator seed, for repeatable output */
+	void setDitherSeed(uint32_t seed) { ditherNoise.setSeed(seed); }
 
-	/** get C component value */
-	virtual double getComponentValue_C() { return componentValue_C; }
+	/** return false: this object only processes samples */
+	virtual bool canProcessAudioFrame() { return false; }
 
-	/** reset the component; clear registers */
-	virtual void reset(double _sampleRate) { setSampleRate(_sampleRate); zRegister_L = 0.0; zRegister_C = 0.0; }
+	/** perform the bitcrushing operation (see FX book for back story and details) */
+	/**
+	\param xn input
+	\return the processed sample
+	*/
+	virtual double processAudioSample(double xn)
+	{
+		// --- sample-and-hold
+		if (parameters.downsampleFactor > 1.0)
+		{
+			if (holdPhase <= 0.0)
+			{
+				heldSample[0] = xn;
+				holdPhase += parameters.downsampleFactor;
+			}
+			holdPhase -= 1.0;
+			xn = heldSample[0];
+		}
 
-	/** set input value into component; */
-	virtual void setInput(double in){ zRegister_L = in; }
+		if (parameters.enableDither)
+			xn += ditherScale*(ditherNoise.nextBipolar() + ditherNoise.nextBipolar());
 
-	/** get output value; NOTE: output is located in zRegister_C */
-	virtual double getOutput()
-	{
-		double NL = zRegister_L;
-		double out = NL*(1.0 - K) - K*zRegister_C;
-		zRegister_C = out;
-		return out;
+		return QL*floor(xn*QL_Reciprocal + 0.5);
 	}
 
-	/** get output1 value; only one resistor output (not used) */
-	virtual double getOutput1() { return  getOutput(); }
+	/** process a block of mono or stereo audio */
+	/**
+	\param inputBuffers input channel buffers
+	\param outputBuffers output channel buffers
+	\param inputChannels number of input channels
+	\param outputChannels number of output channels
+	\param blockSize number of samples in the block
+	\return true if processed
+	*/
+	bool processAudioBlock(const float* const* inputBuffers, float** outputBuffers,
+						   uint32_t inputChannels, uint32_t outputChannels, uint32_t blockSize)
+	{
+		// --- make sure we have input and outputs
+		if (inputChannels == 0 || outputChannels == 0)
+			return false;
 
-	/** get output2 value; only one resistor output (not used) */
-	virtual double getOutput2() { return  getOutput(); }
+		uint32_t numChannels = outputChannels > 2 ? 2 : outputChannels;
+		double startPhase = holdPhase;
 
-	/** get output3 value; only one resistor output (not used) */
-	virtual double getOutput3() { return  getOutput(); }
+		for (uint32_t ch = 0; ch < numChannels; ch++)
+		{
+			const float* input = inputBuffers[ch < inputChannels ? ch : 0];
+			float* output = outputBuffers[ch];
 
-	/** set input1 value; not used for components */
-	virtual void setInput1(double _in1) {}
+			// --- process in chunks: rate reduction and dither fill the chunk, then
+			//     the quantizer runs as a plain loop the compiler can vectorize
+			holdPhase = startPhase;
+			for (uint32_t start = 0; start < blockSize; start += BITCRUSHER_CHUNK)
+			{
+				uint32_t count = blockSize - start < (uint32_t)BITCRUSHER_CHUNK ? blockSize - start : (uint32_t)BITCRUSHER_CHUNK;
+				double chunk[BITCRUSHER_CHUNK];
 
-	/** set input2 value; not used for components */
-	virtual void setInput2(double _in2) {}
+				if (parameters.downsampleFactor > 1.0)
+				{
+					for (uint32_t i = 0; i < count; i++)
+					{
+						if (holdPhase <= 0.0)
+						{
+							heldSample[ch] = input[start + i];
+							holdPhase += parameters.downsampleFactor;
+						}
+						holdPhase -= 1.0;
+						chunk[i] = heldSample[ch];
+					}
+				}
+				else
+				{
+					for (uint32_t i = 0; i < count; i++)
+						chunk[i] = input[start + i];
+				}
 
-	/** set input3 value; not used for components */
-	virtual void setInput3(double _in3) {}
+				if (parameters.enableDither)
+				{
+					for (uint32_t i = 0; i < count; i++)
+						chunk[i] += ditherScale*(ditherNoise.nextBipolar() + ditherNoise.nextBipolar());
+				}
 
-protected:
-	double zRegister_L = 0.0; ///< storage register for L
-	double zRegister_C = 0.0; ///< storage register for C
-	double K = 0.0;
+				// --- reciprocal multiply and round
+				for (uint32_t i = 0; i < count; i++)
+					output[start + i] = (float)(QL*floor(chunk[i] * QL_Reciprocal + 0.5));
+			}
+		}
 
-	double componentValue_C = 0.0;	///< component value C
-	double componentValue_R = 0.0;	///< component value R
+		return true;
+	}
 
-	double RL = 0.0; ///< RL value
-	double RC = 0.0; ///< RC value
-	double RR = 0.0; ///< RR value
+protected:
+	enum { BITCRUSHER_CHUNK = 64 };
 
-	double componentResistance = 0.0; ///< equivalent resistance of pair of components
-	double sampleRate = 0.0; ///< sample rate
+	BitCrusherParameters parameters; ///< object parameters
+	double QL = 1.0;				 ///< the quantization level
+	double QL_Reciprocal = 1.0;		 ///< 1/QL for the quantizer
+	double ditherScale = 0.5;		 ///< QL/2: two bipolar values sum to TPDF dither of +/- 1 LSB
+	FastRandom ditherNoise;			 ///< dither generator
+	double holdPhase = 0.0;			 ///< sample-and-hold phase, in samples
+	double heldSample[2] = { 0.0 };	 ///< held samples per channel
+
+	/** calculate the quantizer from the bit depth */
+	void calculateQuantizer()
+	{
+		QL = 2.0 / (pow(2.0, parameters.quantizedBitDepth) - 1.0);
+		QL_Reciprocal = 1.0 / QL;
+		ditherScale = 0.5*QL;
+	}
 };
 
 
 // ------------------------------------------------------------------ //
-// --- WDF ADAPTORS ------------------------------------------------- //
+// --- WDF LIBRARY -------------------------------------------------- //
 // ------------------------------------------------------------------ //
 
 /**
-\enum wdfComponent
-\ingroup Constants-Enums
+\class IComponentAdaptor
+\ingroup Interfaces
 \brief
-Use this strongly typed enum to easily set the wdfComponent type
-
-- enum class wdfComponent { R, L, C, seriesLC, parallelLC, seriesRL, parallelRL, seriesRC, parallelRC };
+Use this interface for objects in the WDF Ladder Filter library; see book for more information.
 
 \author Will Pirkle http://www.willpirkle.com
 \remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
 \version Revision : 1.0
 \date Date : 2018 / 09 / 7
 */
-enum class wdfComponent { R, L, C, seriesLC, parallelLC, seriesRL, parallelRL, seriesRC, parallelRC };
+class IComponentAdaptor
+{
+public:
+	/** initialize with source resistor R1 */
+	virtual void initialize(double _R1) {}
 
-/**
-\struct WdfComponentInfo
-\ingroup WDF-Objects
-\brief
-Custom structure to hold component information.
+	/** initialize all downstream adaptors in the chain */
+	virtual void initializeAdaptorChain() {}
 
-\author Will Pirkle http://www.willpirkle.com
-\remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
-\version Revision : 1.0
-\date Date : 2018 / 09 / 7
-*/
-struct WdfComponentInfo
-{
-	WdfComponentInfo() { }
+	/** set input value into component port  */
+	virtual void setInput(double _in) {}
 
-	WdfComponentInfo(wdfComponent _componentType, double value1 = 0.0, double value2 = 0.0)
-	{
-		componentType = _componentType;
-		if (componentType == wdfComponent::R)
-			R = value1;
-		else if (componentType == wdfComponent::L)
-			L = value1;
-		else if (componentType == wdfComponent::C)
-			C = value1;
-		else if (componentType == wdfComponent::seriesLC || componentType == wdfComponent::parallelLC)
-		{
-			L = value1;
-			C = value2;
-		}
-		else if (componentType == wdfComponent::seriesRL || componentType == wdfComponent::parallelRL)
-		{
-			R = value1;
-			L = value2;
-		}
-		else if (componentType == wdfComponent::seriesRC || componentType == wdfComponent::parallelRC)
-		{
-			R = value1;
-			C = value2;
-		}
-	}
+	/** get output value from component port  */
+	virtual double getOutput() { return 0.0; }
 
-	double R = 0.0; ///< value of R component
-	double L = 0.0;	///< value of L component
-	double C = 0.0;	///< value of C component
-	wdfComponent componentType = wdfComponent::R; ///< selected component type
-};
+	// --- for adaptors
+	/** ADAPTOR: set input port 1  */
+	virtual void setInput1(double _in1) = 0;
+
+	/** ADAPTOR: set input port 2  */
+	virtual void setInput2(double _in2) = 0;
+
+	/** ADAPTOR: set input port 3 */
+	virtual void setInput3(double _in3) = 0;
+
+	/** ADAPTOR: get output port 1 value */
+	virtual double getOutput1() = 0;
+
+	/** ADAPTOR: get output port 2 value */
+	virtual double getOutput2() = 0;
+
+	/** ADAPTOR: get output port 3 value */
+	virtual double getOutput3() = 0;
+
+	/** reset the object with new sample rate */
+	virtual void reset(double _sampleRate) {}
+
+	/** get the commponent resistance from the attached object at Port3 */
+	virtual double getComponentResistance() { return 0.0; }
+
+	/** get the commponent conductance from the attached object at Port3 */
+	virtual double getComponentConductance() { return 0.0; }
 
+	/** update the commponent resistance at Port3 */
+	virtual void updateComponentResistance() {}
+
+	/** set an individual component value (may be R, L, or C */
+	virtual void setComponentValue(double _componentValue) { }
+
+	/** set LC combined values */
+	virtual void setComponentValue_LC(double componentValue_L, double componentValue_C) { }
+
+	/** set RL combined values */
+	virtual void setComponentValue_RL(double componentValue_R, double componentValue_L) { }
+
+	/** set RC combined values */
+	virtual void setComponentValue_RC(double componentValue_R, double componentValue_C) { }
+
+	/** get a component value */
+	virtual double getComponentValue() { return 0.0; }
+};
 
+// ------------------------------------------------------------------ //
+// --- WDF COMPONENTS & COMMBO COMPONENTS --------------------------- //
+// ------------------------------------------------------------------ //
 /**
-\class WdfAdaptorBase
+\class WdfResistor
 \ingroup WDF-Objects
 \brief
-The WdfAdaptorBase object acts as the base class for all WDF Adaptors; the static members allow
-for simplified connection of components. See the FX book for more details.
+The WdfResistor object implements the reflection coefficient and signal flow through
+a WDF simulated resistor.
 
 \author Will Pirkle http://www.willpirkle.com
 \remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
 \version Revision : 1.0
 \date Date : 2018 / 09 / 7
 */
-class WdfAdaptorBase : public IComponentAdaptor
+class WdfResistor : public IComponentAdaptor
 {
 public:
-	WdfAdaptorBase() {}
-	virtual ~WdfAdaptorBase() {}
-
-	/** set the termainal (load) resistance for terminating adaptors */
-	void setTerminalResistance(double _terminalResistance) { terminalResistance = _terminalResistance; }
+	WdfResistor(double _componentValue) { componentValue = _componentValue; }
+	WdfResistor() { }
+	virtual ~WdfResistor() {}
 
-	/** set the termainal (load) resistance as open circuit for terminating adaptors */
-	void setOpenTerminalResistance(bool _openTerminalResistance = true)
+	/** set sample rate and update component */
+	void setSampleRate(double _sampleRate)
 	{
-		// --- flag overrides value
-		openTerminalResistance = _openTerminalResistance;
-		terminalResistance = 1.0e+34; // avoid /0.0
+		sampleRate = _sampleRate;
+		updateComponentResistance();
 	}
 
-	/** set the input (source) resistance for an input adaptor */
-	void setSourceResistance(double _sourceResistance) { sourceResistance = _sourceResistance; }
-
-	/** set the component or connected adaptor at port 1; functions is generic and allows extending the functionality of the WDF Library */
-	void setPort1_CompAdaptor(IComponentAdaptor* _port1CompAdaptor) { port1CompAdaptor = _port1CompAdaptor; }
+	/** get component's value as a resistance */
+	virtual double getComponentResistance() { return componentResistance; }
 
-	/** set the component or connected adaptor at port 2; functions is generic and allows extending the functionality of the WDF Library */
-	void setPort2_CompAdaptor(IComponentAdaptor* _port2CompAdaptor) { port2CompAdaptor = _port2CompAdaptor; }
+	/** get component's value as a conducatance (or admittance) */
+	virtual double getComponentConductance() { return 1.0 / componentResistance; }
 
-	/** set the component or connected adaptor at port 3; functions is generic and allows extending the functionality of the WDF Library */
-	void setPort3_CompAdaptor(IComponentAdaptor* _port3CompAdaptor) { port3CompAdaptor = _port3CompAdaptor; }
+	/** get the component value */
+	virtual double getComponentValue() { return componentValue; }
 
-	/** reset the connected component */
-	virtual void reset(double _sampleRate)
+	/** set the component value */
+	virtual void setComponentValue(double _componentValue)
 	{
-		if (wdfComponent)
-			wdfComponent->reset(_sampleRate);
+		componentValue = _componentValue;
+		updateComponentResistance();
 	}
 
-	/** creates a new WDF component and connects it to Port 3 */
-	void setComponent(wdfComponent componentType, double value1 = 0.0, double value2 = 0.0)
-	{
-		// --- decode and set
-		if (componentType == wdfComponent::R)
-		{
-			wdfComponent = new WdfResistor;
-			wdfComponent->setComponentValue(value1);
-			port3CompAdaptor = wdfComponent;
-		}
-		else if (componentType == wdfComponent::L)
-		{
-			wdfComponent = new WdfInductor;
-			wdfComponent->setComponentValue(value1);
-			port3CompAdaptor = wdfComponent;
-		}
-		else if (componentType == wdfComponent::C)
-		{
-			wdfComponent = new WdfCapacitor;
-			wdfComponent->setComponentValue(value1);
-			port3CompAdaptor = wdfComponent;
-		}
-		else if (componentType == wdfComponent::seriesLC)
-		{
-			wdfComponent = new WdfSeriesLC;
-			wdfComponent->setComponentValue_LC(value1, value2);
-			port3CompAdaptor = wdfComponent;
-		}
-		else if (componentType == wdfComponent::parallelLC)
-		{
-			wdfComponent = new WdfParallelLC;
-			wdfComponent->setComponentValue_LC(value1, value2);
-			port3CompAdaptor = wdfComponent;
-		}
-		else if (componentType == wdfComponent::seriesRL)
-		{
-			wdfComponent = new WdfSeriesRL;
-			wdfComponent->setComponentValue_RL(value1, value2);
-			port3CompAdaptor = wdfComponent;
-		}
-		else if (componentType == wdfComponent::parallelRL)
-		{
-			wdfComponent = new WdfParallelRL;
-			wdfComponent->setComponentValue_RL(value1, value2);
-			port3CompAdaptor = wdfComponent;
-		}
-		else if (componentType == wdfComponent::seriesRC)
-		{
-			wdfComponent = new WdfSeriesRC;
-			wdfComponent->setComponentValue_RC(value1, value2);
-			port3CompAdaptor = wdfComponent;
-		}
-		else if (componentType == wdfComponent::parallelRC)
-		{
-			wdfComponent = new WdfParallelRC;
-			wdfComponent->setComponentValue_RC(value1, value2);
-			port3CompAdaptor = wdfComponent;
-		}
-	}
+	/** change the resistance of component */
+	virtual void updateComponentResistance() { componentResistance = componentValue; }
 
-	/** connect two adapters together upstreamAdaptor --> downstreamAdaptor */
-	static void connectAdaptors(WdfAdaptorBase* upstreamAdaptor, WdfAdaptorBase* downstreamAdaptor)
-	{
-		upstreamAdaptor->setPort2_CompAdaptor(downstreamAdaptor);
-		downstreamAdaptor->setPort1_CompAdaptor(upstreamAdaptor);
-	}
+	/** reset the component; clear registers */
+	virtual void reset(double _sampleRate) { setSampleRate(_sampleRate);  zRegister = 0.0; }
 
-	/** initialize the chain of adaptors from upstreamAdaptor --> downstreamAdaptor */
-	virtual void initializeAdaptorChain()
+	/** set input value into component; NOTE: resistor is dead-end energy sink so this function does nothing */
+	virtual void setInput(double in) {}
+
+	/** get output value; NOTE: a WDF resistor produces no reflected output */
+	virtual double getOutput() { return 0.0; }
+
+	/** get output1 value; only one resistor output (not used) */
+	virtual double getOutput1() { return  getOutput(); }
+
+	/** get output2 value; only one resistor output (not used) */
+	virtual double getOutput2() { return  getOutput(); }
+
+	/** get output3 value; only one resistor output (not used) */
+	virtual double getOutput3() { return  getOutput(); }
+
+	/** set input1 value; not used for components */
+	virtual void setInput1(double _in1) {}
+
+	/** set input2 value; not used for components */
+	virtual void setInput2(double _in2) {}
+
+	/** set input3 value; not used for components */
+	virtual void setInput3(double _in3) {}
+
+protected:
+	double zRegister = 0.0;			///< storage register (not used with resistor)
+	double componentValue = 0.0;	///< component value in electronic form (ohm, farad, henry)
+	double componentResistance = 0.0;///< simulated resistance
+	double sampleRate = 0.0;		///< sample rate
+};
+
+
+/**
+\class WdfCapacitor
+\ingroup WDF-Objects
+\brief
+The WdfCapacitor object implements the reflection coefficient and signal flow through
+a WDF simulated capacitor.
+
+\author Will Pirkle http://www.willpirkle.com
+\remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
+\version Revision : 1.0
+\date Date : 2018 / 09 / 7
+*/
+class WdfCapacitor : public IComponentAdaptor
+{
+public:
+	WdfCapacitor(double _componentValue) { componentValue = _componentValue; }
+	WdfCapacitor() { }
+	virtual ~WdfCapacitor() {}
+
+	/** set sample rate and update component */
+	void setSampleRate(double _sampleRate)
 	{
-		initialize(sourceResistance);
+		sampleRate = _sampleRate;
+		updateComponentResistance();
 	}
 
-	/** set value of single-component adaptor */
+	/** get component's value as a resistance */
+	virtual double getComponentResistance() { return componentResistance; }
+
+	/** get component's value as a conducatance (or admittance) */
+	virtual double getComponentConductance() { return 1.0 / componentResistance; }
+
+	/** get the component value */
+	virtual double getComponentValue() { return componentValue; }
+
+	/** set the component value */
 	virtual void setComponentValue(double _componentValue)
 	{
-		if (wdfComponent)
-			wdfComponent->setComponentValue(_componentValue);
+		componentValue = _componentValue;
+		updateComponentResistance();
 	}
 
-	/** set LC value of mjulti-component adaptor */
-	virtual void setComponentValue_LC(double componentValue_L, double componentValue_C)
+	/** change the resistance of component */
+	virtual void updateComponentResistance()
 	{
-		if (wdfComponent)
-			wdfComponent->setComponentValue_LC(componentValue_L, componentValue_C);
+		componentResistance = 1.0 / (2.0*componentValue*sampleRate);
 	}
 
-	/** set RL value of mjulti-component adaptor */
-	virtual void setComponentValue_RL(double componentValue_R, double componentValue_L)
-	{
-		if (wdfComponent)
-			wdfComponent->setComponentValue_RL(componentValue_R, componentValue_L);
-	}
+	/** reset the component; clear registers */
+	virtual void reset(double _sampleRate) { setSampleRate(_sampleRate); zRegister = 0.0; }
 
-	/** set RC value of mjulti-component adaptor */
-	virtual void setComponentValue_RC(double componentValue_R, double componentValue_C)
-	{
-		if (wdfComponent)
-			wdfComponent->setComponentValue_RC(componentValue_R, componentValue_C);
-	}
+	/** set input value into component; NOTE: capacitor sets value into register*/
+	virtual void setInput(double in) { zRegister = in; }
 
-	/** get adaptor connected at port 1: for extended functionality; not used in WDF ladder filter library */
-	IComponentAdaptor* getPort1_CompAdaptor() { return port1CompAdaptor; }
+	/** get output value; NOTE: capacitor produces reflected output */
+	virtual double getOutput() { return zRegister; }	// z^-1
 
-	/** get adaptor connected at port 2: for extended functionality; not used in WDF ladder filter library */
-	IComponentAdaptor* getPort2_CompAdaptor() { return port2CompAdaptor; }
+	/** get output1 value; only one capacitor output (not used) */
+	virtual double getOutput1() { return  getOutput(); }
 
-	/** get adaptor connected at port 3: for extended functionality; not used in WDF ladder filter library */
-	IComponentAdaptor* getPort3_CompAdaptor() { return port3CompAdaptor; }
+	/** get output2 value; only one capacitor output (not used) */
+	virtual double getOutput2() { return  getOutput(); }
+
+	/** get output3 value; only one capacitor output (not used) */
+	virtual double getOutput3() { return  getOutput(); }
+
+	/** set input1 value; not used for components */
+	virtual void setInput1(double _in1) {}
+
+	/** set input2 value; not used for components */
+	virtual void setInput2(double _in2) {}
+
+	/** set input3 value; not used for components */
+	virtual void setInput3(double _in3) {}
 
 protected:
-	// --- can in theory connect any port to a component OR adaptor;
-	//     though this library is setup with a convention R3 = component
-	IComponentAdaptor* port1CompAdaptor = nullptr;	///< componant or adaptor connected to port 1
-	IComponentAdaptor* port2CompAdaptor = nullptr;	///< componant or adaptor connected to port 2
-	IComponentAdaptor* port3CompAdaptor = nullptr;	///< componant or adaptor connected to port 3
-	IComponentAdaptor* wdfComponent = nullptr;		///< WDF componant connected to port 3 (default operation)
+	double zRegister = 0.0;			///< storage register (not used with resistor)
+	double componentValue = 0.0;	///< component value in electronic form (ohm, farad, henry)
+	double componentResistance = 0.0;///< simulated resistance
+	double sampleRate = 0.0;		///< sample rate
+};
 
-	// --- These hold the input (R1), component (R3) and output (R2) resistances
-	double R1 = 0.0; ///< input port resistance
-	double R2 = 0.0; ///< output port resistance
-	double R3 = 0.0; ///< component resistance
+/**
+\class WdfInductor
+\ingroup WDF-Objects
+\brief
+The WdfInductor object implements the reflection coefficient and signal flow through
+a WDF simulated inductor.
 
-	// --- these are input variables that are stored;
-	//     not used in this implementation but may be required for extended versions
-	double in1 = 0.0;	///< stored port 1 input;  not used in this implementation but may be required for extended versions
-	double in2 = 0.0;	///< stored port 2 input;  not used in this implementation but may be required for extended versions
-	double in3 = 0.0;	///< stored port 3 input;  not used in this implementation but may be required for extended versions
+\author Will Pirkle http://www.willpirkle.com
+\remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
+\version Revision : 1.0
+\date Date : 2018 / 09 / 7
+*/
+class WdfInductor : public IComponentAdaptor
+{
+public:
+	WdfInductor(double _componentValue) { componentValue = _componentValue; }
+	WdfInductor() { }
+	virtual ~WdfInductor() {}
 
-	// --- these are output variables that are stored;
-	//     currently out2 is the only one used as it is y(n) for this library
-	//     out1 and out2 are stored; not used in this implementation but may be required for extended versions
-	double out1 = 0.0;	///< stored port 1 output; not used in this implementation but may be required for extended versions
-	double out2 = 0.0;	///< stored port 2 output; it is y(n) for this library
-	double out3 = 0.0;	///< stored port 3 output; not used in this implementation but may be required for extended versions
+	/** set sample rate and update component */
+	void setSampleRate(double _sampleRate)
+	{
+		sampleRate = _sampleRate;
+		updateComponentResistance();
+	}
+
+	/** get component's value as a resistance */
+	virtual double getComponentResistance() { return componentResistance; }
+
+	/** get component's value as a conducatance (or admittance) */
+	virtual double getComponentConductance() { return 1.0 / componentResistance; }
+
+	/** get the component value */
+	virtual double getComponentValue() { return componentValue; }
+
+	/** set the component value */
+	virtual void setComponentValue(double _componentValue)
+	{
+		componentValue = _componentValue;
+		updateComponentResistance();
+	}
+
+	/** change the resistance of component R(L) = 2Lfs */
+	virtual void updateComponentResistance(){ componentResistance = 2.0*componentValue*sampleRate;}
+
+	/** reset the component; clear registers */
+	virtual void reset(double _sampleRate) { setSampleRate(_sampleRate); zRegister = 0.0; }
+
+	/** set input value into component; NOTE: inductor sets value into storage register */
+	virtual void setInput(double in) { zRegister = in; }
+
+	/** get output value; NOTE: a WDF inductor produces reflected output that is inverted */
+	virtual double getOutput() { return -zRegister; } // -z^-1
+
+	/** get output1 value; only one resistor output (not used) */
+	virtual double getOutput1() { return  getOutput(); }
+
+	/** get output2 value; only one resistor output (not used) */
+	virtual double getOutput2() { return  getOutput(); }
+
+	/** get output3 value; only one resistor output (not used) */
+	virtual double getOutput3() { return  getOutput(); }
+
+	/** set input1 value; not used for components */
+	virtual void setInput1(double _in1) {}
+
+	/** set input2 value; not used for components */
+	virtual void setInput2(double _in2) {}
+
+	/** set input3 value; not used for components */
+	virtual void setInput3(double _in3) {}
+
+protected:
+	double zRegister = 0.0;			///< storage register (not used with resistor)
+	double componentValue = 0.0;	///< component value in electronic form (ohm, farad, henry)
+	double componentResistance = 0.0;///< simulated resistance
+	double sampleRate = 0.0;		///< sample rate
+};
+
+
+/**
+\class WdfSeriesLC
+\ingroup WDF-Objects
+\brief
+The WdfSeriesLC object implements the reflection coefficient and signal flow through
+a WDF simulated series LC pair.
+
+\author Will Pirkle http://www.willpirkle.com
+\remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
+SEE: p143 "Design of Wave Digital Filters" Psenicka, Ugalde, Romero M.
+\version Revision : 1.0
+\date Date : 2018 / 09 / 7
+*/
+class WdfSeriesLC : public IComponentAdaptor
+{
+public:
+	WdfSeriesLC() {}
+	WdfSeriesLC(double _componentValue_L, double _componentValue_C)
+	{
+		componentValue_L = _componentValue_L;
+		componentValue_C = _componentValue_C;
+	}
+	virtual ~WdfSeriesLC() {}
+
+	/** set sample rate and update component */
+	void setSampleRate(double _sampleRate)
+	{
+		sampleRate = _sampleRate;
+		updateComponentResistance();
+	}
+
+	/** get component's value as a resistance */
+	virtual double getComponentResistance() { return componentResistance; }
+
+	/** get component's value as a conducatance (or admittance) */
+	virtual double getComponentConductance() { return 1.0 / componentResistance; }
+
+	/** change the resistance of component; see FX book for details */
+	virtual void updateComponentResistance()
+	{
+		RL = 2.0*componentValue_L*sampleRate;
+		RC = 1.0 / (2.0*componentValue_C*sampleRate);
+		componentResistance = RL + (1.0 / RC);
+	}
+
+	/** set both LC components at once */
+	virtual void setComponentValue_LC(double _componentValue_L, double _componentValue_C)
+	{
+		componentValue_L = _componentValue_L;
+		componentValue_C = _componentValue_C;
+		updateComponentResistance();
+	}
+
+	/** set L component */
+	virtual void setComponentValue_L(double _componentValue_L)
+	{
+		componentValue_L = _componentValue_L;
+		updateComponentResistance();
+	}
+
+	/** set C component */
+	virtual void setComponentValue_C(double _componentValue_C)
+	{
+		componentValue_C = _componentValue_C;
+		updateComponentResistance();
+	}
+
+	/** get L component value */
+	virtual double getComponentValue_L() { return componentValue_L; }
+
+	/** get C component value */
+	virtual double getComponentValue_C() { return componentValue_C; }
+
+	/** reset the component; clear registers */
+	virtual void reset(double _sampleRate) { setSampleRate(_sampleRate); zRegister_L = 0.0; zRegister_C = 0.0; }
+
+	/** set input value into component; NOTE: K is calculated here */
+	virtual void setInput(double in)
+	{
+		double YC = 1.0 / RC;
+		double K = (1.0 - RL*YC) / (1.0 + RL*YC);
+		double N1 = K*(in - zRegister_L);
+		zRegister_L = N1 + zRegister_C;
+		zRegister_C = in;
+	}
+
+	/** get output value; NOTE: utput is located in zReg_L */
+	virtual double getOutput(){ return zRegister_L; }
+
+	/** get output1 value; only one resistor output (not used) */
+	virtual double getOutput1() { return  getOutput(); }
+
+	/** get output2 value; only one resistor output (not used) */
+	virtual double getOutput2() { return  getOutput(); }
+
+	/** get output3 value; only one resistor output (not used) */
+	virtual double getOutput3() { return  getOutput(); }
+
+	/** set input1 value; not used for components */
+	virtual void setInput1(double _in1) {}
+
+	/** set input2 value; not used for components */
+	virtual void setInput2(double _in2) {}
+
+	/** set input3 value; not used for components */
+	virtual void setInput3(double _in3) {}
+
+protected:
+	double zRegister_L = 0.0; ///< storage register for L
+	double zRegister_C = 0.0; ///< storage register for C
+
+	double componentValue_L = 0.0; ///< component value L
+	double componentValue_C = 0.0; ///< component value C
+
+	double RL = 0.0; ///< RL value
+	double RC = 0.0; ///< RC value
+	double componentResistance = 0.0; ///< equivalent resistance of pair of components
+	double sampleRate = 0.0; ///< sample rate
+};
+
+/**
+\class WdfParallelLC
+\ingroup WDF-Objects
+\brief
+The WdfParallelLC object implements the reflection coefficient and signal flow through
+a WDF simulated parallel LC pair.
+
+\author Will Pirkle http://www.willpirkle.com
+\remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
+SEE: p143 "Design of Wave Digital Filters" Psenicka, Ugalde, Romero M.
+\version Revision : 1.0
+\date Date : 2018 / 09 / 7
+*/
+class WdfParallelLC : public IComponentAdaptor
+{
+public:
+	WdfParallelLC() {}
+	WdfParallelLC(double _componentValue_L, double _componentValue_C)
+	{
+		componentValue_L = _componentValue_L;
+		componentValue_C = _componentValue_C;
+	}
+	virtual ~WdfParallelLC() {}
+
+	/** set sample rate and update component */
+	void setSampleRate(double _sampleRate)
+	{
+		sampleRate = _sampleRate;
+		updateComponentResistance();
+	}
+
+	/** get component's value as a resistance */
+	virtual double getComponentResistance() { return componentResistance; }
+
+	/** get component's value as a conducatance (or admittance) */
+	virtual double getComponentConductance() { return 1.0 / componentResistance; }
+
+	/** change the resistance of component; see FX book for details */
+	virtual void updateComponentResistance()
+	{
+		RL = 2.0*componentValue_L*sampleRate;
+		RC = 1.0 / (2.0*componentValue_C*sampleRate);
+		componentResistance = (RC + 1.0 / RL);
+	}
+
+	/** set both LC components at once */
+	virtual void setComponentValue_LC(double _componentValue_L, double _componentValue_C)
+	{
+		componentValue_L = _componentValue_L;
+		componentValue_C = _componentValue_C;
+		updateComponentResistance();
+	}
+
+	/** set L component */
+	virtual void setComponentValue_L(double _componentValue_L)
+	{
+		componentValue_L = _componentValue_L;
+		updateComponentResistance();
+	}
+
+	/** set C component */
+	virtual void setComponentValue_C(double _componentValue_C)
+	{
+		componentValue_C = _componentValue_C;
+		updateComponentResistance();
+	}
+
+	/** get L component value */
+	virtual double getComponentValue_L() { return componentValue_L; }
+
+	/** get C component value */
+	virtual double getComponentValue_C() { return componentValue_C; }
+
+	/** reset the component; clear registers */
+	virtual void reset(double _sampleRate) { setSampleRate(_sampleRate); zRegister_L = 0.0; zRegister_C = 0.0; }
+
+	/** set input value into component; NOTE: K is calculated here */
+	virtual void setInput(double in)
+	{
+		double YL = 1.0 / RL;
+		double K = (YL*RC - 1.0) / (YL*RC + 1.0);
+		double N1 = K*(in - zRegister_L);
+		zRegister_L = N1 + zRegister_C;
+		zRegister_C = in;
+	}
+
+	/** get output value; NOTE: output is located in -zReg_L */
+	virtual double getOutput(){ return -zRegister_L; }
+
+	/** get output1 value; only one resistor output (not used) */
+	virtual double getOutput1() { return  getOutput(); }
+
+	/** get output2 value; only one resistor output (not used) */
+	virtual double getOutput2() { return  getOutput(); }
+
+	/** get output3 value; only one resistor output (not used) */
+	virtual double getOutput3() { return  getOutput(); }
+
+	/** set input1 value; not used for components */
+	virtual void setInput1(double _in1) {}
+
+	/** set input2 value; not used for components */
+	virtual void setInput2(double _in2) {}
+
+	/** set input3 value; not used for components */
+	virtual void setInput3(double _in3) {}
+
+protected:
+	double zRegister_L = 0.0; ///< storage register for L
+	double zRegister_C = 0.0; ///< storage register for C
+
+	double componentValue_L = 0.0; ///< component value L
+	double componentValue_C = 0.0; ///< component value C
+
+	double RL = 0.0; ///< RL value
+	double RC = 0.0; ///< RC value
+	double componentResistance = 0.0; ///< equivalent resistance of pair of components
+	double sampleRate = 0.0; ///< sample rate
+};
+
+
+/**
+\class WdfSeriesRL
+\ingroup WDF-Objects
+\brief
+The WdfSeriesRL object implements the reflection coefficient and signal flow through
+a WDF simulated series RL pair.
+
+\author Will Pirkle http://www.willpirkle.com
+\remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
+SEE: p143 "Design of Wave Digital Filters" Psenicka, Ugalde, Romero M.
+\version Revision : 1.0
+\date Date : 2018 / 09 / 7
+*/
+class WdfSeriesRL : public IComponentAdaptor
+{
+public:
+	WdfSeriesRL() {}
+	WdfSeriesRL(double _componentValue_R, double _componentValue_L)
+	{
+		componentValue_L = _componentValue_L;
+		componentValue_R = _componentValue_R;
+	}
+	virtual ~WdfSeriesRL() {}
+
+	/** set sample rate and update component */
+	void setSampleRate(double _sampleRate)
+	{
+		sampleRate = _sampleRate;
+		updateComponentResistance();
+	}
+
+	/** get component's value as a resistance */
+	virtual double getComponentResistance() { return componentResistance; }
+
+	/** get component's value as a conducatance (or admittance) */
+	virtual double getComponentConductance() { return 1.0 / componentResistance; }
+
+	/** change the resistance of component; see FX book for details */
+	virtual void updateComponentResistance()
+	{
+		RR = componentValue_R;
+		RL = 2.0*componentValue_L*sampleRate;
+		componentResistance = RR + RL;
+		K = RR / componentResistance;
+	}
+
+	/** set both RL components at once */
+	virtual void setComponentValue_RL(double _componentValue_R, double _componentValue_L)
+	{
+		componentValue_L = _componentValue_L;
+		componentValue_R = _componentValue_R;
+		updateComponentResistance();
+	}
+
+	/** set L component */
+	virtual void setComponentValue_L(double _componentValue_L)
+	{
+		componentValue_L = _componentValue_L;
+		updateComponentResistance();
+	}
+
+	/** set R component */
+	virtual void setComponentValue_R(double _componentValue_R)
+	{
+		componentValue_R = _componentValue_R;
+		updateComponentResistance();
+	}
+
+	/** get L component value */
+	virtual double getComponentValue_L() { return componentValue_L; }
+
+	/** get R component value */
+	virtual double getComponentValue_R() { return componentValue_R; }
+
+	/** reset the component; clear registers */
+	virtual void reset(double _sampleRate) { setSampleRate(_sampleRate); zRegister_L = 0.0; zRegister_C = 0.0; }
+
+	/** set input value into component */
+	virtual void setInput(double in){ zRegister_L = in; }
+
+	/** get output value; NOTE: see FX book for details */
+	virtual double getOutput()
+	{
+		double NL = -zRegister_L;
+		double out = NL*(1.0 - K) - K*zRegister_C;
+		zRegister_C = out;
+
+		return out;
+	}
+
+	/** get output1 value; only one resistor output (not used) */
+	virtual double getOutput1() { return  getOutput(); }
+
+	/** get output2 value; only one resistor output (not used) */
+	virtual double getOutput2() { return  getOutput(); }
+
+	/** get output3 value; only one resistor output (not used) */
+	virtual double getOutput3() { return  getOutput(); }
+
+	/** set input1 value; not used for components */
+	virtual void setInput1(double _in1) {}
+
+	/** set input2 value; not used for components */
+	virtual void setInput2(double _in2) {}
+
+	/** set input3 value; not used for components */
+	virtual void setInput3(double _in3) {}
+
+protected:
+	double zRegister_L = 0.0; ///< storage register for L
+	double zRegister_C = 0.0;///< storage register for C (not used)
+	double K = 0.0;
+
+	double componentValue_L = 0.0;///< component value L
+	double componentValue_R = 0.0;///< component value R
+
+	double RL = 0.0; ///< RL value
+	double RC = 0.0; ///< RC value
+	double RR = 0.0; ///< RR value
+
+	double componentResistance = 0.0; ///< equivalent resistance of pair of componen
+	double sampleRate = 0.0; ///< sample rate
+};
+
+/**
+\class WdfParallelRL
+\ingroup WDF-Objects
+\brief
+The WdfParallelRL object implements the reflection coefficient and signal flow through
+a WDF simulated parallel RL pair.
+
+\author Will Pirkle http://www.willpirkle.com
+\remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
+\version Revision : 1.0
+\date Date : 2018 / 09 / 7
+*/
+class WdfParallelRL : public IComponentAdaptor
+{
+public:
+	WdfParallelRL() {}
+	WdfParallelRL(double _componentValue_R, double _componentValue_L)
+	{
+		componentValue_L = _componentValue_L;
+		componentValue_R = _componentValue_R;
+	}
+	virtual ~WdfParallelRL() {}
+
+	/** set sample rate and update component */
+	void setSampleRate(double _sampleRate)
+	{
+		sampleRate = _sampleRate;
+		updateComponentResistance();
+	}
+
+	/** get component's value as a resistance */
+	virtual double getComponentResistance() { return componentResistance; }
+
+	/** get component's value as a conducatance (or admittance) */
+	virtual double getComponentConductance() { return 1.0 / componentResistance; }
+
+	/** change the resistance of component; see FX book for details */
+	virtual void updateComponentResistance()
+	{
+		RR = componentValue_R;
+		RL = 2.0*componentValue_L*sampleRate;
+		componentResistance = 1.0 / ((1.0 / RR) + (1.0 / RL));
+		K = componentResistance / RR;
+	}
+
+
+	/** set both RL components at once */
+	virtual void setComponentValue_RL(double _componentValue_R, double _componentValue_L)
+	{
+		componentValue_L = _componentValue_L;
+		componentValue_R = _componentValue_R;
+		updateComponentResistance();
+	}
+
+	/** set L component */
+	virtual void setComponentValue_L(double _componentValue_L)
+	{
+		componentValue_L = _componentValue_L;
+		updateComponentResistance();
+	}
+
+	/** set R component */
+	virtual void setComponentValue_R(double _componentValue_R)
+	{
+		componentValue_R = _componentValue_R;
+		updateComponentResistance();
+	}
+
+	/** get L component value */
+	virtual double getComponentValue_L() { return componentValue_L; }
+
+	/** get R component value */
+	virtual double getComponentValue_R() { return componentValue_R; }
+
+	/** reset the component; clear registers */
+	virtual void reset(double _sampleRate) { setSampleRate(_sampleRate); zRegister_L = 0.0; zRegister_C = 0.0; }
+
+	/** set input value into component */
+	virtual void setInput(double in){ zRegister_L = in; }
+
+	/** get output value; NOTE: see FX book for details */
+	virtual double getOutput()
+	{
+		double NL = -zRegister_L;
+		double out = NL*(1.0 - K) + K*zRegister_C;
+		zRegister_C = out;
+		return out;
+	}
+
+	/** get output1 value; only one resistor output (not used) */
+	virtual double getOutput1() { return  getOutput(); }
+
+	/** get output2 value; only one resistor output (not used) */
+	virtual double getOutput2() { return  getOutput(); }
+
+	/** get output3 value; only one resistor output (not used) */
+	virtual double getOutput3() { return  getOutput(); }
+
+	/** set input1 value; not used for components */
+	virtual void setInput1(double _in1) {}
+
+	/** set input2 value; not used for components */
+	virtual void setInput2(double _in2) {}
+
+	/** set input3 value; not used for components */
+	virtual void setInput3(double _in3) {}
+
+protected:
+	double zRegister_L = 0.0;	///< storage register for L
+	double zRegister_C = 0.0;	///< storage register for L
+	double K = 0.0;				///< K value
+
+	double componentValue_L = 0.0;	///< component value L
+	double componentValue_R = 0.0;	///< component value R
+
+	double RL = 0.0;	///< RL value
+	double RC = 0.0;	///< RC value
+	double RR = 0.0;	///< RR value
+
+	double componentResistance = 0.0; ///< equivalent resistance of pair of components
+	double sampleRate = 0.0; ///< sample rate
+};
+
+/**
+\class WdfSeriesRC
+\ingroup WDF-Objects
+\brief
+The WdfSeriesRC object implements the reflection coefficient and signal flow through
+a WDF simulated series RC pair.
+
+\author Will Pirkle http://www.willpirkle.com
+\remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
+SEE: p143 "Design of Wave Digital Filters" Psenicka, Ugalde, Romero M.
+\version Revision : 1.0
+\date Date : 2018 / 09 / 7
+*/
+class WdfSeriesRC : public IComponentAdaptor
+{
+public:
+	WdfSeriesRC() {}
+	WdfSeriesRC(double _componentValue_R, double _componentValue_C)
+	{
+		componentValue_C = _componentValue_C;
+		componentValue_R = _componentValue_R;
+	}
+	virtual ~WdfSeriesRC() {}
+
+	/** set sample rate and update component */
+	void setSampleRate(double _sampleRate)
+	{
+		sampleRate = _sampleRate;
+		updateComponentResistance();
+	}
+
+	/** get component's value as a resistance */
+	virtual double getComponentResistance() { return componentResistance; }
+
+	/** get component's value as a conducatance (or admittance) */
+	virtual double getComponentConductance() { return 1.0 / componentResistance; }
+
+	/** change the resistance of component; see FX book for details */
+	virtual void updateComponentResistance()
+	{
+		RR = componentValue_R;
+		RC = 1.0 / (2.0*componentValue_C*sampleRate);
+		componentResistance = RR + RC;
+		K = RR / componentResistance;
+	}
+
+	/** set both RC components at once */
+	virtual void setComponentValue_RC(double _componentValue_R, double _componentValue_C)
+	{
+		componentValue_R = _componentValue_R;
+		componentValue_C = _componentValue_C;
+		updateComponentResistance();
+	}
+
+	/** set R component */
+	virtual void setComponentValue_R(double _componentValue_R)
+	{
+		componentValue_R = _componentValue_R;
+		updateComponentResistance();
+	}
+
+	/** set C component */
+	virtual void setComponentValue_C(double _componentValue_C)
+	{
+		componentValue_C = _componentValue_C;
+		updateComponentResistance();
+	}
+
+	/** get R component value */
+	virtual double getComponentValue_R() { return componentValue_R; }
+
+	/** get C component value */
+	virtual double getComponentValue_C() { return componentValue_C; }
+
+	/** reset the component; clear registers */
+	virtual void reset(double _sampleRate) { setSampleRate(_sampleRate); zRegister_L = 0.0; zRegister_C = 0.0; }
+
+	/** set input value into component */
+	virtual void setInput(double in){ zRegister_L = in; }
+
+	/** get output value; NOTE: see FX book for details */
+	virtual double getOutput()
+	{
+		double NL = zRegister_L;
+		double out = NL*(1.0 - K) + K*zRegister_C;
+		zRegister_C = out;
+		return out;
+	}
+
+	/** get output1 value; only one resistor output (not used) */
+	virtual double getOutput1() { return  getOutput(); }
+
+	/** get output2 value; only one resistor output (not used) */
+	virtual double getOutput2() { return  getOutput(); }
+
+	/** get output3 value; only one resistor output (not used) */
+	virtual double getOutput3() { return  getOutput(); }
+
+	/** set input1 value; not used for components */
+	virtual void setInput1(double _in1) {}
+
+	/** set input2 value; not used for components */
+	virtual void setInput2(double _in2) {}
+
+	/** set input3 value; not used for components */
+	virtual void setInput3(double _in3) {}
+
+protected:
+	double zRegister_L = 0.0; ///< storage register for L
+	double zRegister_C = 0.0; ///< storage register for C
+	double K = 0.0;
+
+	double componentValue_R = 0.0;///< component value R
+	double componentValue_C = 0.0;///< component value C
+
+	double RL = 0.0;	///< RL value
+	double RC = 0.0;	///< RC value
+	double RR = 0.0;	///< RR value
+
+	double componentResistance = 0.0; ///< equivalent resistance of pair of components
+	double sampleRate = 0.0; ///< sample rate
+};
+
+/**
+\class WdfParallelRC
+\ingroup WDF-Objects
+\brief
+The WdfParallelRC object implements the reflection coefficient and signal flow through
+a WDF simulated parallal RC pair.
+
+\author Will Pirkle http://www.willpirkle.com
+\remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
+SEE: p143 "Design of Wave Digital Filters" Psenicka, Ugalde, Romero M.
+\version Revision : 1.0
+\date Date : 2018 / 09 / 7
+*/
+class WdfParallelRC : public IComponentAdaptor
+{
+public:
+	WdfParallelRC() {}
+	WdfParallelRC(double _componentValue_R, double _componentValue_C)
+	{
+		componentValue_C = _componentValue_C;
+		componentValue_R = _componentValue_R;
+	}
+	virtual ~WdfParallelRC() {}
+
+	/** set sample rate and update component */
+	void setSampleRate(double _sampleRate)
+	{
+		sampleRate = _sampleRate;
+		updateComponentResistance();
+	}
+
+	/** get component's value as a resistance */
+	virtual double getComponentResistance() { return componentResistance; }
+
+	/** get component's value as a conducatance (or admittance) */
+	virtual double getComponentConductance() { return 1.0 / componentResistance; }
+
+	/** change the resistance of component; see FX book for details */
+	virtual void updateComponentResistance()
+	{
+		RR = componentValue_R;
+		RC = 1.0 / (2.0*componentValue_C*sampleRate);
+		componentResistance = 1.0 / ((1.0 / RR) + (1.0 / RC));
+		K = componentResistance / RR;
+	}
+
+	/** set both RC components at once */
+	virtual void setComponentValue_RC(double _componentValue_R, double _componentValue_C)
+	{
+		componentValue_R = _componentValue_R;
+		componentValue_C = _componentValue_C;
+		updateComponentResistance();
+	}
+
+	/** set R component */
+	virtual void setComponentValue_R(double _componentValue_R)
+	{
+		componentValue_R = _componentValue_R;
+		updateComponentResistance();
+	}
+
+	/** set C component */
+	virtual void setComponentValue_C(double _componentValue_C)
+	{
+		componentValue_C = _componentValue_C;
+		updateComponentResistance();
+	}
+
+	/** get R component value */
+	virtual double getComponentValue_R() { return componentValue_R; }
+
+	/** get C component value */
+	virtual double getComponentValue_C() { return componentValue_C; }
+
+	/** reset the component; clear registers */
+	virtual void reset(double _sampleRate) { setSampleRate(_sampleRate); zRegister_L = 0.0; zRegister_C = 0.0; }
+
+	/** set input value into component; */
+	virtual void setInput(double in){ zRegister_L = in; }
+
+	/** get output value; NOTE: output is located in zRegister_C */
+	virtual double getOutput()
+	{
+		double NL = zRegister_L;
+		double out = NL*(1.0 - K) - K*zRegister_C;
+		zRegister_C = out;
+		return out;
+	}
+
+	/** get output1 value; only one resistor output (not used) */
+	virtual double getOutput1() { return  getOutput(); }
+
+	/** get output2 value; only one resistor output (not used) */
+	virtual double getOutput2() { return  getOutput(); }
+
+	/** get output3 value; only one resistor output (not used) */
+	virtual double getOutput3() { return  getOutput(); }
+
+	/** set input1 value; not used for components */
+	virtual void setInput1(double _in1) {}
+
+	/** set input2 value; not used for components */
+	virtual void setInput2(double _in2) {}
+
+	/** set input3 value; not used for components */
+	virtual void setInput3(double _in3) {}
+
+protected:
+	double zRegister_L = 0.0; ///< storage register for L
+	double zRegister_C = 0.0; ///< storage register for C
+	double K = 0.0;
+
+	double componentValue_C = 0.0;	///< component value C
+	double componentValue_R = 0.0;	///< component value R
+
+	double RL = 0.0; ///< RL value
+	double RC = 0.0; ///< RC value
+	double RR = 0.0; ///< RR value
+
+	double componentResistance = 0.0; ///< equivalent resistance of pair of components
+	double sampleRate = 0.0; ///< sample rate
+};
+
+
+// ------------------------------------------------------------------ //
+// --- WDF ADAPTORS ------------------------------------------------- //
+// ------------------------------------------------------------------ //
+
+/**
+\enum wdfComponent
+\ingroup Constants-Enums
+\brief
+Use this strongly typed enum to easily set the wdfComponent type
+
+- enum class wdfComponent { R, L, C, seriesLC, parallelLC, seriesRL, parallelRL, seriesRC, parallelRC };
+
+\author Will Pirkle http://www.willpirkle.com
+\remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
+\version Revision : 1.0
+\date Date : 2018 / 09 / 7
+*/
+enum class wdfComponent { R, L, C, seriesLC, parallelLC, seriesRL, parallelRL, seriesRC, parallelRC };
+
+/**
+\struct WdfComponentInfo
+\ingroup WDF-Objects
+\brief
+Custom structure to hold component information.
+
+\author Will Pirkle http://www.willpirkle.com
+\remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
+\version Revision : 1.0
+\date Date : 2018 / 09 / 7
+*/
+struct WdfComponentInfo
+{
+	WdfComponentInfo() { }
+
+	WdfComponentInfo(wdfComponent _componentType, double value1 = 0.0, double value2 = 0.0)
+	{
+		componentType = _componentType;
+		if (componentType == wdfComponent::R)
+			R = value1;
+		else if (componentType == wdfComponent::L)
+			L = value1;
+		else if (componentType == wdfComponent::C)
+			C = value1;
+		else if (componentType == wdfComponent::seriesLC || componentType == wdfComponent::parallelLC)
+		{
+			L = value1;
+			C = value2;
+		}
+		else if (componentType == wdfComponent::seriesRL || componentType == wdfComponent::parallelRL)
+		{
+			R = value1;
+			L = value2;
+		}
+		else if (componentType == wdfComponent::seriesRC || componentType == wdfComponent::parallelRC)
+		{
+			R = value1;
+			C = value2;
+		}
+	}
+
+	double R = 0.0; ///< value of R component
+	double L = 0.0;	///< value of L component
+	double C = 0.0;	///< value of C component
+	wdfComponent componentType = wdfComponent::R; ///< selected component type
+};
+
+
+/**
+\class WdfAdaptorBase
+\ingroup WDF-Objects
+\brief
+The WdfAdaptorBase object acts as the base class for all WDF Adaptors; the static members allow
+for simplified connection of components. See the FX book for more details.
+
+\author Will Pirkle http://www.willpirkle.com
+\remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
+\version Revision : 1.0
+\date Date : 2018 / 09 / 7
+*/
+class WdfAdaptorBase : public IComponentAdaptor
+{
+public:
+	WdfAdaptorBase() {}
+	virtual ~WdfAdaptorBase() {}
+
+	/** set the termainal (load) resistance for terminating adaptors */
+	void setTerminalResistance(double _terminalResistance) { terminalResistance = _terminalResistance; }
+
+	/** set the termainal (load) resistance as open circuit for terminating adaptors */
+	void setOpenTerminalResistance(bool _openTerminalResistance = true)
+	{
+		// --- flag overrides value
+		openTerminalResistance = _openTerminalResistance;
+		terminalResistance = 1.0e+34; // avoid /0.0
+	}
+
+	/** set the input (source) resistance for an input adaptor */
+	void setSourceResistance(double _sourceResistance) { sourceResistance = _sourceResistance; }
+
+	/** set the component or connected adaptor at port 1; functions is generic and allows extending the functionality of the WDF Library */
+	void setPort1_CompAdaptor(IComponentAdaptor* _port1CompAdaptor) { port1CompAdaptor = _port1CompAdaptor; }
+
+	/** set the component or connected adaptor at port 2; functions is generic and allows extending the functionality of the WDF Library */
+	void setPort2_CompAdaptor(IComponentAdaptor* _port2CompAdaptor) { port2CompAdaptor = _port2CompAdaptor; }
+
+	/** set the component or connected adaptor at port 3; functions is generic and allows extending the functionality of the WDF Library */
+	void setPort3_CompAdaptor(IComponentAdaptor* _port3CompAdaptor) { port3CompAdaptor = _port3CompAdaptor; }
+
+	/** reset the connected component */
+	virtual void reset(double _sampleRate)
+	{
+		if (wdfComponent)
+			wdfComponent->reset(_sampleRate);
+	}
+
+	/** creates a new WDF component and connects it to Port 3 */
+	void setComponent(wdfComponent componentType, double value1 = 0.0, double value2 = 0.0)
+	{
+		// --- decode and set
+		if (componentType == wdfComponent::R)
+		{
+			wdfComponent = new WdfResistor;
+			wdfComponent->setComponentValue(value1);
+			port3CompAdaptor = wdfComponent;
+		}
+		else if (componentType == wdfComponent::L)
+		{
+			wdfComponent = new WdfInductor;
+			wdfComponent->setComponentValue(value1);
+			port3CompAdaptor = wdfComponent;
+		}
+		else if (componentType == wdfComponent::C)
+		{
+			wdfComponent = new WdfCapacitor;
+			wdfComponent->setComponentValue(value1);
+			port3CompAdaptor = wdfComponent;
+		}
+		else if (componentType == wdfComponent::seriesLC)
+		{
+			wdfComponent = new WdfSeriesLC;
+			wdfComponent->setComponentValue_LC(value1, value2);
+			port3CompAdaptor = wdfComponent;
+		}
+		else if (componentType == wdfComponent::parallelLC)
+		{
+			wdfComponent = new WdfParallelLC;
+			wdfComponent->setComponentValue_LC(value1, value2);
+			port3CompAdaptor = wdfComponent;
+		}
+		else if (componentType == wdfComponent::seriesRL)
+		{
+			wdfComponent = new WdfSeriesRL;
+			wdfComponent->setComponentValue_RL(value1, value2);
+			port3CompAdaptor = wdfComponent;
+		}
+		else if (componentType == wdfComponent::parallelRL)
+		{
+			wdfComponent = new WdfParallelRL;
+			wdfComponent->setComponentValue_RL(value1, value2);
+			port3CompAdaptor = wdfComponent;
+		}
+		else if (componentType == wdfComponent::seriesRC)
+		{
+			wdfComponent = new WdfSeriesRC;
+			wdfComponent->setComponentValue_RC(value1, value2);
+			port3CompAdaptor = wdfComponent;
+		}
+		else if (componentType == wdfComponent::parallelRC)
+		{
+			wdfComponent = new WdfParallelRC;
+			wdfComponent->setComponentValue_RC(value1, value2);
+			port3CompAdaptor = wdfComponent;
+		}
+	}
+
+	/** connect two adapters together upstreamAdaptor --> downstreamAdaptor */
+	static void connectAdaptors(WdfAdaptorBase* upstreamAdaptor, WdfAdaptorBase* downstreamAdaptor)
+	{
+		upstreamAdaptor->setPort2_CompAdaptor(downstreamAdaptor);
+		downstreamAdaptor->setPort1_CompAdaptor(upstreamAdaptor);
+	}
+
+	/** initialize the chain of adaptors from upstreamAdaptor --> downstreamAdaptor */
+	virtual void initializeAdaptorChain()
+	{
+		initialize(sourceResistance);
+	}
+
+	/** set value of single-component adaptor */
+	virtual void setComponentValue(double _componentValue)
+	{
+		if (wdfComponent)
+			wdfComponent->setComponentValue(_componentValue);
+	}
+
+	/** set LC value of mjulti-component adaptor */
+	virtual void setComponentValue_LC(double componentValue_L, double componentValue_C)
+	{
+		if (wdfComponent)
+			wdfComponent->setComponentValue_LC(componentValue_L, componentValue_C);
+	}
+
+	/** set RL value of mjulti-component adaptor */
+	virtual void setComponentValue_RL(double componentValue_R, double componentValue_L)
+	{
+		if (wdfComponent)
+			wdfComponent->setComponentValue_RL(componentValue_R, componentValue_L);
+	}
+
+	/** set RC value of mjulti-component adaptor */
+	virtual void setComponentValue_RC(double componentValue_R, double componentValue_C)
+	{
+		if (wdfComponent)
+			wdfComponent->setComponentValue_RC(componentValue_R, componentValue_C);
+	}
+
+	/** get adaptor connected at port 1: for extended functionality; not used in WDF ladder filter library */
+	IComponentAdaptor* getPort1_CompAdaptor() { return port1CompAdaptor; }
+
+	/** get adaptor connected at port 2: for extended functionality; not used in WDF ladder filter library */
+	IComponentAdaptor* getPort2_CompAdaptor() { return port2CompAdaptor; }
+
+	/** get adaptor connected at port 3: for extended functionality; not used in WDF ladder filter library */
+	IComponentAdaptor* getPort3_CompAdaptor() { return port3CompAdaptor; }
+
+protected:
+	// --- can in theory connect any port to a component OR adaptor;
+	//     though this library is setup with a convention R3 = component
+	IComponentAdaptor* port1CompAdaptor = nullptr;	///< componant or adaptor connected to port 1
+	IComponentAdaptor* port2CompAdaptor = nullptr;	///< componant or adaptor connected to port 2
+	IComponentAdaptor* port3CompAdaptor = nullptr;	///< componant or adaptor connected to port 3
+	IComponentAdaptor* wdfComponent = nullptr;		///< WDF componant connected to port 3 (default operation)
+
+	// --- These hold the input (R1), component (R3) and output (R2) resistances
+	double R1 = 0.0; ///< input port resistance
+	double R2 = 0.0; ///< output port resistance
+	double R3 = 0.0; ///< component resistance
+
+	// --- these are input variables that are stored;
+	//     not used in this implementation but may be required for extended versions
+	double in1 = 0.0;	///< stored port 1 input;  not used in this implementation but may be required for extended versions
+	double in2 = 0.0;	///< stored port 2 input;  not used in this implementation but may be required for extended versions
+	double in3 = 0.0;	///< stored port 3 input;  not used in this implementation but may be required for extended versions
+
+	// --- these are output variables that are stored;
+	//     currently out2 is the only one used as it is y(n) for this library
+	//     out1 and out2 are stored; not used in this implementation but may be required for extended versions
+	double out1 = 0.0;	///< stored port 1 output; not used in this implementation but may be required for extended versions
+	double out2 = 0.0;	///< stored port 2 output; it is y(n) for this library
+	double out3 = 0.0;	///< stored port 3 output; not used in this implementation but may be required for extended versions
+
+	// --- terminal impedance
+	double terminalResistance = 600.0; ///< value of terminal (load) resistance
+	bool openTerminalResistance = false; ///< flag for open circuit load
+
+	// --- source impedance, OK for this to be set to 0.0 for Rs = 0
+	double sourceResistance = 600.0; ///< source impedance; OK for this to be set to 0.0 for Rs = 0
+};
+
+/**
+\class WdfSeriesAdaptor
+\ingroup WDF-Objects
+\brief
+The WdfSeriesAdaptor object implements the series reflection-free (non-terminated) adaptor
+
+\author Will Pirkle http://www.willpirkle.com
+\remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
+\version Revision : 1.0
+\date Date : 2018 / 09 / 7
+*/
+class WdfSeriesAdaptor : public WdfAdaptorBase
+{
+public:
+	WdfSeriesAdaptor() {}
+	virtual ~WdfSeriesAdaptor() {}
+
+	/** get the resistance at port 2; R2 = R1 + component (series)*/
+	virtual double getR2()
+	{
+		double componentResistance = 0.0;
+		if (getPort3_CompAdaptor())
+			componentResistance = getPort3_CompAdaptor()->getComponentResistance();
+
+		R2 = R1 + componentResistance;
+		return R2;
+	}
+
+	/** initialize adaptor with input resistance */
+	virtual void initialize(double _R1)
+	{
+		// --- R1 is source resistance for this adaptor
+		R1 = _R1;
+
+		double componentResistance = 0.0;
+		if (getPort3_CompAdaptor())
+			componentResistance = getPort3_CompAdaptor()->getComponentResistance();
+
+		// --- calculate B coeff
+		B = R1 / (R1 + componentResistance);
+
+		// --- init downstream adaptor
+		if (getPort2_CompAdaptor())
+			getPort2_CompAdaptor()->initialize(getR2());
+
+		// --- not used in this implementation but saving for extended use
+		R3 = componentResistance;
+	}
+
+	/** push audio input sample into incident wave input*/
+	virtual void setInput1(double _in1)
+	{
+		// --- save
+		in1 = _in1;
+
+		// --- read component value
+		N2 = 0.0;
+		if (getPort3_CompAdaptor())
+			N2 = getPort3_CompAdaptor()->getOutput();
+
+		// --- form output
+		out2 = -(in1 + N2);
+
+		// --- deliver downstream
+		if (getPort2_CompAdaptor())
+			getPort2_CompAdaptor()->setInput1(out2);
+	}
+
+	/** push audio input sample into reflected wave input */
+	virtual void setInput2(double _in2)
+	{
+		// --- save
+		in2 = _in2;
+
+		// --- calc N1
+		N1 = -(in1 - B*(in1 + N2 + in2) + in2);
+
+		// --- calc out1
+		out1 = in1 - B*(N2 + in2);
+
+		// --- deliver upstream
+		if (getPort1_CompAdaptor())
+			getPort1_CompAdaptor()->setInput2(out1);
+
+		// --- set component state
+		if (getPort3_CompAdaptor())
+			getPort3_CompAdaptor()->setInput(N1);
+	}
+
+	/** set input 3 always connects to component */
+	virtual void setInput3(double _in3){ }
+
+	/** get OUT1 = reflected output pin on Port 1 */
+	virtual double getOutput1() { return out1; }
+
+	/** get OUT2 = incident (normal) output pin on Port 2 */
+	virtual double getOutput2() { return out2; }
+
+	/** get OUT3 always connects to component */
+	virtual double getOutput3() { return out3; }
+
+private:
+	double N1 = 0.0;	///< node 1 value, internal use only
+	double N2 = 0.0;	///< node 2 value, internal use only
+	double B = 0.0;		///< B coefficient value
+};
+
+/**
+\class WdfSeriesTerminatedAdaptor
+\ingroup WDF-Objects
+\brief
+The WdfSeriesTerminatedAdaptor object implements the series terminated (non-reflection-free) adaptor
+
+\author Will Pirkle http://www.willpirkle.com
+\remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
+\version Revision : 1.0
+\date Date : 2018 / 09 / 7
+*/
+// --- Series terminated adaptor
+class WdfSeriesTerminatedAdaptor : public WdfAdaptorBase
+{
+public:
+	WdfSeriesTerminatedAdaptor() {}
+	virtual ~WdfSeriesTerminatedAdaptor() {}
+
+	/** get the resistance at port 2; R2 = R1 + component (series)*/
+	virtual double getR2()
+	{
+		double componentResistance = 0.0;
+		if (getPort3_CompAdaptor())
+			componentResistance = getPort3_CompAdaptor()->getComponentResistance();
+
+		R2 = R1 + componentResistance;
+		return R2;
+	}
+
+	/** initialize adaptor with input resistance */
+	virtual void initialize(double _R1)
+	{
+		// --- source impedance
+		R1 = _R1;
+
+		double componentResistance = 0.0;
+		if (getPort3_CompAdaptor())
+			componentResistance = getPort3_CompAdaptor()->getComponentResistance();
+
+		B1 = (2.0*R1) / (R1 + componentResistance + terminalResistance);
+		B3 = (2.0*terminalResistance) / (R1 + componentResistance + terminalResistance);
+
+		// --- init downstream
+		if (getPort2_CompAdaptor())
+			getPort2_CompAdaptor()->initialize(getR2());
+
+		// --- not used in this implementation but saving for extended use
+		R3 = componentResistance;
+	}
+
+	/** push audio input sample into incident wave input*/
+	virtual void setInput1(double _in1)
+	{
+		// --- save
+		in1 = _in1;
+
+		N2 = 0.0;
+		if (getPort3_CompAdaptor())
+			N2 = getPort3_CompAdaptor()->getOutput();
+
+		double N3 = in1 + N2;
+
+		// --- calc out2 y(n)
+		out2 = -B3*N3;
+
+		// --- form output1
+		out1 = in1 - B1*N3;
+
+		// --- form N1
+		N1 = -(out1 + out2 + N3);
+
+		// --- deliver upstream to input2
+		if (getPort1_CompAdaptor())
+			getPort1_CompAdaptor()->setInput2(out1);
+
+		// --- set component state
+		if (getPort3_CompAdaptor())
+			getPort3_CompAdaptor()->setInput(N1);
+	}
+
+	/** push audio input sample into reflected wave input
+	    for terminated adaptor, this is dead end, just store it */
+	virtual void setInput2(double _in2) { in2 = _in2;}
+
+	/** set input 3 always connects to component */
+	virtual void setInput3(double _in3) { in3 = _in3;}
+
+	/** get OUT1 = reflected output pin on Port 1 */
+	virtual double getOutput1() { return out1; }
+
+	/** get OUT2 = incident (normal) output pin on Port 2 */
+	virtual double getOutput2() { return out2; }
+
+	/** get OUT3 always connects to component */
+	virtual double getOutput3() { return out3; }
+
+private:
+	double N1 = 0.0;	///< node 1 value, internal use only
+	double N2 = 0.0;	///< node 2 value, internal use only
+	double B1 = 0.0;	///< B1 coefficient value
+	double B3 = 0.0;	///< B3 coefficient value
+};
+
+/**
+\class WdfParallelAdaptor
+\ingroup WDF-Objects
+\brief
+The WdfParallelAdaptor object implements the parallel reflection-free (non-terminated) adaptor
+
+\author Will Pirkle http://www.willpirkle.com
+\remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
+\version Revision : 1.0
+\date Date : 2018 / 09 / 7
+*/
+class WdfParallelAdaptor : public WdfAdaptorBase
+{
+public:
+	WdfParallelAdaptor() {}
+	virtual ~WdfParallelAdaptor() {}
+
+	/** get the resistance at port 2;  R2 = 1.0/(sum of admittances) */
+	virtual double getR2()
+	{
+		double componentConductance = 0.0;
+		if (getPort3_CompAdaptor())
+			componentConductance = getPort3_CompAdaptor()->getComponentConductance();
+
+		// --- 1 / (sum of admittances)
+		R2 = 1.0 / ((1.0 / R1) + componentConductance);
+		return R2;
+	}
+
+	/** initialize adaptor with input resistance */
+	virtual void initialize(double _R1)
+	{
+		// --- save R1
+		R1 = _R1;
+
+		double G1 = 1.0 / R1;
+		double componentConductance = 0.0;
+		if (getPort3_CompAdaptor())
+			componentConductance = getPort3_CompAdaptor()->getComponentConductance();
+
+		// --- calculate B coeff
+		A = G1 / (G1 + componentConductance);
+
+		// --- now, do we init our downstream??
+		if (getPort2_CompAdaptor())
+			getPort2_CompAdaptor()->initialize(getR2());
+
+		// --- not used in this implementation but saving for extended use
+		R3 = 1.0/ componentConductance;
+	}
+
+	/** push audio input sample into incident wave input*/
+	virtual void setInput1(double _in1)
+	{
+		// --- save
+		in1 = _in1;
+
+		// --- read component
+		N2 = 0.0;
+		if (getPort3_CompAdaptor())
+			N2 = getPort3_CompAdaptor()->getOutput();
+
+		// --- form output
+		out2 = N2 - A*(-in1 + N2);
+
+		// --- deliver downstream
+		if (getPort2_CompAdaptor())
+			getPort2_CompAdaptor()->setInput1(out2);
+	}
+
+	/** push audio input sample into reflected wave input*/
+	virtual void setInput2(double _in2)
+	{
+		// --- save
+		in2 = _in2;
+
+		// --- calc N1
+		N1 = in2 - A*(-in1 + N2);
+
+		// --- calc out1
+		out1 = -in1 + N2 + N1;
+
+		// --- deliver upstream
+		if (getPort1_CompAdaptor())
+			getPort1_CompAdaptor()->setInput2(out1);
+
+		// --- set component state
+		if (getPort3_CompAdaptor())
+			getPort3_CompAdaptor()->setInput(N1);
+	}
+
+	/** set input 3 always connects to component */
+	virtual void setInput3(double _in3) { }
+
+	/** get OUT1 = reflected output pin on Port 1 */
+	virtual double getOutput1() { return out1; }
+
+	/** get OUT2 = incident (normal) output pin on Port 2 */
+	virtual double getOutput2() { return out2; }
+
+	/** get OUT3 always connects to component */
+	virtual double getOutput3() { return out3; }
+
+private:
+	double N1 = 0.0;	///< node 1 value, internal use only
+	double N2 = 0.0;	///< node 2 value, internal use only
+	double A = 0.0;		///< A coefficient value
+};
+
+
+/**
+\class WdfParallelTerminatedAdaptor
+\ingroup WDF-Objects
+\brief
+The WdfParallelTerminatedAdaptor object implements the parallel  terminated (non-reflection-free) adaptor
+
+\author Will Pirkle http://www.willpirkle.com
+\remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
+\version Revision : 1.0
+\date Date : 2018 / 09 / 7
+*/
+class WdfParallelTerminatedAdaptor : public WdfAdaptorBase
+{
+public:
+	WdfParallelTerminatedAdaptor() {}
+	virtual ~WdfParallelTerminatedAdaptor() {}
+
+	/** get the resistance at port 2;  R2 = 1.0/(sum of admittances) */
+	virtual double getR2()
+	{
+		double componentConductance = 0.0;
+		if (getPort3_CompAdaptor())
+			componentConductance = getPort3_CompAdaptor()->getComponentConductance();
+
+		// --- 1 / (sum of admittances)
+		R2 = 1.0 / ((1.0 / R1) + componentConductance);
+		return R2;
+	}
+
+	/** initialize adaptor with input resistance */
+	virtual void initialize(double _R1)
+	{
+		// --- save R1
+		R1 = _R1;
+
+		double G1 = 1.0 / R1;
+		if (terminalResistance <= 0.0)
+			terminalResistance = 1e-15;
+
+		double G2 = 1.0 / terminalResistance;
+		double componentConductance = 0.0;
+		if (getPort3_CompAdaptor())
+			componentConductance = getPort3_CompAdaptor()->getComponentConductance();
+
+		A1 = 2.0*G1 / (G1 + componentConductance + G2);
+		A3 = openTerminalResistance ? 0.0 : 2.0*G2 / (G1 + componentConductance + G2);
+
+		// --- init downstream
+		if (getPort2_CompAdaptor())
+			getPort2_CompAdaptor()->initialize(getR2());
+
+		// --- not used in this implementation but saving for extended use
+		R3 = 1.0 / componentConductance;
+	}
+
+	/** push audio input sample into incident wave input*/
+	virtual void setInput1(double _in1)
+	{
+		// --- save
+		in1 = _in1;
+
+		N2 = 0.0;
+		if (getPort3_CompAdaptor())
+			N2 = getPort3_CompAdaptor()->getOutput();
+
+		// --- form N1
+		N1 = -A1*(-in1 + N2) + N2 - A3*N2;
+
+		// --- form output1
+		out1 = -in1 + N2 + N1;
+
+		// --- deliver upstream to input2
+		if (getPort1_CompAdaptor())
+			getPort1_CompAdaptor()->setInput2(out1);
+
+		// --- calc out2 y(n)
+		out2 = N2 + N1;
+
+		// --- set component state
+		if (getPort3_CompAdaptor())
+			getPort3_CompAdaptor()->setInput(N1);
+	}
+
+	/** push audio input sample into reflected wave input; this is a dead end for terminated adaptorsthis is a dead end for terminated adaptors  */
+	virtual void setInput2(double _in2){ in2 = _in2;}
+
+	/** set input 3 always connects to component */
+	virtual void setInput3(double _in3) { }
+
+	/** get OUT1 = reflected output pin on Port 1 */
+	virtual double getOutput1() { return out1; }
+
+	/** get OUT2 = incident (normal) output pin on Port 2 */
+	virtual double getOutput2() { return out2; }
+
+	/** get OUT3 always connects to component */
+	virtual double getOutput3() { return out3; }
+
+private:
+	double N1 = 0.0;	///< node 1 value, internal use only
+	double N2 = 0.0;	///< node 2 value, internal use only
+	double A1 = 0.0;	///< A1 coefficient value
+	double A3 = 0.0;	///< A3 coefficient value
+};
+
+// ------------------------------------------------------------------ //
+// --- WDF COMPILE-TIME ADAPTORS ------------------------------------ //
+// ------------------------------------------------------------------ //
+//
+// --- the adaptors below hold their port 3 component and their downstream (port 2)
+//     adaptor by value as template parameters, so a whole ladder is one object whose
+//     connections are resolved at compile time; the scattering calls are non-virtual
+//     and the compiler can flatten the ladder into straight-line code.
+//
+//     setInput1( ) pushes the incident wave downstream and returns the reflected wave
+//     from port 1, replacing the setInput2( ) calls back up the virtual chain; the
+//     arithmetic is identical to the IComponentAdaptor versions.
+//
+//     Any of the WDF components (WdfResistor, WdfCapacitor, WdfSeriesLC, ...) may be
+//     used as the Component type.
+//
+//     For ladders of single R, L and C components, the scattering coefficients are the
+//     only tuning-dependent state, so get/setCoefficients( ) can be used to store and
+//     recall a whole tuning in one pass (see WDFTunableButterLPF3T); the combo components
+//     (seriesLC, parallelRC, ...) also hold their own coefficients and need setComponentValue_xx( ).
+
+/**
+\class WdfSeriesAdaptorT
+\ingroup WDF-Objects
+\brief
+The WdfSeriesAdaptorT object implements the series reflection-free (non-terminated) adaptor
+with the component and downstream adaptor bound at compile time.
+
+\version Revision : 1.0
+*/
+template <class Component, class Downstream>
+class WdfSeriesAdaptorT
+{
+public:
+	WdfSeriesAdaptorT() {}
+	~WdfSeriesAdaptorT() {}
+
+	/** get the component at port 3 */
+	Component& getComponent() { return component; }
+
+	/** get the adaptor at port 2 */
+	Downstream& getDownstream() { return downstream; }
+
+	/** set the input (source) resistance for an input adaptor */
+	void setSourceResistance(double _sourceResistance) { sourceResistance = _sourceResistance; }
+
+	/** set the terminal (load) resistance of the terminating adaptor */
+	void setTerminalResistance(double _terminalResistance) { downstream.setTerminalResistance(_terminalResistance); }
+
+	/** set the terminal (load) resistance of the terminating adaptor as open circuit */
+	void setOpenTerminalResistance(bool _openTerminalResistance = true) { downstream.setOpenTerminalResistance(_openTerminalResistance); }
+
+	/** reset the component and all downstream adaptors */
+	void reset(double _sampleRate)
+	{
+		component.reset(_sampleRate);
+		downstream.reset(_sampleRate);
+	}
+
+	/** initialize the chain of adaptors from this adaptor with the source resistance */
+	void initializeAdaptorChain() { initialize(sourceResistance); }
+
+	/** get the resistance at port 2; R2 = R1 + component (series)*/
+	double getR2()
+	{
+		R2 = R1 + component.getComponentResistance();
+		return R2;
+	}
+
+	/** initialize adaptor with input resistance */
+	void initialize(double _R1)
+	{
+		R1 = _R1;
+		B = R1 / (R1 + component.getComponentResistance());
+		downstream.initialize(getR2());
+	}
+
+	/** push incident wave into port 1; returns the reflected wave at port 1 */
+	inline double setInput1(double in1)
+	{
+		double N2 = component.getOutput();
+		double in2 = downstream.setInput1(-(in1 + N2));
+
+		component.setInput(-(in1 - B*(in1 + N2 + in2) + in2));
+		return in1 - B*(N2 + in2);
+	}
+
+	/** get y(n) from the terminating adaptor */
+	double getOutput2() { return downstream.getOutput2(); }
+
+	/** number of scattering coefficients in this adaptor and all downstream adaptors */
+	enum { numCoefficients = 1 + Downstream::numCoefficients };
+
+	/** copy the scattering coefficients of the chain into coefficients[numCoefficients] */
+	void getCoefficients(double* coefficients)
+	{
+		coefficients[0] = B;
+		downstream.getCoefficients(coefficients + 1);
+	}
+
+	/** set the scattering coefficients of the chain directly; the component values are not changed */
+	void setCoefficients(const double* coefficients)
+	{
+		B = coefficients[0];
+		downstream.setCoefficients(coefficients + 1);
+	}
+
+protected:
+	Component component;	///< component at port 3
+	Downstream downstream;	///< adaptor at port 2
+	double R1 = 0.0;		///< input port resistance
+	double R2 = 0.0;		///< output port resistance
+	double B = 0.0;			///< B coefficient value
+	double sourceResistance = 600.0; ///< source impedance; OK for this to be set to 0.0 for Rs = 0
+};
+
+/**
+\class WdfParallelAdaptorT
+\ingroup WDF-Objects
+\brief
+The WdfParallelAdaptorT object implements the parallel reflection-free (non-terminated) adaptor
+with the component and downstream adaptor bound at compile time.
+
+\version Revision : 1.0
+*/
+template <class Component, class Downstream>
+class WdfParallelAdaptorT
+{
+public:
+	WdfParallelAdaptorT() {}
+	~WdfParallelAdaptorT() {}
+
+	/** get the component at port 3 */
+	Component& getComponent() { return component; }
+
+	/** get the adaptor at port 2 */
+	Downstream& getDownstream() { return downstream; }
+
+	/** set the input (source) resistance for an input adaptor */
+	void setSourceResistance(double _sourceResistance) { sourceResistance = _sourceResistance; }
+
+	/** set the terminal (load) resistance of the terminating adaptor */
+	void setTerminalResistance(double _terminalResistance) { downstream.setTerminalResistance(_terminalResistance); }
+
+	/** set the terminal (load) resistance of the terminating adaptor as open circuit */
+	void setOpenTerminalResistance(bool _openTerminalResistance = true) { downstream.setOpenTerminalResistance(_openTerminalResistance); }
+
+	/** reset the component and all downstream adaptors */
+	void reset(double _sampleRate)
+	{
+		component.reset(_sampleRate);
+		downstream.reset(_sampleRate);
+	}
+
+	/** initialize the chain of adaptors from this adaptor with the source resistance */
+	void initializeAdaptorChain() { initialize(sourceResistance); }
+
+	/** get the resistance at port 2;  R2 = 1.0/(sum of admittances) */
+	double getR2()
+	{
+		R2 = 1.0 / ((1.0 / R1) + component.getComponentConductance());
+		return R2;
+	}
+
+	/** initialize adaptor with input resistance */
+	void initialize(double _R1)
+	{
+		R1 = _R1;
+		double G1 = 1.0 / R1;
+		A = G1 / (G1 + component.getComponentConductance());
+		downstream.initialize(getR2());
+	}
+
+	/** push incident wave into port 1; returns the reflected wave at port 1 */
+	inline double setInput1(double in1)
+	{
+		double N2 = component.getOutput();
+		double in2 = downstream.setInput1(N2 - A*(-in1 + N2));
+
+		double N1 = in2 - A*(-in1 + N2);
+		component.setInput(N1);
+		return -in1 + N2 + N1;
+	}
+
+	/** get y(n) from the terminating adaptor */
+	double getOutput2() { return downstream.getOutput2(); }
+
+	/** number of scattering coefficients in this adaptor and all downstream adaptors */
+	enum { numCoefficients = 1 + Downstream::numCoefficients };
+
+	/** copy the scattering coefficients of the chain into coefficients[numCoefficients] */
+	void getCoefficients(double* coefficients)
+	{
+		coefficients[0] = A;
+		downstream.getCoefficients(coefficients + 1);
+	}
+
+	/** set the scattering coefficients of the chain directly; the component values are not changed */
+	void setCoefficients(const double* coefficients)
+	{
+		A = coefficients[0];
+		downstream.setCoefficients(coefficients + 1);
+	}
+
+protected:
+	Component component;	///< component at port 3
+	Downstream downstream;	///< adaptor at port 2
+	double R1 = 0.0;		///< input port resistance
+	double R2 = 0.0;		///< output port resistance
+	double A = 0.0;			///< A coefficient value
+	double sourceResistance = 600.0; ///< source impedance; OK for this to be set to 0.0 for Rs = 0
+};
+
+/**
+\class WdfSeriesTerminatedAdaptorT
+\ingroup WDF-Objects
+\brief
+The WdfSeriesTerminatedAdaptorT object implements the series terminated (non-reflection-free) adaptor
+with the component bound at compile time; it ends a compile-time ladder.
+
+\version Revision : 1.0
+*/
+template <class Component>
+class WdfSeriesTerminatedAdaptorT
+{
+public:
+	WdfSeriesTerminatedAdaptorT() {}
+	~WdfSeriesTerminatedAdaptorT() {}
+
+	/** get the component at port 3 */
+	Component& getComponent() { return component; }
+
+	/** set the input (source) resistance when this is the only adaptor */
+	void setSourceResistance(double _sourceResistance) { sourceResistance = _sourceResistance; }
+
+	/** set the termainal (load) resistance */
+	void setTerminalResistance(double _terminalResistance) { terminalResistance = _terminalResistance; }
+
+	/** set the termainal (load) resistance as open circuit */
+	void setOpenTerminalResistance(bool _openTerminalResistance = true)
+	{
+		// --- flag overrides value
+		openTerminalResistance = _openTerminalResistance;
+		terminalResistance = 1.0e+34; // avoid /0.0
+	}
+
+	/** reset the component */
+	void reset(double _sampleRate) { component.reset(_sampleRate); }
+
+	/** initialize with the source resistance when this is the only adaptor */
+	void initializeAdaptorChain() { initialize(sourceResistance); }
+
+	/** initialize adaptor with input resistance */
+	void initialize(double _R1)
+	{
+		R1 = _R1;
+		double componentResistance = component.getComponentResistance();
+		B1 = (2.0*R1) / (R1 + componentResistance + terminalResistance);
+		B3 = (2.0*terminalResistance) / (R1 + componentResistance + terminalResistance);
+	}
+
+	/** push incident wave into port 1; returns the reflected wave at port 1 */
+	inline double setInput1(double in1)
+	{
+		double N2 = component.getOutput();
+		double N3 = in1 + N2;
+
+		out2 = -B3*N3;
+		double out1 = in1 - B1*N3;
+
+		component.setInput(-(out1 + out2 + N3));
+		return out1;
+	}
+
+	/** get OUT2 = y(n) */
+	double getOutput2() { return out2; }
+
+	/** number of scattering coefficients */
+	enum { numCoefficients = 2 };
+
+	/** copy the scattering coefficients into coefficients[numCoefficients] */
+	void getCoefficients(double* coefficients)
+	{
+		coefficients[0] = B1;
+		coefficients[1] = B3;
+	}
+
+	/** set the scattering coefficients directly; the component value is not changed */
+	void setCoefficients(const double* coefficients)
+	{
+		B1 = coefficients[0];
+		B3 = coefficients[1];
+	}
+
+protected:
+	Component component;	///< component at port 3
+	double R1 = 0.0;		///< input port resistance
+	double B1 = 0.0;		///< B1 coefficient value
+	double B3 = 0.0;		///< B3 coefficient value
+	double out2 = 0.0;		///< port 2 output y(n)
+	double terminalResistance = 600.0;	///< value of terminal (load) resistance
+	bool openTerminalResistance = false;///< flag for open circuit load
+	double sourceResistance = 600.0;	///< source impedance
+};
+
+/**
+\class WdfParallelTerminatedAdaptorT
+\ingroup WDF-Objects
+\brief
+The WdfParallelTerminatedAdaptorT object implements the parallel terminated (non-reflection-free) adaptor
+with the component bound at compile time; it ends a compile-time ladder.
+
+\version Revision : 1.0
+*/
+template <class Component>
+class WdfParallelTerminatedAdaptorT
+{
+public:
+	WdfParallelTerminatedAdaptorT() {}
+	~WdfParallelTerminatedAdaptorT() {}
+
+	/** get the component at port 3 */
+	Component& getComponent() { return component; }
+
+	/** set the input (source) resistance when this is the only adaptor */
+	void setSourceResistance(double _sourceResistance) { sourceResistance = _sourceResistance; }
+
+	/** set the termainal (load) resistance */
+	void setTerminalResistance(double _terminalResistance) { terminalResistance = _terminalResistance; }
+
+	/** set the termainal (load) resistance as open circuit */
+	void setOpenTerminalResistance(bool _openTerminalResistance = true)
+	{
+		// --- flag overrides value
+		openTerminalResistance = _openTerminalResistance;
+		terminalResistance = 1.0e+34; // avoid /0.0
+	}
+
+	/** reset the component */
+	void reset(double _sampleRate) { component.reset(_sampleRate); }
+
+	/** initialize with the source resistance when this is the only adaptor */
+	void initializeAdaptorChain() { initialize(sourceResistance); }
+
+	/** initialize adaptor with input resistance */
+	void initialize(double _R1)
+	{
+		R1 = _R1;
+		double G1 = 1.0 / R1;
+		if (terminalResistance <= 0.0)
+			terminalResistance = 1e-15;
+
+		double G2 = 1.0 / terminalResistance;
+		double componentConductance = component.getComponentConductance();
+
+		A1 = 2.0*G1 / (G1 + componentConductance + G2);
+		A3 = openTerminalResistance ? 0.0 : 2.0*G2 / (G1 + componentConductance + G2);
+	}
+
+	/** push incident wave into port 1; returns the reflected wave at port 1 */
+	inline double setInput1(double in1)
+	{
+		double N2 = component.getOutput();
+		double N1 = -A1*(-in1 + N2) + N2 - A3*N2;
+
+		out2 = N2 + N1;
+		component.setInput(N1);
+		return -in1 + N2 + N1;
+	}
+
+	/** get OUT2 = y(n) */
+	double getOutput2() { return out2; }
+
+	/** number of scattering coefficients */
+	enum { numCoefficients = 2 };
+
+	/** copy the scattering coefficients into coefficients[numCoefficients] */
+	void getCoefficients(double* coefficients)
+	{
+		coefficients[0] = A1;
+		coefficients[1] = A3;
+	}
+
+	/** set the scattering coefficients directly; the component value is not changed */
+	void setCoefficients(const double* coefficients)
+	{
+		A1 = coefficients[0];
+		A3 = coefficients[1];
+	}
+
+protected:
+	Component component;	///< component at port 3
+	double R1 = 0.0;		///< input port resistance
+	double A1 = 0.0;		///< A1 coefficient value
+	double A3 = 0.0;		///< A3 coefficient value
+	double out2 = 0.0;		///< port 2 output y(n)
+	double terminalResistance = 600.0;	///< value of terminal (load) resistance
+	bool openTerminalResistance = false;///< flag for open circuit load
+	double sourceResistance = 600.0;	///< source impedance
+};
+
+/**
+\class WdfLadderFilter
+\ingroup WDF-Objects
+\brief
+The WdfLadderFilter object wraps a compile-time ladder (built from the WdfSeriesAdaptorT,
+WdfParallelAdaptorT and terminated adaptor templates) as an IAudioSignalProcessor.
+
+Audio I/O:
+- Processes mono input to mono output.
+
+Control I/F:
+- getLadder( ) to access the ladder adaptors and components
+
+\version Revision : 1.0
+*/
+template <class Ladder>
+class WdfLadderFilter : public IAudioSignalProcessor
+{
+public:
+	WdfLadderFilter(void) {}	/* C-TOR */
+	~WdfLadderFilter(void) {}	/* D-TOR */
+
+	/** reset members to initialized state */
+	virtual bool reset(double _sampleRate)
+	{
+		sampleRate = _sampleRate;
+
+		// --- rest WDF components (flush state registers)
+		ladder.reset(_sampleRate);
+
+		// --- intialize the chain of adapters
+		ladder.initializeAdaptorChain();
+		return true;
+	}
+
+	/** return false: this object only processes samples */
+	virtual bool canProcessAudioFrame() { return false; }
+
+	/** process input x(n) through the WDF ladder filter to produce return value y(n) */
+	/**
+	\param xn input
+	\return the processed sample
+	*/
+	virtual double processAudioSample(double xn)
+	{
+		ladder.setInput1(xn);
+		return outputScaling*ladder.getOutput2();
+	}
+
+	/** process a block; the whole ladder is inlined into the loop */
+	/**
+	\param input input buffer
+	\param output output buffer, may be the same as input
+	\param blockSize number of samples
+	*/
+	void processAudioBlock(const double* input, double* output, uint32_t blockSize)
+	{
+		for (uint32_t i = 0; i < blockSize; i++)
+		{
+			ladder.setInput1(input[i]);
+			output[i] = outputScaling*ladder.getOutput2();
+		}
+	}
+
+	/** get the ladder for component access */
+	Ladder& getLadder() { return ladder; }
+
+protected:
+	Ladder ladder;				///< the compile-time WDF ladder
+	double outputScaling = 1.0;	///< output scaling (e.g. 0.5 to compensate ideal Rs/Rload)
+	double sampleRate = 1.0;	///< stored sample rate
+};
+
+// ------------------------------------------------------------------------------ //
+// --- WDF Ladder Filter Design  Examples --------------------------------------- //
+// ------------------------------------------------------------------------------ //
+//
+// --- 3rd order Butterworth LPF designed with Elsie www.TonneSoftware.comm
+//
+/*
+	3rd Order Inductor-Leading LPF
+
+	Rs = Rload = 600 ohms
+
+	Series(L1) -> Parallel(C1) -> Series(L2)
+
+	--L1-- | --L2--
+		   C1
+		   |
+
+	fc = 1kHz
+		L1 = 95.49e-3;
+		C1 = 0.5305e-6;
+		L2 = 95.49e-3;
+
+	fc = 10kHz
+		L1 = 9.549e-3;
+		C1 = 0.05305e-6;
+		L2 = 9.549e-3;
+*/
+
+/**
+\class WDFButterLPF3
+\ingroup WDF-Objects
+\brief
+The WDFButterLPF3 object implements a 3rd order Butterworth ladder filter.
+NOTE: designed with Elsie www.TonneSoftware.comm
+
+Audio I/O:
+- Processes mono input to mono output.
+
+Control I/F:
+- none - this object is hard-wired.
+
+\author Will Pirkle http://www.willpirkle.com
+\remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
+\version Revision : 1.0
+\date Date : 2018 / 09 / 7
+*/
+class WDFButterLPF3 : public IAudioSignalProcessor
+{
+public:
+	WDFButterLPF3(void) { createWDF(); }	/* C-TOR */
+	~WDFButterLPF3(void) {}	/* D-TOR */
+
+	/** reset members to initialized state */
+	virtual bool reset(double _sampleRate)
+	{
+		// --- rest WDF components (flush state registers)
+		seriesAdaptor_L1.reset(_sampleRate);
+		parallelAdaptor_C1.reset(_sampleRate);
+		seriesTerminatedAdaptor_L2.reset(_sampleRate);
+
+		// --- intialize the chain of adapters
+		seriesAdaptor_L1.initializeAdaptorChain();
+		return true;
+	}
+
+	/** return false: this object only processes samples */
+	virtual bool canProcessAudioFrame() { return false; }
+
+	/** process input x(n) through the WDF ladder filter to produce return value y(n) */
+	/**
+	\param xn input
+	\return the processed sample
+	*/
+	virtual double processAudioSample(double xn)
+	{
+		// --- push audio sample into series L1
+		seriesAdaptor_L1.setInput1(xn);
+
+		// --- output is at terminated L2's output2
+		return seriesTerminatedAdaptor_L2.getOutput2();
+	}
+
+	/** create the WDF structure for this object - may be called more than once */
+	void createWDF()
+	{
+		// --- actual component values fc = 1kHz
+		double L1_value = 95.49e-3;		// 95.5 mH
+		double C1_value = 0.5305e-6;	// 0.53 uF
+		double L2_value = 95.49e-3;		// 95.5 mH
+
+										// --- set adapter components
+		seriesAdaptor_L1.setComponent(wdfComponent::L, L1_value);
+		parallelAdaptor_C1.setComponent(wdfComponent::C, C1_value);
+		seriesTerminatedAdaptor_L2.setComponent(wdfComponent::L, L2_value);
+
+		// --- connect adapters
+		WdfAdaptorBase::connectAdaptors(&seriesAdaptor_L1, &parallelAdaptor_C1);
+		WdfAdaptorBase::connectAdaptors(&parallelAdaptor_C1, &seriesTerminatedAdaptor_L2);
+
+		// --- set source resistance
+		seriesAdaptor_L1.setSourceResistance(600.0); // --- Rs = 600
+
+		// --- set terminal resistance
+		seriesTerminatedAdaptor_L2.setTerminalResistance(600.0); // --- Rload = 600
+	}
+
+protected:
+	// --- three adapters
+	WdfSeriesAdaptor seriesAdaptor_L1;			///< adaptor for L1
+	WdfParallelAdaptor parallelAdaptor_C1;		///< adaptor for C1
+	WdfSeriesTerminatedAdaptor seriesTerminatedAdaptor_L2;	///< adaptor for L2
+};
+
+/**
+\class WDFTunableButterLPF3
+\ingroup WDF-Objects
+\brief
+The WDFTunableButterLPF3 object implements a tunable 3rd order Butterworth ladder filter.
+NOTE: designed with Elsie www.TonneSoftware.comm
+
+Audio I/O:
+- Processes mono input to mono output.
+
+Control I/F:
+- setUsePostWarping(bool b) to enable/disable warping (see book)
+- setFilterFc(double fc_Hz) to set the tunable fc value
+
+\author Will Pirkle http://www.willpirkle.com
+\remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
+\version Revision : 1.0
+\date Date : 2018 / 09 / 7
+*/
+class WDFTunableButterLPF3 : public IAudioSignalProcessor
+{
+public:
+	WDFTunableButterLPF3(void) { createWDF(); }	/* C-TOR */
+	~WDFTunableButterLPF3(void) {}	/* D-TOR */
+
+	/** reset members to initialized state */
+	virtual bool reset(double _sampleRate)
+	{
+		sampleRate = _sampleRate;
+		// --- rest WDF components (flush state registers)
+		seriesAdaptor_L1.reset(_sampleRate);
+		parallelAdaptor_C1.reset(_sampleRate);
+		seriesTerminatedAdaptor_L2.reset(_sampleRate);
+
+		// --- intialize the chain of adapters
+		seriesAdaptor_L1.initializeAdaptorChain();
+		return true;
+	}
+
+	/** return false: this object only processes samples */
+	virtual bool canProcessAudioFrame() { return false; }
+
+	/** process input x(n) through the WDF ladder filter to produce return value y(n) */
+	/**
+	\param xn input
+	\return the processed sample
+	*/
+	virtual double processAudioSample(double xn)
+	{
+		// --- push audio sample into series L1
+		seriesAdaptor_L1.setInput1(xn);
+
+		// --- output is at terminated L2's output2
+		return seriesTerminatedAdaptor_L2.getOutput2();
+	}
+
+	/** create the filter structure; may be called more than once */
+	void createWDF()
+	{
+		// --- create components, init to noramlized values fc = 1Hz
+		seriesAdaptor_L1.setComponent(wdfComponent::L, L1_norm);
+		parallelAdaptor_C1.setComponent(wdfComponent::C, C1_norm);
+		seriesTerminatedAdaptor_L2.setComponent(wdfComponent::L, L2_norm);
+
+		// --- connect adapters
+		WdfAdaptorBase::connectAdaptors(&seriesAdaptor_L1, &parallelAdaptor_C1);
+		WdfAdaptorBase::connectAdaptors(&parallelAdaptor_C1, &seriesTerminatedAdaptor_L2);
+
+		// --- set source resistance
+		seriesAdaptor_L1.setSourceResistance(600.0); // --- Rs = 600
+
+		// --- set terminal resistance
+		seriesTerminatedAdaptor_L2.setTerminalResistance(600.0); // --- Rload = 600
+	}
+
+	/** parameter setter for warping */
+	void setUsePostWarping(bool b) { useFrequencyWarping = b; }
+
+	/** parameter setter for fc; all component values are set first, then the port resistances
+	    and coefficients are updated down the chain in one pass */
+	void setFilterFc(double fc_Hz)
+	{
+		if (useFrequencyWarping)
+		{
+			double arg = (kPi*fc_Hz) / sampleRate;
+			fc_Hz = fc_Hz*(tan(arg) / arg);
+		}
+
+		double scale = 1.0 / fc_Hz;
+		seriesAdaptor_L1.setComponentValue(L1_norm*scale);
+		parallelAdaptor_C1.setComponentValue(C1_norm*scale);
+		seriesTerminatedAdaptor_L2.setComponentValue(L2_norm*scale);
+
+		// --- update the adaptor chain with the new component resistances
+		seriesAdaptor_L1.initializeAdaptorChain();
+	}
+
+protected:
+	// --- three adapters
+	WdfSeriesAdaptor seriesAdaptor_L1;		///< adaptor for L1
+	WdfParallelAdaptor parallelAdaptor_C1;	///< adaptor for C1
+	WdfSeriesTerminatedAdaptor seriesTerminatedAdaptor_L2;	///< adaptor for L2
+
+	double L1_norm = 95.493;		// 95.5 mH
+	double C1_norm = 530.516e-6;	// 0.53 uF
+	double L2_norm = 95.493;		// 95.5 mH
+
+	bool useFrequencyWarping = false;	///< flag for freq warping
+	double sampleRate = 1.0;			///< stored sample rate
+};
+
+/**
+\class WDFBesselBSF3
+\ingroup WDF-Objects
+\brief
+The WDFBesselBSF3 object implements a 3rd order Bessel BSF
+NOTE: designed with Elsie www.TonneSoftware.comm
+
+Audio I/O:
+- Processes mono input to mono output.
+
+Control I/F:
+- none - object is hardwired
+
+\author Will Pirkle http://www.willpirkle.com
+\remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
+\version Revision : 1.0
+\date Date : 2018 / 09 / 7
+*/
+class WDFBesselBSF3 : public IAudioSignalProcessor
+{
+public:
+	WDFBesselBSF3(void) { createWDF(); }	/* C-TOR */
+	~WDFBesselBSF3(void) {}	/* D-TOR */
+
+	/** reset members to initialized state */
+	virtual bool reset(double _sampleRate)
+	{
+		// --- rest WDF components (flush state registers)
+		seriesAdaptor_L1C1.reset(_sampleRate);
+		parallelAdaptor_L2C2.reset(_sampleRate);
+		seriesTerminatedAdaptor_L3C3.reset(_sampleRate);
+
+		// --- intialize the chain of adapters
+		seriesAdaptor_L1C1.initializeAdaptorChain();
+
+		return true;
+	}
+
+	/** return false: this object only processes samples */
+	virtual bool canProcessAudioFrame() { return false; }
+
+	/** process input x(n) through the WDF ladder filter to produce return value y(n) */
+	/**
+	\param xn input
+	\return the processed sample
+	*/
+	virtual double processAudioSample(double xn)
+	{
+		// --- push audio sample into series L1
+		seriesAdaptor_L1C1.setInput1(xn);
+
+		// --- output is at terminated L2's output2
+		return seriesTerminatedAdaptor_L3C3.getOutput2();
+	}
+
+	/** create the WDF structure; may be called more than once*/
+	void createWDF()
+	{
+		// --- set component values
+		// --- fo = 5kHz
+		//     BW = 2kHz or Q = 2.5
+		seriesAdaptor_L1C1.setComponent(wdfComponent::parallelLC, 16.8327e-3, 0.060193e-6);	/* L, C */
+		parallelAdaptor_L2C2.setComponent(wdfComponent::seriesLC, 49.1978e-3, 0.02059e-6);	/* L, C */
+		seriesTerminatedAdaptor_L3C3.setComponent(wdfComponent::parallelLC, 2.57755e-3, 0.393092e-6);	/* L, C */
+
+		// --- connect adapters
+		WdfAdaptorBase::connectAdaptors(&seriesAdaptor_L1C1, &parallelAdaptor_L2C2);
+		WdfAdaptorBase::connectAdaptors(&parallelAdaptor_L2C2, &seriesTerminatedAdaptor_L3C3);
+
+		// --- set source resistance
+		seriesAdaptor_L1C1.setSourceResistance(600.0); // Ro = 600
 
-	// --- terminal impedance
-	double terminalResistance = 600.0; ///< value of terminal (load) resistance
-	bool openTerminalResistance = false; ///< flag for open circuit load
+		// --- set terminal resistance
+		seriesTerminatedAdaptor_L3C3.setTerminalResistance(600.0);
+	}
 
-	// --- source impedance, OK for this to be set to 0.0 for Rs = 0
-	double sourceResistance = 600.0; ///< source impedance; OK for this to be set to 0.0 for Rs = 0
+protected:
+	// --- three adapters
+	WdfSeriesAdaptor seriesAdaptor_L1C1;		///< adaptor for L1 and C1
+	WdfParallelAdaptor parallelAdaptor_L2C2;	///< adaptor for L2 and C2
+	WdfSeriesTerminatedAdaptor seriesTerminatedAdaptor_L3C3;	///< adaptor for L3 and C3
 };
 
+
 /**
-\class WdfSeriesAdaptor
+\class WDFConstKBPF6
 \ingroup WDF-Objects
 \brief
-The WdfSeriesAdaptor object implements the series reflection-free (non-terminated) adaptor
+The WDFConstKBPF6 object implements a 6th order constant K BPF
+NOTE: designed with Elsie www.TonneSoftware.comm
+
+Audio I/O:
+- Processes mono input to mono output.
+
+Control I/F:
+- none - object is hardwired
 
 \author Will Pirkle http://www.willpirkle.com
 \remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
 \version Revision : 1.0
 \date Date : 2018 / 09 / 7
 */
-class WdfSeriesAdaptor : public WdfAdaptorBase
+class WDFConstKBPF6 : public IAudioSignalProcessor
 {
 public:
-	WdfSeriesAdaptor() {}
-	virtual ~WdfSeriesAdaptor() {}
-
-	/** get the resistance at port 2; R2 = R1 + component (series)*/
-	virtual double getR2()
-	{
-		double componentResistance = 0.0;
-		if (getPort3_CompAdaptor())
-			componentResistance = getPort3_CompAdaptor()->getComponentResistance();
-
-		R2 = R1 + componentResistance;
-		return R2;
-	}
+	WDFConstKBPF6(void) { createWDF(); }	/* C-TOR */
+	~WDFConstKBPF6(void) {}	/* D-TOR */
 
-	/** initialize adaptor with input resistance */
-	virtual void initialize(double _R1)
+	/** reset members to initialized state */
+	virtual bool reset(double _sampleRate)
 	{
-		// --- R1 is source resistance for this adaptor
-		R1 = _R1;
-
-		double componentResistance = 0.0;
-		if (getPort3_CompAdaptor())
-			componentResistance = getPort3_CompAdaptor()->getComponentResistance();
+		// --- rest WDF components (flush state registers)
+		seriesAdaptor_L1C1.reset(_sampleRate);
+		parallelAdaptor_L2C2.reset(_sampleRate);
 
-		// --- calculate B coeff
-		B = R1 / (R1 + componentResistance);
+		seriesAdaptor_L3C3.reset(_sampleRate);
+		parallelAdaptor_L4C4.reset(_sampleRate);
 
-		// --- init downstream adaptor
-		if (getPort2_CompAdaptor())
-			getPort2_CompAdaptor()->initialize(getR2());
+		seriesAdaptor_L5C5.reset(_sampleRate);
+		parallelTerminatedAdaptor_L6C6.reset(_sampleRate);
 
-		// --- not used in this implementation but saving for extended use
-		R3 = componentResistance;
+		// --- intialize the chain of adapters
+		seriesAdaptor_L1C1.initializeAdaptorChain();
+		return true;
 	}
 
-	/** push audio input sample into incident wave input*/
-	virtual void setInput1(double _in1)
-	{
-		// --- save
-		in1 = _in1;
+	/** return false: this object only processes samples */
+	virtual bool canProcessAudioFrame() { return false; }
 
-		// --- read component value
-		N2 = 0.0;
-		if (getPort3_CompAdaptor())
-			N2 = getPort3_CompAdaptor()->getOutput();
+	/** process input x(n) through the WDF ladder filter to produce return value y(n) */
+	/**
+	\param xn input
+	\return the processed sample
+	*/
+	virtual double processAudioSample(double xn)
+	{
+		// --- push audio sample into series L1
+		seriesAdaptor_L1C1.setInput1(xn);
 
-		// --- form output
-		out2 = -(in1 + N2);
+		// --- output is at terminated L6C6 output2
+		double output = parallelTerminatedAdaptor_L6C6.getOutput2();
 
-		// --- deliver downstream
-		if (getPort2_CompAdaptor())
-			getPort2_CompAdaptor()->setInput1(out2);
+		return output;
 	}
 
-	/** push audio input sample into reflected wave input */
-	virtual void setInput2(double _in2)
+	/** create the WDF structure */
+	void createWDF()
 	{
-		// --- save
-		in2 = _in2;
-
-		// --- calc N1
-		N1 = -(in1 - B*(in1 + N2 + in2) + in2);
+		// --- fo = 5kHz
+		//     BW = 2kHz or Q = 2.5
+		seriesAdaptor_L1C1.setComponent(wdfComponent::seriesLC, 47.7465e-3, 0.02122e-6);
+		parallelAdaptor_L2C2.setComponent(wdfComponent::parallelLC, 3.81972e-3, 0.265258e-6);
 
-		// --- calc out1
-		out1 = in1 - B*(N2 + in2);
+		seriesAdaptor_L3C3.setComponent(wdfComponent::seriesLC, 95.493e-3, 0.01061e-6);
+		parallelAdaptor_L4C4.setComponent(wdfComponent::parallelLC, 3.81972e-3, 0.265258e-6);
 
-		// --- deliver upstream
-		if (getPort1_CompAdaptor())
-			getPort1_CompAdaptor()->setInput2(out1);
+		seriesAdaptor_L5C5.setComponent(wdfComponent::seriesLC, 95.493e-3, 0.01061e-6);
+		parallelTerminatedAdaptor_L6C6.setComponent(wdfComponent::parallelLC, 7.63944e-3, 0.132629e-6);
 
-		// --- set component state
-		if (getPort3_CompAdaptor())
-			getPort3_CompAdaptor()->setInput(N1);
-	}
+		// --- connect adapters
+		WdfAdaptorBase::connectAdaptors(&seriesAdaptor_L1C1, &parallelAdaptor_L2C2);
+		WdfAdaptorBase::connectAdaptors(&parallelAdaptor_L2C2, &seriesAdaptor_L3C3);
+		WdfAdaptorBase::connectAdaptors(&seriesAdaptor_L3C3, &parallelAdaptor_L4C4);
+		WdfAdaptorBase::connectAdaptors(&parallelAdaptor_L4C4, &seriesAdaptor_L5C5);
+		WdfAdaptorBase::connectAdaptors(&seriesAdaptor_L5C5, &parallelTerminatedAdaptor_L6C6);
 
-	/** set input 3 always connects to component */
-	virtual void setInput3(double _in3){ }
+		// --- set source resistance
+		seriesAdaptor_L1C1.setSourceResistance(600.0); // Ro = 600
 
-	/** get OUT1 = reflected output pin on Port 1 */
-	virtual double getOutput1() { return out1; }
+		// --- set terminal resistance
+		parallelTerminatedAdaptor_L6C6.setTerminalResistance(600.0);
+	}
 
-	/** get OUT2 = incident (normal) output pin on Port 2 */
-	virtual double getOutput2() { return out2; }
+protected:
+	// --- six adapters
+	WdfSeriesAdaptor seriesAdaptor_L1C1;		///< adaptor for L1 and C1
+	WdfParallelAdaptor parallelAdaptor_L2C2;	///< adaptor for L2 and C2
 
-	/** get OUT3 always connects to component */
-	virtual double getOutput3() { return out3; }
+	WdfSeriesAdaptor seriesAdaptor_L3C3;		///< adaptor for L3 and C3
+	WdfParallelAdaptor parallelAdaptor_L4C4;	///< adaptor for L4 and C4
 
-private:
-	double N1 = 0.0;	///< node 1 value, internal use only
-	double N2 = 0.0;	///< node 2 value, internal use only
-	double B = 0.0;		///< B coefficient value
+	WdfSeriesAdaptor seriesAdaptor_L5C5;		///< adaptor for L5 and C5
+	WdfParallelTerminatedAdaptor parallelTerminatedAdaptor_L6C6;///< adaptor for L6 and C6
 };
 
+
 /**
-\class WdfSeriesTerminatedAdaptor
+\struct WDFParameters
 \ingroup WDF-Objects
 \brief
-The WdfSeriesTerminatedAdaptor object implements the series terminated (non-reflection-free) adaptor
+Custom parameter structure for the WDF filter examples.
 
 \author Will Pirkle http://www.willpirkle.com
 \remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
 \version Revision : 1.0
 \date Date : 2018 / 09 / 7
 */
-// --- Series terminated adaptor
-class WdfSeriesTerminatedAdaptor : public WdfAdaptorBase
+struct WDFParameters
 {
-public:
-	WdfSeriesTerminatedAdaptor() {}
-	virtual ~WdfSeriesTerminatedAdaptor() {}
-
-	/** get the resistance at port 2; R2 = R1 + component (series)*/
-	virtual double getR2()
-	{
-		double componentResistance = 0.0;
-		if (getPort3_CompAdaptor())
-			componentResistance = getPort3_CompAdaptor()->getComponentResistance();
-
-		R2 = R1 + componentResistance;
-		return R2;
-	}
-
-	/** initialize adaptor with input resistance */
-	virtual void initialize(double _R1)
-	{
-		// --- source impedance
-		R1 = _R1;
-
-		double componentResistance = 0.0;
-		if (getPort3_CompAdaptor())
-			componentResistance = getPort3_CompAdaptor()->getComponentResistance();
-
-		B1 = (2.0*R1) / (R1 + componentResistance + terminalResistance);
-		B3 = (2.0*terminalResistance) / (R1 + componentResistance + terminalResistance);
-
-		// --- init downstream
-		if (getPort2_CompAdaptor())
-			getPort2_CompAdaptor()->initialize(getR2());
-
-		// --- not used in this implementation but saving for extended use
-		R3 = componentResistance;
-	}
-
-	/** push audio input sample into incident wave input*/
-	virtual void setInput1(double _in1)
+	WDFParameters() {}
+	/** all FXObjects parameter objects require overloaded= operator so remember to add new entries if you add new variables. */
+	WDFParameters& operator=(const WDFParameters& params)
 	{
-		// --- save
-		in1 = _in1;
-
-		N2 = 0.0;
-		if (getPort3_CompAdaptor())
-			N2 = getPort3_CompAdaptor()->getOutput();
-
-		double N3 = in1 + N2;
-
-		// --- calc out2 y(n)
-		out2 = -B3*N3;
-
-		// --- form output1
-		out1 = in1 - B1*N3;
-
-		// --- form N1
-		N1 = -(out1 + out2 + N3);
-
-		// --- deliver upstream to input2
-		if (getPort1_CompAdaptor())
-			getPort1_CompAdaptor()->setInput2(out1);
+		if (this == &params)
+			return *this;
 
-		// --- set component state
-		if (getPort3_CompAdaptor())
-			getPort3_CompAdaptor()->setInput(N1);
+		fc = params.fc;
+		Q = params.Q;
+		boostCut_dB = params.boostCut_dB;
+		frequencyWarping = params.frequencyWarping;
+		return *this;
 	}
 
-	/** push audio input sample into reflected wave input
-	    for terminated adaptor, this is dead end, just store it */
-	virtual void setInput2(double _in2) { in2 = _in2;}
-
-	/** set input 3 always connects to component */
-	virtual void setInput3(double _in3) { in3 = _in3;}
+	// --- individual parameters
+	double fc = 100.0;				///< filter fc
+	double Q = 0.707;				///< filter Q
+	double boostCut_dB = 0.0;		///< filter boost or cut in dB
+	bool frequencyWarping = true;	///< enable frequency warping
+};
 
-	/** get OUT1 = reflected output pin on Port 1 */
-	virtual double getOutput1() { return out1; }
+/**
+@calculateIdealRLCValues
+\ingroup FX-Functions
 
-	/** get OUT2 = incident (normal) output pin on Port 2 */
-	virtual double getOutput2() { return out2; }
+@brief calculates the L and R values for the ideal RLC filters with C held constant at 1uF
 
-	/** get OUT3 always connects to component */
-	virtual double getOutput3() { return out3; }
+\param params - WDF parameters (fc, Q, warping)
+\param sampleRate - sample rate for warping
+\param inductorValue - returns the inductor value
+\param resistorValue - returns the resistor value
+*/
+inline void calculateIdealRLCValues(const WDFParameters& params, double sampleRate, double& inductorValue, double& resistorValue)
+{
+	double fc_Hz = params.fc;
 
-private:
-	double N1 = 0.0;	///< node 1 value, internal use only
-	double N2 = 0.0;	///< node 2 value, internal use only
-	double B1 = 0.0;	///< B1 coefficient value
-	double B3 = 0.0;	///< B3 coefficient value
-};
+	if (params.frequencyWarping)
+	{
+		double arg = (kPi*fc_Hz) / sampleRate;
+		fc_Hz = fc_Hz*(tan(arg) / arg);
+	}
 
+	double wc = 2.0*kPi*fc_Hz;
+	inductorValue = 1.0 / (1.0e-6 * wc*wc);
+	resistorValue = sqrt(inductorValue / 1.0e-6) / params.Q;
+}
 /**
-\class WdfParallelAdaptor
+\class WDFIdealRLCLPF
 \ingroup WDF-Objects
 \brief
-The WdfParallelAdaptor object implements the parallel reflection-free (non-terminated) adaptor
+The WDFIdealRLCLPF object implements an ideal RLC LPF using the WDF library.
+
+Audio I/O:
+- Processes mono input to mono output.
+
+Control I/F:
+- Use WDFParameters structure to get/set object params.
 
 \author Will Pirkle http://www.willpirkle.com
 \remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
 \version Revision : 1.0
 \date Date : 2018 / 09 / 7
 */
-class WdfParallelAdaptor : public WdfAdaptorBase
+class WDFIdealRLCLPF : public IAudioSignalProcessor
 {
 public:
-	WdfParallelAdaptor() {}
-	virtual ~WdfParallelAdaptor() {}
+	WDFIdealRLCLPF(void) { createWDF(); }	/* C-TOR */
+	~WDFIdealRLCLPF(void) {}	/* D-TOR */
 
-	/** get the resistance at port 2;  R2 = 1.0/(sum of admittances) */
-	virtual double getR2()
+	/** reset members to initialized state */
+	virtual bool reset(double _sampleRate)
 	{
-		double componentConductance = 0.0;
-		if (getPort3_CompAdaptor())
-			componentConductance = getPort3_CompAdaptor()->getComponentConductance();
-
-		// --- 1 / (sum of admittances)
-		R2 = 1.0 / ((1.0 / R1) + componentConductance);
-		return R2;
-	}
+		sampleRate = _sampleRate;
 
-	/** initialize adaptor with input resistance */
-	virtual void initialize(double _R1)
-	{
-		// --- save R1
-		R1 = _R1;
+		// --- rest WDF components (flush state registers)
+		seriesAdaptor_RL.reset(_sampleRate);
+		parallelTerminatedAdaptor_C.reset(_sampleRate);
 
-		double G1 = 1.0 / R1;
-		double componentConductance = 0.0;
-		if (getPort3_CompAdaptor())
-			componentConductance = getPort3_CompAdaptor()->getComponentConductance();
+		// --- intialize the chain of adapters
+		seriesAdaptor_RL.initializeAdaptorChain();
+		return true;
+	}
 
-		// --- calculate B coeff
-		A = G1 / (G1 + componentConductance);
+	/** return false: this object only processes samples */
+	virtual bool canProcessAudioFrame() { return false; }
 
-		// --- now, do we init our downstream??
-		if (getPort2_CompAdaptor())
-			getPort2_CompAdaptor()->initialize(getR2());
+	/** process input x(n) through the WDF Ideal RLC filter to produce return value y(n) */
+	/**
+	\param xn input
+	\return the processed sample
+	*/
+	virtual double processAudioSample(double xn)
+	{
+		// --- push audio sample into series L1
+		seriesAdaptor_RL.setInput1(xn);
 
-		// --- not used in this implementation but saving for extended use
-		R3 = 1.0/ componentConductance;
+		// --- output is at terminated L2's output2
+		//     note compensation scaling by -6dB = 0.5
+		//     because of WDF assumption about Rs and Rload
+		return 0.5*parallelTerminatedAdaptor_C.getOutput2();
 	}
 
-	/** push audio input sample into incident wave input*/
-	virtual void setInput1(double _in1)
+	/** create the WDF structure; may be called more than once */
+	void createWDF()
 	{
-		// --- save
-		in1 = _in1;
+		// --- create components, init to noramlized values fc =
+		//	   initial values for fc = 1kHz Q = 0.707
+		//     Holding C Constant at 1e-6
+		//			   L = 2.533e-2
+		//			   R = 2.251131 e2
+		seriesAdaptor_RL.setComponent(wdfComponent::seriesRL, 2.251131e2, 2.533e-2);
+		parallelTerminatedAdaptor_C.setComponent(wdfComponent::C, 1.0e-6);
 
-		// --- read component
-		N2 = 0.0;
-		if (getPort3_CompAdaptor())
-			N2 = getPort3_CompAdaptor()->getOutput();
+		// --- connect adapters
+		WdfAdaptorBase::connectAdaptors(&seriesAdaptor_RL, &parallelTerminatedAdaptor_C);
 
-		// --- form output
-		out2 = N2 - A*(-in1 + N2);
+		// --- set source resistance
+		seriesAdaptor_RL.setSourceResistance(0.0); // --- Rs = 600
 
-		// --- deliver downstream
-		if (getPort2_CompAdaptor())
-			getPort2_CompAdaptor()->setInput1(out2);
+		// --- set open ckt termination
+		parallelTerminatedAdaptor_C.setOpenTerminalResistance(true);
 	}
 
-	/** push audio input sample into reflected wave input*/
-	virtual void setInput2(double _in2)
-	{
-		// --- save
-		in2 = _in2;
-
-		// --- calc N1
-		N1 = in2 - A*(-in1 + N2);
+	/** get parameters: note use of custom structure for passing param data */
+	/**
+	\return WDFParameters custom data structure
+	*/
+	WDFParameters getParameters() { return wdfParameters; }
 
-		// --- calc out1
-		out1 = -in1 + N2 + N1;
+	/** set parameters: note use of custom structure for passing param data */
+	/**
+	\param WDFParameters custom data structure
+	*/
+	void setParameters(const WDFParameters& _wdfParameters)
+	{
+		if (_wdfParameters.fc != wdfParameters.fc ||
+			_wdfParameters.Q != wdfParameters.Q ||
+			_wdfParameters.boostCut_dB != wdfParameters.boostCut_dB ||
+			_wdfParameters.frequencyWarping != wdfParameters.frequencyWarping)
+		{
+			wdfParameters = _wdfParameters;
 
-		// --- deliver upstream
-		if (getPort1_CompAdaptor())
-			getPort1_CompAdaptor()->setInput2(out1);
+			// --- calculate all component values, then update the chain in one pass
+			double inductorValue = 0.0;
+			double resistorValue = 0.0;
+			calculateIdealRLCValues(wdfParameters, sampleRate, inductorValue, resistorValue);
 
-		// --- set component state
-		if (getPort3_CompAdaptor())
-			getPort3_CompAdaptor()->setInput(N1);
+			seriesAdaptor_RL.setComponentValue_RL(resistorValue, inductorValue);
+			seriesAdaptor_RL.initializeAdaptorChain();
+		}
 	}
 
-	/** set input 3 always connects to component */
-	virtual void setInput3(double _in3) { }
-
-	/** get OUT1 = reflected output pin on Port 1 */
-	virtual double getOutput1() { return out1; }
+protected:
+	WDFParameters wdfParameters;	///< object parameters
 
-	/** get OUT2 = incident (normal) output pin on Port 2 */
-	virtual double getOutput2() { return out2; }
+	// --- adapters
+	WdfSeriesAdaptor				seriesAdaptor_RL;				///< adaptor for series RL
+	WdfParallelTerminatedAdaptor	parallelTerminatedAdaptor_C;	///< adaptopr for parallel C
 
-	/** get OUT3 always connects to component */
-	virtual double getOutput3() { return out3; }
+	double sampleRate = 1.0;
 
-private:
-	double N1 = 0.0;	///< node 1 value, internal use only
-	double N2 = 0.0;	///< node 2 value, internal use only
-	double A = 0.0;		///< A coefficient value
 };
 
-
 /**
-\class WdfParallelTerminatedAdaptor
+\class WDFIdealRLCHPF
 \ingroup WDF-Objects
 \brief
-The WdfParallelTerminatedAdaptor object implements the parallel  terminated (non-reflection-free) adaptor
+The WDFIdealRLCHPF object implements an ideal RLC HPF using the WDF library.
+
+Audio I/O:
+- Processes mono input to mono output.
+
+Control I/F:
+- Use WDFParameters structure to get/set object params.
 
 \author Will Pirkle http://www.willpirkle.com
 \remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
 \version Revision : 1.0
 \date Date : 2018 / 09 / 7
 */
-class WdfParallelTerminatedAdaptor : public WdfAdaptorBase
+class WDFIdealRLCHPF : public IAudioSignalProcessor
 {
 public:
-	WdfParallelTerminatedAdaptor() {}
-	virtual ~WdfParallelTerminatedAdaptor() {}
+	WDFIdealRLCHPF(void) { createWDF(); }	/* C-TOR */
+	~WDFIdealRLCHPF(void) {}	/* D-TOR */
 
-	/** get the resistance at port 2;  R2 = 1.0/(sum of admittances) */
-	virtual double getR2()
+	/** reset members to initialized state */
+	virtual bool reset(double _sampleRate)
 	{
-		double componentConductance = 0.0;
-		if (getPort3_CompAdaptor())
-			componentConductance = getPort3_CompAdaptor()->getComponentConductance();
+		sampleRate = _sampleRate;
+		// --- rest WDF components (flush state registers)
+		seriesAdaptor_RC.reset(_sampleRate);
+		parallelTerminatedAdaptor_L.reset(_sampleRate);
 
-		// --- 1 / (sum of admittances)
-		R2 = 1.0 / ((1.0 / R1) + componentConductance);
-		return R2;
+		// --- intialize the chain of adapters
+		seriesAdaptor_RC.initializeAdaptorChain();
+		return true;
 	}
 
-	/** initialize adaptor with input resistance */
-	virtual void initialize(double _R1)
-	{
-		// --- save R1
-		R1 = _R1;
-
-		double G1 = 1.0 / R1;
-		if (terminalResistance <= 0.0)
-			terminalResistance = 1e-15;
-
-		double G2 = 1.0 / terminalResistance;
-		double componentConductance = 0.0;
-		if (getPort3_CompAdaptor())
-			componentConductance = getPort3_CompAdaptor()->getComponentConductance();
-
-		A1 = 2.0*G1 / (G1 + componentConductance + G2);
-		A3 = openTerminalResistance ? 0.0 : 2.0*G2 / (G1 + componentConductance + G2);
-
-		// --- init downstream
-		if (getPort2_CompAdaptor())
-			getPort2_CompAdaptor()->initialize(getR2());
-
-		// --- not used in this implementation but saving for extended use
-		R3 = 1.0 / componentConductance;
-	}
+	/** return false: this object only processes samples */
+	virtual bool canProcessAudioFrame() { return false; }
 
-	/** push audio input sample into incident wave input*/
-	virtual void setInput1(double _in1)
+	/** process input x(n) through the WDF Ideal RLC filter to produce return value y(n) */
+	/**
+	\param xn input
+	\return the processed sample
+	*/
+	virtual double processAudioSample(double xn)
 	{
-		// --- save
-		in1 = _in1;
-
-		N2 = 0.0;
-		if (getPort3_CompAdaptor())
-			N2 = getPort3_CompAdaptor()->getOutput();
-
-		// --- form N1
-		N1 = -A1*(-in1 + N2) + N2 - A3*N2;
-
-		// --- form output1
-		out1 = -in1 + N2 + N1;
-
-		// --- deliver upstream to input2
-		if (getPort1_CompAdaptor())
-			getPort1_CompAdaptor()->setInput2(out1);
-
-		// --- calc out2 y(n)
-		out2 = N2 + N1;
+		// --- push audio sample into series L1
+		seriesAdaptor_RC.setInput1(xn);
 
-		// --- set component state
-		if (getPort3_CompAdaptor())
-			getPort3_CompAdaptor()->setInput(N1);
+		// --- output is at terminated L2's output2
+		//     note compensation scaling by -6dB = 0.5
+		//     because of WDF assumption about Rs and Rload
+		return 0.5*parallelTerminatedAdaptor_L.getOutput2();
 	}
 
-	/** push audio input sample into reflected wave input; this is a dead end for terminated adaptorsthis is a dead end for terminated adaptors  */
-	virtual void setInput2(double _in2){ in2 = _in2;}
+	/** create WDF structure; may be called more than once */
+	void createWDF()
+	{
+		// --- create components, init to noramlized values fc =
+		//	   initial values for fc = 1kHz Q = 0.707
+		//     Holding C Constant at 1e-6
+		//			   L = 2.533e-2
+		//			   R = 2.251131 e2
+		seriesAdaptor_RC.setComponent(wdfComponent::seriesRC, 2.251131e2, 1.0e-6);
+		parallelTerminatedAdaptor_L.setComponent(wdfComponent::L, 2.533e-2);
 
-	/** set input 3 always connects to component */
-	virtual void setInput3(double _in3) { }
+		// --- connect adapters
+		WdfAdaptorBase::connectAdaptors(&seriesAdaptor_RC, &parallelTerminatedAdaptor_L);
 
-	/** get OUT1 = reflected output pin on Port 1 */
-	virtual double getOutput1() { return out1; }
+		// --- set source resistance
+		seriesAdaptor_RC.setSourceResistance(0.0); // --- Rs = 600
 
-	/** get OUT2 = incident (normal) output pin on Port 2 */
-	virtual double getOutput2() { return out2; }
+		// --- set open ckt termination
+		parallelTerminatedAdaptor_L.setOpenTerminalResistance(true);
+	}
 
-	/** get OUT3 always connects to component */
-	virtual double getOutput3() { return out3; }
+	/** get parameters: note use of custom structure for passing param data */
+	/**
+	\return WDFParameters custom data structure
+	*/
+	WDFParameters getParameters() { return wdfParameters; }
 
-private:
-	double N1 = 0.0;	///< node 1 value, internal use only
-	double N2 = 0.0;	///< node 2 value, internal use only
-	double A1 = 0.0;	///< A1 coefficient value
-	double A3 = 0.0;	///< A3 coefficient value
-};
+	/** set parameters: note use of custom structure for passing param data */
+	/**
+	\param WDFParameters custom data structure
+	*/
+	void setParameters(const WDFParameters& _wdfParameters)
+	{
+		if (_wdfParameters.fc != wdfParameters.fc ||
+			_wdfParameters.Q != wdfParameters.Q ||
+			_wdfParameters.boostCut_dB != wdfParameters.boostCut_dB ||
+			_wdfParameters.frequencyWarping != wdfParameters.frequencyWarping)
+		{
+			wdfParameters = _wdfParameters;
 
-// ------------------------------------------------------------------------------ //
-// --- WDF Ladder Filter Design  Examples --------------------------------------- //
-// ------------------------------------------------------------------------------ //
-//
-// --- 3rd order Butterworth LPF designed with Elsie www.TonneSoftware.comm
-//
-/*
-	3rd Order Inductor-Leading LPF
+			// --- calculate all component values, then update the chain in one pass
+			double inductorValue = 0.0;
+			double resistorValue = 0.0;
+			calculateIdealRLCValues(wdfParameters, sampleRate, inductorValue, resistorValue);
 
-	Rs = Rload = 600 ohms
+			seriesAdaptor_RC.setComponentValue_RC(resistorValue, 1.0e-6);
+			parallelTerminatedAdaptor_L.setComponentValue(inductorValue);
+			seriesAdaptor_RC.initializeAdaptorChain();
+		}
+	}
 
-	Series(L1) -> Parallel(C1) -> Series(L2)
 
-	--L1-- | --L2--
-		   C1
-		   |
+protected:
+	WDFParameters wdfParameters;	///< object parameters
 
-	fc = 1kHz
-		L1 = 95.49e-3;
-		C1 = 0.5305e-6;
-		L2 = 95.49e-3;
+	// --- three
+	WdfSeriesAdaptor				seriesAdaptor_RC;				///< adaptor for RC
+	WdfParallelTerminatedAdaptor	parallelTerminatedAdaptor_L;	///< adaptor for L
 
-	fc = 10kHz
-		L1 = 9.549e-3;
-		C1 = 0.05305e-6;
-		L2 = 9.549e-3;
-*/
+	double sampleRate = 1.0;	///< sample rate storage
+};
 
 /**
-\class WDFButterLPF3
+\class WDFIdealRLCBPF
 \ingroup WDF-Objects
 \brief
-The WDFButterLPF3 object implements a 3rd order Butterworth ladder filter.
-NOTE: designed with Elsie www.TonneSoftware.comm
+The WDFIdealRLCBPF object implements an ideal RLC BPF using the WDF library.
 
 Audio I/O:
 - Processes mono input to mono output.
 
 Control I/F:
-- none - this object is hard-wired.
+- Use WDFParameters structure to get/set object params.
 
 \author Will Pirkle http://www.willpirkle.com
 \remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
 \version Revision : 1.0
 \date Date : 2018 / 09 / 7
 */
-class WDFButterLPF3 : public IAudioSignalProcessor
+class WDFIdealRLCBPF : public IAudioSignalProcessor
 {
 public:
-	WDFButterLPF3(void) { createWDF(); }	/* C-TOR */
-	~WDFButterLPF3(void) {}	/* D-TOR */
+	WDFIdealRLCBPF(void) { createWDF(); }	/* C-TOR */
+	~WDFIdealRLCBPF(void) {}	/* D-TOR */
 
 	/** reset members to initialized state */
 	virtual bool reset(double _sampleRate)
 	{
+		sampleRate = _sampleRate;
 		// --- rest WDF components (flush state registers)
-		seriesAdaptor_L1.reset(_sampleRate);
-		parallelAdaptor_C1.reset(_sampleRate);
-		seriesTerminatedAdaptor_L2.reset(_sampleRate);
+		seriesAdaptor_LC.reset(_sampleRate);
+		parallelTerminatedAdaptor_R.reset(_sampleRate);
 
 		// --- intialize the chain of adapters
-		seriesAdaptor_L1.initializeAdaptorChain();
+		seriesAdaptor_LC.initializeAdaptorChain();
 		return true;
 	}
 
 	/** return false: this object only processes samples */
 	virtual bool canProcessAudioFrame() { return false; }
 
-	/** process input x(n) through the WDF ladder filter to produce return value y(n) */
+	/** process input x(n) through the WDF Ideal RLC filter to produce return value y(n) */
 	/**
 	\param xn input
 	\return the processed sample
@@ -7811,86 +11975,116 @@ public:
 	virtual double processAudioSample(double xn)
 	{
 		// --- push audio sample into series L1
-		seriesAdaptor_L1.setInput1(xn);
+		seriesAdaptor_LC.setInput1(xn);
 
 		// --- output is at terminated L2's output2
-		return seriesTerminatedAdaptor_L2.getOutput2();
+		//     note compensation scaling by -6dB = 0.5
+		//     because of WDF assumption about Rs and Rload
+		return 0.5*parallelTerminatedAdaptor_R.getOutput2();
 	}
 
-	/** create the WDF structure for this object - may be called more than once */
+	/** create the WDF structure*/
 	void createWDF()
 	{
-		// --- actual component values fc = 1kHz
-		double L1_value = 95.49e-3;		// 95.5 mH
-		double C1_value = 0.5305e-6;	// 0.53 uF
-		double L2_value = 95.49e-3;		// 95.5 mH
-
-										// --- set adapter components
-		seriesAdaptor_L1.setComponent(wdfComponent::L, L1_value);
-		parallelAdaptor_C1.setComponent(wdfComponent::C, C1_value);
-		seriesTerminatedAdaptor_L2.setComponent(wdfComponent::L, L2_value);
+		// --- create components, init to noramlized values fc =
+		//	   initial values for fc = 1kHz Q = 0.707
+		//     Holding C Constant at 1e-6
+		//			   L = 2.533e-2
+		//			   R = 2.251131 e2
+		seriesAdaptor_LC.setComponent(wdfComponent::seriesLC, 2.533e-2, 1.0e-6);
+		parallelTerminatedAdaptor_R.setComponent(wdfComponent::R, 2.251131e2);
 
 		// --- connect adapters
-		WdfAdaptorBase::connectAdaptors(&seriesAdaptor_L1, &parallelAdaptor_C1);
-		WdfAdaptorBase::connectAdaptors(&parallelAdaptor_C1, &seriesTerminatedAdaptor_L2);
+		WdfAdaptorBase::connectAdaptors(&seriesAdaptor_LC, &parallelTerminatedAdaptor_R);
 
 		// --- set source resistance
-		seriesAdaptor_L1.setSourceResistance(600.0); // --- Rs = 600
+		seriesAdaptor_LC.setSourceResistance(0.0); // --- Rs = 600
 
-		// --- set terminal resistance
-		seriesTerminatedAdaptor_L2.setTerminalResistance(600.0); // --- Rload = 600
+		// --- set open ckt termination
+		parallelTerminatedAdaptor_R.setOpenTerminalResistance(true);
+	}
+
+	/** get parameters: note use of custom structure for passing param data */
+	/**
+	\return WDFParameters custom data structure
+	*/
+	WDFParameters getParameters() { return wdfParameters; }
+
+	/** set parameters: note use of custom structure for passing param data */
+	/**
+	\param WDFParameters custom data structure
+	*/
+	void setParameters(const WDFParameters& _wdfParameters)
+	{
+		if (_wdfParameters.fc != wdfParameters.fc ||
+			_wdfParameters.Q != wdfParameters.Q ||
+			_wdfParameters.boostCut_dB != wdfParameters.boostCut_dB ||
+			_wdfParameters.frequencyWarping != wdfParameters.frequencyWarping)
+		{
+			wdfParameters = _wdfParameters;
+
+			// --- calculate all component values, then update the chain in one pass
+			double inductorValue = 0.0;
+			double resistorValue = 0.0;
+			calculateIdealRLCValues(wdfParameters, sampleRate, inductorValue, resistorValue);
+
+			seriesAdaptor_LC.setComponentValue_LC(inductorValue, 1.0e-6);
+			parallelTerminatedAdaptor_R.setComponentValue(resistorValue);
+			seriesAdaptor_LC.initializeAdaptorChain();
+		}
 	}
 
 protected:
-	// --- three adapters
-	WdfSeriesAdaptor seriesAdaptor_L1;			///< adaptor for L1
-	WdfParallelAdaptor parallelAdaptor_C1;		///< adaptor for C1
-	WdfSeriesTerminatedAdaptor seriesTerminatedAdaptor_L2;	///< adaptor for L2
+	WDFParameters wdfParameters;	///< object parameters
+
+	// --- adapters
+	WdfSeriesAdaptor				seriesAdaptor_LC; ///< adaptor for LC
+	WdfParallelTerminatedAdaptor	parallelTerminatedAdaptor_R; ///< adaptor for R
+
+	double sampleRate = 1.0;
 };
 
+
 /**
-\class WDFTunableButterLPF3
+\class WDFIdealRLCBSF
 \ingroup WDF-Objects
 \brief
-The WDFTunableButterLPF3 object implements a tunable 3rd order Butterworth ladder filter.
-NOTE: designed with Elsie www.TonneSoftware.comm
+The WDFIdealRLCBSF object implements an ideal RLC BSF using the WDF library.
 
 Audio I/O:
 - Processes mono input to mono output.
 
 Control I/F:
-- setUsePostWarping(bool b) to enable/disable warping (see book)
-- setFilterFc(double fc_Hz) to set the tunable fc value
+- Use WDFParameters structure to get/set object params.
 
 \author Will Pirkle http://www.willpirkle.com
 \remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
 \version Revision : 1.0
 \date Date : 2018 / 09 / 7
 */
-class WDFTunableButterLPF3 : public IAudioSignalProcessor
+class WDFIdealRLCBSF : public IAudioSignalProcessor
 {
 public:
-	WDFTunableButterLPF3(void) { createWDF(); }	/* C-TOR */
-	~WDFTunableButterLPF3(void) {}	/* D-TOR */
+	WDFIdealRLCBSF(void) { createWDF(); }	/* C-TOR */
+	~WDFIdealRLCBSF(void) {}	/* D-TOR */
 
 	/** reset members to initialized state */
 	virtual bool reset(double _sampleRate)
 	{
 		sampleRate = _sampleRate;
 		// --- rest WDF components (flush state registers)
-		seriesAdaptor_L1.reset(_sampleRate);
-		parallelAdaptor_C1.reset(_sampleRate);
-		seriesTerminatedAdaptor_L2.reset(_sampleRate);
+		seriesAdaptor_R.reset(_sampleRate);
+		parallelTerminatedAdaptor_LC.reset(_sampleRate);
 
 		// --- intialize the chain of adapters
-		seriesAdaptor_L1.initializeAdaptorChain();
+		seriesAdaptor_R.initializeAdaptorChain();
 		return true;
 	}
 
 	/** return false: this object only processes samples */
 	virtual bool canProcessAudioFrame() { return false; }
 
-	/** process input x(n) through the WDF ladder filter to produce return value y(n) */
+	/** process input x(n) through the WDF Ideal RLC filter to produce return value y(n) */
 	/**
 	\param xn input
 	\return the processed sample
@@ -7898,357 +12092,391 @@ public:
 	virtual double processAudioSample(double xn)
 	{
 		// --- push audio sample into series L1
-		seriesAdaptor_L1.setInput1(xn);
+		seriesAdaptor_R.setInput1(xn);
 
 		// --- output is at terminated L2's output2
-		return seriesTerminatedAdaptor_L2.getOutput2();
+		//     note compensation scaling by -6dB = 0.5
+		//     because of WDF assumption about Rs and Rload
+		return 0.5*parallelTerminatedAdaptor_LC.getOutput2();
 	}
 
-	/** create the filter structure; may be called more than once */
+	/** create WDF structure */
 	void createWDF()
 	{
-		// --- create components, init to noramlized values fc = 1Hz
-		seriesAdaptor_L1.setComponent(wdfComponent::L, L1_norm);
-		parallelAdaptor_C1.setComponent(wdfComponent::C, C1_norm);
-		seriesTerminatedAdaptor_L2.setComponent(wdfComponent::L, L2_norm);
+		// --- create components, init to noramlized values fc =
+		//	   initial values for fc = 1kHz Q = 0.707
+		//     Holding C Constant at 1e-6
+		//			   L = 2.533e-2
+		//			   R = 2.251131 e2
+		seriesAdaptor_R.setComponent(wdfComponent::R, 2.533e-2);
+		parallelTerminatedAdaptor_LC.setComponent(wdfComponent::seriesLC, 2.533e-2, 1.0e-6);
 
 		// --- connect adapters
-		WdfAdaptorBase::connectAdaptors(&seriesAdaptor_L1, &parallelAdaptor_C1);
-		WdfAdaptorBase::connectAdaptors(&parallelAdaptor_C1, &seriesTerminatedAdaptor_L2);
+		WdfAdaptorBase::connectAdaptors(&seriesAdaptor_R, &parallelTerminatedAdaptor_LC);
 
 		// --- set source resistance
-		seriesAdaptor_L1.setSourceResistance(600.0); // --- Rs = 600
+		seriesAdaptor_R.setSourceResistance(0.0); // --- Rs = 600
 
-		// --- set terminal resistance
-		seriesTerminatedAdaptor_L2.setTerminalResistance(600.0); // --- Rload = 600
+		// --- set open ckt termination
+		parallelTerminatedAdaptor_LC.setOpenTerminalResistance(true);
 	}
 
-	/** parameter setter for warping */
-	void setUsePostWarping(bool b) { useFrequencyWarping = b; }
+	/** get parameters: note use of custom structure for passing param data */
+	/**
+	\return WDFParameters custom data structure
+	*/
+	WDFParameters getParameters() { return wdfParameters; }
 
-	/** parameter setter for fc */
-	void setFilterFc(double fc_Hz)
+	/** set parameters: note use of custom structure for passing param data */
+	/**
+	\param WDFParameters custom data structure
+	*/
+	void setParameters(const WDFParameters& _wdfParameters)
 	{
-		if (useFrequencyWarping)
+		if (_wdfParameters.fc != wdfParameters.fc ||
+			_wdfParameters.Q != wdfParameters.Q ||
+			_wdfParameters.boostCut_dB != wdfParameters.boostCut_dB ||
+			_wdfParameters.frequencyWarping != wdfParameters.frequencyWarping)
 		{
-			double arg = (kPi*fc_Hz) / sampleRate;
-			fc_Hz = fc_Hz*(tan(arg) / arg);
+			wdfParameters = _wdfParameters;
+
+			// --- calculate all component values, then update the chain in one pass
+			double inductorValue = 0.0;
+			double resistorValue = 0.0;
+			calculateIdealRLCValues(wdfParameters, sampleRate, inductorValue, resistorValue);
+
+			seriesAdaptor_R.setComponentValue(resistorValue);
+			parallelTerminatedAdaptor_LC.setComponentValue_LC(inductorValue, 1.0e-6);
+			seriesAdaptor_R.initializeAdaptorChain();
 		}
-
-		seriesAdaptor_L1.setComponentValue(L1_norm / fc_Hz);
-		parallelAdaptor_C1.setComponentValue(C1_norm / fc_Hz);
-		seriesTerminatedAdaptor_L2.setComponentValue(L2_norm / fc_Hz);
 	}
 
 protected:
-	// --- three adapters
-	WdfSeriesAdaptor seriesAdaptor_L1;		///< adaptor for L1
-	WdfParallelAdaptor parallelAdaptor_C1;	///< adaptor for C1
-	WdfSeriesTerminatedAdaptor seriesTerminatedAdaptor_L2;	///< adaptor for L2
+	WDFParameters wdfParameters;	///< object parameters
 
-	double L1_norm = 95.493;		// 95.5 mH
-	double C1_norm = 530.516e-6;	// 0.53 uF
-	double L2_norm = 95.493;		// 95.5 mH
+	// --- adapters
+	WdfSeriesAdaptor				seriesAdaptor_R; ///< adaptor for series R
+	WdfParallelTerminatedAdaptor	parallelTerminatedAdaptor_LC; ///< adaptor for parallel LC
 
-	bool useFrequencyWarping = false;	///< flag for freq warping
-	double sampleRate = 1.0;			///< stored sample rate
+	double sampleRate = 1.0; ///< sample rate storage
 };
 
+// ------------------------------------------------------------------------------ //
+// --- WDF Ladder Filters with compile-time adaptors ---------------------------- //
+// ------------------------------------------------------------------------------ //
+//
+// --- these are the ladder filters above, built with the template adaptors; they
+//     produce the same output as the IComponentAdaptor versions
+
+/** ladder for WDFButterLPF3T and WDFTunableButterLPF3T: Series(L1) -> Parallel(C1) -> Series(L2) */
+typedef WdfSeriesAdaptorT<WdfInductor, WdfParallelAdaptorT<WdfCapacitor, WdfSeriesTerminatedAdaptorT<WdfInductor>>> WdfButterLPF3Ladder;
+
+/** ladder for WDFBesselBSF3T: Series(L1||C1) -> Parallel(L2+C2) -> Series(L3||C3) */
+typedef WdfSeriesAdaptorT<WdfParallelLC, WdfParallelAdaptorT<WdfSeriesLC, WdfSeriesTerminatedAdaptorT<WdfParallelLC>>> WdfBesselBSF3Ladder;
+
+/** ladder for WDFConstKBPF6T: three Series(L+C) -> Parallel(L||C) sections */
+typedef WdfSeriesAdaptorT<WdfSeriesLC, WdfParallelAdaptorT<WdfParallelLC,
+		WdfSeriesAdaptorT<WdfSeriesLC, WdfParallelAdaptorT<WdfParallelLC,
+		WdfSeriesAdaptorT<WdfSeriesLC, WdfParallelTerminatedAdaptorT<WdfParallelLC>>>>>> WdfConstKBPF6Ladder;
+
+/** ladder for WDFIdealRLCLPFT: Series(R+L) -> Parallel(C) */
+typedef WdfSeriesAdaptorT<WdfSeriesRL, WdfParallelTerminatedAdaptorT<WdfCapacitor>> WdfIdealRLCLPFLadder;
+
+/** ladder for WDFIdealRLCHPFT: Series(R+C) -> Parallel(L) */
+typedef WdfSeriesAdaptorT<WdfSeriesRC, WdfParallelTerminatedAdaptorT<WdfInductor>> WdfIdealRLCHPFLadder;
+
+/** ladder for WDFIdealRLCBPFT: Series(L+C) -> Parallel(R) */
+typedef WdfSeriesAdaptorT<WdfSeriesLC, WdfParallelTerminatedAdaptorT<WdfResistor>> WdfIdealRLCBPFLadder;
+
+/** ladder for WDFIdealRLCBSFT: Series(R) -> Parallel(L+C) */
+typedef WdfSeriesAdaptorT<WdfResistor, WdfParallelTerminatedAdaptorT<WdfSeriesLC>> WdfIdealRLCBSFLadder;
+
 /**
-\class WDFBesselBSF3
+\class WDFButterLPF3T
 \ingroup WDF-Objects
 \brief
-The WDFBesselBSF3 object implements a 3rd order Bessel BSF
-NOTE: designed with Elsie www.TonneSoftware.comm
+The WDFButterLPF3T object implements the WDFButterLPF3 3rd order Butterworth ladder filter
+with compile-time adaptors.
 
 Audio I/O:
 - Processes mono input to mono output.
 
 Control I/F:
-- none - object is hardwired
+- none - this object is hard-wired.
 
-\author Will Pirkle http://www.willpirkle.com
-\remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
 \version Revision : 1.0
-\date Date : 2018 / 09 / 7
 */
-class WDFBesselBSF3 : public IAudioSignalProcessor
+class WDFButterLPF3T : public WdfLadderFilter<WdfButterLPF3Ladder>
 {
 public:
-	WDFBesselBSF3(void) { createWDF(); }	/* C-TOR */
-	~WDFBesselBSF3(void) {}	/* D-TOR */
-
-	/** reset members to initialized state */
-	virtual bool reset(double _sampleRate)
-	{
-		// --- rest WDF components (flush state registers)
-		seriesAdaptor_L1C1.reset(_sampleRate);
-		parallelAdaptor_L2C2.reset(_sampleRate);
-		seriesTerminatedAdaptor_L3C3.reset(_sampleRate);
-
-		// --- intialize the chain of adapters
-		seriesAdaptor_L1C1.initializeAdaptorChain();
-
-		return true;
-	}
-
-	/** return false: this object only processes samples */
-	virtual bool canProcessAudioFrame() { return false; }
-
-	/** process input x(n) through the WDF ladder filter to produce return value y(n) */
-	/**
-	\param xn input
-	\return the processed sample
-	*/
-	virtual double processAudioSample(double xn)
-	{
-		// --- push audio sample into series L1
-		seriesAdaptor_L1C1.setInput1(xn);
+	WDFButterLPF3T(void) { createWDF(); }	/* C-TOR */
+	~WDFButterLPF3T(void) {}	/* D-TOR */
 
-		// --- output is at terminated L2's output2
-		return seriesTerminatedAdaptor_L3C3.getOutput2();
-	}
-
-	/** create the WDF structure; may be called more than once*/
+	/** create the WDF structure for this object - may be called more than once */
 	void createWDF()
 	{
-		// --- set component values
-		// --- fo = 5kHz
-		//     BW = 2kHz or Q = 2.5
-		seriesAdaptor_L1C1.setComponent(wdfComponent::parallelLC, 16.8327e-3, 0.060193e-6);	/* L, C */
-		parallelAdaptor_L2C2.setComponent(wdfComponent::seriesLC, 49.1978e-3, 0.02059e-6);	/* L, C */
-		seriesTerminatedAdaptor_L3C3.setComponent(wdfComponent::parallelLC, 2.57755e-3, 0.393092e-6);	/* L, C */
-
-		// --- connect adapters
-		WdfAdaptorBase::connectAdaptors(&seriesAdaptor_L1C1, &parallelAdaptor_L2C2);
-		WdfAdaptorBase::connectAdaptors(&parallelAdaptor_L2C2, &seriesTerminatedAdaptor_L3C3);
-
-		// --- set source resistance
-		seriesAdaptor_L1C1.setSourceResistance(600.0); // Ro = 600
+		// --- actual component values fc = 1kHz
+		ladder.getComponent().setComponentValue(95.49e-3);								// L1 = 95.5 mH
+		ladder.getDownstream().getComponent().setComponentValue(0.5305e-6);				// C1 = 0.53 uF
+		ladder.getDownstream().getDownstream().getComponent().setComponentValue(95.49e-3);// L2 = 95.5 mH
 
-		// --- set terminal resistance
-		seriesTerminatedAdaptor_L3C3.setTerminalResistance(600.0);
+		ladder.setSourceResistance(600.0);	// --- Rs = 600
+		ladder.setTerminalResistance(600.0);// --- Rload = 600
 	}
-
-protected:
-	// --- three adapters
-	WdfSeriesAdaptor seriesAdaptor_L1C1;		///< adaptor for L1 and C1
-	WdfParallelAdaptor parallelAdaptor_L2C2;	///< adaptor for L2 and C2
-	WdfSeriesTerminatedAdaptor seriesTerminatedAdaptor_L3C3;	///< adaptor for L3 and C3
 };
 
-
 /**
-\class WDFConstKBPF6
+\class WDFTunableButterLPF3T
 \ingroup WDF-Objects
 \brief
-The WDFConstKBPF6 object implements a 6th order constant K BPF
-NOTE: designed with Elsie www.TonneSoftware.comm
+The WDFTunableButterLPF3T object implements the WDFTunableButterLPF3 tunable 3rd order Butterworth
+ladder filter with compile-time adaptors.
 
 Audio I/O:
 - Processes mono input to mono output.
 
 Control I/F:
-- none - object is hardwired
+- setUsePostWarping(bool b) to enable/disable warping (see book)
+- setFilterFc(double fc_Hz) to set the tunable fc value
+- createFcTable(double minFc_Hz, double maxFc_Hz, unsigned int numPoints) to precompute the
+  ladder coefficients for cheap per-sample fc modulation
 
-\author Will Pirkle http://www.willpirkle.com
-\remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
 \version Revision : 1.0
-\date Date : 2018 / 09 / 7
 */
-class WDFConstKBPF6 : public IAudioSignalProcessor
+class WDFTunableButterLPF3T : public WdfLadderFilter<WdfButterLPF3Ladder>
 {
 public:
-	WDFConstKBPF6(void) { createWDF(); }	/* C-TOR */
-	~WDFConstKBPF6(void) {}	/* D-TOR */
+	WDFTunableButterLPF3T(void) { createWDF(); }	/* C-TOR */
+	~WDFTunableButterLPF3T(void) {}	/* D-TOR */
 
-	/** reset members to initialized state */
-	virtual bool reset(double _sampleRate)
+	/** create the filter structure; may be called more than once */
+	void createWDF()
 	{
-		// --- rest WDF components (flush state registers)
-		seriesAdaptor_L1C1.reset(_sampleRate);
-		parallelAdaptor_L2C2.reset(_sampleRate);
+		// --- init to noramlized values fc = 1Hz
+		ladder.getComponent().setComponentValue(L1_norm);
+		ladder.getDownstream().getComponent().setComponentValue(C1_norm);
+		ladder.getDownstream().getDownstream().getComponent().setComponentValue(L2_norm);
 
-		seriesAdaptor_L3C3.reset(_sampleRate);
-		parallelAdaptor_L4C4.reset(_sampleRate);
-
-		seriesAdaptor_L5C5.reset(_sampleRate);
-		parallelTerminatedAdaptor_L6C6.reset(_sampleRate);
+		ladder.setSourceResistance(600.0);	// --- Rs = 600
+		ladder.setTerminalResistance(600.0);// --- Rload = 600
+	}
 
-		// --- intialize the chain of adapters
-		seriesAdaptor_L1C1.initializeAdaptorChain();
+	/** reset members to initialized state; rebuilds the fc table for the new sample rate */
+	virtual bool reset(double _sampleRate)
+	{
+		WdfLadderFilter<WdfButterLPF3Ladder>::reset(_sampleRate);
+		if (tableSize > 0)
+			createFcTable(tableMinFc_Hz, tableMaxFc_Hz, tableSize);
 		return true;
 	}
 
-	/** return false: this object only processes samples */
-	virtual bool canProcessAudioFrame() { return false; }
+	/** parameter setter for warping */
+	void setUsePostWarping(bool b)
+	{
+		useFrequencyWarping = b;
+		if (tableSize > 0)
+			createFcTable(tableMinFc_Hz, tableMaxFc_Hz, tableSize);
+	}
 
-	/** process input x(n) through the WDF ladder filter to produce return value y(n) */
-	/**
-	\param xn input
-	\return the processed sample
-	*/
-	virtual double processAudioSample(double xn)
+	/** parameter setter for fc; uses the fc table when it covers fc_Hz */
+	void setFilterFc(double fc_Hz)
 	{
-		// --- push audio sample into series L1
-		seriesAdaptor_L1C1.setInput1(xn);
+		currentFc_Hz = fc_Hz;
 
-		// --- output is at terminated L6C6 output2
-		double output = parallelTerminatedAdaptor_L6C6.getOutput2();
+		// --- table lookup: linear interpolation of the coefficients on a log2(fc) axis
+		if (tableSize > 0)
+		{
+			double index = (fastLog2(fc_Hz) - tableMinOctave)*tablePointsPerOctave;
+			if (index >= 0.0 && index < tableSize - 1)
+			{
+				unsigned int i = (unsigned int)index;
+				double frac = index - i;
+				const double* c0 = &fcTable[i*WdfButterLPF3Ladder::numCoefficients];
+				const double* c1 = c0 + WdfButterLPF3Ladder::numCoefficients;
 
-		return output;
-	}
+				double coefficients[WdfButterLPF3Ladder::numCoefficients];
+				for (unsigned int k = 0; k < WdfButterLPF3Ladder::numCoefficients; k++)
+					coefficients[k] = c0[k] + frac*(c1[k] - c0[k]);
 
-	/** create the WDF structure */
-	void createWDF()
-	{
-		// --- fo = 5kHz
-		//     BW = 2kHz or Q = 2.5
-		seriesAdaptor_L1C1.setComponent(wdfComponent::seriesLC, 47.7465e-3, 0.02122e-6);
-		parallelAdaptor_L2C2.setComponent(wdfComponent::parallelLC, 3.81972e-3, 0.265258e-6);
+				ladder.setCoefficients(coefficients);
+				return;
+			}
+		}
 
-		seriesAdaptor_L3C3.setComponent(wdfComponent::seriesLC, 95.493e-3, 0.01061e-6);
-		parallelAdaptor_L4C4.setComponent(wdfComponent::parallelLC, 3.81972e-3, 0.265258e-6);
+		calculateCoefficients(fc_Hz);
+	}
 
-		seriesAdaptor_L5C5.setComponent(wdfComponent::seriesLC, 95.493e-3, 0.01061e-6);
-		parallelTerminatedAdaptor_L6C6.setComponent(wdfComponent::parallelLC, 7.63944e-3, 0.132629e-6);
+	/** precompute the coefficients for numPoints log-spaced fc values from minFc_Hz to maxFc_Hz;
+	    setFilterFc( ) then interpolates the table instead of recalculating the ladder;
+	    do NOT call from realtime audio thread */
+	void createFcTable(double minFc_Hz, double maxFc_Hz, unsigned int numPoints)
+	{
+		tableMinFc_Hz = minFc_Hz;
+		tableMaxFc_Hz = maxFc_Hz;
+		tableSize = numPoints < 2 ? 2 : numPoints;
+		tableMinOctave = fastLog2(minFc_Hz);
+		tablePointsPerOctave = (tableSize - 1) / (fastLog2(maxFc_Hz) - tableMinOctave);
+		fcTable.resize(tableSize*WdfButterLPF3Ladder::numCoefficients);
 
-		// --- connect adapters
-		WdfAdaptorBase::connectAdaptors(&seriesAdaptor_L1C1, &parallelAdaptor_L2C2);
-		WdfAdaptorBase::connectAdaptors(&parallelAdaptor_L2C2, &seriesAdaptor_L3C3);
-		WdfAdaptorBase::connectAdaptors(&seriesAdaptor_L3C3, &parallelAdaptor_L4C4);
-		WdfAdaptorBase::connectAdaptors(&parallelAdaptor_L4C4, &seriesAdaptor_L5C5);
-		WdfAdaptorBase::connectAdaptors(&seriesAdaptor_L5C5, &parallelTerminatedAdaptor_L6C6);
+		for (unsigned int i = 0; i < tableSize; i++)
+		{
+			calculateCoefficients(fastPow2(tableMinOctave + i / tablePointsPerOctave));
+			ladder.getCoefficients(&fcTable[i*WdfButterLPF3Ladder::numCoefficients]);
+		}
 
-		// --- set source resistance
-		seriesAdaptor_L1C1.setSourceResistance(600.0); // Ro = 600
+		// --- the loop leaves the ladder at the top of the table; go back to the current fc
+		if (currentFc_Hz > 0.0)
+			setFilterFc(currentFc_Hz);
+	}
 
-		// --- set terminal resistance
-		parallelTerminatedAdaptor_L6C6.setTerminalResistance(600.0);
+	/** remove the fc table; setFilterFc( ) will recalculate the ladder */
+	void clearFcTable()
+	{
+		tableSize = 0;
+		fcTable.clear();
 	}
 
 protected:
-	// --- six adapters
-	WdfSeriesAdaptor seriesAdaptor_L1C1;		///< adaptor for L1 and C1
-	WdfParallelAdaptor parallelAdaptor_L2C2;	///< adaptor for L2 and C2
+	double L1_norm = 95.493;		// 95.5 mH
+	double C1_norm = 530.516e-6;	// 0.53 uF
+	double L2_norm = 95.493;		// 95.5 mH
 
-	WdfSeriesAdaptor seriesAdaptor_L3C3;		///< adaptor for L3 and C3
-	WdfParallelAdaptor parallelAdaptor_L4C4;	///< adaptor for L4 and C4
+	bool useFrequencyWarping = false;	///< flag for freq warping
+	double currentFc_Hz = 0.0;			///< last fc from setFilterFc( ), 0 = not set yet
 
-	WdfSeriesAdaptor seriesAdaptor_L5C5;		///< adaptor for L5 and C5
-	WdfParallelTerminatedAdaptor parallelTerminatedAdaptor_L6C6;///< adaptor for L6 and C6
-};
+	// --- fc table
+	std::vector<double> fcTable;		///< coefficients, numCoefficients per point
+	unsigned int tableSize = 0;			///< number of points, 0 = no table
+	double tableMinFc_Hz = 20.0;		///< lowest fc in table
+	double tableMaxFc_Hz = 20480.0;		///< highest fc in table
+	double tableMinOctave = 0.0;		///< log2(tableMinFc_Hz)
+	double tablePointsPerOctave = 1.0;	///< table resolution
+
+	/** set the component values for fc and update the ladder in one pass */
+	void calculateCoefficients(double fc_Hz)
+	{
+		if (useFrequencyWarping)
+		{
+			double arg = (kPi*fc_Hz) / sampleRate;
+			fc_Hz = fc_Hz*(tan(arg) / arg);
+		}
 
+		double scale = 1.0 / fc_Hz;
+		ladder.getComponent().setComponentValue(L1_norm*scale);
+		ladder.getDownstream().getComponent().setComponentValue(C1_norm*scale);
+		ladder.getDownstream().getDownstream().getComponent().setComponentValue(L2_norm*scale);
+		ladder.initializeAdaptorChain();
+	}
+};
 
 /**
-\struct WDFParameters
+\class WDFBesselBSF3T
 \ingroup WDF-Objects
 \brief
-Custom parameter structure for the WDF filter examples.
+The WDFBesselBSF3T object implements the WDFBesselBSF3 3rd order Bessel BSF with compile-time adaptors.
+
+Audio I/O:
+- Processes mono input to mono output.
+
+Control I/F:
+- none - object is hardwired
 
-\author Will Pirkle http://www.willpirkle.com
-\remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
 \version Revision : 1.0
-\date Date : 2018 / 09 / 7
 */
-struct WDFParameters
+class WDFBesselBSF3T : public WdfLadderFilter<WdfBesselBSF3Ladder>
 {
-	WDFParameters() {}
-	/** all FXObjects parameter objects require overloaded= operator so remember to add new entries if you add new variables. */
-	WDFParameters& operator=(const WDFParameters& params)
+public:
+	WDFBesselBSF3T(void) { createWDF(); }	/* C-TOR */
+	~WDFBesselBSF3T(void) {}	/* D-TOR */
+
+	/** create the WDF structure; may be called more than once*/
+	void createWDF()
 	{
-		if (this == &params)
-			return *this;
+		// --- fo = 5kHz
+		//     BW = 2kHz or Q = 2.5
+		ladder.getComponent().setComponentValue_LC(16.8327e-3, 0.060193e-6);
+		ladder.getDownstream().getComponent().setComponentValue_LC(49.1978e-3, 0.02059e-6);
+		ladder.getDownstream().getDownstream().getComponent().setComponentValue_LC(2.57755e-3, 0.393092e-6);
 
-		fc = params.fc;
-		Q = params.Q;
-		boostCut_dB = params.boostCut_dB;
-		frequencyWarping = params.frequencyWarping;
-		return *this;
+		ladder.setSourceResistance(600.0);	// Ro = 600
+		ladder.setTerminalResistance(600.0);
 	}
-
-	// --- individual parameters
-	double fc = 100.0;				///< filter fc
-	double Q = 0.707;				///< filter Q
-	double boostCut_dB = 0.0;		///< filter boost or cut in dB
-	bool frequencyWarping = true;	///< enable frequency warping
 };
 
 /**
-\class WDFIdealRLCLPF
+\class WDFConstKBPF6T
 \ingroup WDF-Objects
 \brief
-The WDFIdealRLCLPF object implements an ideal RLC LPF using the WDF library.
+The WDFConstKBPF6T object implements the WDFConstKBPF6 6th order constant K BPF with compile-time adaptors.
 
 Audio I/O:
 - Processes mono input to mono output.
 
 Control I/F:
-- Use WDFParameters structure to get/set object params.
+- none - object is hardwired
 
-\author Will Pirkle http://www.willpirkle.com
-\remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
 \version Revision : 1.0
-\date Date : 2018 / 09 / 7
 */
-class WDFIdealRLCLPF : public IAudioSignalProcessor
+class WDFConstKBPF6T : public WdfLadderFilter<WdfConstKBPF6Ladder>
 {
 public:
-	WDFIdealRLCLPF(void) { createWDF(); }	/* C-TOR */
-	~WDFIdealRLCLPF(void) {}	/* D-TOR */
+	WDFConstKBPF6T(void) { createWDF(); }	/* C-TOR */
+	~WDFConstKBPF6T(void) {}	/* D-TOR */
 
-	/** reset members to initialized state */
-	virtual bool reset(double _sampleRate)
+	/** create the WDF structure */
+	void createWDF()
 	{
-		sampleRate = _sampleRate;
+		auto& section2 = ladder.getDownstream().getDownstream();
+		auto& section3 = section2.getDownstream().getDownstream();
 
-		// --- rest WDF components (flush state registers)
-		seriesAdaptor_RL.reset(_sampleRate);
-		parallelTerminatedAdaptor_C.reset(_sampleRate);
+		// --- fo = 5kHz
+		//     BW = 2kHz or Q = 2.5
+		ladder.getComponent().setComponentValue_LC(47.7465e-3, 0.02122e-6);
+		ladder.getDownstream().getComponent().setComponentValue_LC(3.81972e-3, 0.265258e-6);
 
-		// --- intialize the chain of adapters
-		seriesAdaptor_RL.initializeAdaptorChain();
-		return true;
+		section2.getComponent().setComponentValue_LC(95.493e-3, 0.01061e-6);
+		section2.getDownstream().getComponent().setComponentValue_LC(3.81972e-3, 0.265258e-6);
+
+		section3.getComponent().setComponentValue_LC(95.493e-3, 0.01061e-6);
+		section3.getDownstream().getComponent().setComponentValue_LC(7.63944e-3, 0.132629e-6);
+
+		ladder.setSourceResistance(600.0);	// Ro = 600
+		ladder.setTerminalResistance(600.0);
 	}
+};
+
+/**
+\class WDFIdealRLCLPFT
+\ingroup WDF-Objects
+\brief
+The WDFIdealRLCLPFT object implements the WDFIdealRLCLPF ideal RLC LPF with compile-time adaptors.
 
-	/** return false: this object only processes samples */
-	virtual bool canProcessAudioFrame() { return false; }
+Audio I/O:
+- Processes mono input to mono output.
 
-	/** process input x(n) through the WDF Ideal RLC filter to produce return value y(n) */
-	/**
-	\param xn input
-	\return the processed sample
-	*/
-	virtual double processAudioSample(double xn)
-	{
-		// --- push audio sample into series L1
-		seriesAdaptor_RL.setInput1(xn);
+Control I/F:
+- Use WDFParameters structure to get/set object params.
 
-		// --- output is at terminated L2's output2
-		//     note compensation scaling by -6dB = 0.5
-		//     because of WDF assumption about Rs and Rload
-		return 0.5*parallelTerminatedAdaptor_C.getOutput2();
-	}
+\version Revision : 1.0
+*/
+class WDFIdealRLCLPFT : public WdfLadderFilter<WdfIdealRLCLPFLadder>
+{
+public:
+	WDFIdealRLCLPFT(void) { createWDF(); }	/* C-TOR */
+	~WDFIdealRLCLPFT(void) {}	/* D-TOR */
 
 	/** create the WDF structure; may be called more than once */
 	void createWDF()
 	{
-		// --- create components, init to noramlized values fc =
-		//	   initial values for fc = 1kHz Q = 0.707
-		//     Holding C Constant at 1e-6
-		//			   L = 2.533e-2
-		//			   R = 2.251131 e2
-		seriesAdaptor_RL.setComponent(wdfComponent::seriesRL, 2.251131e2, 2.533e-2);
-		parallelTerminatedAdaptor_C.setComponent(wdfComponent::C, 1.0e-6);
-
-		// --- connect adapters
-		WdfAdaptorBase::connectAdaptors(&seriesAdaptor_RL, &parallelTerminatedAdaptor_C);
+		// --- initial values for fc = 1kHz Q = 0.707, C = 1e-6
+		ladder.getComponent().setComponentValue_RL(2.251131e2, 2.533e-2);
+		ladder.getDownstream().getComponent().setComponentValue(1.0e-6);
 
-		// --- set source resistance
-		seriesAdaptor_RL.setSourceResistance(0.0); // --- Rs = 600
+		ladder.setSourceResistance(0.0);
+		ladder.setOpenTerminalResistance(true);
 
-		// --- set open ckt termination
-		parallelTerminatedAdaptor_C.setOpenTerminalResistance(true);
+		// --- compensate for WDF assumption about Rs and Rload (-6dB)
+		outputScaling = 0.5;
 	}
 
 	/** get parameters: note use of custom structure for passing param data */
@@ -8269,38 +12497,25 @@ public:
 			_wdfParameters.frequencyWarping != wdfParameters.frequencyWarping)
 		{
 			wdfParameters = _wdfParameters;
-			double fc_Hz = wdfParameters.fc;
-
-			if (wdfParameters.frequencyWarping)
-			{
-				double arg = (kPi*fc_Hz) / sampleRate;
-				fc_Hz = fc_Hz*(tan(arg) / arg);
-			}
 
-			double inductorValue = 1.0 / (1.0e-6 * pow((2.0*kPi*fc_Hz), 2.0));
-			double resistorValue = (1.0 / wdfParameters.Q)*(pow(inductorValue / 1.0e-6, 0.5));
+			double inductorValue = 0.0;
+			double resistorValue = 0.0;
+			calculateIdealRLCValues(wdfParameters, sampleRate, inductorValue, resistorValue);
 
-			seriesAdaptor_RL.setComponentValue_RL(resistorValue, inductorValue);
-			seriesAdaptor_RL.initializeAdaptorChain();
+			ladder.getComponent().setComponentValue_RL(resistorValue, inductorValue);
+			ladder.initializeAdaptorChain();
 		}
 	}
 
 protected:
 	WDFParameters wdfParameters;	///< object parameters
-
-	// --- adapters
-	WdfSeriesAdaptor				seriesAdaptor_RL;				///< adaptor for series RL
-	WdfParallelTerminatedAdaptor	parallelTerminatedAdaptor_C;	///< adaptopr for parallel C
-
-	double sampleRate = 1.0;
-
 };
 
 /**
-\class WDFIdealRLCHPF
+\class WDFIdealRLCHPFT
 \ingroup WDF-Objects
 \brief
-The WDFIdealRLCHPF object implements an ideal RLC HPF using the WDF library.
+The WDFIdealRLCHPFT object implements the WDFIdealRLCHPF ideal RLC HPF with compile-time adaptors.
 
 Audio I/O:
 - Processes mono input to mono output.
@@ -8308,68 +12523,26 @@ Audio I/O:
 Control I/F:
 - Use WDFParameters structure to get/set object params.
 
-\author Will Pirkle http://www.willpirkle.com
-\remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
 \version Revision : 1.0
-\date Date : 2018 / 09 / 7
 */
-class WDFIdealRLCHPF : public IAudioSignalProcessor
+class WDFIdealRLCHPFT : public WdfLadderFilter<WdfIdealRLCHPFLadder>
 {
 public:
-	WDFIdealRLCHPF(void) { createWDF(); }	/* C-TOR */
-	~WDFIdealRLCHPF(void) {}	/* D-TOR */
-
-	/** reset members to initialized state */
-	virtual bool reset(double _sampleRate)
-	{
-		sampleRate = _sampleRate;
-		// --- rest WDF components (flush state registers)
-		seriesAdaptor_RC.reset(_sampleRate);
-		parallelTerminatedAdaptor_L.reset(_sampleRate);
-
-		// --- intialize the chain of adapters
-		seriesAdaptor_RC.initializeAdaptorChain();
-		return true;
-	}
-
-	/** return false: this object only processes samples */
-	virtual bool canProcessAudioFrame() { return false; }
-
-	/** process input x(n) through the WDF Ideal RLC filter to produce return value y(n) */
-	/**
-	\param xn input
-	\return the processed sample
-	*/
-	virtual double processAudioSample(double xn)
-	{
-		// --- push audio sample into series L1
-		seriesAdaptor_RC.setInput1(xn);
-
-		// --- output is at terminated L2's output2
-		//     note compensation scaling by -6dB = 0.5
-		//     because of WDF assumption about Rs and Rload
-		return 0.5*parallelTerminatedAdaptor_L.getOutput2();
-	}
+	WDFIdealRLCHPFT(void) { createWDF(); }	/* C-TOR */
+	~WDFIdealRLCHPFT(void) {}	/* D-TOR */
 
-	/** create WDF structure; may be called more than once */
+	/** create the WDF structure; may be called more than once */
 	void createWDF()
 	{
-		// --- create components, init to noramlized values fc =
-		//	   initial values for fc = 1kHz Q = 0.707
-		//     Holding C Constant at 1e-6
-		//			   L = 2.533e-2
-		//			   R = 2.251131 e2
-		seriesAdaptor_RC.setComponent(wdfComponent::seriesRC, 2.251131e2, 1.0e-6);
-		parallelTerminatedAdaptor_L.setComponent(wdfComponent::L, 2.533e-2);
-
-		// --- connect adapters
-		WdfAdaptorBase::connectAdaptors(&seriesAdaptor_RC, &parallelTerminatedAdaptor_L);
+		// --- initial values for fc = 1kHz Q = 0.707, C = 1e-6
+		ladder.getComponent().setComponentValue_RC(2.251131e2, 1.0e-6);
+		ladder.getDownstream().getComponent().setComponentValue(2.533e-2);
 
-		// --- set source resistance
-		seriesAdaptor_RC.setSourceResistance(0.0); // --- Rs = 600
+		ladder.setSourceResistance(0.0);
+		ladder.setOpenTerminalResistance(true);
 
-		// --- set open ckt termination
-		parallelTerminatedAdaptor_L.setOpenTerminalResistance(true);
+		// --- compensate for WDF assumption about Rs and Rload (-6dB)
+		outputScaling = 0.5;
 	}
 
 	/** get parameters: note use of custom structure for passing param data */
@@ -8390,39 +12563,26 @@ public:
 			_wdfParameters.frequencyWarping != wdfParameters.frequencyWarping)
 		{
 			wdfParameters = _wdfParameters;
-			double fc_Hz = wdfParameters.fc;
-
-			if (wdfParameters.frequencyWarping)
-			{
-				double arg = (kPi*fc_Hz) / sampleRate;
-				fc_Hz = fc_Hz*(tan(arg) / arg);
-			}
 
-			double inductorValue = 1.0 / (1.0e-6 * pow((2.0*kPi*fc_Hz), 2.0));
-			double resistorValue = (1.0 / wdfParameters.Q)*(pow(inductorValue / 1.0e-6, 0.5));
+			double inductorValue = 0.0;
+			double resistorValue = 0.0;
+			calculateIdealRLCValues(wdfParameters, sampleRate, inductorValue, resistorValue);
 
-			seriesAdaptor_RC.setComponentValue_RC(resistorValue, 1.0e-6);
-			parallelTerminatedAdaptor_L.setComponentValue(inductorValue);
-			seriesAdaptor_RC.initializeAdaptorChain();
+			ladder.getComponent().setComponentValue_RC(resistorValue, 1.0e-6);
+			ladder.getDownstream().getComponent().setComponentValue(inductorValue);
+			ladder.initializeAdaptorChain();
 		}
 	}
 
-
 protected:
 	WDFParameters wdfParameters;	///< object parameters
-
-	// --- three
-	WdfSeriesAdaptor				seriesAdaptor_RC;				///< adaptor for RC
-	WdfParallelTerminatedAdaptor	parallelTerminatedAdaptor_L;	///< adaptor for L
-
-	double sampleRate = 1.0;	///< sample rate storage
 };
 
 /**
-\class WDFIdealRLCBPF
+\class WDFIdealRLCBPFT
 \ingroup WDF-Objects
 \brief
-The WDFIdealRLCBPF object implements an ideal RLC BPF using the WDF library.
+The WDFIdealRLCBPFT object implements the WDFIdealRLCBPF ideal RLC BPF with compile-time adaptors.
 
 Audio I/O:
 - Processes mono input to mono output.
@@ -8430,68 +12590,26 @@ Audio I/O:
 Control I/F:
 - Use WDFParameters structure to get/set object params.
 
-\author Will Pirkle http://www.willpirkle.com
-\remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
 \version Revision : 1.0
-\date Date : 2018 / 09 / 7
 */
-class WDFIdealRLCBPF : public IAudioSignalProcessor
+class WDFIdealRLCBPFT : public WdfLadderFilter<WdfIdealRLCBPFLadder>
 {
 public:
-	WDFIdealRLCBPF(void) { createWDF(); }	/* C-TOR */
-	~WDFIdealRLCBPF(void) {}	/* D-TOR */
-
-	/** reset members to initialized state */
-	virtual bool reset(double _sampleRate)
-	{
-		sampleRate = _sampleRate;
-		// --- rest WDF components (flush state registers)
-		seriesAdaptor_LC.reset(_sampleRate);
-		parallelTerminatedAdaptor_R.reset(_sampleRate);
-
-		// --- intialize the chain of adapters
-		seriesAdaptor_LC.initializeAdaptorChain();
-		return true;
-	}
-
-	/** return false: this object only processes samples */
-	virtual bool canProcessAudioFrame() { return false; }
-
-	/** process input x(n) through the WDF Ideal RLC filter to produce return value y(n) */
-	/**
-	\param xn input
-	\return the processed sample
-	*/
-	virtual double processAudioSample(double xn)
-	{
-		// --- push audio sample into series L1
-		seriesAdaptor_LC.setInput1(xn);
-
-		// --- output is at terminated L2's output2
-		//     note compensation scaling by -6dB = 0.5
-		//     because of WDF assumption about Rs and Rload
-		return 0.5*parallelTerminatedAdaptor_R.getOutput2();
-	}
+	WDFIdealRLCBPFT(void) { createWDF(); }	/* C-TOR */
+	~WDFIdealRLCBPFT(void) {}	/* D-TOR */
 
-	/** create the WDF structure*/
+	/** create the WDF structure; may be called more than once */
 	void createWDF()
 	{
-		// --- create components, init to noramlized values fc =
-		//	   initial values for fc = 1kHz Q = 0.707
-		//     Holding C Constant at 1e-6
-		//			   L = 2.533e-2
-		//			   R = 2.251131 e2
-		seriesAdaptor_LC.setComponent(wdfComponent::seriesLC, 2.533e-2, 1.0e-6);
-		parallelTerminatedAdaptor_R.setComponent(wdfComponent::R, 2.251131e2);
+		// --- initial values for fc = 1kHz Q = 0.707, C = 1e-6
+		ladder.getComponent().setComponentValue_LC(2.533e-2, 1.0e-6);
+		ladder.getDownstream().getComponent().setComponentValue(2.251131e2);
 
-		// --- connect adapters
-		WdfAdaptorBase::connectAdaptors(&seriesAdaptor_LC, &parallelTerminatedAdaptor_R);
-
-		// --- set source resistance
-		seriesAdaptor_LC.setSourceResistance(0.0); // --- Rs = 600
+		ladder.setSourceResistance(0.0);
+		ladder.setOpenTerminalResistance(true);
 
-		// --- set open ckt termination
-		parallelTerminatedAdaptor_R.setOpenTerminalResistance(true);
+		// --- compensate for WDF assumption about Rs and Rload (-6dB)
+		outputScaling = 0.5;
 	}
 
 	/** get parameters: note use of custom structure for passing param data */
@@ -8512,39 +12630,26 @@ public:
 			_wdfParameters.frequencyWarping != wdfParameters.frequencyWarping)
 		{
 			wdfParameters = _wdfParameters;
-			double fc_Hz = wdfParameters.fc;
-
-			if (wdfParameters.frequencyWarping)
-			{
-				double arg = (kPi*fc_Hz) / sampleRate;
-				fc_Hz = fc_Hz*(tan(arg) / arg);
-			}
 
-			double inductorValue = 1.0 / (1.0e-6 * pow((2.0*kPi*fc_Hz), 2.0));
-			double resistorValue = (1.0 / wdfParameters.Q)*(pow(inductorValue / 1.0e-6, 0.5));
+			double inductorValue = 0.0;
+			double resistorValue = 0.0;
+			calculateIdealRLCValues(wdfParameters, sampleRate, inductorValue, resistorValue);
 
-			seriesAdaptor_LC.setComponentValue_LC(inductorValue, 1.0e-6);
-			parallelTerminatedAdaptor_R.setComponentValue(resistorValue);
-			seriesAdaptor_LC.initializeAdaptorChain();
+			ladder.getComponent().setComponentValue_LC(inductorValue, 1.0e-6);
+			ladder.getDownstream().getComponent().setComponentValue(resistorValue);
+			ladder.initializeAdaptorChain();
 		}
 	}
 
 protected:
 	WDFParameters wdfParameters;	///< object parameters
-
-	// --- adapters
-	WdfSeriesAdaptor				seriesAdaptor_LC; ///< adaptor for LC
-	WdfParallelTerminatedAdaptor	parallelTerminatedAdaptor_R; ///< adaptor for R
-
-	double sampleRate = 1.0;
 };
 
-
 /**
-\class WDFIdealRLCBSF
+\class WDFIdealRLCBSFT
 \ingroup WDF-Objects
 \brief
-The WDFIdealRLCBSF object implements an ideal RLC BSF using the WDF library.
+The WDFIdealRLCBSFT object implements the WDFIdealRLCBSF ideal RLC BSF with compile-time adaptors.
 
 Audio I/O:
 - Processes mono input to mono output.
@@ -8552,68 +12657,26 @@ Audio I/O:
 Control I/F:
 - Use WDFParameters structure to get/set object params.
 
-\author Will Pirkle http://www.willpirkle.com
-\remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
 \version Revision : 1.0
-\date Date : 2018 / 09 / 7
 */
-class WDFIdealRLCBSF : public IAudioSignalProcessor
+class WDFIdealRLCBSFT : public WdfLadderFilter<WdfIdealRLCBSFLadder>
 {
 public:
-	WDFIdealRLCBSF(void) { createWDF(); }	/* C-TOR */
-	~WDFIdealRLCBSF(void) {}	/* D-TOR */
-
-	/** reset members to initialized state */
-	virtual bool reset(double _sampleRate)
-	{
-		sampleRate = _sampleRate;
-		// --- rest WDF components (flush state registers)
-		seriesAdaptor_R.reset(_sampleRate);
-		parallelTerminatedAdaptor_LC.reset(_sampleRate);
-
-		// --- intialize the chain of adapters
-		seriesAdaptor_R.initializeAdaptorChain();
-		return true;
-	}
-
-	/** return false: this object only processes samples */
-	virtual bool canProcessAudioFrame() { return false; }
-
-	/** process input x(n) through the WDF Ideal RLC filter to produce return value y(n) */
-	/**
-	\param xn input
-	\return the processed sample
-	*/
-	virtual double processAudioSample(double xn)
-	{
-		// --- push audio sample into series L1
-		seriesAdaptor_R.setInput1(xn);
-
-		// --- output is at terminated L2's output2
-		//     note compensation scaling by -6dB = 0.5
-		//     because of WDF assumption about Rs and Rload
-		return 0.5*parallelTerminatedAdaptor_LC.getOutput2();
-	}
+	WDFIdealRLCBSFT(void) { createWDF(); }	/* C-TOR */
+	~WDFIdealRLCBSFT(void) {}	/* D-TOR */
 
-	/** create WDF structure */
+	/** create the WDF structure; may be called more than once */
 	void createWDF()
 	{
-		// --- create components, init to noramlized values fc =
-		//	   initial values for fc = 1kHz Q = 0.707
-		//     Holding C Constant at 1e-6
-		//			   L = 2.533e-2
-		//			   R = 2.251131 e2
-		seriesAdaptor_R.setComponent(wdfComponent::R, 2.533e-2);
-		parallelTerminatedAdaptor_LC.setComponent(wdfComponent::seriesLC, 2.533e-2, 1.0e-6);
-
-		// --- connect adapters
-		WdfAdaptorBase::connectAdaptors(&seriesAdaptor_R, &parallelTerminatedAdaptor_LC);
+		// --- initial values for fc = 1kHz Q = 0.707, C = 1e-6
+		ladder.getComponent().setComponentValue(2.533e-2);
+		ladder.getDownstream().getComponent().setComponentValue_LC(2.533e-2, 1.0e-6);
 
-		// --- set source resistance
-		seriesAdaptor_R.setSourceResistance(0.0); // --- Rs = 600
+		ladder.setSourceResistance(0.0);
+		ladder.setOpenTerminalResistance(true);
 
-		// --- set open ckt termination
-		parallelTerminatedAdaptor_LC.setOpenTerminalResistance(true);
+		// --- compensate for WDF assumption about Rs and Rload (-6dB)
+		outputScaling = 0.5;
 	}
 
 	/** get parameters: note use of custom structure for passing param data */
@@ -8634,31 +12697,19 @@ public:
 			_wdfParameters.frequencyWarping != wdfParameters.frequencyWarping)
 		{
 			wdfParameters = _wdfParameters;
-			double fc_Hz = wdfParameters.fc;
 
-			if (wdfParameters.frequencyWarping)
-			{
-				double arg = (kPi*fc_Hz) / sampleRate;
-				fc_Hz = fc_Hz*(tan(arg) / arg);
-			}
+			double inductorValue = 0.0;
+			double resistorValue = 0.0;
+			calculateIdealRLCValues(wdfParameters, sampleRate, inductorValue, resistorValue);
 
-			double inductorValue = 1.0 / (1.0e-6 * pow((2.0*kPi*fc_Hz), 2.0));
-			double resistorValue = (1.0 / wdfParameters.Q)*(pow(inductorValue / 1.0e-6, 0.5));
-
-			seriesAdaptor_R.setComponentValue(resistorValue);
-			parallelTerminatedAdaptor_LC.setComponentValue_LC(inductorValue, 1.0e-6);
-			seriesAdaptor_R.initializeAdaptorChain();
+			ladder.getComponent().setComponentValue(resistorValue);
+			ladder.getDownstream().getComponent().setComponentValue_LC(inductorValue, 1.0e-6);
+			ladder.initializeAdaptorChain();
 		}
 	}
 
 protected:
 	WDFParameters wdfParameters;	///< object parameters
-
-	// --- adapters
-	WdfSeriesAdaptor				seriesAdaptor_R; ///< adaptor for series R
-	WdfParallelTerminatedAdaptor	parallelTerminatedAdaptor_LC; ///< adaptor for parallel LC
-
-	double sampleRate = 1.0; ///< sample rate storage
 };
 
 